@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstring>
+
+#include "../ServerNetLib/tcp_network.h"
+
+namespace NBenchmark
+{
+	using ServerConfig = NServerNetLib::ServerConfig;
+	using ClientSession = NServerNetLib::ClientSession;
+	using ILog = NServerNetLib::ILog;
+
+	// 벤치마크에서 TcpNetwork 내부 함수를 직접 호출하기 위한 파생 클래스
+	class BenchTcpNetwork : public NServerNetLib::TcpNetwork
+	{
+	public:
+		using TcpNetwork::RecvBufferProcess;
+		using TcpNetwork::AddPacketQueue;
+		using TcpNetwork::FlushSendBuff;
+
+		// 리슨 소켓 없이 세션 풀만 만듦 (소켓을 쓰지 않는 함수 측정용)
+		void InitSessionPool(const ServerConfig* pConfig, ILog* pLogger)
+		{
+			memcpy(&m_Config, pConfig, sizeof(ServerConfig));
+			m_pRefLogger = pLogger;
+
+			FD_ZERO(&m_Readfds);
+			CreateSessionPool(pConfig->MaxClientCount + pConfig->ExtraClientCount);
+		}
+
+		// 이미 연결된 소켓(socketpair 의 한쪽)을 접속한 세션으로 등록
+		int32_t AttachSocket(const SOCKET fd)
+		{
+			int32_t sessionIndex = AllocClientSessionIndex();
+			if (sessionIndex < 0) {
+				return -1;
+			}
+
+			SetNonBlockSocket(fd);
+			FD_SET(fd, &m_Readfds);
+			ConnectedSession(sessionIndex, fd, "bench");
+			return sessionIndex;
+		}
+
+		ClientSession& GetSession(const int32_t sessionIndex) { return m_ClientSessionPool[sessionIndex]; }
+
+		// 로직 스레드 없이 받은 패킷 큐를 비움
+		void ClearPacketQueue()
+		{
+			std::lock_guard<std::mutex> guard(m_PacketQueueLock);
+			m_PacketQueue.clear();
+			m_PacketDataQueue.clear();
+		}
+	};
+
+	class NullLog : public ILog
+	{
+	protected:
+		void Trace(const char*) override {}
+		void Debug(const char*) override {}
+		void Warn(const char*) override {}
+		void Error(const char*) override {}
+		void Info(const char*) override {}
+	};
+}
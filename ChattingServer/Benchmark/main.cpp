@@ -0,0 +1,415 @@
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/socket.h>
+#include <cerrno>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+#include "bench_tcp_network.h"
+#include "../ServerNetLib/loopback_network.h"
+
+namespace
+{
+	using namespace NBenchmark;
+	using NServerNetLib::PacketHeader;
+	using NServerNetLib::PACKET_HEADER_SIZE;
+	using NServerNetLib::MAX_PACKET_BODY_SIZE;
+
+	constexpr int16_t BENCH_PACKET_ID = 241;
+
+	// rdtsc 는 코어 클럭이 아니라 고정 주파수(reference) 사이클이므로 bytes/cycle 은 같은 장비끼리만 비교
+	inline uint64_t ReadCycle()
+	{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return 0;
+#endif
+	}
+
+	struct BenchResult
+	{
+		uint64_t PacketCount = 0;
+		uint64_t ByteCount = 0;
+		double ElapsedNs = 0;
+		uint64_t Cycles = 0;
+	};
+
+	void PrintHeader()
+	{
+		printf("%-40s %12s %10s %12s %10s\n", "case", "packets", "ns/packet", "bytes/cycle", "MB/s");
+	}
+
+	void PrintResult(const char* pszName, const BenchResult& result)
+	{
+		double nsPerPacket = result.PacketCount > 0 ? result.ElapsedNs / (double)result.PacketCount : 0;
+		double mbPerSec = result.ElapsedNs > 0 ? ((double)result.ByteCount / (1024.0 * 1024.0)) / (result.ElapsedNs / 1e9) : 0;
+
+		if (result.Cycles > 0) {
+			printf("%-40s %12llu %10.2f %12.3f %10.1f\n", pszName, (unsigned long long)result.PacketCount, nsPerPacket,
+				(double)result.ByteCount / (double)result.Cycles, mbPerSec);
+		}
+		else {
+			printf("%-40s %12llu %10.2f %12s %10.1f\n", pszName, (unsigned long long)result.PacketCount, nsPerPacket, "n/a", mbPerSec);
+		}
+	}
+
+	// func 한 번이 packetsPerIter 개 패킷, bytesPerIter 바이트를 처리한다고 보고 iterCount 번 측정
+	BenchResult Measure(const int iterCount, const uint64_t packetsPerIter, const uint64_t bytesPerIter, const std::function<void()>& func)
+	{
+		// 캐시와 분기 예측을 데우는 용도
+		for (int i = 0; i < iterCount / 10 + 1; ++i) {
+			func();
+		}
+
+		auto startTime = std::chrono::steady_clock::now();
+		auto startCycle = ReadCycle();
+		for (int i = 0; i < iterCount; ++i) {
+			func();
+		}
+		auto endCycle = ReadCycle();
+		auto endTime = std::chrono::steady_clock::now();
+
+		BenchResult result;
+		result.PacketCount = packetsPerIter * iterCount;
+		result.ByteCount = bytesPerIter * iterCount;
+		result.ElapsedNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+		result.Cycles = endCycle - startCycle;
+		return result;
+	}
+
+	// 크기 bufferSize 안에 bodySize 패킷을 빈틈없이 채우고, partialSize 만큼 다음 패킷의 앞부분을 붙임
+	int BuildPacketStream(std::vector<char>& buffer, const int bufferSize, const int16_t bodySize, const int partialSize)
+	{
+		buffer.assign(bufferSize, 'x');
+
+		int packetSize = PACKET_HEADER_SIZE + bodySize;
+		int packetCount = (bufferSize - partialSize) / packetSize;
+		int pos = 0;
+		for (int i = 0; i < packetCount; ++i) {
+			PacketHeader header{ (int16_t)packetSize, BENCH_PACKET_ID, 0 };
+			memcpy(&buffer[pos], &header, PACKET_HEADER_SIZE);
+			pos += packetSize;
+		}
+
+		if (partialSize > 0) {
+			PacketHeader header{ (int16_t)packetSize, BENCH_PACKET_ID, 0 };
+			memcpy(&buffer[pos], &header, std::min(partialSize, PACKET_HEADER_SIZE));
+			pos += partialSize;
+		}
+
+		buffer.resize(pos);
+		return packetCount;
+	}
+
+	ServerConfig MakeConfig()
+	{
+		ServerConfig config;
+		memset(&config, 0, sizeof(config));
+		config.Port = 0;
+		config.BackLogCount = 32;
+		config.MaxClientCount = 512;
+		config.ExtraClientCount = 0;
+		config.MaxClientSocketOptRecvBufferSize = 10240;
+		config.MaxClientSocketOptSendBufferSize = 10240;
+		config.MaxClientRecvBufferSize = 8192;
+		config.MaxClientSendBufferSize = 8192;
+		config.IdleStrategy = NServerNetLib::IDLE_STRATEGY::kBUSY_SPIN;
+		return config;
+	}
+
+	void BenchRecvBufferProcess(const char* pszName, const int16_t bodySize, const int partialSize, const int iterCount)
+	{
+		NullLog logger;
+		auto config = MakeConfig();
+		BenchTcpNetwork network;
+		network.InitSessionPool(&config, &logger);
+
+		std::vector<char> stream;
+		int packetCount = BuildPacketStream(stream, config.MaxClientRecvBufferSize, bodySize, partialSize);
+
+		auto& session = network.GetSession(0);
+		session.SocketFD = 1;
+
+		auto result = Measure(iterCount, packetCount, stream.size(), [&]() {
+			memcpy(session.pRecvBuffer, stream.data(), stream.size());
+			session.RemainingDataSize = (int32_t)stream.size();
+			session.PrevReadPosInRecvBuffer = 0;
+
+			network.RecvBufferProcess(0);
+			network.ClearPacketQueue();
+		});
+
+		session.SocketFD = 0;
+		PrintResult(pszName, result);
+	}
+
+	void BenchAddPacketQueue(const char* pszName, const int16_t bodySize, const int iterCount)
+	{
+		NullLog logger;
+		auto config = MakeConfig();
+		BenchTcpNetwork network;
+		network.InitSessionPool(&config, &logger);
+
+		constexpr int BATCH_COUNT = 256;
+		std::vector<int8_t> body(bodySize > 0 ? bodySize : 1, 'x');
+
+		auto result = Measure(iterCount, BATCH_COUNT, (uint64_t)BATCH_COUNT * bodySize, [&]() {
+			for (int i = 0; i < BATCH_COUNT; ++i) {
+				network.AddPacketQueue(0, BENCH_PACKET_ID, bodySize, body.data());
+			}
+			network.ClearPacketQueue();
+		});
+
+		PrintResult(pszName, result);
+	}
+
+	void BenchSendData(const char* pszName, const int16_t bodySize, const int iterCount)
+	{
+		NullLog logger;
+		auto config = MakeConfig();
+		BenchTcpNetwork network;
+		network.InitSessionPool(&config, &logger);
+
+		auto& session = network.GetSession(0);
+		session.SocketFD = 1;
+
+		int packetSize = PACKET_HEADER_SIZE + bodySize;
+		int packetCount = config.MaxClientSendBufferSize / packetSize;
+		std::vector<char> body(bodySize > 0 ? bodySize : 1, 'x');
+
+		auto result = Measure(iterCount, packetCount, (uint64_t)packetCount * packetSize, [&]() {
+			for (int i = 0; i < packetCount; ++i) {
+				network.SendData(0, BENCH_PACKET_ID, bodySize, body.data());
+			}
+			session.SendSize = 0;
+		});
+
+		session.SocketFD = 0;
+		PrintResult(pszName, result);
+	}
+
+	// 소켓 없는 루프백: 생성 함수가 넣은 패킷 -> GetPacketInfo -> SendData 로 되돌려줌 -> TakeSendData 로 꺼내서 크기 확인
+	// 같은 조건의 Run/... echo 와 비교하면 소켓과 시스템 콜을 뺀 비용
+	void BenchLoopbackEcho(const char* pszName, const int sessionCount, const int16_t bodySize, const int packetsPerSession, const int roundCount)
+	{
+		NullLog logger;
+		auto config = MakeConfig();
+		config.IsLoopbackVirtualClock = true;
+		config.IsLoopbackCaptureSend = true;
+		NServerNetLib::LoopbackNetwork network;
+		if (network.Init(&config, &logger) != NServerNetLib::NET_ERROR_CODE::kNONE) {
+			printf("%-40s 네트워크 초기화 실패\n", pszName);
+			return;
+		}
+
+		for (int i = 0; i < sessionCount; ++i) {
+			network.ConnectSession(i);
+		}
+
+		// 접속 통보 패킷 정리
+		while (network.GetPacketInfo().PacketId != 0) {
+		}
+
+		std::vector<int8_t> body(bodySize > 0 ? bodySize : 1, 'x');
+		std::vector<char> sendData;
+		uint64_t expectBytes = (uint64_t)(PACKET_HEADER_SIZE + bodySize) * packetsPerSession * sessionCount;
+		bool isMatched = true;
+
+		auto result = Measure(roundCount, (uint64_t)sessionCount * packetsPerSession, expectBytes, [&]() {
+			// 한 라운드의 패킷을 모두 넣고 끝남
+			network.SetGenerator([&](NServerNetLib::LoopbackNetwork& loopback) {
+				for (int i = 0; i < packetsPerSession; ++i) {
+					for (int sessionIndex = 0; sessionIndex < sessionCount; ++sessionIndex) {
+						loopback.InjectPacket(sessionIndex, BENCH_PACKET_ID, bodySize, body.data());
+					}
+				}
+				return false;
+			});
+
+			while (true) {
+				auto packetInfo = network.GetPacketInfo();
+				if (packetInfo.PacketId == 0) {
+					break;
+				}
+				network.SendData(packetInfo.SessionIndex, packetInfo.PacketId + 1, packetInfo.PacketBodySize, (const char*)packetInfo.pRefData);
+			}
+
+			uint64_t recvBytes = 0;
+			for (int sessionIndex = 0; sessionIndex < sessionCount; ++sessionIndex) {
+				network.TakeSendData(sessionIndex, sendData);
+				recvBytes += sendData.size();
+			}
+			if (recvBytes != expectBytes) {
+				isMatched = false;
+			}
+		});
+
+		if (isMatched == false) {
+			printf("%-40s 되돌려 받은 크기가 보낸 크기와 다름\n", pszName);
+			return;
+		}
+		PrintResult(pszName, result);
+	}
+
+#ifndef _WIN32
+	void DrainSocket(const int fd)
+	{
+		char buffer[64 * 1024];
+		while (recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT) > 0) {
+		}
+	}
+
+	void BenchFlushSendBuff(const char* pszName, const int16_t bodySize, const int iterCount)
+	{
+		NullLog logger;
+		auto config = MakeConfig();
+		BenchTcpNetwork network;
+		network.InitSessionPool(&config, &logger);
+
+		int fds[2];
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+			printf("%-40s socketpair 실패 (errno %d)\n", pszName, errno);
+			return;
+		}
+
+		int sessionIndex = network.AttachSocket(fds[0]);
+		auto& session = network.GetSession(sessionIndex);
+
+		int packetSize = PACKET_HEADER_SIZE + bodySize;
+		int packetCount = config.MaxClientSendBufferSize / packetSize;
+		std::vector<char> fill(packetCount * packetSize, 'x');
+
+		// 송신 버퍼를 가득 채운 상태에서 한 번 보내는 비용 (send 시스템 콜 포함)
+		auto result = Measure(iterCount, packetCount, fill.size(), [&]() {
+			memcpy(session.pSendBuffer, fill.data(), fill.size());
+			session.SendSize = (int32_t)fill.size();
+
+			network.FlushSendBuff(sessionIndex);
+			DrainSocket(fds[1]);
+		});
+
+		close(fds[0]);
+		close(fds[1]);
+		PrintResult(pszName, result);
+	}
+
+	// 클라이언트 쓰기 -> Run(select, recv, 파싱) -> 로직(GetPacketInfo, SendData 로 되돌려줌) -> Run(send) -> 클라이언트 읽기
+	void BenchRunLoop(const char* pszName, const int pairCount, const int16_t bodySize, const int packetsPerPair, const int roundCount)
+	{
+		NullLog logger;
+		auto config = MakeConfig();
+		BenchTcpNetwork network;
+		if (network.Init(&config, &logger) != NServerNetLib::NET_ERROR_CODE::kNONE) {
+			printf("%-40s 네트워크 초기화 실패\n", pszName);
+			return;
+		}
+
+		std::vector<int> clientFdList;
+		for (int i = 0; i < pairCount; ++i) {
+			int fds[2];
+			if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+				printf("%-40s socketpair 실패 (errno %d)\n", pszName, errno);
+				return;
+			}
+
+			network.AttachSocket(fds[0]);
+			clientFdList.push_back(fds[1]);
+		}
+
+		// 접속 통보 패킷 정리
+		while (network.GetPacketInfo().PacketId != 0) {
+		}
+
+		std::vector<char> stream;
+		BuildPacketStream(stream, (PACKET_HEADER_SIZE + bodySize) * packetsPerPair, bodySize, 0);
+
+		uint64_t expectBytes = (uint64_t)stream.size() * pairCount;
+
+		auto result = Measure(roundCount, (uint64_t)pairCount * packetsPerPair, expectBytes, [&]() {
+			for (auto fd : clientFdList) {
+				send(fd, stream.data(), stream.size(), 0);
+			}
+
+			uint64_t recvBytes = 0;
+			char buffer[64 * 1024];
+			while (recvBytes < expectBytes) {
+				network.Run();
+
+				while (true) {
+					auto packetInfo = network.GetPacketInfo();
+					if (packetInfo.PacketId == 0) {
+						break;
+					}
+					network.SendData(packetInfo.SessionIndex, packetInfo.PacketId + 1, packetInfo.PacketBodySize, (const char*)packetInfo.pRefData);
+				}
+
+				for (auto fd : clientFdList) {
+					while (true) {
+						auto size = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+						if (size <= 0) {
+							break;
+						}
+						recvBytes += size;
+					}
+				}
+			}
+		});
+
+		for (auto fd : clientFdList) {
+			close(fd);
+		}
+		PrintResult(pszName, result);
+	}
+#endif
+}
+
+int main(int argc, char* argv[])
+{
+	// 인자로 반복 배수를 주면 측정 시간을 늘리거나 줄임
+	int scale = argc > 1 ? std::max(1, atoi(argv[1])) : 1;
+
+	PrintHeader();
+
+	BenchRecvBufferProcess("RecvBufferProcess/16B back-to-back", 16, 0, 20000 * scale);
+	BenchRecvBufferProcess("RecvBufferProcess/16B + partial header", 16, 3, 20000 * scale);
+	BenchRecvBufferProcess("RecvBufferProcess/128B back-to-back", 128, 0, 20000 * scale);
+	BenchRecvBufferProcess("RecvBufferProcess/max body", MAX_PACKET_BODY_SIZE, 0, 50000 * scale);
+	BenchRecvBufferProcess("RecvBufferProcess/max body + partial", MAX_PACKET_BODY_SIZE, PACKET_HEADER_SIZE + 100, 50000 * scale);
+
+	BenchAddPacketQueue("AddPacketQueue/0B", 0, 20000 * scale);
+	BenchAddPacketQueue("AddPacketQueue/16B", 16, 20000 * scale);
+	BenchAddPacketQueue("AddPacketQueue/max body", MAX_PACKET_BODY_SIZE, 5000 * scale);
+
+	BenchSendData("SendData/16B", 16, 20000 * scale);
+	BenchSendData("SendData/128B", 128, 20000 * scale);
+	BenchSendData("SendData/max body", MAX_PACKET_BODY_SIZE, 50000 * scale);
+
+#ifndef _WIN32
+	BenchFlushSendBuff("FlushSendBuff/16B x full buffer", 16, 20000 * scale);
+	BenchFlushSendBuff("FlushSendBuff/max body x full buffer", MAX_PACKET_BODY_SIZE, 20000 * scale);
+
+	BenchRunLoop("Run/8 sessions 16B echo", 8, 16, 64, 2000 * scale);
+	BenchRunLoop("Run/256 sessions 16B echo", 256, 16, 16, 200 * scale);
+	BenchRunLoop("Run/64 sessions max body echo", 64, MAX_PACKET_BODY_SIZE, 4, 200 * scale);
+#endif
+
+	BenchLoopbackEcho("Loopback/8 sessions 16B echo", 8, 16, 64, 2000 * scale);
+	BenchLoopbackEcho("Loopback/256 sessions 16B echo", 256, 16, 16, 200 * scale);
+	BenchLoopbackEcho("Loopback/64 sessions max body echo", 64, MAX_PACKET_BODY_SIZE, 4, 200 * scale);
+
+	return 0;
+}
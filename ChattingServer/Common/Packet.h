@@ -1,7 +1,7 @@
 ﻿#pragma once
 
-#include "PacketID.h"
-#include "ErrorCode.h"
+#include "packet_id.h"
+#include "error_code.h"
 
 namespace NCommon
 {	
@@ -32,6 +32,14 @@ namespace NCommon
 	{
 	};
 
+	//- UDP 채널 정보. UDP 데이터그램 헤더에 SessionIndex 와 Token 을 붙여서 Port 로 보냄
+	struct PktLogInUdpInfoNtf
+	{
+		int SessionIndex;
+		unsigned long long Token;
+		unsigned short Port;
+	};
+
 
 	//- 채널 리스트 요청
 	// Request에는 Body가 없음.
@@ -63,6 +71,20 @@ namespace NCommon
 	};
 
 
+	//- 로그인 후 서버가 다시 시작하기 전에 있던 로비/룸으로 돌아가기 요청
+	// 로비 입장(과 룸 입장)을 한 번에 처리하고 결과를 돌려줌
+	struct PktLobbyRejoinReq {};
+
+	struct PktLobbyRejoinRes : PktBase
+	{
+		short LobbyId = -1;
+		// 룸에 돌아가지 못했으면(가득 찼거나 닫힘) -1 이고 로비에만 들어감
+		short RoomIndex = -1;
+		short MaxUserCount = 0;
+		short MaxRoomCount = 0;
+	};
+
+
 	
 	//- 로비에서 나가기 요청
 	struct PktLobbyLeaveReq {};
@@ -74,16 +96,46 @@ namespace NCommon
 	
 
 	//- 룸에 들어가기 요청
+	// 패킷의 문자열은 플랫폼과 상관없이 UTF-16 (윈도우 클라이언트의 wchar_t 와 같은 배치, 리눅스의 wchar_t 는 4바이트라 쓰지 않음)
 	const int MAX_ROOM_TITLE_SIZE = 16;
+	// IsCreate 가 false 이고 RoomIndex 가 이 값이면 빠른 입장 (게임 시작 전이고 자리가 남은 룸 중 가장 꽉 찬 룸)
+	const short QUICK_ENTER_ROOM_INDEX = -1;
 	struct PktRoomEnterReq
 	{
 		bool IsCreate;
 		short RoomIndex;
-		wchar_t RoomTitle[MAX_ROOM_TITLE_SIZE + 1];
+		char16_t RoomTitle[MAX_ROOM_TITLE_SIZE + 1];
 	};
 
 	struct PktRoomEnterRes : PktBase
 	{
+		// 들어간 룸 (만들기/빠른 입장으로 들어간 룸도 알 수 있도록)
+		short RoomIndex = -1;
+	};
+
+
+
+	//- 로비의 룸 목록 요청
+	// GameState 의 룸 중 빈 자리가 MinFreeSeatCount 이상인 룸을 가장 꽉 찬 룸부터 (GameState 0: 시작 전, 1: 시작 대기, 2: 게임 중)
+	const int MAX_ROOM_LIST_COUNT = 20;
+	struct PktLobbyRoomListReq
+	{
+		char GameState;
+		short MinFreeSeatCount;
+	};
+
+	struct RoomListInfo
+	{
+		short RoomIndex;
+		short RoomUserCount;
+		short RoomMaxUserCount;
+		char GameState;
+		char16_t RoomTitle[MAX_ROOM_TITLE_SIZE + 1];
+	};
+	struct PktLobbyRoomListRes : PktBase
+	{
+		short RoomCount = 0;
+		RoomListInfo RoomList[MAX_ROOM_LIST_COUNT];
 	};
 
 		
@@ -112,7 +164,7 @@ namespace NCommon
 	const int MAX_ROOM_CHAT_MSG_SIZE = 256;
 	struct PktRoomChatReq
 	{
-		wchar_t Msg[MAX_ROOM_CHAT_MSG_SIZE + 1] = { 0, };
+		char16_t Msg[MAX_ROOM_CHAT_MSG_SIZE + 1] = { 0, };
 	};
 
 	struct PktRoomChatRes : PktBase
@@ -122,14 +174,14 @@ namespace NCommon
 	struct PktRoomChatNtf
 	{
 		char UserID[MAX_USER_ID_SIZE + 1] = { 0, };
-		wchar_t Msg[MAX_ROOM_CHAT_MSG_SIZE + 1] = { 0, };
+		char16_t Msg[MAX_ROOM_CHAT_MSG_SIZE + 1] = { 0, };
 	};
 
 	//- 로비 채팅
 	const int MAX_LOBBY_CHAT_MSG_SIZE = 256;
 	struct PktLobbyChatReq
 	{
-		wchar_t Msg[MAX_LOBBY_CHAT_MSG_SIZE + 1] = { 0, };
+		char16_t Msg[MAX_LOBBY_CHAT_MSG_SIZE + 1] = { 0, };
 	};
 
 	struct PktLobbyChatRes : PktBase
@@ -139,7 +191,7 @@ namespace NCommon
 	struct PktLobbyChatNtf
 	{
 		char UserID[MAX_USER_ID_SIZE + 1] = { 0, };
-		wchar_t Msg[MAX_LOBBY_CHAT_MSG_SIZE + 1] = { 0, };
+		char16_t Msg[MAX_LOBBY_CHAT_MSG_SIZE + 1] = { 0, };
 	};
 
 
@@ -167,6 +219,22 @@ namespace NCommon
 	};
 
 
+	// 게임 중인 룸의 상태 (UDP, 받은 유저를 뺀 룸의 모든 유저에게 그대로 전달)
+	const int MAX_GAME_STATE_DATA_SIZE = 512;
+	struct PktRoomGameStateReq
+	{
+		short DataSize;
+		char Datas[MAX_GAME_STATE_DATA_SIZE];
+	};
+
+	struct PktRoomGameStateNtf
+	{
+		char UserID[MAX_USER_ID_SIZE + 1] = { 0, };
+		short DataSize;
+		char Datas[MAX_GAME_STATE_DATA_SIZE];
+	};
+
+
 
 
 	const int DEV_ECHO_DATA_MAX_SIZE = 1024;
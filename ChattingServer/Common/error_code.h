@@ -9,7 +9,16 @@ namespace NCommon
 
 		UNASSIGNED_ERROR = 201,
 
+		MAIN_INIT_USER_STORE_OPEN_FAIL = 202,
+		MAIN_INIT_CHAT_FILTER_LOAD_FAIL = 203,
+		MAIN_INIT_CLUSTER_INIT_FAIL = 204,
+		MAIN_INIT_SHM_GATEWAY_INIT_FAIL = 205,
 		MAIN_INIT_NETWORK_INIT_FAIL = 206,
+		MAIN_INIT_CONFIG_LOAD_FAIL = 207,
+		MAIN_INIT_CREDENTIAL_LOAD_FAIL = 208,
+		MAIN_INIT_METRICS_INIT_FAIL = 209,
+		MAIN_INIT_LOG_FILE_OPEN_FAIL = 210,
+		MAIN_INIT_UDP_INIT_FAIL = 211,
 
 		USER_MGR_ID_DUPLICATION = 211,
 		USER_MGR_MAX_USER_COUNT = 212,
@@ -17,6 +26,10 @@ namespace NCommon
 		USER_MGR_NOT_CONFIRM_USER = 214,
 		USER_MGR_REMOVE_INVALID_SESSION = 221,
 
+		LOGIN_ALREADY_PENDING = 222,
+		// 없는 ID 도 이 코드 (어떤 ID 가 있는지 알 수 없도록)
+		LOGIN_INVALID_PASSWORD = 224,
+
 		LOBBY_LIST_INVALID_DOMAIN = 226,
 
 		LOBBY_ENTER_INVALID_DOMAIN = 231,
@@ -24,10 +37,16 @@ namespace NCommon
 		LOBBY_ENTER_USER_DUPLICATION = 234,
 		LOBBY_ENTER_MAX_USER_COUNT = 235,
 		LOBBY_ENTER_EMPTY_USER_LIST = 236,
+		// 클러스터: 로비를 맡은 노드와 연결되어 있지 않음
+		LOBBY_ENTER_NODE_UNAVAILABLE = 237,
+		LOBBY_REJOIN_INVALID_DOMAIN = 238,
+		// 돌아갈 자리가 없음 (스냅샷에 없었거나 기다리는 시간이 지남). 평소처럼 로비 입장부터
+		LOBBY_REJOIN_NOT_FOUND = 239,
 
 		LOBBY_ROOM_LIST_INVALID_START_ROOM_INDEX = 241,
 		LOBBY_ROOM_LIST_INVALID_DOMAIN = 242,
 		LOBBY_ROOM_LIST_INVALID_LOBBY_INDEX = 243,
+		LOBBY_ROOM_LIST_INVALID_GAME_STATE = 244,
 
 		LOBBY_USER_LIST_INVALID_DOMAIN = 251, 
 		LOBBY_USER_LIST_INVALID_LOBBY_INDEX = 252, 
@@ -44,6 +63,9 @@ namespace NCommon
 		ROOM_ENTER_NOT_CREATED = 275,
 		ROOM_ENTER_MEMBER_FULL = 276,
 		ROOM_ENTER_EMPTY_ROOM = 277,
+		ROOM_ENTER_INVALID_TITLE = 278,
+		// 빠른 입장: 게임 시작 전이고 자리가 남은 룸이 없음
+		ROOM_ENTER_NO_OPEN_ROOM = 279,
 
 
 		ROOM_LEAVE_INVALID_DOMAIN = 286,
@@ -55,9 +77,11 @@ namespace NCommon
 		ROOM_CHAT_INVALID_DOMAIN = 296,	
 		ROOM_CHAT_INVALID_LOBBY_INDEX = 297,
 		ROOM_CHAT_INVALID_ROOM_INDEX = 298,
+		ROOM_CHAT_INVALID_MSG = 299,
 
 		LOBBY_CHAT_INVALID_DOMAIN = 306,
 		LOBBY_CHAT_INVALID_LOBBY_INDEX = 307,
+		LOBBY_CHAT_INVALID_MSG = 308,
 
 		ROOM_MASTER_GAME_START_INVALID_DOMAIN = 401,
 		ROOM_MASTER_GAME_START_INVALID_LOBBY_INDEX = 402,
@@ -65,5 +89,18 @@ namespace NCommon
 		ROOM_MASTER_GAME_START_INVALID_MASTER = 404,
 		ROOM_MASTER_GAME_START_INVALID_GAME_STATE = 405,
 		ROOM_MASTER_GAME_START_INVALID_USER_COUNT = 406,
+
+		ROOM_GAME_START_INVALID_DOMAIN = 411,
+		ROOM_GAME_START_INVALID_LOBBY_INDEX = 412,
+		ROOM_GAME_START_INVALID_ROOM_INDEX = 413,
+		ROOM_GAME_START_INVALID_GAME_STATE = 414,
+		ROOM_GAME_START_MASTER_USER = 415,
+		ROOM_GAME_START_ALREADY_REQUESTED = 416,
+
+		ROOM_GAME_STATE_UDP_DISABLED = 421,
+		ROOM_GAME_STATE_INVALID_DOMAIN = 422,
+		ROOM_GAME_STATE_INVALID_LOBBY_INDEX = 423,
+		ROOM_GAME_STATE_INVALID_ROOM_INDEX = 424,
+		ROOM_GAME_STATE_NOT_STARTED = 425,
 	};
 }
\ No newline at end of file
@@ -7,12 +7,21 @@ namespace NCommon
 	{		
 		LOGIN_IN_REQ = 21,
 		LOGIN_IN_RES = 22,
+		// 로그인 성공 후 UDP 채널 토큰 (UDP 를 켰을 때만)
+		LOGIN_UDP_INFO_NTF = 23,
 
 		LOBBY_LIST_REQ = 26,
 		LOBBY_LIST_RES = 27,
 
 		LOBBY_ENTER_REQ = 31,
 		LOBBY_ENTER_RES = 32,
+
+		// 서버가 다시 시작한 뒤 이전 로비/룸으로 돌아가기
+		LOBBY_REJOIN_REQ = 36,
+		LOBBY_REJOIN_RES = 37,
+
+		LOBBY_ROOM_LIST_REQ = 41,
+		LOBBY_ROOM_LIST_RES = 42,
 				
 		LOBBY_LEAVE_REQ = 46,
 		LOBBY_LEAVE_RES = 47,
@@ -43,6 +52,10 @@ namespace NCommon
 		ROOM_GAME_START_RES = 112,
 		ROOM_GAME_START_NTF = 113,
 
+		// UDP 로만 주고받는 게임 중 상태 (응답 없음)
+		ROOM_GAME_STATE_REQ = 121,
+		ROOM_GAME_STATE_NTF = 123,
+
 
 
 		DEV_ECHO_REQ = 241,
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+
+#include "../LogicLib/main.h"
+
+namespace
+{
+	std::atomic<bool> g_IsStopRequested = false;
+	std::atomic<bool> g_IsHandoffRequested = false;
+
+	void OnStopSignal(int)
+	{
+		g_IsStopRequested = true;
+	}
+
+	void OnHandoffSignal(int)
+	{
+		g_IsHandoffRequested = true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	// 실행 인자로 설정 파일 경로를 주지 않으면 작업 폴더(Bin)의 ServerConfig.ini 사용
+	// --handoff: 실행 중인 이전 프로세스에게서 리슨 소켓과 세션을 넘겨받아 시작
+	// --gateway: 소켓만 처리하는 게이트웨이로 시작 (로직 프로세스는 같은 ShmFileName 으로 인자 없이 실행)
+	const char* pszConfigFileName = "ServerConfig.ini";
+	bool isHandoffReceive = false;
+	bool isShmGateway = false;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--handoff") == 0) {
+			isHandoffReceive = true;
+		}
+		else if (strcmp(argv[i], "--gateway") == 0) {
+			isShmGateway = true;
+		}
+		else {
+			pszConfigFileName = argv[i];
+		}
+	}
+
+	NLogicLib::Main main;
+	auto initResult = main.Init(pszConfigFileName, isHandoffReceive, isShmGateway);
+	if (initResult != NCommon::ERROR_CODE::NONE) {
+		std::cout << "서버 초기화 실패. ErrorCode: " << (int)initResult << std::endl;
+		return 1;
+	}
+
+	// Ctrl+C 또는 종료 요청 시 스레드를 정리하고 종료
+	std::signal(SIGINT, OnStopSignal);
+	std::signal(SIGTERM, OnStopSignal);
+#ifndef _WIN32
+	// 새 프로세스를 --handoff 로 띄운 뒤 이 프로세스에 보내면 세션을 넘기고 종료
+	std::signal(SIGUSR2, OnHandoffSignal);
+	// 상대가 끊은 소켓에 send 해도 종료되지 않도록 (send 마다 MSG_NOSIGNAL 을 주지 않은 곳까지 막음)
+	std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+	main.Start();
+	std::cout << "서버 실행 중. 종료하려면 Ctrl+C" << std::endl;
+
+	// 루프백 스크립트로 돌면 스크립트를 모두 처리했을 때도 종료
+	while (g_IsStopRequested == false && main.IsFinished() == false) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+		if (g_IsHandoffRequested.exchange(false) && main.Handoff()) {
+			std::cout << "세션을 새 프로세스에게 넘기고 종료" << std::endl;
+			return 0;
+		}
+	}
+
+	main.Stop();
+
+	if (main.IsFinished()) {
+		std::cout << "루프백 스크립트 실행 완료" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,532 @@
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <cerrno>
+#endif
+
+#include <cstring>
+#include <algorithm>
+#include <thread>
+
+#include "../Common/Packet.h"
+#include "../ServerNetLib/define.h"
+#include "load_tester.h"
+
+#ifdef _WIN32
+#define poll WSAPoll
+#define CLOSE_SOCKET closesocket
+#define IS_WOULD_BLOCK() (WSAGetLastError() == WSAEWOULDBLOCK)
+#else
+#define CLOSE_SOCKET close
+#define IS_WOULD_BLOCK() (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINPROGRESS)
+#endif
+
+namespace NLoadTester
+{
+	using PACKET_ID = NCommon::PACKET_ID;
+	using ERROR_CODE = NCommon::ERROR_CODE;
+
+	namespace
+	{
+		constexpr int RECV_BUFFER_SIZE = 64 * 1024;
+		constexpr int SEND_BUFFER_SIZE = 64 * 1024;
+
+		// 들어갈 룸을 찾지 못했을 때 다시 시도할 간격
+		constexpr int64_t ROOM_RETRY_NS = 100LL * 1000 * 1000;
+	}
+
+	int64_t LoadWorker::NowNs()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	void LoadWorker::Init(const LoadTestConfig* pConfig, const int firstIndex, const int connectionCount, LoadCounter* pCounter)
+	{
+		m_pRefConfig = pConfig;
+		m_pRefCounter = pCounter;
+
+		m_ConnectionList.resize(connectionCount);
+		for (int i = 0; i < connectionCount; ++i) {
+			auto& conn = m_ConnectionList[i];
+			conn.Index = firstIndex + i;
+			conn.RecvBuffer.resize(RECV_BUFFER_SIZE);
+			conn.SendBuffer.resize(SEND_BUFFER_SIZE);
+
+			// 연결 번호 순서대로 로비를 돌아가며 배정하고, 로비 안에서 RoomUserCount 명마다 한 명이 룸을 만듦
+			int lobbyCount = std::max(1, pConfig->LobbyCount);
+			conn.LobbyIndex = (short)(conn.Index % lobbyCount);
+			int orderInLobby = conn.Index / lobbyCount;
+			conn.IsRoomCreator = (orderInLobby % std::max(1, pConfig->RoomUserCount)) == 0;
+		}
+	}
+
+	void LoadWorker::Run(const std::atomic<bool>& isRun, const int64_t endTimeNs)
+	{
+		const int threadConnectPerSec = std::max(1, m_pRefConfig->ConnectPerSec / std::max(1, m_pRefConfig->ThreadCount));
+		const int64_t connectIntervalNs = 1000LL * 1000 * 1000 / threadConnectPerSec;
+		int64_t nextConnectTimeNs = NowNs();
+		size_t nextConnectPos = 0;
+
+		std::vector<pollfd> pollList;
+		std::vector<Connection*> pollConnList;
+		pollList.reserve(m_ConnectionList.size());
+		pollConnList.reserve(m_ConnectionList.size());
+
+		while (isRun) {
+			auto curTimeNs = NowNs();
+			if (curTimeNs >= endTimeNs) {
+				break;
+			}
+
+			while (nextConnectPos < m_ConnectionList.size() && curTimeNs >= nextConnectTimeNs) {
+				StartConnect(m_ConnectionList[nextConnectPos++]);
+				nextConnectTimeNs += connectIntervalNs;
+			}
+
+			for (auto& conn : m_ConnectionList) {
+				OnTimer(conn, curTimeNs);
+			}
+
+			pollList.clear();
+			pollConnList.clear();
+			for (auto& conn : m_ConnectionList) {
+				if (conn.Fd == INVALID_SOCKET) {
+					continue;
+				}
+
+				pollfd pfd;
+				pfd.fd = conn.Fd;
+				pfd.events = POLLIN;
+				pfd.revents = 0;
+				if (conn.State == CONNECTION_STATE::CONNECTING || conn.SendSize > 0) {
+					pfd.events |= POLLOUT;
+				}
+
+				pollList.push_back(pfd);
+				pollConnList.push_back(&conn);
+			}
+
+			if (pollList.empty()) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				continue;
+			}
+
+			int result = poll(pollList.data(), (unsigned long)pollList.size(), 1);
+			if (result <= 0) {
+				continue;
+			}
+
+			for (size_t i = 0; i < pollList.size(); ++i) {
+				auto revents = pollList[i].revents;
+				if (revents == 0) {
+					continue;
+				}
+
+				auto& conn = *pollConnList[i];
+				if (conn.State == CONNECTION_STATE::CONNECTING) {
+					if (revents & (POLLOUT | POLLERR | POLLHUP)) {
+						OnConnected(conn);
+					}
+					continue;
+				}
+
+				if (revents & (POLLIN | POLLERR | POLLHUP)) {
+					OnReadable(conn);
+				}
+
+				if (conn.Fd != INVALID_SOCKET && (revents & POLLOUT)) {
+					OnWritable(conn);
+				}
+			}
+		}
+
+		for (auto& conn : m_ConnectionList) {
+			if (conn.Fd != INVALID_SOCKET) {
+				CLOSE_SOCKET(conn.Fd);
+				conn.Fd = INVALID_SOCKET;
+			}
+		}
+	}
+
+	void LoadWorker::StartConnect(Connection& conn)
+	{
+		addrinfo hints;
+		memset(&hints, 0, sizeof(hints));
+		hints.ai_family = AF_INET;
+		hints.ai_socktype = SOCK_STREAM;
+
+		addrinfo* pAddr = nullptr;
+		auto portText = std::to_string(m_pRefConfig->Port);
+		if (getaddrinfo(m_pRefConfig->Host.c_str(), portText.c_str(), &hints, &pAddr) != 0 || pAddr == nullptr) {
+			++m_pRefCounter->ConnectFail;
+			conn.State = CONNECTION_STATE::CLOSED;
+			return;
+		}
+
+		auto fd = socket(pAddr->ai_family, pAddr->ai_socktype, pAddr->ai_protocol);
+		if (fd == INVALID_SOCKET) {
+			freeaddrinfo(pAddr);
+			++m_pRefCounter->ConnectFail;
+			conn.State = CONNECTION_STATE::CLOSED;
+			return;
+		}
+
+#ifdef _WIN32
+		unsigned long mode = 1;
+		ioctlsocket(fd, FIONBIO, &mode);
+#else
+		fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+#endif
+		int noDelay = 1;
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, sizeof(noDelay));
+
+		auto result = connect(fd, pAddr->ai_addr, (int)pAddr->ai_addrlen);
+		freeaddrinfo(pAddr);
+
+		if (result == SOCKET_ERROR && IS_WOULD_BLOCK() == false) {
+			CLOSE_SOCKET(fd);
+			++m_pRefCounter->ConnectFail;
+			conn.State = CONNECTION_STATE::CLOSED;
+			return;
+		}
+
+		conn.Fd = fd;
+		conn.State = CONNECTION_STATE::CONNECTING;
+		conn.RecvSize = 0;
+		conn.SendSize = 0;
+	}
+
+	void LoadWorker::OnConnected(Connection& conn)
+	{
+		int error = 0;
+		socklen_t errorLen = sizeof(error);
+		getsockopt(conn.Fd, SOL_SOCKET, SO_ERROR, (char*)&error, &errorLen);
+		if (error != 0) {
+			++m_pRefCounter->ConnectFail;
+			CLOSE_SOCKET(conn.Fd);
+			conn.Fd = INVALID_SOCKET;
+			conn.State = CONNECTION_STATE::CLOSED;
+			return;
+		}
+
+		++m_pRefCounter->ConnectSuccess;
+		SendLogin(conn);
+	}
+
+	void LoadWorker::OnWritable(Connection& conn)
+	{
+		if (conn.SendSize <= 0) {
+			return;
+		}
+
+		auto sendSize = send(conn.Fd, conn.SendBuffer.data(), conn.SendSize, 0);
+		if (sendSize <= 0) {
+			if (sendSize < 0 && IS_WOULD_BLOCK()) {
+				return;
+			}
+
+			Close(conn);
+			return;
+		}
+
+		m_pRefCounter->SendBytes.fetch_add(sendSize, std::memory_order_relaxed);
+		if (sendSize < conn.SendSize) {
+			memmove(conn.SendBuffer.data(), conn.SendBuffer.data() + sendSize, conn.SendSize - sendSize);
+		}
+		conn.SendSize -= (int)sendSize;
+	}
+
+	void LoadWorker::OnReadable(Connection& conn)
+	{
+		while (true) {
+			auto recvSize = recv(conn.Fd, conn.RecvBuffer.data() + conn.RecvSize, (int)conn.RecvBuffer.size() - conn.RecvSize, 0);
+			if (recvSize == 0) {
+				Close(conn);
+				return;
+			}
+
+			if (recvSize < 0) {
+				if (IS_WOULD_BLOCK() == false) {
+					Close(conn);
+				}
+				return;
+			}
+
+			m_pRefCounter->RecvBytes.fetch_add(recvSize, std::memory_order_relaxed);
+			conn.RecvSize += (int)recvSize;
+
+			int readPos = 0;
+			while (conn.RecvSize - readPos >= NServerNetLib::PACKET_HEADER_SIZE) {
+				auto pHeader = (NServerNetLib::PacketHeader*)(conn.RecvBuffer.data() + readPos);
+				int totalSize = pHeader->TotalSize;
+				if (totalSize < NServerNetLib::PACKET_HEADER_SIZE || totalSize > (int)conn.RecvBuffer.size()) {
+					Close(conn);
+					return;
+				}
+
+				if (conn.RecvSize - readPos < totalSize) {
+					break;
+				}
+
+				m_pRefCounter->RecvPacket.fetch_add(1, std::memory_order_relaxed);
+				ProcessPacket(conn, pHeader->Id, conn.RecvBuffer.data() + readPos + NServerNetLib::PACKET_HEADER_SIZE,
+					(int16_t)(totalSize - NServerNetLib::PACKET_HEADER_SIZE));
+				if (conn.Fd == INVALID_SOCKET) {
+					return;
+				}
+
+				readPos += totalSize;
+			}
+
+			if (readPos > 0) {
+				memmove(conn.RecvBuffer.data(), conn.RecvBuffer.data() + readPos, conn.RecvSize - readPos);
+				conn.RecvSize -= readPos;
+			}
+		}
+	}
+
+	void LoadWorker::ProcessPacket(Connection& conn, const int16_t packetId, const char* pBody, const int16_t bodySize)
+	{
+		auto curTimeNs = NowNs();
+
+		short errorCode = 0;
+		if (bodySize >= (int16_t)sizeof(NCommon::PktBase)) {
+			memcpy(&errorCode, pBody, sizeof(errorCode));
+		}
+
+		switch ((PACKET_ID)packetId)
+		{
+		case PACKET_ID::LOGIN_IN_RES:
+			m_LoginLatencyList.push_back(curTimeNs - conn.RequestTimeNs);
+			if (errorCode != (short)ERROR_CODE::NONE) {
+				++m_pRefCounter->LoginFail;
+				Close(conn);
+				return;
+			}
+
+			++m_pRefCounter->LoginSuccess;
+			if (m_pRefConfig->Scenario == SCENARIO::LOGIN || m_pRefConfig->Scenario == SCENARIO::ECHO) {
+				OnReady(conn);
+			}
+			else {
+				SendLobbyEnter(conn);
+			}
+			break;
+
+		case PACKET_ID::LOBBY_ENTER_RES:
+			if (errorCode != (short)ERROR_CODE::NONE) {
+				++m_pRefCounter->ErrorResponse;
+				Close(conn);
+				return;
+			}
+
+			if (m_pRefConfig->Scenario == SCENARIO::ROOM || m_pRefConfig->Scenario == SCENARIO::ROOM_CHAT) {
+				SendRoomEnter(conn);
+			}
+			else {
+				OnReady(conn);
+			}
+			break;
+
+		case PACKET_ID::ROOM_ENTER_RES:
+			if (errorCode == (short)ERROR_CODE::NONE) {
+				OnReady(conn);
+				break;
+			}
+
+			if (conn.IsRoomCreator) {
+				++m_pRefCounter->ErrorResponse;
+				Close(conn);
+				return;
+			}
+
+			// 들어갈 수 있는 룸이 아직 없으면 잠시 뒤 다시 빠른 입장
+			conn.RetryTimeNs = curTimeNs + ROOM_RETRY_NS;
+			break;
+
+		case PACKET_ID::ROOM_CHAT_RES:
+		case PACKET_ID::LOBBY_CHAT_RES:
+			if (conn.PendingTimeQueue.empty() == false) {
+				m_RequestLatencyList.push_back(curTimeNs - conn.PendingTimeQueue.front());
+				conn.PendingTimeQueue.pop_front();
+			}
+
+			m_pRefCounter->Response.fetch_add(1, std::memory_order_relaxed);
+			if (errorCode != (short)ERROR_CODE::NONE) {
+				m_pRefCounter->ErrorResponse.fetch_add(1, std::memory_order_relaxed);
+			}
+			break;
+
+		case PACKET_ID::DEV_ECHO_RES:
+		{
+			// 보낼 때 Datas 앞에 넣은 송신 시간으로 계산
+			int64_t sendTimeNs = 0;
+			int headerSize = (int)(sizeof(NCommon::PktBase) + sizeof(short));
+			if (bodySize >= headerSize + (int)sizeof(sendTimeNs)) {
+				memcpy(&sendTimeNs, pBody + headerSize, sizeof(sendTimeNs));
+				m_RequestLatencyList.push_back(curTimeNs - sendTimeNs);
+			}
+
+			m_pRefCounter->Response.fetch_add(1, std::memory_order_relaxed);
+			break;
+		}
+
+		default:
+			// 다른 유저의 채팅 통보 등은 수신 수치에만 포함
+			break;
+		}
+	}
+
+	void LoadWorker::OnReady(Connection& conn)
+	{
+		conn.State = CONNECTION_STATE::RUNNING;
+		++m_pRefCounter->Ready;
+
+		// 모든 연결이 같은 순간에 보내지 않도록 첫 송신 시간을 연결 번호로 흩어 놓음
+		if (m_pRefConfig->RatePerSec > 0) {
+			int64_t intervalNs = (int64_t)(1e9 / m_pRefConfig->RatePerSec);
+			conn.NextSendTimeNs = NowNs() + (intervalNs / 1000) * (conn.Index % 1000);
+		}
+	}
+
+	void LoadWorker::OnTimer(Connection& conn, const int64_t curTimeNs)
+	{
+		if (conn.Fd == INVALID_SOCKET) {
+			return;
+		}
+
+		if (conn.State == CONNECTION_STATE::ROOM_ENTER && conn.RetryTimeNs != 0 && curTimeNs >= conn.RetryTimeNs) {
+			conn.RetryTimeNs = 0;
+			SendRoomEnter(conn);
+			return;
+		}
+
+		if (conn.State != CONNECTION_STATE::RUNNING || m_pRefConfig->RatePerSec <= 0) {
+			return;
+		}
+
+		auto scenario = m_pRefConfig->Scenario;
+		if (scenario != SCENARIO::ECHO && scenario != SCENARIO::LOBBY_CHAT && scenario != SCENARIO::ROOM_CHAT) {
+			return;
+		}
+
+		if (curTimeNs < conn.NextSendTimeNs) {
+			return;
+		}
+
+		SendRequest(conn, curTimeNs);
+
+		int64_t intervalNs = (int64_t)(1e9 / m_pRefConfig->RatePerSec);
+		conn.NextSendTimeNs += intervalNs;
+		// 많이 밀렸으면 몰아서 보내지 않고 현재 시간부터 다시 맞춤
+		if (conn.NextSendTimeNs < curTimeNs - 1000LL * 1000 * 1000) {
+			conn.NextSendTimeNs = curTimeNs + intervalNs;
+		}
+	}
+
+	void LoadWorker::SendLogin(Connection& conn)
+	{
+		conn.State = CONNECTION_STATE::LOGIN;
+		conn.RequestTimeNs = NowNs();
+
+		NCommon::PktLogInReq reqPkt;
+		auto id = m_pRefConfig->IDPrefix + std::to_string(conn.Index);
+		strncpy(reqPkt.szID, id.c_str(), NCommon::MAX_USER_ID_SIZE);
+		strncpy(reqPkt.szPW, m_pRefConfig->Password.c_str(), NCommon::MAX_USER_PASSWORD_SIZE);
+		SendPacket(conn, (int16_t)PACKET_ID::LOGIN_IN_REQ, sizeof(reqPkt), (char*)&reqPkt);
+	}
+
+	void LoadWorker::SendLobbyEnter(Connection& conn)
+	{
+		conn.State = CONNECTION_STATE::LOBBY_ENTER;
+
+		NCommon::PktLobbyEnterReq reqPkt;
+		reqPkt.LobbyId = conn.LobbyIndex;
+		SendPacket(conn, (int16_t)PACKET_ID::LOBBY_ENTER_REQ, sizeof(reqPkt), (char*)&reqPkt);
+	}
+
+	void LoadWorker::SendRoomEnter(Connection& conn)
+	{
+		conn.State = CONNECTION_STATE::ROOM_ENTER;
+
+		NCommon::PktRoomEnterReq reqPkt;
+		memset((void*)&reqPkt, 0, sizeof(reqPkt));
+		reqPkt.IsCreate = conn.IsRoomCreator;
+		reqPkt.RoomIndex = NCommon::QUICK_ENTER_ROOM_INDEX;
+		const char16_t title[] = u"load";
+		memcpy(reqPkt.RoomTitle, title, sizeof(title));
+		SendPacket(conn, (int16_t)PACKET_ID::ROOM_ENTER_REQ, sizeof(reqPkt), (char*)&reqPkt);
+	}
+
+	void LoadWorker::SendRequest(Connection& conn, const int64_t curTimeNs)
+	{
+		switch (m_pRefConfig->Scenario)
+		{
+		case SCENARIO::ECHO:
+		{
+			NCommon::PktDevEchoReq reqPkt;
+			int dataSize = std::clamp(m_pRefConfig->EchoDataSize, (int)sizeof(int64_t), NCommon::DEV_ECHO_DATA_MAX_SIZE);
+			reqPkt.DataSize = (short)dataSize;
+			memset(reqPkt.Datas, 'a', dataSize);
+			memcpy(reqPkt.Datas, &curTimeNs, sizeof(curTimeNs));
+			SendPacket(conn, (int16_t)PACKET_ID::DEV_ECHO_REQ, (int16_t)(sizeof(reqPkt.DataSize) + dataSize), (char*)&reqPkt);
+			break;
+		}
+
+		case SCENARIO::LOBBY_CHAT:
+		case SCENARIO::ROOM_CHAT:
+		{
+			// 서버는 모자란 바디를 0 으로 채우므로 메시지 길이 + 널 문자만 보냄
+			const char16_t msg[] = u"load test chat message";
+			int16_t bodySize = (int16_t)sizeof(msg);
+			auto packetId = m_pRefConfig->Scenario == SCENARIO::ROOM_CHAT ? PACKET_ID::ROOM_CHAT_REQ : PACKET_ID::LOBBY_CHAT_REQ;
+			conn.PendingTimeQueue.push_back(curTimeNs);
+			SendPacket(conn, (int16_t)packetId, bodySize, (const char*)msg);
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+
+	void LoadWorker::SendPacket(Connection& conn, const int16_t packetId, const int16_t bodySize, const char* pBody)
+	{
+		int totalSize = NServerNetLib::PACKET_HEADER_SIZE + bodySize;
+		// 서버가 느려서 송신 버퍼가 가득 차면 이번 요청은 보내지 않음 (과부하 상태는 Sent/Response 차이로 드러남)
+		if (conn.SendSize + totalSize > (int)conn.SendBuffer.size()) {
+			return;
+		}
+
+		NServerNetLib::PacketHeader header{ (int16_t)totalSize, packetId, 0 };
+		memcpy(conn.SendBuffer.data() + conn.SendSize, &header, NServerNetLib::PACKET_HEADER_SIZE);
+		if (bodySize > 0) {
+			memcpy(conn.SendBuffer.data() + conn.SendSize + NServerNetLib::PACKET_HEADER_SIZE, pBody, bodySize);
+		}
+		conn.SendSize += totalSize;
+
+		m_pRefCounter->SendPacket.fetch_add(1, std::memory_order_relaxed);
+
+		// 다음 poll 까지 기다리지 않고 바로 보내 봄
+		OnWritable(conn);
+	}
+
+	void LoadWorker::Close(Connection& conn)
+	{
+		if (conn.Fd == INVALID_SOCKET) {
+			return;
+		}
+
+		CLOSE_SOCKET(conn.Fd);
+		conn.Fd = INVALID_SOCKET;
+		conn.State = CONNECTION_STATE::CLOSED;
+		conn.PendingTimeQueue.clear();
+		++m_pRefCounter->Closed;
+	}
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#ifdef _WIN32
+#pragma comment(lib, "ws2_32")
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#else
+#define SOCKET int
+#define SOCKET_ERROR -1
+#define INVALID_SOCKET -1
+#endif
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <chrono>
+
+namespace NLoadTester
+{
+	// 연결마다 반복할 시나리오
+	enum class SCENARIO : int16_t
+	{
+		// 로그인 후 대기 (동시 접속 수 측정)
+		LOGIN = 0,
+		// 로비 입장 후 대기
+		LOBBY = 1,
+		// 룸 입장 후 대기
+		ROOM = 2,
+		// 로비 입장 후 RatePerSec 로 로비 채팅
+		LOBBY_CHAT = 3,
+		// 룸 입장 후 RatePerSec 로 룸 채팅
+		ROOM_CHAT = 4,
+		// 로그인 후 RatePerSec 로 DEV_ECHO_REQ
+		ECHO = 5,
+	};
+
+	struct LoadTestConfig
+	{
+		std::string Host = "127.0.0.1";
+		uint16_t Port = 32452;
+
+		// 서버의 select 한도(FD_SETSIZE - 32, 리눅스 992) 보다 작게
+		int ConnectionCount = 900;
+		int ThreadCount = 4;
+		// 서버 accept 대기열이 넘치지 않도록 초당 새 연결 수를 제한
+		int ConnectPerSec = 500;
+
+		SCENARIO Scenario = SCENARIO::ECHO;
+		// 연결 하나가 초당 보내는 요청 수 (응답을 기다리지 않는 open-loop)
+		double RatePerSec = 1.0;
+		int DurationSec = 10;
+
+		int EchoDataSize = 32;
+
+		// 로비/룸 시나리오에서 연결을 나눌 로비 수와 룸 하나에 넣을 인원
+		int LobbyCount = 2;
+		int RoomUserCount = 4;
+
+		std::string IDPrefix = "load";
+		std::string Password = "1234";
+	};
+
+	// 워커 스레드가 갱신하고 메인 스레드가 매초 읽는 누적 수치
+	struct LoadCounter
+	{
+		std::atomic<uint64_t> ConnectSuccess = 0;
+		std::atomic<uint64_t> ConnectFail = 0;
+		std::atomic<uint64_t> LoginSuccess = 0;
+		std::atomic<uint64_t> LoginFail = 0;
+		std::atomic<uint64_t> Ready = 0;
+		std::atomic<uint64_t> Closed = 0;
+
+		std::atomic<uint64_t> SendPacket = 0;
+		std::atomic<uint64_t> SendBytes = 0;
+		std::atomic<uint64_t> RecvPacket = 0;
+		std::atomic<uint64_t> RecvBytes = 0;
+		// 보낸 요청에 대한 응답 (지연 시간 측정 대상)
+		std::atomic<uint64_t> Response = 0;
+		std::atomic<uint64_t> ErrorResponse = 0;
+	};
+
+	class LoadWorker
+	{
+		enum class CONNECTION_STATE : int16_t
+		{
+			NONE = 0,
+			CONNECTING = 1,
+			LOGIN = 2,
+			LOBBY_ENTER = 3,
+			ROOM_ENTER = 4,
+			RUNNING = 5,
+			CLOSED = 6,
+		};
+
+		struct Connection
+		{
+			int Index = 0;
+			SOCKET Fd = INVALID_SOCKET;
+			CONNECTION_STATE State = CONNECTION_STATE::NONE;
+
+			std::vector<char> RecvBuffer;
+			int RecvSize = 0;
+			std::vector<char> SendBuffer;
+			int SendSize = 0;
+
+			short LobbyIndex = 0;
+			bool IsRoomCreator = false;
+
+			// 로그인/입장 요청 시간 또는 재시도 시간
+			int64_t RequestTimeNs = 0;
+			int64_t RetryTimeNs = 0;
+			int64_t NextSendTimeNs = 0;
+
+			// 응답이 순서대로 오는 채팅 요청의 송신 시간
+			std::deque<int64_t> PendingTimeQueue;
+		};
+
+	public:
+		void Init(const LoadTestConfig* pConfig, const int firstIndex, const int connectionCount, LoadCounter* pCounter);
+
+		void Run(const std::atomic<bool>& isRun, const int64_t endTimeNs);
+
+		const std::vector<int64_t>& GetLoginLatencyList() const { return m_LoginLatencyList; }
+		const std::vector<int64_t>& GetRequestLatencyList() const { return m_RequestLatencyList; }
+
+		static int64_t NowNs();
+
+	private:
+		void StartConnect(Connection& conn);
+		void OnConnected(Connection& conn);
+		void OnWritable(Connection& conn);
+		void OnReadable(Connection& conn);
+		void ProcessPacket(Connection& conn, const int16_t packetId, const char* pBody, const int16_t bodySize);
+		void OnReady(Connection& conn);
+		void OnTimer(Connection& conn, const int64_t curTimeNs);
+
+		void SendLogin(Connection& conn);
+		void SendLobbyEnter(Connection& conn);
+		void SendRoomEnter(Connection& conn);
+		void SendRequest(Connection& conn, const int64_t curTimeNs);
+
+		void SendPacket(Connection& conn, const int16_t packetId, const int16_t bodySize, const char* pBody);
+		void Close(Connection& conn);
+
+	private:
+		const LoadTestConfig* m_pRefConfig = nullptr;
+		LoadCounter* m_pRefCounter = nullptr;
+
+		std::vector<Connection> m_ConnectionList;
+
+		std::vector<int64_t> m_LoginLatencyList;
+		std::vector<int64_t> m_RequestLatencyList;
+	};
+}
@@ -0,0 +1,209 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <algorithm>
+
+#include "load_tester.h"
+
+namespace
+{
+	std::atomic<bool> g_IsRun = true;
+
+	void OnStopSignal(int)
+	{
+		g_IsRun = false;
+	}
+
+	void PrintUsage()
+	{
+		printf("사용법: LoadTester [옵션]\n"
+			"  --host <ip>            서버 주소 (127.0.0.1)\n"
+			"  --port <port>          서버 포트 (32452)\n"
+			"  --connections <n>      연결 수 (900)\n"
+			"  --threads <n>          워커 스레드 수 (4)\n"
+			"  --connect-rate <n>     초당 새 연결 수 (500)\n"
+			"  --scenario <name>      login | lobby | room | lobby_chat | room_chat | echo (echo)\n"
+			"  --rate <r>             연결 하나의 초당 요청 수 (1)\n"
+			"  --duration <sec>       실행 시간 (10)\n"
+			"  --echo-size <bytes>    DEV_ECHO_REQ 데이터 크기 (32)\n"
+			"  --lobby-count <n>      연결을 나눌 로비 수 (2)\n"
+			"  --room-users <n>       룸 하나에 넣을 인원 (4)\n"
+			"  --id-prefix <text>     로그인 ID 앞부분 (load)\n"
+			"  --password <text>      로그인 비밀번호 (1234)\n"
+			"서버는 select 로 소켓을 처리하므로 동시 세션은 FD_SETSIZE - 32 (리눅스 992) 까지이고 그 이상은 접속 직후 끊김\n"
+			"  (리슨/로그 소켓 몫을 빼고 기본값을 그 아래로 둠. 더 많이 붙이려면 서버를 FD_SETSIZE 를 키워 빌드)\n"
+			"채팅 시나리오는 서버의 ChatTokenPerSec/ChatTokenBurst 보다 rate 가 높으면 요청이 버려지므로 설정을 함께 올려야 함\n");
+	}
+
+	bool ParseScenario(const char* pszName, NLoadTester::SCENARIO& scenario)
+	{
+		using NLoadTester::SCENARIO;
+		struct { const char* pszName; SCENARIO Scenario; } nameList[] = {
+			{ "login", SCENARIO::LOGIN }, { "lobby", SCENARIO::LOBBY }, { "room", SCENARIO::ROOM },
+			{ "lobby_chat", SCENARIO::LOBBY_CHAT }, { "room_chat", SCENARIO::ROOM_CHAT }, { "echo", SCENARIO::ECHO },
+		};
+
+		for (auto& item : nameList) {
+			if (strcmp(item.pszName, pszName) == 0) {
+				scenario = item.Scenario;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool ParseArgs(int argc, char* argv[], NLoadTester::LoadTestConfig& config)
+	{
+		for (int i = 1; i < argc; ++i) {
+			std::string key = argv[i];
+			if (key == "--help" || key == "-h") {
+				return false;
+			}
+
+			if (i + 1 >= argc) {
+				printf("'%s' 의 값이 없음\n", key.c_str());
+				return false;
+			}
+
+			const char* pszValue = argv[++i];
+			if (key == "--host") config.Host = pszValue;
+			else if (key == "--port") config.Port = (uint16_t)atoi(pszValue);
+			else if (key == "--connections") config.ConnectionCount = atoi(pszValue);
+			else if (key == "--threads") config.ThreadCount = atoi(pszValue);
+			else if (key == "--connect-rate") config.ConnectPerSec = atoi(pszValue);
+			else if (key == "--rate") config.RatePerSec = atof(pszValue);
+			else if (key == "--duration") config.DurationSec = atoi(pszValue);
+			else if (key == "--echo-size") config.EchoDataSize = atoi(pszValue);
+			else if (key == "--lobby-count") config.LobbyCount = atoi(pszValue);
+			else if (key == "--room-users") config.RoomUserCount = atoi(pszValue);
+			else if (key == "--id-prefix") config.IDPrefix = pszValue;
+			else if (key == "--password") config.Password = pszValue;
+			else if (key == "--scenario") {
+				if (ParseScenario(pszValue, config.Scenario) == false) {
+					printf("알 수 없는 시나리오 '%s'\n", pszValue);
+					return false;
+				}
+			}
+			else {
+				printf("알 수 없는 옵션 '%s'\n", key.c_str());
+				return false;
+			}
+		}
+
+		config.ConnectionCount = std::max(1, config.ConnectionCount);
+		config.ThreadCount = std::clamp(config.ThreadCount, 1, config.ConnectionCount);
+		return true;
+	}
+
+	void PrintLatency(const char* pszName, std::vector<int64_t>& latencyList)
+	{
+		if (latencyList.empty()) {
+			printf("%-8s 응답 없음\n", pszName);
+			return;
+		}
+
+		std::sort(latencyList.begin(), latencyList.end());
+		auto percentile = [&](const double p) {
+			size_t pos = (size_t)(p * (double)latencyList.size());
+			pos = std::min(pos, latencyList.size() - 1);
+			return (double)latencyList[pos] / 1000.0;
+		};
+
+		printf("%-8s count=%zu  p50=%.1fus  p99=%.1fus  p999=%.1fus  max=%.1fus\n", pszName, latencyList.size(),
+			percentile(0.50), percentile(0.99), percentile(0.999), (double)latencyList.back() / 1000.0);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	NLoadTester::LoadTestConfig config;
+	if (ParseArgs(argc, argv, config) == false) {
+		PrintUsage();
+		return 1;
+	}
+
+#ifdef _WIN32
+	WSADATA wsaData;
+	WSAStartup(MAKEWORD(2, 2), &wsaData);
+#else
+	// 서버가 먼저 끊은 소켓에 send 해도 종료되지 않도록
+	std::signal(SIGPIPE, SIG_IGN);
+#endif
+	std::signal(SIGINT, OnStopSignal);
+	std::signal(SIGTERM, OnStopSignal);
+
+	NLoadTester::LoadCounter counter;
+	std::vector<NLoadTester::LoadWorker> workerList(config.ThreadCount);
+
+	// 연결을 스레드 수로 나눠서 앞 스레드부터 하나씩 더 배정
+	int firstIndex = 0;
+	for (int i = 0; i < config.ThreadCount; ++i) {
+		int count = config.ConnectionCount / config.ThreadCount + (i < config.ConnectionCount % config.ThreadCount ? 1 : 0);
+		workerList[i].Init(&config, firstIndex, count, &counter);
+		firstIndex += count;
+	}
+
+	auto startTimeNs = NLoadTester::LoadWorker::NowNs();
+	auto endTimeNs = startTimeNs + (int64_t)config.DurationSec * 1000 * 1000 * 1000;
+
+	std::vector<std::thread> threadList;
+	for (auto& worker : workerList) {
+		threadList.emplace_back([&worker, endTimeNs]() { worker.Run(g_IsRun, endTimeNs); });
+	}
+
+	// 1초마다 구간 처리량 출력
+	uint64_t prevSend = 0, prevRecv = 0, prevResponse = 0, prevRecvBytes = 0;
+	for (int sec = 1; g_IsRun && NLoadTester::LoadWorker::NowNs() < endTimeNs; ++sec) {
+		std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(startTimeNs + (int64_t)sec * 1000 * 1000 * 1000)));
+
+		uint64_t send = counter.SendPacket, recv = counter.RecvPacket, response = counter.Response, recvBytes = counter.RecvBytes;
+		printf("[%3ds] 연결=%llu 준비=%llu 끊김=%llu | 송신 %llu/s 수신 %llu/s 응답 %llu/s 수신량 %.2fMB/s\n", sec,
+			(unsigned long long)counter.ConnectSuccess.load(), (unsigned long long)counter.Ready.load(), (unsigned long long)counter.Closed.load(),
+			(unsigned long long)(send - prevSend), (unsigned long long)(recv - prevRecv), (unsigned long long)(response - prevResponse),
+			(double)(recvBytes - prevRecvBytes) / (1024.0 * 1024.0));
+		fflush(stdout);
+
+		prevSend = send;
+		prevRecv = recv;
+		prevResponse = response;
+		prevRecvBytes = recvBytes;
+	}
+
+	g_IsRun = false;
+	for (auto& thread : threadList) {
+		thread.join();
+	}
+
+	double elapsedSec = (double)(NLoadTester::LoadWorker::NowNs() - startTimeNs) / 1e9;
+
+	std::vector<int64_t> loginLatencyList;
+	std::vector<int64_t> requestLatencyList;
+	for (auto& worker : workerList) {
+		auto& loginList = worker.GetLoginLatencyList();
+		auto& requestList = worker.GetRequestLatencyList();
+		loginLatencyList.insert(loginLatencyList.end(), loginList.begin(), loginList.end());
+		requestLatencyList.insert(requestLatencyList.end(), requestList.begin(), requestList.end());
+	}
+
+	printf("\n==== 결과 (%.1f 초) ====\n", elapsedSec);
+	printf("연결 성공=%llu 실패=%llu  로그인 성공=%llu 실패=%llu  에러 응답=%llu\n",
+		(unsigned long long)counter.ConnectSuccess.load(), (unsigned long long)counter.ConnectFail.load(),
+		(unsigned long long)counter.LoginSuccess.load(), (unsigned long long)counter.LoginFail.load(),
+		(unsigned long long)counter.ErrorResponse.load());
+	printf("송신 %.0f pkt/s (%.2f MB/s)  수신 %.0f pkt/s (%.2f MB/s)  응답 %.0f /s\n",
+		(double)counter.SendPacket / elapsedSec, (double)counter.SendBytes / elapsedSec / (1024.0 * 1024.0),
+		(double)counter.RecvPacket / elapsedSec, (double)counter.RecvBytes / elapsedSec / (1024.0 * 1024.0),
+		(double)counter.Response / elapsedSec);
+	PrintLatency("login", loginLatencyList);
+	PrintLatency("request", requestLatencyList);
+
+#ifdef _WIN32
+	WSACleanup();
+#endif
+	return 0;
+}
@@ -1,10 +0,0 @@
-﻿
-#include <iostream>
-
-int main()
-{
-
-
-
-    std::cout << "Hello World!\n";
-}
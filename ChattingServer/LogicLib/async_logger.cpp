@@ -0,0 +1,244 @@
+#include <cstring>
+#include <chrono>
+#include <ctime>
+
+#include "../ServerNetLib/thread_affinity.h"
+#include "async_logger.h"
+
+namespace NLogicLib
+{
+	namespace
+	{
+		int RoundUpPowerOfTwo(const int value)
+		{
+			int result = 1;
+			while (result < value) {
+				result <<= 1;
+			}
+			return result;
+		}
+
+		const char* GetLevelText(const LOG_LEVEL level)
+		{
+			switch (level)
+			{
+			case LOG_LEVEL::kL_TRACE: return "[추적]";
+			case LOG_LEVEL::kL_DEBUG: return "[디버깅]";
+			case LOG_LEVEL::kL_WARN: return "[경고]";
+			case LOG_LEVEL::kL_ERROR: return "[오류]";
+			case LOG_LEVEL::kL_INFO: return "[정보]";
+			default: return "[?]";
+			}
+		}
+
+		int64_t NowMicroSec()
+		{
+			return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		}
+
+		std::atomic<uint64_t> g_LastLoggerId = 0;
+
+		// 스레드가 마지막으로 로그를 남긴 로거와 그 링 (스레드가 끝나면 링을 놓음)
+		struct LocalRingCache
+		{
+			~LocalRingCache()
+			{
+				if (pRing != nullptr) {
+					pRing->Release();
+				}
+			}
+
+			uint64_t LoggerId = 0;
+			std::shared_ptr<LogRing> pRing;
+		};
+	}
+
+	LogRing::LogRing(const int ringSize, const int threadNumber)
+	{
+		int size = RoundUpPowerOfTwo(ringSize > 0 ? ringSize : 1);
+		m_RecordList.resize(size);
+		m_Mask = (uint64_t)size - 1;
+		m_ThreadNumber = threadNumber;
+	}
+
+	bool LogRing::TryPush(const LOG_LEVEL level, const int64_t timeMicroSec, const char* pText)
+	{
+		auto writePos = m_WritePos.load(std::memory_order_relaxed);
+		auto readPos = m_ReadPos.load(std::memory_order_acquire);
+		if (writePos - readPos >= m_RecordList.size()) {
+			return false;
+		}
+
+		auto& record = m_RecordList[writePos & m_Mask];
+		record.TimeMicroSec = timeMicroSec;
+		record.Level = level;
+
+		auto length = strnlen(pText, NServerNetLib::MAX_LOG_STRING_LENGTH - 1);
+		memcpy(record.Text, pText, length);
+		record.Text[length] = '\0';
+		record.Length = (int16_t)length;
+
+		m_WritePos.store(writePos + 1, std::memory_order_release);
+		return true;
+	}
+
+	AsyncLog::AsyncLog(const char* pszFileName, const int ringSize, const LOG_FULL_POLICY fullPolicy, const int32_t writerCpu)
+	{
+		m_RingSize = ringSize;
+		m_FullPolicy = fullPolicy;
+		m_WriterCpu = writerCpu;
+		m_LoggerId = ++g_LastLoggerId;
+
+		if (pszFileName != nullptr && pszFileName[0] != '\0') {
+			m_pOutFile = fopen(pszFileName, "ab");
+			m_IsOwnFile = m_pOutFile != nullptr;
+		}
+		else {
+			m_pOutFile = stdout;
+		}
+
+		m_IsRun = true;
+		m_WriterThread = std::thread([this]() { WriterThreadFunc(); });
+	}
+
+	AsyncLog::~AsyncLog()
+	{
+		m_IsRun = false;
+		if (m_WriterThread.joinable()) {
+			m_WriterThread.join();
+		}
+
+		if (m_IsOwnFile) {
+			fclose(m_pOutFile);
+		}
+	}
+
+	LogRing* AsyncLog::GetLocalRing()
+	{
+		// 로거 객체가 바뀌면(재생성) 이전 링을 놓고 새 로거에 다시 등록
+		thread_local LocalRingCache cache;
+		if (cache.LoggerId == m_LoggerId) {
+			return cache.pRing.get();
+		}
+
+		if (cache.pRing != nullptr) {
+			cache.pRing->Release();
+		}
+
+		std::lock_guard<std::mutex> guard(m_RingListLock);
+		cache.LoggerId = m_LoggerId;
+		cache.pRing = nullptr;
+
+		// 끝난 스레드가 놓은 링이 있으면 이어서 씀 (스레드를 다시 만들어도 링이 늘지 않음)
+		for (auto& pRing : m_RingList) {
+			if (pRing->TryClaim()) {
+				cache.pRing = pRing;
+				return cache.pRing.get();
+			}
+		}
+
+		m_RingList.push_back(std::make_shared<LogRing>(m_RingSize, (int)m_RingList.size()));
+		cache.pRing = m_RingList.back();
+		return cache.pRing.get();
+	}
+
+	void AsyncLog::Push(const LOG_LEVEL level, const char* pText)
+	{
+		if (m_pOutFile == nullptr) {
+			return;
+		}
+
+		auto pRing = GetLocalRing();
+		auto timeMicroSec = NowMicroSec();
+
+		while (pRing->TryPush(level, timeMicroSec, pText) == false) {
+			if (m_FullPolicy == LOG_FULL_POLICY::kDROP) {
+				m_DropCount.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			std::this_thread::yield();
+		}
+	}
+
+	void AsyncLog::WriterThreadFunc()
+	{
+		// 고정에 실패해도 기록은 계속
+		if (NServerNetLib::ThreadAffinity::PinCurrentThread(m_WriterCpu) == false) {
+			WriteLog(LOG_LEVEL::kL_WARN, "%s | 로그 기록 스레드를 CPU(%d)에 고정하지 못함", __FUNCTION__, m_WriterCpu);
+		}
+
+		std::string batch;
+		batch.reserve(64 * 1024);
+
+		while (m_IsRun) {
+			if (WriteBatch(batch) == false) {
+				// 쓸 것이 없으면 잠깐 쉼 (producer 는 lock-free 라 깨워주지 않음)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+
+		// 종료 전에 남은 로그를 모두 씀
+		while (WriteBatch(batch)) {
+		}
+	}
+
+	bool AsyncLog::WriteBatch(std::string& batch)
+	{
+		batch.clear();
+
+		{
+			std::lock_guard<std::mutex> guard(m_RingListLock);
+			if (m_WriterRingList.size() != m_RingList.size()) {
+				m_WriterRingList.clear();
+				for (auto& pRing : m_RingList) {
+					m_WriterRingList.push_back(pRing.get());
+				}
+			}
+		}
+
+		for (auto pRing : m_WriterRingList) {
+			int threadNumber = pRing->GetThreadNumber();
+			pRing->PopAll([&](const LogRecord& record) {
+				AppendRecord(batch, threadNumber, record);
+			});
+		}
+
+		auto dropCount = m_DropCount.load(std::memory_order_relaxed);
+		if (dropCount != m_ReportedDropCount) {
+			char szText[128];
+			snprintf(szText, sizeof(szText), "[경고] | 로그 링이 가득 차서 %llu 개를 버림\n", (unsigned long long)(dropCount - m_ReportedDropCount));
+			batch += szText;
+			m_ReportedDropCount = dropCount;
+		}
+
+		if (batch.empty()) {
+			return false;
+		}
+
+		fwrite(batch.data(), 1, batch.size(), m_pOutFile);
+		fflush(m_pOutFile);
+		return true;
+	}
+
+	void AsyncLog::AppendRecord(std::string& batch, const int threadNumber, const LogRecord& record)
+	{
+		time_t seconds = (time_t)(record.TimeMicroSec / 1000000);
+		int milliSec = (int)((record.TimeMicroSec / 1000) % 1000);
+
+		tm localTime;
+#ifdef _WIN32
+		localtime_s(&localTime, &seconds);
+#else
+		localtime_r(&seconds, &localTime);
+#endif
+
+		char szPrefix[64];
+		int prefixLength = snprintf(szPrefix, sizeof(szPrefix), "%02d:%02d:%02d.%03d T%d %s | ",
+			localTime.tm_hour, localTime.tm_min, localTime.tm_sec, milliSec, threadNumber, GetLevelText(record.Level));
+
+		batch.append(szPrefix, prefixLength);
+		batch.append(record.Text, record.Length);
+		batch += '\n';
+	}
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdio>
+
+#include "../ServerNetLib/interface_log.h"
+
+namespace NLogicLib
+{
+	using LOG_LEVEL = NServerNetLib::LOG_LEVEL;
+
+	// 링이 가득 찼을 때 로그를 남기는 스레드의 동작
+	enum class LOG_FULL_POLICY : int16_t
+	{
+		// 버리고 버린 수만 셈 (호출 스레드가 절대 기다리지 않음)
+		kDROP = 0,
+		// 자리가 날 때까지 yield 하며 기다림 (로그는 잃지 않음)
+		kBLOCK = 1,
+	};
+
+	struct LogRecord
+	{
+		int64_t TimeMicroSec = 0;
+		LOG_LEVEL Level = LOG_LEVEL::kL_INFO;
+		int16_t Length = 0;
+		char Text[NServerNetLib::MAX_LOG_STRING_LENGTH];
+	};
+
+	// 로그를 남기는 스레드 하나(producer)와 기록 스레드 하나(consumer)만 쓰는 lock-free 링
+	class LogRing
+	{
+	public:
+		LogRing(const int ringSize, const int threadNumber);
+
+		bool TryPush(const LOG_LEVEL level, const int64_t timeMicroSec, const char* pText);
+
+		// 쌓인 레코드를 모두 func 로 넘기고 꺼낸 수를 돌려줌
+		template<class Func>
+		int PopAll(Func&& func)
+		{
+			auto readPos = m_ReadPos.load(std::memory_order_relaxed);
+			auto writePos = m_WritePos.load(std::memory_order_acquire);
+
+			int count = 0;
+			for (; readPos < writePos; ++readPos, ++count) {
+				func(m_RecordList[readPos & m_Mask]);
+			}
+
+			m_ReadPos.store(readPos, std::memory_order_release);
+			return count;
+		}
+
+		int GetThreadNumber() const { return m_ThreadNumber; }
+
+		// 링을 쓰던 스레드가 끝나면 호출. 다음에 등록하는 스레드가 이어서 씀
+		void Release() { m_IsReleased.store(true, std::memory_order_release); }
+
+		// 놓인 링이면 가져오고 true
+		bool TryClaim() { return m_IsReleased.exchange(false, std::memory_order_acquire); }
+
+	private:
+		std::vector<LogRecord> m_RecordList;
+		uint64_t m_Mask = 0;
+		int m_ThreadNumber = 0;
+
+		// producer 와 consumer 가 서로의 캐시 라인을 건드리지 않도록 떨어뜨림
+		alignas(64) std::atomic<uint64_t> m_WritePos = 0;
+		alignas(64) std::atomic<uint64_t> m_ReadPos = 0;
+
+		std::atomic<bool> m_IsReleased = false;
+	};
+
+	// 로그 문자열을 스레드별 링에 넣기만 하고, 시간/레벨 붙이기와 출력은 기록 스레드가 모아서 처리
+	// (ConsoleLog 처럼 매 줄 mutex + std::endl 로 flush 하지 않음)
+	class AsyncLog : public NServerNetLib::ILog
+	{
+	public:
+		// pszFileName 이 비어 있으면 콘솔(stdout)에 씀. writerCpu 가 0 이상이면 기록 스레드를 그 CPU 에 고정
+		// (스레드별 링은 처음 로그를 남기는 스레드가 만들므로 그 스레드의 노드에 잡힘)
+		AsyncLog(const char* pszFileName, const int ringSize, const LOG_FULL_POLICY fullPolicy, const int32_t writerCpu = -1);
+		virtual ~AsyncLog();
+
+		bool IsOpened() const { return m_pOutFile != nullptr; }
+
+		uint64_t GetDropCount() const { return m_DropCount.load(std::memory_order_relaxed); }
+
+	protected:
+		void Error(const char* pText) override { Push(LOG_LEVEL::kL_ERROR, pText); }
+		void Warn(const char* pText) override { Push(LOG_LEVEL::kL_WARN, pText); }
+		void Debug(const char* pText) override { Push(LOG_LEVEL::kL_DEBUG, pText); }
+		void Trace(const char* pText) override { Push(LOG_LEVEL::kL_TRACE, pText); }
+		void Info(const char* pText) override { Push(LOG_LEVEL::kL_INFO, pText); }
+
+	private:
+		void Push(const LOG_LEVEL level, const char* pText);
+
+		// 호출한 스레드 전용 링 (처음 호출할 때 등록, 스레드가 끝나면 놓아서 다음 스레드가 다시 씀)
+		LogRing* GetLocalRing();
+
+		void WriterThreadFunc();
+
+		// 모든 링을 한 번 비우고 모은 내용을 한 번에 씀 (쓴 것이 있으면 true)
+		bool WriteBatch(std::string& batch);
+
+		static void AppendRecord(std::string& batch, const int threadNumber, const LogRecord& record);
+
+	private:
+		FILE* m_pOutFile = nullptr;
+		bool m_IsOwnFile = false;
+
+		int m_RingSize = 0;
+		LOG_FULL_POLICY m_FullPolicy = LOG_FULL_POLICY::kDROP;
+		int32_t m_WriterCpu = -1;
+
+		// 스레드별 링 캐시가 로거를 구분하는 번호 (같은 주소에 새 로거가 만들어져도 다름)
+		uint64_t m_LoggerId = 0;
+
+		std::mutex m_RingListLock;
+		// 스레드가 끝날 때 놓는 링은 로거보다 늦게 풀릴 수 있으므로 함께 소유
+		std::vector<std::shared_ptr<LogRing>> m_RingList;
+		std::vector<LogRing*> m_WriterRingList;
+
+		std::atomic<uint64_t> m_DropCount = 0;
+		uint64_t m_ReportedDropCount = 0;
+
+		std::atomic<bool> m_IsRun = false;
+		std::thread m_WriterThread;
+	};
+}
@@ -0,0 +1,527 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CHAT_FILTER_SSE2
+#endif
+
+#include "utf_codec.h"
+#include "chat_filter.h"
+
+namespace NLogicLib
+{
+	using LOG_LEVEL = NServerNetLib::LOG_LEVEL;
+
+	namespace
+	{
+		// 채팅 메시지보다 긴 단어는 찾을 일이 없음
+		constexpr int32_t MAX_WORD_LENGTH = 256;
+		// 간선이 이보다 적으면 처음부터 훑고, 많으면 이진 탐색 (루트는 비트맵 순위로 바로 찾음)
+		constexpr uint16_t LINEAR_EDGE_SEARCH_COUNT = 8;
+		// SIMD 로 건너뛸 때 비교하는 첫 유닛 범위 수
+		constexpr int32_t MAX_FIRST_UNIT_RANGE = 4;
+		constexpr int32_t UNIT_BIT_WORD_COUNT = 65536 / 64;
+	}
+
+	struct ChatFilterNode
+	{
+		int32_t EdgeBegin = 0;
+		int32_t Fail = 0;
+		uint16_t EdgeCount = 0;
+		// 이 상태에서 끝나는 가장 긴 단어 길이 (실패 링크를 따라가서 끝나는 단어 포함, 없으면 0)
+		uint16_t MatchLength = 0;
+	};
+
+	struct ChatFilterAutomaton
+	{
+		int32_t WordCount = 0;
+
+		// 0 번이 루트. 노드의 간선은 [EdgeBegin, EdgeBegin + EdgeCount) 에 유닛 순서로 정렬
+		std::vector<ChatFilterNode> NodeList;
+		std::vector<char16_t> EdgeUnitList;
+		std::vector<int32_t> EdgeTargetList;
+
+		// 단어 첫 유닛(소문자로 바꾼 것)의 비트맵과 워드마다 그 앞까지 켜진 비트 수
+		// 루트의 간선은 유닛 순서로 정렬돼 있으므로 켜진 비트의 순위가 곧 루트 간선 번호 (루트만 이진 탐색 없이 바로 찾음)
+		std::vector<uint64_t> FirstUnitBitList;
+		std::vector<uint16_t> FirstUnitRankList;
+		// 두 유닛 이상인 단어의 앞 두 유닛을 해시한 비트맵과 한 유닛짜리 단어의 비트맵
+		// 둘 다 꺼져 있으면 그 위치에서 시작하는 단어가 없으므로 첫 유닛이 맞아도 건너뜀 (해시가 겹치면 들러 볼 뿐 놓치지는 않음)
+		std::vector<uint64_t> FirstPairBitList;
+		std::vector<uint64_t> SingleUnitBitList;
+
+		// 첫 유닛(대문자 포함)을 모두 덮는 범위. 이 범위 밖의 유닛은 8 개씩 한 번에 건너뜀
+		int32_t RangeCount = 0;
+		char16_t RangeLowList[MAX_FIRST_UNIT_RANGE] = { 0, };
+		char16_t RangeSpanList[MAX_FIRST_UNIT_RANGE] = { 0, };
+	};
+
+	namespace
+	{
+		char16_t FoldUnit(const char16_t unit)
+		{
+			return (unit >= u'A' && unit <= u'Z') ? (char16_t)(unit + (u'a' - u'A')) : unit;
+		}
+
+		int32_t FindRootEdge(const ChatFilterAutomaton& automaton, const char16_t unit)
+		{
+			const auto word = automaton.FirstUnitBitList[unit >> 6];
+			const auto bit = 1ULL << (unit & 63);
+			if ((word & bit) == 0) {
+				return -1;
+			}
+			return automaton.EdgeTargetList[automaton.FirstUnitRankList[unit >> 6] + std::popcount(word & (bit - 1))];
+		}
+
+		int32_t FindEdge(const ChatFilterAutomaton& automaton, const int32_t nodeIndex, const char16_t unit)
+		{
+			if (nodeIndex == 0) {
+				return FindRootEdge(automaton, unit);
+			}
+
+			const auto& node = automaton.NodeList[nodeIndex];
+			const auto pUnitList = automaton.EdgeUnitList.data() + node.EdgeBegin;
+
+			if (node.EdgeCount <= LINEAR_EDGE_SEARCH_COUNT) {
+				for (uint16_t i = 0; i < node.EdgeCount; ++i) {
+					if (pUnitList[i] == unit) {
+						return automaton.EdgeTargetList[node.EdgeBegin + i];
+					}
+				}
+				return -1;
+			}
+
+			auto pFound = std::lower_bound(pUnitList, pUnitList + node.EdgeCount, unit);
+			if (pFound == pUnitList + node.EdgeCount || *pFound != unit) {
+				return -1;
+			}
+			return automaton.EdgeTargetList[node.EdgeBegin + (pFound - pUnitList)];
+		}
+
+		bool TestBit(const std::vector<uint64_t>& bitList, const uint32_t index)
+		{
+			return ((bitList[index >> 6] >> (index & 63)) & 1) != 0;
+		}
+
+		void SetBit(std::vector<uint64_t>& bitList, const uint32_t index)
+		{
+			bitList[index >> 6] |= 1ULL << (index & 63);
+		}
+
+		uint32_t HashPair(const char16_t first, const char16_t second)
+		{
+			return ((((uint32_t)first << 16) | second) * 0x9E3779B1u) >> 16;
+		}
+
+		// 8 유닛 중 단어가 시작할 수 있는 위치를 비트로 모음 (유닛마다 분기하지 않음). pText[8] 까지 읽음
+		uint32_t GetCandidateMask(const ChatFilterAutomaton& automaton, const char16_t* pText)
+		{
+			uint32_t mask = 0;
+			auto unit = FoldUnit(pText[0]);
+			for (int32_t i = 0; i < 8; ++i) {
+				const auto nextUnit = FoldUnit(pText[i + 1]);
+				const auto pairHash = HashPair(unit, nextUnit);
+				const auto isCandidate = (automaton.FirstUnitBitList[unit >> 6] >> (unit & 63))
+					& ((automaton.FirstPairBitList[pairHash >> 6] >> (pairHash & 63)) | (automaton.SingleUnitBitList[unit >> 6] >> (unit & 63)));
+				mask |= (uint32_t)(isCandidate & 1) << i;
+				unit = nextUnit;
+			}
+			return mask;
+		}
+
+		bool IsCandidate(const ChatFilterAutomaton& automaton, const char16_t* pText, const int32_t index, const int32_t length)
+		{
+			const auto unit = FoldUnit(pText[index]);
+			if (TestBit(automaton.FirstUnitBitList, unit) == false) {
+				return false;
+			}
+
+			// 마지막 유닛은 뒤를 볼 수 없으므로 오토마톤에 맡김
+			return index + 1 >= length || TestBit(automaton.SingleUnitBitList, unit)
+				|| TestBit(automaton.FirstPairBitList, HashPair(unit, FoldUnit(pText[index + 1])));
+		}
+
+		// 단어가 시작할 수 있는 위치까지 건너뜀 (없으면 length)
+		int32_t SkipToCandidate(const ChatFilterAutomaton& automaton, const char16_t* pText, int32_t index, const int32_t length)
+		{
+#ifdef CHAT_FILTER_SSE2
+			// SSE2 에는 임의의 유닛 집합을 찾아보는 명령이 없으므로 첫 유닛을 덮는 몇 개의 범위와 먼저 비교해서
+			// 8 유닛이 모두 범위 밖이면 비트맵을 보지 않고 넘김 (부호 없는 비교는 0x8000 을 뒤집어서 부호 있는 비교로)
+			const auto signBit = _mm_set1_epi16((short)0x8000);
+			__m128i lowList[MAX_FIRST_UNIT_RANGE];
+			__m128i spanList[MAX_FIRST_UNIT_RANGE];
+			for (int32_t r = 0; r < automaton.RangeCount; ++r) {
+				lowList[r] = _mm_set1_epi16((short)automaton.RangeLowList[r]);
+				spanList[r] = _mm_set1_epi16((short)(automaton.RangeSpanList[r] ^ 0x8000));
+			}
+#endif
+
+			while (index + 9 <= length) {
+#ifdef CHAT_FILTER_SSE2
+				const auto units = _mm_loadu_si128((const __m128i*)(pText + index));
+				auto outside = _mm_set1_epi16(-1);
+				for (int32_t r = 0; r < automaton.RangeCount; ++r) {
+					const auto offset = _mm_xor_si128(_mm_sub_epi16(units, lowList[r]), signBit);
+					outside = _mm_and_si128(outside, _mm_cmpgt_epi16(offset, spanList[r]));
+				}
+
+				if (_mm_movemask_epi8(outside) == 0xFFFF) {
+					index += 8;
+					continue;
+				}
+#endif
+				const auto mask = GetCandidateMask(automaton, pText + index);
+				if (mask != 0) {
+					return index + std::countr_zero(mask);
+				}
+				index += 8;
+			}
+
+			while (index < length && IsCandidate(automaton, pText, index, length) == false) {
+				++index;
+			}
+			return index;
+		}
+
+		// 정렬된 첫 유닛 목록을 가장 넓은 틈 (MAX_FIRST_UNIT_RANGE - 1) 개에서 끊어 범위로 만듦
+		void BuildFirstUnitRange(ChatFilterAutomaton& automaton, std::vector<char16_t>& unitList)
+		{
+			std::sort(unitList.begin(), unitList.end());
+			unitList.erase(std::unique(unitList.begin(), unitList.end()), unitList.end());
+			if (unitList.empty()) {
+				return;
+			}
+
+			std::vector<int32_t> gapIndexList;
+			for (int32_t i = 1; i < (int32_t)unitList.size(); ++i) {
+				if (unitList[i] - unitList[i - 1] > 1) {
+					gapIndexList.push_back(i);
+				}
+			}
+
+			if ((int32_t)gapIndexList.size() > MAX_FIRST_UNIT_RANGE - 1) {
+				std::partial_sort(gapIndexList.begin(), gapIndexList.begin() + (MAX_FIRST_UNIT_RANGE - 1), gapIndexList.end(),
+					[&unitList](const int32_t lhs, const int32_t rhs) {
+						return unitList[lhs] - unitList[lhs - 1] > unitList[rhs] - unitList[rhs - 1];
+					});
+				gapIndexList.resize(MAX_FIRST_UNIT_RANGE - 1);
+				std::sort(gapIndexList.begin(), gapIndexList.end());
+			}
+
+			int32_t begin = 0;
+			gapIndexList.push_back((int32_t)unitList.size());
+			for (auto end : gapIndexList) {
+				automaton.RangeLowList[automaton.RangeCount] = unitList[begin];
+				automaton.RangeSpanList[automaton.RangeCount] = (char16_t)(unitList[end - 1] - unitList[begin]);
+				++automaton.RangeCount;
+				begin = end;
+			}
+		}
+
+		std::shared_ptr<const ChatFilterAutomaton> BuildAutomaton(const std::vector<std::u16string>& wordList)
+		{
+			// 만드는 동안만 쓰는 트라이 (자식은 유닛 순서로 정렬)
+			struct TrieNode
+			{
+				std::vector<std::pair<char16_t, int32_t>> ChildList;
+				uint16_t WordLength = 0;
+			};
+
+			std::vector<TrieNode> trieList(1);
+			for (auto& word : wordList) {
+				int32_t trieIndex = 0;
+				for (auto unit : word) {
+					auto& childList = trieList[trieIndex].ChildList;
+					auto iter = std::lower_bound(childList.begin(), childList.end(), std::make_pair(unit, (int32_t)-1));
+					if (iter != childList.end() && iter->first == unit) {
+						trieIndex = iter->second;
+						continue;
+					}
+
+					auto childIndex = (int32_t)trieList.size();
+					childList.insert(iter, std::make_pair(unit, childIndex));
+					trieList.emplace_back();
+					trieIndex = childIndex;
+				}
+				trieList[trieIndex].WordLength = (uint16_t)word.size();
+			}
+
+			auto pAutomaton = std::make_shared<ChatFilterAutomaton>();
+			auto& automaton = *pAutomaton;
+			automaton.WordCount = (int32_t)wordList.size();
+			automaton.NodeList.reserve(trieList.size());
+			automaton.EdgeUnitList.reserve(trieList.size());
+			automaton.EdgeTargetList.reserve(trieList.size());
+
+			// BFS 순서로 번호를 다시 매겨서 얕은 노드(가장 자주 들르는 곳)끼리 붙여 둠
+			std::vector<int32_t> orderList{ 0 };
+			for (size_t order = 0; order < orderList.size(); ++order) {
+				auto& trieNode = trieList[orderList[order]];
+
+				ChatFilterNode node;
+				node.EdgeBegin = (int32_t)automaton.EdgeUnitList.size();
+				node.EdgeCount = (uint16_t)trieNode.ChildList.size();
+				node.MatchLength = trieNode.WordLength;
+				for (auto& [unit, childIndex] : trieNode.ChildList) {
+					automaton.EdgeUnitList.push_back(unit);
+					automaton.EdgeTargetList.push_back((int32_t)orderList.size());
+					orderList.push_back(childIndex);
+				}
+				automaton.NodeList.push_back(node);
+			}
+
+			// 루트 간선은 0 번부터 시작
+			automaton.FirstUnitBitList.assign(UNIT_BIT_WORD_COUNT, 0);
+			std::vector<char16_t> firstUnitList;
+			const auto& root = automaton.NodeList[0];
+			for (int32_t edge = root.EdgeBegin; edge < root.EdgeBegin + root.EdgeCount; ++edge) {
+				const auto unit = automaton.EdgeUnitList[edge];
+				SetBit(automaton.FirstUnitBitList, unit);
+
+				// SIMD 비교는 소문자로 바꾸기 전의 유닛과 하므로 대문자도 넣음
+				firstUnitList.push_back(unit);
+				if (unit >= u'a' && unit <= u'z') {
+					firstUnitList.push_back((char16_t)(unit - (u'a' - u'A')));
+				}
+			}
+			BuildFirstUnitRange(automaton, firstUnitList);
+
+			automaton.FirstUnitRankList.assign(UNIT_BIT_WORD_COUNT, 0);
+			for (int32_t i = 1; i < UNIT_BIT_WORD_COUNT; ++i) {
+				automaton.FirstUnitRankList[i] = (uint16_t)(automaton.FirstUnitRankList[i - 1] + std::popcount(automaton.FirstUnitBitList[i - 1]));
+			}
+
+			automaton.FirstPairBitList.assign(UNIT_BIT_WORD_COUNT, 0);
+			automaton.SingleUnitBitList.assign(UNIT_BIT_WORD_COUNT, 0);
+			for (auto& word : wordList) {
+				if (word.size() == 1) {
+					SetBit(automaton.SingleUnitBitList, word[0]);
+				}
+				else {
+					SetBit(automaton.FirstPairBitList, HashPair(word[0], word[1]));
+				}
+			}
+
+			// 실패 링크. BFS 순서라서 부모와 실패 링크 대상(더 얕은 노드)은 항상 먼저 끝나 있음
+			for (int32_t nodeIndex = 0; nodeIndex < (int32_t)automaton.NodeList.size(); ++nodeIndex) {
+				const auto& node = automaton.NodeList[nodeIndex];
+				for (int32_t edge = node.EdgeBegin; edge < node.EdgeBegin + node.EdgeCount; ++edge) {
+					const auto unit = automaton.EdgeUnitList[edge];
+					auto& child = automaton.NodeList[automaton.EdgeTargetList[edge]];
+
+					int32_t fail = 0;
+					if (nodeIndex != 0) {
+						auto state = node.Fail;
+						while (true) {
+							auto next = FindEdge(automaton, state, unit);
+							if (next >= 0) {
+								fail = next;
+								break;
+							}
+							if (state == 0) {
+								break;
+							}
+							state = automaton.NodeList[state].Fail;
+						}
+					}
+
+					child.Fail = fail;
+					child.MatchLength = std::max(child.MatchLength, automaton.NodeList[fail].MatchLength);
+				}
+			}
+
+			return pAutomaton;
+		}
+	}
+
+	ChatFilter::ChatFilter()
+	{
+	}
+
+	ChatFilter::~ChatFilter()
+	{
+		Stop();
+	}
+
+	bool ChatFilter::Init(const char* pszFileName, const uint32_t reloadSec, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_ReloadSec = reloadSec;
+		m_FileName = pszFileName != nullptr ? pszFileName : "";
+
+		if (m_FileName.empty()) {
+			return true;
+		}
+
+		// 읽는 도중에 바뀐 것도 다음 확인 때 다시 읽도록 읽기 전에 수정 시간을 기록
+		std::error_code errorCode;
+		m_LastWriteTime = std::filesystem::last_write_time(m_FileName, errorCode);
+
+		auto pAutomaton = Load();
+		if (pAutomaton == nullptr) {
+			return false;
+		}
+
+		SetAutomaton(std::move(pAutomaton));
+		return true;
+	}
+
+	void ChatFilter::Start()
+	{
+		if (m_IsRun || IsEnabled() == false || m_ReloadSec == 0) {
+			return;
+		}
+
+		m_IsRun = true;
+		m_Thread = std::thread([this]() { ThreadFunc(); });
+	}
+
+	void ChatFilter::Stop()
+	{
+		m_IsRun = false;
+
+		if (m_Thread.joinable()) {
+			m_Thread.join();
+		}
+	}
+
+	int32_t ChatFilter::GetWordCount() const
+	{
+		auto pAutomaton = GetAutomaton();
+		return pAutomaton != nullptr ? pAutomaton->WordCount : 0;
+	}
+
+	int32_t ChatFilter::Filter(char16_t* pText, const int32_t length) const
+	{
+		auto pAutomaton = GetAutomaton();
+		if (pAutomaton == nullptr || pAutomaton->WordCount == 0 || length <= 0) {
+			return 0;
+		}
+
+		const auto& automaton = *pAutomaton;
+		int32_t state = 0;
+		int32_t matchCount = 0;
+
+		for (int32_t index = 0; index < length; ++index) {
+			if (state == 0) {
+				index = SkipToCandidate(automaton, pText, index, length);
+				if (index >= length) {
+					break;
+				}
+			}
+
+			const auto unit = FoldUnit(pText[index]);
+			while (true) {
+				auto next = FindEdge(automaton, state, unit);
+				if (next >= 0) {
+					state = next;
+					break;
+				}
+				if (state == 0) {
+					break;
+				}
+				state = automaton.NodeList[state].Fail;
+			}
+
+			// 앞쪽 유닛만 바꾸므로 이어서 훑는 데는 영향이 없음
+			const auto matchLength = automaton.NodeList[state].MatchLength;
+			if (matchLength > 0) {
+				std::fill(pText + index + 1 - matchLength, pText + index + 1, u'*');
+				++matchCount;
+			}
+		}
+
+		return matchCount;
+	}
+
+	std::shared_ptr<const ChatFilterAutomaton> ChatFilter::GetAutomaton() const
+	{
+		std::lock_guard<std::mutex> lock(m_AutomatonLock);
+		return m_pAutomaton;
+	}
+
+	void ChatFilter::SetAutomaton(std::shared_ptr<const ChatFilterAutomaton> pAutomaton)
+	{
+		std::lock_guard<std::mutex> lock(m_AutomatonLock);
+		m_pAutomaton.swap(pAutomaton);
+	}
+
+	void ChatFilter::ThreadFunc()
+	{
+		auto nextCheckTime = std::chrono::steady_clock::now() + std::chrono::seconds(m_ReloadSec);
+
+		while (m_IsRun) {
+			// 종료 요청을 늦지 않게 확인하도록 100ms 씩만 기다림
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+			auto curTime = std::chrono::steady_clock::now();
+			if (curTime < nextCheckTime) {
+				continue;
+			}
+			nextCheckTime = curTime + std::chrono::seconds(m_ReloadSec);
+
+			std::error_code errorCode;
+			auto writeTime = std::filesystem::last_write_time(m_FileName, errorCode);
+			if (errorCode || writeTime == m_LastWriteTime) {
+				continue;
+			}
+			m_LastWriteTime = writeTime;
+
+			auto pAutomaton = Load();
+			if (pAutomaton == nullptr) {
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 금칙어 파일(%s) 다시 읽기 실패. 이전 목록을 계속 사용", __FUNCTION__, m_FileName.c_str());
+				continue;
+			}
+
+			// 필터링 중인 스레드는 잡고 있던 이전 오토마톤을 끝까지 쓰고, 마지막으로 놓는 쪽에서 해제됨
+			SetAutomaton(std::move(pAutomaton));
+		}
+	}
+
+	std::shared_ptr<const ChatFilterAutomaton> ChatFilter::Load()
+	{
+		std::ifstream file(m_FileName, std::ios::binary);
+		if (file.is_open() == false) {
+			return nullptr;
+		}
+
+		std::vector<std::u16string> wordList;
+		int32_t invalidLineCount = 0;
+		char16_t wordBuffer[MAX_WORD_LENGTH];
+
+		std::string line;
+		bool isFirstLine = true;
+		while (std::getline(file, line)) {
+			if (isFirstLine && line.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+				line.erase(0, 3);
+			}
+			isFirstLine = false;
+
+			auto begin = line.find_first_not_of(" \t\r");
+			if (begin == std::string::npos || line[begin] == '#') {
+				continue;
+			}
+			auto end = line.find_last_not_of(" \t\r");
+
+			auto wordLength = Utf8ToUtf16(line.data() + begin, (int32_t)(end - begin + 1), wordBuffer, MAX_WORD_LENGTH);
+			if (wordLength <= 0) {
+				++invalidLineCount;
+				continue;
+			}
+
+			for (int32_t i = 0; i < wordLength; ++i) {
+				wordBuffer[i] = FoldUnit(wordBuffer[i]);
+			}
+			wordList.emplace_back(wordBuffer, wordLength);
+		}
+
+		auto pAutomaton = BuildAutomaton(wordList);
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 금칙어 파일(%s) 읽음. Word(%d), Node(%d), FirstUnitRange(%d), InvalidLine(%d)", __FUNCTION__,
+			m_FileName.c_str(), pAutomaton->WordCount, (int)pAutomaton->NodeList.size(), pAutomaton->RangeCount, invalidLineCount);
+		return pAutomaton;
+	}
+}
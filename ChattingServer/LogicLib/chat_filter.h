@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <filesystem>
+
+#include "../ServerNetLib/interface_log.h"
+
+namespace NLogicLib
+{
+	using ILog = NServerNetLib::ILog;
+
+	struct ChatFilterAutomaton;
+
+	// 채팅 금칙어 필터
+	// - 금칙어 파일(UTF-8, 한 줄에 한 단어, # 은 주석)을 UTF-16 유닛 단위의 Aho-Corasick 오토마톤으로 만들어 한 번 훑어서 모두 찾음
+	//   노드/간선은 BFS 순서로 배열 하나씩에 이어 붙이고, 영문 대소문자는 구분하지 않음
+	// - 루트 상태에서는 단어가 시작할 수 없는 위치를 8 유닛씩 건너뜀
+	//   SSE2 가 있으면 먼저 첫 유닛을 덮는 범위와 한 번에 비교하고, 그 다음 첫 유닛 비트맵과 앞 두 유닛 해시 비트맵을 분기 없이 확인
+	// - 찾은 단어는 '*' 로 가림
+	// - ReloadSec 마다 파일 수정 시간을 확인해서 바뀌었으면 전용 스레드에서 새로 만든 뒤 통째로 바꿔 끼움
+	//   필터링하는 스레드는 그때 잡고 있던 오토마톤을 끝까지 쓰므로 로직 스레드를 멈추지 않음
+	class ChatFilter
+	{
+	public:
+		ChatFilter();
+		~ChatFilter();
+
+		// 파일 이름이 비어 있으면 필터링하지 않음. reloadSec 가 0 이면 다시 읽지 않음
+		bool Init(const char* pszFileName, const uint32_t reloadSec, ILog* pLogger);
+
+		void Start();
+		void Stop();
+
+		bool IsEnabled() const { return m_FileName.empty() == false; }
+
+		int32_t GetWordCount() const;
+
+		// pText 의 length 유닛 안에서 금칙어를 '*' 로 바꾸고 가린 단어 수를 돌려줌. 여러 스레드에서 동시에 호출 가능
+		int32_t Filter(char16_t* pText, const int32_t length) const;
+
+	private:
+		void ThreadFunc();
+
+		std::shared_ptr<const ChatFilterAutomaton> Load();
+
+		std::shared_ptr<const ChatFilterAutomaton> GetAutomaton() const;
+		void SetAutomaton(std::shared_ptr<const ChatFilterAutomaton> pAutomaton);
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+
+		std::string m_FileName;
+		uint32_t m_ReloadSec = 0;
+		// 마지막으로 읽은 파일의 수정 시간 (다시 읽는 스레드만 사용)
+		std::filesystem::file_time_type m_LastWriteTime;
+
+		// 포인터를 복사/교체하는 동안만 잡음 (필터링은 복사한 포인터로 잠금 밖에서)
+		mutable std::mutex m_AutomatonLock;
+		std::shared_ptr<const ChatFilterAutomaton> m_pAutomaton;
+
+		std::thread m_Thread;
+		std::atomic<bool> m_IsRun = false;
+	};
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <cstring>
+#include <cstdint>
+
+#include "../ServerNetLib/define.h"
+#include "../ServerNetLib/interface_tcp_network.h"
+
+namespace NLogicLib
+{
+	using TcpNet = NServerNetLib::ITcpNetwork;
+
+	// 룸/로비의 최근 채팅 N 개를 헤더까지 붙인 패킷 바이트로 보관하는 고정 크기 링
+	// Init 에서 maxCount * slotSize 만큼 한 번만 할당하고, 이후 추가/재전송 시 할당이 없음
+	// 채팅은 여러 로직 워커가 같은 룸/로비에 동시에 추가할 수 있으므로 추가/재전송은 잠금 안에서
+	class ChatHistory
+	{
+		// 룸/로비는 Init 전에 컨테이너에 복사되어 만들어지므로 잠금은 복사하지 않고 새로 만듦
+		struct HistoryLock
+		{
+			HistoryLock() = default;
+			HistoryLock(const HistoryLock&) {}
+			HistoryLock& operator=(const HistoryLock&) { return *this; }
+
+			std::mutex Mutex;
+		};
+
+	public:
+		void Init(const int maxCount, const int16_t packetId, const int16_t maxBodySize)
+		{
+			m_PacketId = packetId;
+			m_SlotSize = NServerNetLib::PACKET_HEADER_SIZE + maxBodySize;
+			m_MaxCount = maxCount > 0 ? maxCount : 0;
+
+			m_Buffer.assign((size_t)m_MaxCount * m_SlotSize, 0);
+			m_SizeList.assign(m_MaxCount, 0);
+			Clear();
+		}
+
+		void Clear()
+		{
+			std::lock_guard<std::mutex> guard(m_Lock.Mutex);
+			m_HeadPos = 0;
+			m_Count = 0;
+		}
+
+		int GetCount() const { return m_Count; }
+
+		// 가장 오래된 채팅을 덮어쓰면서 새 채팅을 추가
+		void Add(const char* pBody, const int16_t bodySize)
+		{
+			if (m_MaxCount == 0 || bodySize > (m_SlotSize - NServerNetLib::PACKET_HEADER_SIZE)) {
+				return;
+			}
+
+			std::lock_guard<std::mutex> guard(m_Lock.Mutex);
+
+			int writePos = (m_HeadPos + m_Count) % m_MaxCount;
+			char* pSlot = &m_Buffer[(size_t)writePos * m_SlotSize];
+
+			NServerNetLib::PacketHeader header{ (int16_t)(NServerNetLib::PACKET_HEADER_SIZE + bodySize), m_PacketId, (uint8_t)0 };
+			memcpy(pSlot, &header, NServerNetLib::PACKET_HEADER_SIZE);
+			memcpy(pSlot + NServerNetLib::PACKET_HEADER_SIZE, pBody, bodySize);
+			m_SizeList[writePos] = header.TotalSize;
+
+			if (m_Count < m_MaxCount) {
+				++m_Count;
+			}
+			else {
+				m_HeadPos = (m_HeadPos + 1) % m_MaxCount;
+			}
+		}
+
+		// 오래된 순서로 이어 붙여서 한 번에 송신 버퍼에 넣음
+		NServerNetLib::NET_ERROR_CODE SendTo(TcpNet* pNetwork, const int sessionIndex)
+		{
+			std::lock_guard<std::mutex> guard(m_Lock.Mutex);
+
+			if (m_Count == 0) {
+				return NServerNetLib::NET_ERROR_CODE::kNONE;
+			}
+
+			// 링이 한 바퀴 돌면 슬롯 순서가 끊기므로 스레드별 임시 버퍼에 이어 붙임 (스레드당 한 번만 커짐)
+			static thread_local std::vector<char> sendBuffer;
+			sendBuffer.resize((size_t)m_MaxCount * m_SlotSize);
+
+			int32_t totalSize = 0;
+			for (int i = 0; i < m_Count; ++i) {
+				int slotPos = (m_HeadPos + i) % m_MaxCount;
+				memcpy(&sendBuffer[totalSize], &m_Buffer[(size_t)slotPos * m_SlotSize], m_SizeList[slotPos]);
+				totalSize += m_SizeList[slotPos];
+			}
+
+			return pNetwork->SendRawData(sessionIndex, sendBuffer.data(), totalSize);
+		}
+
+	private:
+		int16_t m_PacketId = 0;
+		int32_t m_SlotSize = 0;
+		int m_MaxCount = 0;
+
+		int m_HeadPos = 0;
+		int m_Count = 0;
+
+		std::vector<char> m_Buffer;
+		std::vector<int16_t> m_SizeList;
+
+		HistoryLock m_Lock;
+	};
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+
+#include "../ServerNetLib/define.h"
+#include "../ServerNetLib/interface_tcp_network.h"
+
+namespace NLogicLib
+{
+	using TcpNet = NServerNetLib::ITcpNetwork;
+	using ILog = NServerNetLib::ILog;
+	using LOG_LEVEL = NServerNetLib::LOG_LEVEL;
+
+	// 연결 후 이 시간 안에 로그인하지 않으면 접속을 끊음
+	constexpr int LOGIN_WAIT_MILLISEC = 3000;
+
+	class ConnectedUser
+	{
+	public:
+		void Clear()
+		{
+			m_IsConnected = false;
+			m_IsLoginSuccess = false;
+			m_IsLoginPending = false;
+			m_IsSendLagging = false;
+		}
+
+		void SetConnection(const std::chrono::steady_clock::time_point connectedTime)
+		{
+			m_IsConnected = true;
+			m_IsLoginSuccess = false;
+			m_IsLoginPending = false;
+			m_IsSendLagging = false;
+			m_ConnectedTime = connectedTime;
+		}
+
+		void SetLogin()
+		{
+			m_IsLoginSuccess = true;
+			m_IsLoginPending = false;
+		}
+
+		bool m_IsConnected = false;
+		bool m_IsLoginSuccess = false;
+		// 워커 풀에서 ID/PW 검증 중
+		bool m_IsLoginPending = false;
+		int64_t m_LoginSeq = 0;
+		std::chrono::steady_clock::time_point m_ConnectedTime;
+
+		// 송신 버퍼 고수위를 넘은 뒤 아직 회복하지 않음
+		bool m_IsSendLagging = false;
+		std::chrono::steady_clock::time_point m_SendLagStartTime;
+	};
+
+	// 접속은 했지만 아직 로그인하지 않은 세션을 관리 (IsLoginCheck 설정 시 로직 tick 마다 검사)
+	// 송신 버퍼가 계속 차 있는 느린 세션도 여기서 추적해서 오래 이어지면 끊음
+	class ConnectedUserManager
+	{
+	public:
+		void Init(const int maxSessionCount, TcpNet* pNetwork, const NServerNetLib::ServerConfig* pConfig, ILog* pLogger)
+		{
+			m_pRefNetwork = pNetwork;
+			m_pRefLogger = pLogger;
+			m_IsLoginCheck = pConfig->IsLoginCheck;
+			m_LaggardDisconnectMilliSec = pConfig->LaggardDisconnectMilliSec;
+
+			m_ConnectedUserList.resize(maxSessionCount);
+			for (auto& connectedUser : m_ConnectedUserList) {
+				connectedUser.Clear();
+			}
+		}
+
+		void SetConnectSession(const int sessionIndex)
+		{
+			m_ConnectedUserList[sessionIndex].SetConnection(m_pRefNetwork->GetLogicTime());
+		}
+
+		void SetLogin(const int sessionIndex)
+		{
+			m_ConnectedUserList[sessionIndex].SetLogin();
+		}
+
+		bool IsLoginPending(const int sessionIndex) const
+		{
+			return m_ConnectedUserList[sessionIndex].m_IsLoginPending;
+		}
+
+		// 검증 요청마다 새 번호를 붙여서 돌려줌
+		int64_t SetLoginPending(const int sessionIndex)
+		{
+			auto& connectedUser = m_ConnectedUserList[sessionIndex];
+			connectedUser.m_IsLoginPending = true;
+			connectedUser.m_LoginSeq = ++m_LastLoginSeq;
+			return connectedUser.m_LoginSeq;
+		}
+
+		// 검증 결과가 지금 기다리는 요청의 것이면 대기 상태를 풀고 true
+		// 그 사이 접속이 끊겼거나 세션이 재사용되었으면 false (결과는 버림)
+		bool EndLoginPending(const int sessionIndex, const int64_t loginSeq)
+		{
+			auto& connectedUser = m_ConnectedUserList[sessionIndex];
+			if (connectedUser.m_IsConnected == false || connectedUser.m_IsLoginPending == false || connectedUser.m_LoginSeq != loginSeq) {
+				return false;
+			}
+
+			connectedUser.m_IsLoginPending = false;
+			return true;
+		}
+
+		void SetDisConnectSession(const int sessionIndex)
+		{
+			auto& connectedUser = m_ConnectedUserList[sessionIndex];
+			if (connectedUser.m_IsSendLagging) {
+				--m_SendLaggingCount;
+			}
+			connectedUser.Clear();
+		}
+
+		bool IsSendLagging(const int sessionIndex) const
+		{
+			return m_ConnectedUserList[sessionIndex].m_IsSendLagging;
+		}
+
+		void SetSendLagging(const int sessionIndex, const bool isLagging)
+		{
+			auto& connectedUser = m_ConnectedUserList[sessionIndex];
+			if (connectedUser.m_IsConnected == false || connectedUser.m_IsSendLagging == isLagging) {
+				return;
+			}
+
+			connectedUser.m_IsSendLagging = isLagging;
+			if (isLagging) {
+				connectedUser.m_SendLagStartTime = m_pRefNetwork->GetLogicTime();
+				++m_SendLaggingCount;
+			}
+			else {
+				--m_SendLaggingCount;
+			}
+		}
+
+		// 느린 상태가 LaggardDisconnectMilliSec 넘게 이어진 세션을 끊음
+		void SendLagCheck()
+		{
+			if (m_LaggardDisconnectMilliSec == 0 || m_SendLaggingCount == 0) {
+				return;
+			}
+
+			auto curTime = m_pRefNetwork->GetLogicTime();
+			auto limitTime = std::chrono::milliseconds(m_LaggardDisconnectMilliSec);
+
+			for (int i = 0; i < (int)m_ConnectedUserList.size(); ++i) {
+				auto& connectedUser = m_ConnectedUserList[i];
+				if (connectedUser.m_IsSendLagging == false || (curTime - connectedUser.m_SendLagStartTime) < limitTime) {
+					continue;
+				}
+
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 송신 버퍼가 계속 차 있어 접속을 끊음. 세션 인덱스(%d)", __FUNCTION__, i);
+
+				// 닫힘 통보가 올 때까지 다시 끊지 않도록 느린 상태만 먼저 해제
+				connectedUser.m_IsSendLagging = false;
+				--m_SendLaggingCount;
+				m_pRefNetwork->ForcingClose(i);
+			}
+		}
+
+		void LoginCheck()
+		{
+			if (m_IsLoginCheck == false) {
+				return;
+			}
+
+			auto curTime = m_pRefNetwork->GetLogicTime();
+			auto waitTime = std::chrono::milliseconds(LOGIN_WAIT_MILLISEC);
+
+			for (int i = 0; i < (int)m_ConnectedUserList.size(); ++i) {
+				auto& connectedUser = m_ConnectedUserList[i];
+				if (connectedUser.m_IsConnected == false || connectedUser.m_IsLoginSuccess) {
+					continue;
+				}
+
+				if ((curTime - connectedUser.m_ConnectedTime) < waitTime) {
+					continue;
+				}
+
+				SERVER_LOG(m_pRefLogger, LOG_LEVEL::kL_DEBUG, "%s | 로그인 대기 시간 초과. 세션 인덱스(%d)", __FUNCTION__, i);
+
+				// 같은 세션을 매 tick 마다 다시 끊지 않도록 먼저 정리 (닫힘 통보가 오면 다시 Clear)
+				connectedUser.Clear();
+				m_pRefNetwork->ForcingClose(i);
+			}
+		}
+
+	private:
+		TcpNet* m_pRefNetwork = nullptr;
+		ILog* m_pRefLogger = nullptr;
+
+		bool m_IsLoginCheck = false;
+
+		uint32_t m_LaggardDisconnectMilliSec = 0;
+		// 느린 세션이 하나도 없으면 매 tick 전체를 돌지 않음
+		int m_SendLaggingCount = 0;
+
+		int64_t m_LastLoginSeq = 0;
+
+		std::vector<ConnectedUser> m_ConnectedUserList;
+	};
+}
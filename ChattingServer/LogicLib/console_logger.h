@@ -59,7 +59,7 @@ namespace NLogicLib
 			std::cout << settextcolor(console_text_colors::light_green) << "[추적] | " << pText << std::endl;
 		}
 
-		virtual void Error(const char* pText) override
+		virtual void Info(const char* pText) override
 		{
 			std::lock_guard<std::mutex> guard(m_lock);
 			std::cout << settextcolor(console_text_colors::green) << "[정보] | " << pText << std::endl;
@@ -69,7 +69,6 @@ namespace NLogicLib
 	private:
 		console_out m_Conout;
 		std::mutex m_lock;
-	};
 #else
 		ConsoleLog() = default;
 	protected:
@@ -105,7 +104,6 @@ namespace NLogicLib
 
 	private:
 		std::mutex m_lock;
-
-	};
 #endif
+	};
 }
\ No newline at end of file
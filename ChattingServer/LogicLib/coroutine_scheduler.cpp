@@ -0,0 +1,145 @@
+#include "coroutine_scheduler.h"
+
+namespace NLogicLib
+{
+	CoroutineScheduler::CoroutineScheduler()
+	{
+	}
+
+	CoroutineScheduler::~CoroutineScheduler()
+	{
+		// 끝나지 못한 코루틴의 프레임을 풀에 돌려줌
+		for (auto handle : m_ReadyList) {
+			handle.destroy();
+		}
+
+		while (m_TimerQueue.empty() == false) {
+			m_TimerQueue.top().Handle.destroy();
+			m_TimerQueue.pop();
+		}
+
+		for (auto& waitList : m_SendDrainWaitList) {
+			for (auto& waiter : waitList) {
+				waiter.Handle.destroy();
+			}
+		}
+	}
+
+	void CoroutineScheduler::Init(const int32_t sessionPoolSize, NServerNetLib::ITcpNetwork* pNetwork)
+	{
+		m_pRefNetwork = pNetwork;
+		m_SendDrainWaitList.resize(sessionPoolSize);
+	}
+
+	void CoroutineScheduler::Resume(std::coroutine_handle<> handle)
+	{
+		std::lock_guard<std::mutex> guard(m_Lock);
+		m_ReadyList.push_back(handle);
+	}
+
+	void CoroutineScheduler::WakeSendDrain(const int sessionIndex, const bool isDrained)
+	{
+		std::lock_guard<std::mutex> guard(m_Lock);
+		if (m_SendDrainWaitCount == 0) {
+			return;
+		}
+
+		auto& waitList = m_SendDrainWaitList[sessionIndex];
+		for (auto& waiter : waitList) {
+			*waiter.pIsDrained = isDrained;
+			m_ReadyList.push_back(waiter.Handle);
+		}
+		m_SendDrainWaitCount -= (int32_t)waitList.size();
+		waitList.clear();
+	}
+
+	bool CoroutineScheduler::Run(const bool isExpireAll)
+	{
+		bool isWorked = false;
+
+		while (true) {
+			m_RunList.clear();
+			{
+				std::lock_guard<std::mutex> guard(m_Lock);
+				if (isExpireAll) {
+					ExpireAll();
+				}
+
+				m_RunList.swap(m_ReadyList);
+
+				auto curTime = m_pRefNetwork->GetLogicTime();
+				while (m_TimerQueue.empty() == false && m_TimerQueue.top().WakeTime <= curTime) {
+					m_RunList.push_back(m_TimerQueue.top().Handle);
+					m_TimerQueue.pop();
+				}
+			}
+
+			if (m_RunList.empty()) {
+				return isWorked;
+			}
+
+			// 재개한 코루틴이 다시 기다리면 다음 Run 에서 (isExpireAll 이면 이번 Run 안에서) 이어서 처리
+			for (auto handle : m_RunList) {
+				handle.resume();
+			}
+			isWorked = true;
+
+			if (isExpireAll == false) {
+				return isWorked;
+			}
+		}
+	}
+
+	CoroutineScheduler::Clock::time_point CoroutineScheduler::GetNextWakeTime()
+	{
+		std::lock_guard<std::mutex> guard(m_Lock);
+		if (m_ReadyList.empty() == false) {
+			return m_pRefNetwork->GetLogicTime();
+		}
+
+		return m_TimerQueue.empty() ? Clock::time_point::max() : m_TimerQueue.top().WakeTime;
+	}
+
+	void CoroutineScheduler::AddTimer(const uint32_t milliSec, std::coroutine_handle<> handle)
+	{
+		Timer timer;
+		timer.WakeTime = m_pRefNetwork->GetLogicTime() + std::chrono::milliseconds(milliSec);
+		timer.Handle = handle;
+
+		std::lock_guard<std::mutex> guard(m_Lock);
+		timer.Seq = ++m_LastTimerSeq;
+		m_TimerQueue.push(timer);
+	}
+
+	void CoroutineScheduler::AddSendDrainWaiter(const int sessionIndex, std::coroutine_handle<> handle, bool* pIsDrained)
+	{
+		SendDrainWaiter waiter;
+		waiter.Handle = handle;
+		waiter.pIsDrained = pIsDrained;
+
+		std::lock_guard<std::mutex> guard(m_Lock);
+		m_SendDrainWaitList[sessionIndex].push_back(waiter);
+		++m_SendDrainWaitCount;
+	}
+
+	void CoroutineScheduler::ExpireAll()
+	{
+		while (m_TimerQueue.empty() == false) {
+			m_ReadyList.push_back(m_TimerQueue.top().Handle);
+			m_TimerQueue.pop();
+		}
+
+		if (m_SendDrainWaitCount == 0) {
+			return;
+		}
+
+		for (auto& waitList : m_SendDrainWaitList) {
+			for (auto& waiter : waitList) {
+				*waiter.pIsDrained = false;
+				m_ReadyList.push_back(waiter.Handle);
+			}
+			waitList.clear();
+		}
+		m_SendDrainWaitCount = 0;
+	}
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <coroutine>
+#include <vector>
+#include <queue>
+#include <mutex>
+#include <chrono>
+
+#include "../ServerNetLib/interface_tcp_network.h"
+#include "logic_task.h"
+
+namespace NLogicLib
+{
+	// 기다리던 것이 끝난 LogicTask 를 로직 스레드에서 이어서 실행
+	// - 다른 스레드(로그인 워커, 로직 워커)는 Resume 으로 실행 대기 목록에 넣기만 하고, 실제 재개는 Run 을 호출한 스레드가 함
+	// - Sleep: 네트워크의 로직 시계(GetLogicTime)로 시간이 지나면 재개 (로직 루프가 Run 을 호출하는 간격만큼 늦을 수 있음)
+	// - WaitSendDrain: 세션의 송신 버퍼가 저수위 아래로 내려가면(kNTF_SYS_SEND_BUFFER_LOW) 재개
+	// 로직 스레드: Run, 모든 스레드: Resume/Sleep/WaitSendDrain/WakeSendDrain
+	class CoroutineScheduler
+	{
+		using Clock = std::chrono::steady_clock;
+
+		struct Timer
+		{
+			Clock::time_point WakeTime;
+			// 같은 시간이면 먼저 등록한 것부터
+			uint64_t Seq = 0;
+			std::coroutine_handle<> Handle;
+
+			bool operator>(const Timer& other) const
+			{
+				return WakeTime != other.WakeTime ? WakeTime > other.WakeTime : Seq > other.Seq;
+			}
+		};
+
+		struct SendDrainWaiter
+		{
+			std::coroutine_handle<> Handle;
+			// 재개 전에 결과를 써 둘 awaiter 의 값
+			bool* pIsDrained = nullptr;
+		};
+
+	public:
+		class SleepAwaiter
+		{
+		public:
+			SleepAwaiter(CoroutineScheduler* pScheduler, const uint32_t milliSec) : m_pRefScheduler(pScheduler), m_MilliSec(milliSec) {}
+
+			bool await_ready() const { return m_MilliSec == 0; }
+
+			void await_suspend(std::coroutine_handle<> handle) { m_pRefScheduler->AddTimer(m_MilliSec, handle); }
+
+			void await_resume() const {}
+
+		private:
+			CoroutineScheduler* m_pRefScheduler;
+			uint32_t m_MilliSec;
+		};
+
+		// co_await 결과: 송신 버퍼가 비워졌으면 true, 그 전에 세션이 끊겼거나 무중단 재시작으로 기다림을 끝냈으면 false
+		class SendDrainAwaiter
+		{
+		public:
+			SendDrainAwaiter(CoroutineScheduler* pScheduler, const int sessionIndex) : m_pRefScheduler(pScheduler), m_SessionIndex(sessionIndex) {}
+
+			bool await_ready() const { return false; }
+
+			void await_suspend(std::coroutine_handle<> handle) { m_pRefScheduler->AddSendDrainWaiter(m_SessionIndex, handle, &m_IsDrained); }
+
+			bool await_resume() const { return m_IsDrained; }
+
+		private:
+			CoroutineScheduler* m_pRefScheduler;
+			int m_SessionIndex;
+			bool m_IsDrained = false;
+		};
+
+	public:
+		CoroutineScheduler();
+		~CoroutineScheduler();
+
+		void Init(const int32_t sessionPoolSize, NServerNetLib::ITcpNetwork* pNetwork);
+
+		// 다른 스레드에서 끝난 일을 기다리던 코루틴을 실행 대기 목록에 넣음
+		void Resume(std::coroutine_handle<> handle);
+
+		SleepAwaiter Sleep(const uint32_t milliSec) { return SleepAwaiter(this, milliSec); }
+
+		// 송신 버퍼가 고수위를 넘은(느린) 세션에서만 기다릴 것. 이미 비워진 세션은 다음 고수위 통보 뒤에야 깨어남
+		SendDrainAwaiter WaitSendDrain(const int sessionIndex) { return SendDrainAwaiter(this, sessionIndex); }
+
+		// 송신 버퍼 저수위 통보(isDrained true)나 접속 종료(false) 때 그 세션을 기다리던 코루틴을 깨움
+		void WakeSendDrain(const int sessionIndex, const bool isDrained);
+
+		// 로직 스레드: 깨어난 코루틴과 시간이 된 타이머를 재개 (재개한 것이 있으면 true)
+		// isExpireAll: 무중단 재시작 전에 남은 타이머와 송신 대기를 모두 끝내고, 더 기다리는 것이 없을 때까지 반복
+		bool Run(const bool isExpireAll = false);
+
+		// 가장 이른 타이머 시간 (없으면 time_point::max)
+		Clock::time_point GetNextWakeTime();
+
+	private:
+		void AddTimer(const uint32_t milliSec, std::coroutine_handle<> handle);
+
+		void AddSendDrainWaiter(const int sessionIndex, std::coroutine_handle<> handle, bool* pIsDrained);
+
+		// m_Lock 안에서 호출
+		void ExpireAll();
+
+	private:
+		NServerNetLib::ITcpNetwork* m_pRefNetwork = nullptr;
+
+		std::mutex m_Lock;
+
+		std::vector<std::coroutine_handle<>> m_ReadyList;
+		// Run 이 m_ReadyList 와 교체해서 재개하는 목록 (Run 만 사용)
+		std::vector<std::coroutine_handle<>> m_RunList;
+
+		std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> m_TimerQueue;
+		uint64_t m_LastTimerSeq = 0;
+
+		// 세션 인덱스별 송신 버퍼를 기다리는 코루틴
+		std::vector<std::vector<SendDrainWaiter>> m_SendDrainWaitList;
+		int32_t m_SendDrainWaitCount = 0;
+	};
+}
@@ -0,0 +1,210 @@
+#include <cstring>
+#include <algorithm>
+#include <random>
+#include <fstream>
+#include <sstream>
+
+#include "password_hash.h"
+#include "user_store.h"
+#include "credential_store.h"
+
+namespace NLogicLib
+{
+	namespace
+	{
+		constexpr size_t DUMMY_SALT_SIZE = 16;
+	}
+
+	bool CredentialStore::Load(const char* pszFileName, UserStore* pUserStore)
+	{
+		m_CredentialDic.clear();
+		m_IsEnabled = false;
+		m_pRefUserStore = (pUserStore != nullptr && pUserStore->IsOpened()) ? pUserStore : nullptr;
+
+		if (pszFileName == nullptr || pszFileName[0] == '\0') {
+			m_IsEnabled = m_pRefUserStore != nullptr && m_pRefUserStore->GetCredentialCount() > 0;
+			BuildDummyCredential();
+			return true;
+		}
+
+		std::ifstream file(pszFileName);
+		if (file.is_open() == false) {
+			return false;
+		}
+
+		std::string line;
+		while (std::getline(file, line)) {
+			auto commentPos = line.find_first_of(";#");
+			if (commentPos != std::string::npos) {
+				line.erase(commentPos);
+			}
+
+			std::istringstream lineStream(line);
+			std::string id, saltHex, hashHex;
+			uint32_t iterationCount = 0;
+			if (!(lineStream >> id >> saltHex >> iterationCount >> hashHex)) {
+				continue;
+			}
+
+			Credential credential;
+			credential.IterationCount = iterationCount;
+			if (iterationCount == 0 || HexToBytes(saltHex, credential.Salt) == false || HexToBytes(hashHex, credential.Hash) == false) {
+				return false;
+			}
+
+			if (m_pRefUserStore != nullptr) {
+				if (ImportCredential(id, credential) == false) {
+					return false;
+				}
+				continue;
+			}
+
+			m_CredentialDic[id] = std::move(credential);
+		}
+
+		m_IsEnabled = true;
+		BuildDummyCredential();
+		return true;
+	}
+
+	ERROR_CODE CredentialStore::Verify(const char* pszID, const char* pszPW) const
+	{
+		if (m_IsEnabled == false) {
+			return ERROR_CODE::NONE;
+		}
+
+		// 저장소의 비밀번호 칸은 시작할 때만 바뀌므로 잠금 없이 읽음
+		if (m_pRefUserStore != nullptr) {
+			auto pRecord = m_pRefUserStore->GetRecord(m_pRefUserStore->Find(pszID));
+			if (pRecord == nullptr || pRecord->Credential.IterationCount == 0) {
+				return VerifyUnknownID(pszPW);
+			}
+
+			auto& credential = pRecord->Credential;
+			return VerifyHash(pszPW, credential.Salt, credential.SaltSize, credential.IterationCount, credential.Hash, credential.HashSize);
+		}
+
+		auto iter = m_CredentialDic.find(pszID);
+		if (iter == m_CredentialDic.end()) {
+			return VerifyUnknownID(pszPW);
+		}
+
+		auto& credential = iter->second;
+		return VerifyHash(pszPW, credential.Salt.data(), credential.Salt.size(), credential.IterationCount, credential.Hash.data(), credential.Hash.size());
+	}
+
+	int CredentialStore::GetCount() const
+	{
+		return m_pRefUserStore != nullptr ? m_pRefUserStore->GetCredentialCount() : (int)m_CredentialDic.size();
+	}
+
+	ERROR_CODE CredentialStore::VerifyUnknownID(const char* pszPW) const
+	{
+		// 없는 ID 도 같은 해시 계산을 거치고 같은 에러를 돌려줘서 응답 시간/코드로 ID 가 있는지 알 수 없게 함
+		auto& credential = m_DummyCredential;
+		VerifyHash(pszPW, credential.Salt.data(), credential.Salt.size(), credential.IterationCount, credential.Hash.data(), credential.Hash.size());
+		return ERROR_CODE::LOGIN_INVALID_PASSWORD;
+	}
+
+	void CredentialStore::BuildDummyCredential()
+	{
+		// 가장 오래 걸리는 계정과 같은 반복 횟수로 계산
+		uint32_t iterationCount = 0;
+		if (m_pRefUserStore != nullptr) {
+			for (int32_t i = 0; i < m_pRefUserStore->GetRecordCount(); ++i) {
+				iterationCount = std::max(iterationCount, m_pRefUserStore->GetRecord(i)->Credential.IterationCount);
+			}
+		}
+		for (auto& [id, credential] : m_CredentialDic) {
+			iterationCount = std::max(iterationCount, credential.IterationCount);
+		}
+
+		// 어떤 비밀번호와도 맞지 않도록 솔트/해시는 무작위
+		std::random_device randomDevice;
+		m_DummyCredential.IterationCount = std::max(1u, iterationCount);
+		m_DummyCredential.Salt.resize(DUMMY_SALT_SIZE);
+		m_DummyCredential.Hash.resize(MAX_USER_HASH_SIZE);
+		for (auto& value : m_DummyCredential.Salt) {
+			value = (uint8_t)randomDevice();
+		}
+		for (auto& value : m_DummyCredential.Hash) {
+			value = (uint8_t)randomDevice();
+		}
+	}
+
+	ERROR_CODE CredentialStore::VerifyHash(const char* pszPW, const uint8_t* pSalt, const size_t saltSize, const uint32_t iterationCount,
+		const uint8_t* pHash, const size_t hashSize)
+	{
+		std::vector<uint8_t> hash(hashSize);
+		Pbkdf2Sha256((const uint8_t*)pszPW, strlen(pszPW), pSalt, saltSize, iterationCount, hash.data(), hash.size());
+
+		// 어디서 달라지는지 시간으로 알 수 없도록 끝까지 비교
+		uint8_t diff = 0;
+		for (size_t i = 0; i < hash.size(); ++i) {
+			diff |= hash[i] ^ pHash[i];
+		}
+
+		return diff == 0 ? ERROR_CODE::NONE : ERROR_CODE::LOGIN_INVALID_PASSWORD;
+	}
+
+	bool CredentialStore::ImportCredential(const std::string& id, const Credential& credential)
+	{
+		if (credential.Salt.size() > (size_t)MAX_USER_SALT_SIZE || credential.Hash.size() > (size_t)MAX_USER_HASH_SIZE) {
+			return false;
+		}
+
+		UserCredential userCredential;
+		userCredential.IterationCount = credential.IterationCount;
+		userCredential.SaltSize = (uint8_t)credential.Salt.size();
+		userCredential.HashSize = (uint8_t)credential.Hash.size();
+		memcpy(userCredential.Salt, credential.Salt.data(), credential.Salt.size());
+		memcpy(userCredential.Hash, credential.Hash.data(), credential.Hash.size());
+
+		auto recordIndex = m_pRefUserStore->Find(id.c_str());
+		if (recordIndex < 0) {
+			recordIndex = m_pRefUserStore->Add(id.c_str());
+			if (recordIndex < 0) {
+				return false;
+			}
+		}
+
+		// 이미 가져온 계정은 바뀌었을 때만 씀
+		auto& storedCredential = m_pRefUserStore->GetRecord(recordIndex)->Credential;
+		if (storedCredential.IterationCount != userCredential.IterationCount || storedCredential.SaltSize != userCredential.SaltSize
+			|| storedCredential.HashSize != userCredential.HashSize
+			|| memcmp(storedCredential.Salt, userCredential.Salt, sizeof(userCredential.Salt)) != 0
+			|| memcmp(storedCredential.Hash, userCredential.Hash, sizeof(userCredential.Hash)) != 0) {
+			m_pRefUserStore->SetCredential(recordIndex, userCredential);
+		}
+
+		return true;
+	}
+
+	bool CredentialStore::HexToBytes(const std::string& hex, std::vector<uint8_t>& bytes)
+	{
+		if (hex.empty() || (hex.size() % 2) != 0) {
+			return false;
+		}
+
+		auto toValue = [](const char c) -> int {
+			if (c >= '0' && c <= '9') return c - '0';
+			if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+			return -1;
+		};
+
+		bytes.clear();
+		bytes.reserve(hex.size() / 2);
+		for (size_t i = 0; i < hex.size(); i += 2) {
+			int high = toValue(hex[i]);
+			int low = toValue(hex[i + 1]);
+			if (high < 0 || low < 0) {
+				return false;
+			}
+
+			bytes.push_back((uint8_t)((high << 4) | low));
+		}
+
+		return true;
+	}
+}
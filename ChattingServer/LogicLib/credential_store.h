@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+#include "../Common/error_code.h"
+
+namespace NLogicLib
+{
+	using ERROR_CODE = NCommon::ERROR_CODE;
+
+	class UserStore;
+
+	struct Credential
+	{
+		std::vector<uint8_t> Salt;
+		uint32_t IterationCount = 0;
+		std::vector<uint8_t> Hash;
+	};
+
+	// 계정 서비스 대신 사용하는 로컬 계정 파일
+	// 한 줄에 "ID 솔트(hex) 반복횟수 해시(hex)" 이고 해시는 PBKDF2-HMAC-SHA256
+	// 시작할 때 한 번 읽은 뒤로는 읽기만 하므로 여러 워커 스레드가 잠금 없이 같이 사용
+	// 유저 저장소가 열려 있으면 파일의 계정을 저장소에 가져오고(바뀐 것만) 검증도 저장소의 레코드로 함
+	class CredentialStore
+	{
+	public:
+		// 파일 이름이 비어 있으면 검증하지 않는 개발용 모드 (유저 저장소에 가져온 계정이 있으면 파일 없이도 검증)
+		bool Load(const char* pszFileName, UserStore* pUserStore);
+
+		bool IsEnabled() const { return m_IsEnabled; }
+
+		int GetCount() const;
+
+		// 느린 해시 계산을 하므로 로직 스레드가 아닌 워커 스레드에서 호출
+		// 없는 ID 와 틀린 비밀번호는 모두 LOGIN_INVALID_PASSWORD (걸리는 시간도 같음)
+		ERROR_CODE Verify(const char* pszID, const char* pszPW) const;
+
+	private:
+		static bool HexToBytes(const std::string& hex, std::vector<uint8_t>& bytes);
+
+		static ERROR_CODE VerifyHash(const char* pszPW, const uint8_t* pSalt, const size_t saltSize, const uint32_t iterationCount,
+			const uint8_t* pHash, const size_t hashSize);
+
+		bool ImportCredential(const std::string& id, const Credential& credential);
+
+		// 없는 ID 일 때 임시 계정으로 해시만 계산하고 실패를 돌려줌
+		ERROR_CODE VerifyUnknownID(const char* pszPW) const;
+
+		void BuildDummyCredential();
+
+	private:
+		bool m_IsEnabled = false;
+
+		UserStore* m_pRefUserStore = nullptr;
+
+		std::unordered_map<std::string, Credential> m_CredentialDic;
+
+		// 없는 ID 의 검증에 쓰는 임시 계정
+		Credential m_DummyCredential;
+	};
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+
+#include "../ServerNetLib/define.h"
+#include "../ServerNetLib/interface_tcp_network.h"
+
+namespace NLogicLib
+{
+	using TcpNet = NServerNetLib::ITcpNetwork;
+	using ILog = NServerNetLib::ILog;
+	using LOG_LEVEL = NServerNetLib::LOG_LEVEL;
+
+	// 같은 비율 제한을 받는 패킷 묶음
+	enum class FLOOD_CLASS : int16_t
+	{
+		NONE = -1,
+		// 룸/로비 채팅 (모든 멤버에게 퍼지므로 가장 엄격하게)
+		CHAT = 0,
+		// 그 밖의 클라이언트 요청
+		REQUEST = 1,
+		// 게임 중 틱마다 오는 상태 (UDP)
+		GAME_STATE = 2,
+		MAX = 3,
+	};
+
+	// 초당 TokenPerSec 개씩 차고 최대 Burst 개까지 모이는 토큰 통
+	class TokenBucket
+	{
+	public:
+		void Init(const double tokenPerSec, const double burst, const std::chrono::steady_clock::time_point curTime)
+		{
+			m_TokenPerSec = tokenPerSec;
+			m_Burst = burst;
+			m_Token = burst;
+			m_LastTime = curTime;
+		}
+
+		bool Consume(const std::chrono::steady_clock::time_point curTime)
+		{
+			std::chrono::duration<double> elapsed = curTime - m_LastTime;
+			m_LastTime = curTime;
+			m_Token = std::min(m_Burst, m_Token + elapsed.count() * m_TokenPerSec);
+
+			if (m_Token < 1.0) {
+				return false;
+			}
+
+			m_Token -= 1.0;
+			return true;
+		}
+
+	private:
+		double m_TokenPerSec = 0;
+		double m_Burst = 0;
+		double m_Token = 0;
+		std::chrono::steady_clock::time_point m_LastTime;
+	};
+
+	struct FloodControlConfig
+	{
+		// 둘 중 하나라도 0 이면 해당 묶음은 제한하지 않음 (Burst 0 은 모든 패킷을 버리게 되므로)
+		uint32_t TokenPerSec[(int)FLOOD_CLASS::MAX] = { 0, };
+		uint32_t TokenBurst[(int)FLOOD_CLASS::MAX] = { 0, };
+
+		// DropWindowMilliSec 안에 이만큼 버려지면 접속을 끊음 (0 이면 끊지 않음)
+		uint32_t MaxDropCount = 0;
+		uint32_t DropWindowMilliSec = 0;
+	};
+
+	// 세션별, 패킷 묶음별 토큰 통으로 짧은 시간에 몰려오는 요청을 처리 전에 버림
+	// 세션 상태는 그 세션의 패킷을 처리하는 스레드(로직 스레드 또는 로직 워커 하나)만 사용
+	class FloodControl
+	{
+		struct SessionFloodState
+		{
+			TokenBucket BucketList[(int)FLOOD_CLASS::MAX];
+			uint32_t DropCount = 0;
+			std::chrono::steady_clock::time_point DropWindowStartTime;
+			bool IsForcingClosed = false;
+		};
+
+	public:
+		void Init(const int maxSessionCount, const FloodControlConfig& config, TcpNet* pNetwork, ILog* pLogger)
+		{
+			m_Config = config;
+			m_pRefNetwork = pNetwork;
+			m_pRefLogger = pLogger;
+
+			m_SessionStateList.resize(maxSessionCount);
+		}
+
+		void SetConnectSession(const int sessionIndex)
+		{
+			auto curTime = m_pRefNetwork->GetLogicTime();
+
+			auto& state = m_SessionStateList[sessionIndex];
+			for (int i = 0; i < (int)FLOOD_CLASS::MAX; ++i) {
+				state.BucketList[i].Init(m_Config.TokenPerSec[i], m_Config.TokenBurst[i], curTime);
+			}
+			state.DropCount = 0;
+			state.DropWindowStartTime = curTime;
+			state.IsForcingClosed = false;
+		}
+
+		// 처리해도 되면 true, 버려야 하면 false
+		bool Check(const int sessionIndex, const FLOOD_CLASS floodClass)
+		{
+			if (floodClass == FLOOD_CLASS::NONE || m_Config.TokenPerSec[(int)floodClass] == 0 || m_Config.TokenBurst[(int)floodClass] == 0) {
+				return true;
+			}
+
+			auto& state = m_SessionStateList[sessionIndex];
+			if (state.IsForcingClosed) {
+				return false;
+			}
+
+			auto curTime = m_pRefNetwork->GetLogicTime();
+			if (state.BucketList[(int)floodClass].Consume(curTime)) {
+				return true;
+			}
+
+			++m_DropCountList[(int)floodClass];
+			CheckRepeatOffender(sessionIndex, state, curTime);
+			return false;
+		}
+
+		uint64_t GetDropCount(const FLOOD_CLASS floodClass) const { return m_DropCountList[(int)floodClass].load(); }
+
+	private:
+		void CheckRepeatOffender(const int sessionIndex, SessionFloodState& state, const std::chrono::steady_clock::time_point curTime)
+		{
+			if (m_Config.MaxDropCount == 0) {
+				return;
+			}
+
+			if ((curTime - state.DropWindowStartTime) > std::chrono::milliseconds(m_Config.DropWindowMilliSec)) {
+				state.DropWindowStartTime = curTime;
+				state.DropCount = 0;
+			}
+
+			if (++state.DropCount < m_Config.MaxDropCount) {
+				return;
+			}
+
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 요청 폭주로 접속을 끊음. 세션 인덱스(%d), 버린 패킷 수(%u)", __FUNCTION__,
+				sessionIndex, state.DropCount);
+
+			// 닫힘 통보가 올 때까지 남은 패킷은 모두 버림
+			state.IsForcingClosed = true;
+			m_pRefNetwork->ForcingClose(sessionIndex);
+		}
+
+	private:
+		TcpNet* m_pRefNetwork = nullptr;
+		ILog* m_pRefLogger = nullptr;
+
+		FloodControlConfig m_Config;
+
+		std::vector<SessionFloodState> m_SessionStateList;
+
+		// 여러 로직 워커가 서로 다른 세션을 검사하면서 같이 올림
+		std::atomic<uint64_t> m_DropCountList[(int)FLOOD_CLASS::MAX] = {};
+	};
+}
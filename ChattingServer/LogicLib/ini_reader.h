@@ -0,0 +1,99 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace NLogicLib
+{
+	// ServerConfig.ini 같은 "[섹션]" + "키 = 값" 형식의 설정 파일을 읽음
+	// 값 뒤의 ';' 이후는 주석으로 취급
+	class IniReader
+	{
+	public:
+		bool Load(const char* pszFileName)
+		{
+			std::ifstream file(pszFileName);
+			if (file.is_open() == false) {
+				return false;
+			}
+
+			std::string section;
+			std::string line;
+			while (std::getline(file, line)) {
+				// UTF-8 BOM 제거
+				if (line.size() >= 3 && line.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+					line.erase(0, 3);
+				}
+
+				auto commentPos = line.find_first_of(";#");
+				if (commentPos != std::string::npos) {
+					line.erase(commentPos);
+				}
+
+				line = Trim(line);
+				if (line.empty()) {
+					continue;
+				}
+
+				if (line.front() == '[' && line.back() == ']') {
+					section = Trim(line.substr(1, line.size() - 2));
+					continue;
+				}
+
+				auto equalPos = line.find('=');
+				if (equalPos == std::string::npos) {
+					continue;
+				}
+
+				auto key = Trim(line.substr(0, equalPos));
+				auto value = Trim(line.substr(equalPos + 1));
+				m_Values[section + "." + key] = value;
+			}
+
+			return true;
+		}
+
+		int GetInt(const char* pszSection, const char* pszKey, const int defaultValue) const
+		{
+			auto iter = m_Values.find(std::string(pszSection) + "." + pszKey);
+			if (iter == m_Values.end() || iter->second.empty()) {
+				return defaultValue;
+			}
+
+			try {
+				return std::stoi(iter->second);
+			}
+			catch (...) {
+				return defaultValue;
+			}
+		}
+
+		std::string GetString(const char* pszSection, const char* pszKey, const char* pszDefaultValue) const
+		{
+			auto iter = m_Values.find(std::string(pszSection) + "." + pszKey);
+			if (iter == m_Values.end()) {
+				return pszDefaultValue;
+			}
+
+			return iter->second;
+		}
+
+	private:
+		static std::string Trim(const std::string& text)
+		{
+			const char* pszSpace = " \t\r\n";
+			auto begin = text.find_first_not_of(pszSpace);
+			if (begin == std::string::npos) {
+				return "";
+			}
+
+			auto end = text.find_last_not_of(pszSpace);
+			return text.substr(begin, end - begin + 1);
+		}
+
+	private:
+		// "섹션.키" -> 값
+		std::unordered_map<std::string, std::string> m_Values;
+	};
+}
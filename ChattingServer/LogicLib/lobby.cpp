@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <cstring>
+
+#include "../Common/Packet.h"
+#include "state_snapshot.h"
+#include "lobby.h"
+
+namespace NLogicLib
+{
+	using PACKET_ID = NCommon::PACKET_ID;
+
+	Lobby::Lobby()
+	{
+	}
+
+	Lobby::~Lobby()
+	{
+	}
+
+	void Lobby::Init(const short lobbyIndex, const short maxLobbyUserCount, const short maxRoomCountByLobby, const short maxRoomUserCount, const short chatHistoryCount)
+	{
+		m_LobbyIndex = lobbyIndex;
+
+		m_ChatHistory.Init(chatHistoryCount, (int16_t)PACKET_ID::LOBBY_CHAT_NTF, sizeof(NCommon::PktLobbyChatNtf));
+
+		for (int i = 0; i < maxLobbyUserCount; ++i) {
+			LobbyUser lobbyUser;
+			lobbyUser.Index = (short)i;
+			lobbyUser.pUser = nullptr;
+
+			m_UserList.push_back(lobbyUser);
+		}
+
+		m_RoomList.reserve(maxRoomCountByLobby);
+		for (int i = 0; i < maxRoomCountByLobby; ++i) {
+			m_RoomList.emplace_back(Room());
+			m_RoomList[i].Init((short)i, maxRoomUserCount, chatHistoryCount);
+		}
+
+		m_RoomOccupancyIndex.Init(maxRoomCountByLobby, maxRoomUserCount);
+		for (auto& room : m_RoomList) {
+			room.SetOccupancyIndex(&m_RoomOccupancyIndex);
+		}
+	}
+
+	void Lobby::SetNetwork(TcpNet* pNetwork, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_pRefNetwork = pNetwork;
+
+		for (auto& room : m_RoomList) {
+			room.SetNetwork(pNetwork, pLogger);
+		}
+	}
+
+	void Lobby::SetTopic(TopicHub* pTopicHub, const int32_t topicId, const int32_t firstRoomTopicId)
+	{
+		m_pRefTopicHub = pTopicHub;
+		m_TopicId = topicId;
+
+		for (int i = 0; i < (int)m_RoomList.size(); ++i) {
+			m_RoomList[i].SetTopic(pTopicHub, firstRoomTopicId + i, topicId);
+		}
+	}
+
+	ERROR_CODE Lobby::EnterUser(User* pUser)
+	{
+		if (m_UserIndexDic.size() >= m_UserList.size()) {
+			return ERROR_CODE::LOBBY_ENTER_MAX_USER_COUNT;
+		}
+
+		if (m_UserIndexDic.find(pUser->GetIndex()) != m_UserIndexDic.end()) {
+			return ERROR_CODE::LOBBY_ENTER_USER_DUPLICATION;
+		}
+
+		for (auto& lobbyUser : m_UserList) {
+			if (lobbyUser.pUser != nullptr) {
+				continue;
+			}
+
+			lobbyUser.pUser = pUser;
+			m_UserIndexDic.insert({ pUser->GetIndex(), pUser });
+			m_pRefTopicHub->Subscribe(m_TopicId, pUser->GetSessioIndex());
+
+			pUser->EnterLobby(m_LobbyIndex);
+			return ERROR_CODE::NONE;
+		}
+
+		return ERROR_CODE::LOBBY_ENTER_EMPTY_USER_LIST;
+	}
+
+	ERROR_CODE Lobby::LeaveUser(const int userIndex)
+	{
+		for (auto& lobbyUser : m_UserList) {
+			if (lobbyUser.pUser == nullptr || lobbyUser.pUser->GetIndex() != userIndex) {
+				continue;
+			}
+
+			m_pRefTopicHub->Unsubscribe(m_TopicId, lobbyUser.pUser->GetSessioIndex());
+			lobbyUser.pUser = nullptr;
+			m_UserIndexDic.erase(userIndex);
+			return ERROR_CODE::NONE;
+		}
+
+		return ERROR_CODE::LOBBY_LEAVE_USER_NVALID_UNIQUEINDEX;
+	}
+
+	Room* Lobby::CreateRoom()
+	{
+		return GetRoom(m_RoomOccupancyIndex.GetUnusedRoom());
+	}
+
+	Room* Lobby::FindQuickEnterRoom()
+	{
+		return GetRoom(m_RoomOccupancyIndex.FindFullestRoom((int32_t)Room::GAME_STATE::NONE, 1));
+	}
+
+	int32_t Lobby::GetRoomList(const Room::GAME_STATE gameState, const short minFreeSeatCount, short* pRoomIndexList, const int32_t maxCount) const
+	{
+		return m_RoomOccupancyIndex.GetRoomList((int32_t)gameState, minFreeSeatCount, pRoomIndexList, maxCount);
+	}
+
+	Room* Lobby::GetRoom(const short roomIndex)
+	{
+		if (roomIndex < 0 || roomIndex >= (short)m_RoomList.size()) {
+			return nullptr;
+		}
+
+		return &m_RoomList[roomIndex];
+	}
+
+	const Room* Lobby::GetRoom(const short roomIndex) const
+	{
+		if (roomIndex < 0 || roomIndex >= (short)m_RoomList.size()) {
+			return nullptr;
+		}
+
+		return &m_RoomList[roomIndex];
+	}
+
+	void Lobby::CaptureSnapshot(SnapshotImage& image) const
+	{
+		for (auto& lobbyUser : m_UserList) {
+			if (lobbyUser.pUser == nullptr || lobbyUser.pUser->IsCurDomainInRoom()) {
+				continue;
+			}
+
+			image.AddUser(lobbyUser.pUser->GetID().c_str(), m_LobbyIndex, -1);
+		}
+
+		for (auto& room : m_RoomList) {
+			if (room.IsUsed() == false) {
+				continue;
+			}
+
+			image.AddRoom(m_LobbyIndex, room.GetIndex(), (int16_t)room.GetGameState(), room.GetTitle());
+			for (auto pUser : room.GetUserList()) {
+				image.AddUser(pUser->GetID().c_str(), m_LobbyIndex, room.GetIndex());
+			}
+		}
+	}
+
+	int32_t Lobby::CloseEmptyRoom()
+	{
+		int32_t closeCount = 0;
+		for (auto& room : m_RoomList) {
+			if (room.CloseIfEmpty()) {
+				++closeCount;
+			}
+		}
+
+		return closeCount;
+	}
+
+	void Lobby::SendToAllUser(const short packetId, const short dataSize, const char* pData, const int passSessionIndex)
+	{
+		m_pRefTopicHub->Publish(m_TopicId, packetId, dataSize, pData, passSessionIndex);
+	}
+
+	void Lobby::NotifyChat(const int sessionIndex, const char* pszUserID, const char16_t* pMsg, const int msgLength)
+	{
+		NCommon::PktLobbyChatNtf pkt;
+		memcpy(pkt.UserID, pszUserID, strnlen(pszUserID, NCommon::MAX_USER_ID_SIZE));
+		memcpy(pkt.Msg, pMsg, std::min(msgLength, NCommon::MAX_LOBBY_CHAT_MSG_SIZE) * sizeof(char16_t));
+
+		m_ChatHistory.Add((char*)&pkt, sizeof(pkt));
+
+		SendToAllUser((short)PACKET_ID::LOBBY_CHAT_NTF, sizeof(pkt), (char*)&pkt, sessionIndex);
+	}
+
+	void Lobby::SendChatHistory(const int sessionIndex)
+	{
+		m_ChatHistory.SendTo(m_pRefNetwork, sessionIndex);
+	}
+}
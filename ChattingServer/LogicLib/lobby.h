@@ -0,0 +1,96 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "../ServerNetLib/interface_tcp_network.h"
+#include "../Common/error_code.h"
+#include "user.h"
+#include "room.h"
+#include "room_occupancy_index.h"
+#include "chat_history.h"
+#include "topic_hub.h"
+
+namespace NLogicLib
+{
+	struct SnapshotImage;
+
+	using TcpNet = NServerNetLib::ITcpNetwork;
+	using ILog = NServerNetLib::ILog;
+	using ERROR_CODE = NCommon::ERROR_CODE;
+
+	struct LobbyUser
+	{
+		short Index = 0;
+		User* pUser = nullptr;
+	};
+
+	class Lobby
+	{
+	public:
+		Lobby();
+		virtual ~Lobby();
+
+		void Init(const short lobbyIndex, const short maxLobbyUserCount, const short maxRoomCountByLobby, const short maxRoomUserCount, const short chatHistoryCount);
+
+		void SetNetwork(TcpNet* pNetwork, ILog* pLogger);
+
+		// 로비 토픽은 룸에 들어가지 않은 로비 유저, 룸 토픽은 firstRoomTopicId 부터 룸 순서대로
+		void SetTopic(TopicHub* pTopicHub, const int32_t topicId, const int32_t firstRoomTopicId);
+
+		short GetIndex() const { return m_LobbyIndex; }
+
+		ERROR_CODE EnterUser(User* pUser);
+		ERROR_CODE LeaveUser(const int userIndex);
+
+		short GetUserCount() const { return (short)m_UserIndexDic.size(); }
+
+		short MaxUserCount() const { return (short)m_UserList.size(); }
+
+		short MaxRoomCount() const { return (short)m_RoomList.size(); }
+
+		// 비어 있는 룸을 찾아서 돌려줌 (없으면 nullptr)
+		Room* CreateRoom();
+
+		// 게임 시작 전이고 자리가 남은 룸 중 가장 꽉 찬 룸 (없으면 nullptr)
+		Room* FindQuickEnterRoom();
+
+		// gameState 이고 빈 자리가 minFreeSeatCount 이상인 룸을 가장 꽉 찬 것부터 maxCount 개까지 담음
+		int32_t GetRoomList(const Room::GAME_STATE gameState, const short minFreeSeatCount, short* pRoomIndexList, const int32_t maxCount) const;
+
+		Room* GetRoom(const short roomIndex);
+		const Room* GetRoom(const short roomIndex) const;
+
+		// 사용 중인 룸과 그 유저(들어온 순서대로), 룸에 들어가지 않은 로비 유저를 image 에 덧붙임
+		void CaptureSnapshot(SnapshotImage& image) const;
+
+		// 유저가 없는 룸을 모두 닫고 닫은 수를 돌려줌
+		int32_t CloseEmptyRoom();
+
+		// 로비에 있는 유저(룸에 들어간 유저 제외)에게 보냄
+		void SendToAllUser(const short packetId, const short dataSize, const char* pData, const int passSessionIndex = -1);
+
+		// msgLength 는 검사가 끝난 pMsg 의 길이 (UTF-16 유닛 수)
+		void NotifyChat(const int sessionIndex, const char* pszUserID, const char16_t* pMsg, const int msgLength);
+
+		// 새로 들어온 유저에게 최근 로비 채팅을 한 번에 보냄
+		void SendChatHistory(const int sessionIndex);
+
+	protected:
+		ILog* m_pRefLogger = nullptr;
+		TcpNet* m_pRefNetwork = nullptr;
+		TopicHub* m_pRefTopicHub = nullptr;
+		int32_t m_TopicId = -1;
+
+		short m_LobbyIndex = 0;
+
+		std::vector<LobbyUser> m_UserList;
+		std::unordered_map<int, User*> m_UserIndexDic;
+
+		std::vector<Room> m_RoomList;
+		// 룸이 이 색인을 가리키므로 Init 뒤에는 로비를 옮기지 않음
+		RoomOccupancyIndex m_RoomOccupancyIndex;
+
+		ChatHistory m_ChatHistory;
+	};
+}
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cstring>
+
+#include "../Common/Packet.h"
+#include "state_snapshot.h"
+#include "lobby_manager.h"
+
+namespace NLogicLib
+{
+	using PACKET_ID = NCommon::PACKET_ID;
+
+	LobbyManager::LobbyManager()
+	{
+	}
+
+	LobbyManager::~LobbyManager()
+	{
+	}
+
+	void LobbyManager::Init(const LobbyManagerConfig config, TcpNet* pNetwork, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_pRefNetwork = pNetwork;
+
+		// 최근 채팅은 입장 응답과 함께 송신 버퍼에 한 번에 넣으므로 응답 1개 자리를 남기고 버퍼 크기에 맞춤
+		int chatSlotSize = NServerNetLib::PACKET_HEADER_SIZE + (int)std::max(sizeof(NCommon::PktRoomChatNtf), sizeof(NCommon::PktLobbyChatNtf));
+		int maxChatHistoryCount = std::max(0, (config.MaxClientSendBufferSize / chatSlotSize) - 1);
+		int chatHistoryCount = std::min(config.ChatHistoryCount, maxChatHistoryCount);
+		if (chatHistoryCount != config.ChatHistoryCount) {
+			m_pRefLogger->WriteLog(NServerNetLib::LOG_LEVEL::kL_WARN, "%s | ChatHistoryCount(%d) 가 송신 버퍼보다 커서 %d 로 줄임",
+				__FUNCTION__, config.ChatHistoryCount, chatHistoryCount);
+		}
+
+		m_TopicHub.Init(config.MaxLobbyCount * (1 + config.MaxRoomCountByLobby), config.SessionPoolSize, m_pRefNetwork);
+
+		// 룸이 로비 안의 색인을 가리키므로 로비는 제자리에서 초기화하고 옮기지 않음
+		m_LobbyList.resize(config.MaxLobbyCount);
+		for (int i = 0; i < config.MaxLobbyCount; ++i) {
+			auto& lobby = m_LobbyList[i];
+			lobby.Init((short)i, (short)config.MaxLobbyUserCount, (short)config.MaxRoomCountByLobby, (short)config.MaxRoomUserCount, (short)chatHistoryCount);
+			lobby.SetNetwork(m_pRefNetwork, m_pRefLogger);
+			lobby.SetTopic(&m_TopicHub, i, config.MaxLobbyCount + i * config.MaxRoomCountByLobby);
+		}
+	}
+
+	Lobby* LobbyManager::GetLobby(short lobbyId)
+	{
+		if (lobbyId < 0 || lobbyId >= (short)m_LobbyList.size()) {
+			return nullptr;
+		}
+
+		return &m_LobbyList[lobbyId];
+	}
+
+	void LobbyManager::SendLobbyListInfo(const int sessionIndex)
+	{
+		NCommon::PktLobbyListRes resPkt;
+		resPkt.ErrorCode = (short)ERROR_CODE::NONE;
+		resPkt.LobbyCount = 0;
+
+		for (auto& lobby : m_LobbyList) {
+			if (resPkt.LobbyCount >= NCommon::MAX_LOBBY_LIST_COUNT) {
+				break;
+			}
+
+			auto& info = resPkt.LobbyList[resPkt.LobbyCount];
+			info.LobbyId = lobby.GetIndex();
+			info.LobbyUserCount = lobby.GetUserCount();
+			info.LobbyMaxUserCount = lobby.MaxUserCount();
+
+			++resPkt.LobbyCount;
+		}
+
+		m_pRefNetwork->SendData(sessionIndex, (short)PACKET_ID::LOBBY_LIST_RES, sizeof(resPkt), (char*)&resPkt);
+	}
+
+	void LobbyManager::CaptureSnapshot(SnapshotImage& image) const
+	{
+		for (auto& lobby : m_LobbyList) {
+			lobby.CaptureSnapshot(image);
+		}
+
+		// 기다리는 중에 다시 멈춰도 아직 돌아오지 않은 유저의 자리가 남도록
+		// 룸이 그 사이 바뀌었으면 다음 복원에서 새 룸으로 들어가지 않도록 로비 자리만 남김
+		for (auto& [userID, rejoinInfo] : m_RejoinInfoDic) {
+			auto pRoom = m_LobbyList[rejoinInfo.LobbyIndex].GetRoom(rejoinInfo.RoomIndex);
+			auto isSameRoom = pRoom != nullptr && pRoom->IsUsed() && pRoom->GetGeneration() == rejoinInfo.RoomGeneration;
+			image.AddUser(userID.c_str(), rejoinInfo.LobbyIndex, isSameRoom ? rejoinInfo.RoomIndex : -1);
+		}
+	}
+
+	void LobbyManager::RestoreSnapshot(const SnapshotImage& image, const uint32_t graceSec)
+	{
+		for (auto& snapshotRoom : image.RoomList) {
+			auto pLobby = GetLobby(snapshotRoom.LobbyIndex);
+			auto pRoom = pLobby != nullptr ? pLobby->GetRoom(snapshotRoom.RoomIndex) : nullptr;
+			if (pRoom == nullptr || pRoom->IsUsed()) {
+				continue;
+			}
+
+			const int titleLength = (int)std::char_traits<char16_t>::length(snapshotRoom.Title);
+			pRoom->Restore(snapshotRoom.Title, std::min(titleLength, NCommon::MAX_ROOM_TITLE_SIZE), (Room::GAME_STATE)snapshotRoom.GameState);
+		}
+
+		for (auto& snapshotUser : image.UserList) {
+			auto pLobby = GetLobby(snapshotUser.LobbyIndex);
+			if (pLobby == nullptr) {
+				continue;
+			}
+
+			auto pRoom = pLobby->GetRoom(snapshotUser.RoomIndex);
+
+			RejoinInfo rejoinInfo;
+			rejoinInfo.LobbyIndex = snapshotUser.LobbyIndex;
+			rejoinInfo.RoomIndex = snapshotUser.RoomIndex;
+			rejoinInfo.RoomGeneration = pRoom != nullptr ? pRoom->GetGeneration() : 0;
+			m_RejoinInfoDic.emplace(std::string(snapshotUser.szID, strnlen(snapshotUser.szID, NCommon::MAX_USER_ID_SIZE)), rejoinInfo);
+		}
+
+		m_RejoinExpireTime = std::chrono::steady_clock::now() + std::chrono::seconds(graceSec);
+		m_IsRejoinPending = true;
+	}
+
+	bool LobbyManager::PopRejoinInfo(const std::string& userID, RejoinInfo& rejoinInfo)
+	{
+		auto iter = m_RejoinInfoDic.find(userID);
+		if (iter == m_RejoinInfoDic.end()) {
+			return false;
+		}
+
+		rejoinInfo = iter->second;
+		m_RejoinInfoDic.erase(iter);
+		return true;
+	}
+
+	Room* LobbyManager::GetRejoinRoom(const RejoinInfo& rejoinInfo)
+	{
+		auto pLobby = GetLobby(rejoinInfo.LobbyIndex);
+		auto pRoom = pLobby != nullptr ? pLobby->GetRoom(rejoinInfo.RoomIndex) : nullptr;
+		if (pRoom == nullptr || pRoom->GetGeneration() != rejoinInfo.RoomGeneration) {
+			return nullptr;
+		}
+
+		return pRoom;
+	}
+
+	void LobbyManager::CheckRejoinExpire()
+	{
+		if (m_IsRejoinPending == false || std::chrono::steady_clock::now() < m_RejoinExpireTime) {
+			return;
+		}
+
+		m_IsRejoinPending = false;
+		const auto expireUserCount = (int)m_RejoinInfoDic.size();
+		m_RejoinInfoDic.clear();
+
+		int32_t closeRoomCount = 0;
+		for (auto& lobby : m_LobbyList) {
+			closeRoomCount += lobby.CloseEmptyRoom();
+		}
+
+		m_pRefLogger->WriteLog(NServerNetLib::LOG_LEVEL::kL_INFO, "%s | 돌아오기 대기 끝. 돌아오지 않은 유저(%d), 닫은 빈 룸(%d)",
+			__FUNCTION__, expireUserCount, closeRoomCount);
+	}
+}
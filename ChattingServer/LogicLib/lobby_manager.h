@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <chrono>
+
+#include "../ServerNetLib/interface_tcp_network.h"
+#include "../Common/error_code.h"
+#include "lobby.h"
+
+namespace NLogicLib
+{
+	using TcpNet = NServerNetLib::ITcpNetwork;
+	using ILog = NServerNetLib::ILog;
+
+	struct LobbyManagerConfig
+	{
+		int MaxLobbyCount;
+		int MaxLobbyUserCount;
+		int MaxRoomCountByLobby;
+		int MaxRoomUserCount;
+		int ChatHistoryCount;
+		int MaxClientSendBufferSize;
+		// 토픽 비트셋 크기 (네트워크의 ClientSessionPoolSize)
+		int SessionPoolSize;
+	};
+
+	// 스냅샷에서 되살린 유저가 돌아갈 자리
+	struct RejoinInfo
+	{
+		short LobbyIndex = -1;
+		// 로비에만 있었으면 -1
+		short RoomIndex = -1;
+		// 되살린 룸의 세대. 그 사이 룸이 닫히고 같은 자리에 다른 룸이 만들어졌으면 달라짐
+		uint32_t RoomGeneration = 0;
+	};
+
+	class LobbyManager
+	{
+	public:
+		LobbyManager();
+		virtual ~LobbyManager();
+
+		void Init(const LobbyManagerConfig config, TcpNet* pNetwork, ILog* pLogger);
+
+		Lobby* GetLobby(short lobbyId);
+
+		void SendLobbyListInfo(const int sessionIndex);
+
+		// 모든 로비의 상태와 아직 돌아오지 않은 유저의 자리를 image 에 담음 (상태 잠금 SHARED 이상 안에서)
+		void CaptureSnapshot(SnapshotImage& image) const;
+
+		// 스냅샷의 룸을 되살리고 유저가 돌아갈 자리를 graceSec 동안 남겨 둠. 서버를 시작하기 전에 한 번
+		void RestoreSnapshot(const SnapshotImage& image, const uint32_t graceSec);
+
+		// userID 가 돌아갈 자리를 꺼냄 (없으면 false)
+		bool PopRejoinInfo(const std::string& userID, RejoinInfo& rejoinInfo);
+
+		// 돌아갈 룸이 스냅샷에서 되살린 그 룸 그대로면 그 룸, 아니면 nullptr (로비에만 들어가야 함)
+		Room* GetRejoinRoom(const RejoinInfo& rejoinInfo);
+
+		// 기다리는 시간이 지나면 남은 자리를 버리고 아무도 돌아오지 않은 룸을 닫음
+		void CheckRejoinExpire();
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+		TcpNet* m_pRefNetwork = nullptr;
+
+		std::vector<Lobby> m_LobbyList;
+
+		// 토픽 번호: 로비는 [0, 로비 수), 룸은 그 뒤로 로비 순서 * 로비당 룸 수 + 룸 순서
+		TopicHub m_TopicHub;
+
+		std::unordered_map<std::string, RejoinInfo> m_RejoinInfoDic;
+		std::chrono::steady_clock::time_point m_RejoinExpireTime;
+		bool m_IsRejoinPending = false;
+	};
+}
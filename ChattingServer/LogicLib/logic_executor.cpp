@@ -0,0 +1,201 @@
+#include "../ServerNetLib/thread_affinity.h"
+#include "packet_process.h"
+#include "logic_executor.h"
+
+namespace NLogicLib
+{
+	LogicExecutor::LogicExecutor()
+	{
+	}
+
+	LogicExecutor::~LogicExecutor()
+	{
+		Stop();
+	}
+
+	void LogicExecutor::Init(const int workerCount, const int32_t sessionPoolSize, PacketProcess* pPacketProc, const std::vector<int32_t>& workerCpuList)
+	{
+		m_WorkerCount = workerCount > 0 ? workerCount : 0;
+		m_pRefPacketProc = pPacketProc;
+		m_WorkerCpuList = workerCpuList;
+
+		if (m_WorkerCount == 0) {
+			return;
+		}
+
+		m_SessionQueueList.reserve(sessionPoolSize);
+		for (int32_t i = 0; i < sessionPoolSize; ++i) {
+			m_SessionQueueList.push_back(std::make_unique<SessionQueue>());
+		}
+
+		m_WorkerQueueList.reserve(m_WorkerCount);
+		for (int i = 0; i < m_WorkerCount; ++i) {
+			m_WorkerQueueList.push_back(std::make_unique<WorkerQueue>());
+		}
+	}
+
+	void LogicExecutor::Start()
+	{
+		if (m_IsRun) {
+			return;
+		}
+
+		m_IsRun = true;
+		for (int i = 0; i < m_WorkerCount; ++i) {
+			m_WorkerList.emplace_back([this, i]() { WorkerThreadFunc(i); });
+		}
+	}
+
+	void LogicExecutor::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_WaitLock);
+			m_IsRun = false;
+		}
+		m_WaitCV.notify_all();
+
+		for (auto& worker : m_WorkerList) {
+			if (worker.joinable()) {
+				worker.join();
+			}
+		}
+		m_WorkerList.clear();
+	}
+
+	void LogicExecutor::Post(const RecvPacketInfo& packetInfo)
+	{
+		if (m_WorkerCount == 0) {
+			m_pRefPacketProc->Process(packetInfo);
+			return;
+		}
+
+		auto& sessionQueue = *m_SessionQueueList[packetInfo.SessionIndex];
+
+		bool isNewSchedule = false;
+		{
+			std::lock_guard<std::mutex> guard(sessionQueue.Lock);
+			sessionQueue.PacketList.push_back(packetInfo);
+			if (packetInfo.PacketBodySize > 0) {
+				sessionQueue.DataList.insert(sessionQueue.DataList.end(), packetInfo.pRefData, packetInfo.pRefData + packetInfo.PacketBodySize);
+			}
+
+			if (sessionQueue.IsScheduled == false) {
+				sessionQueue.IsScheduled = true;
+				isNewSchedule = true;
+			}
+		}
+
+		// 이미 대기열에 있거나 처리 중이면 그 워커가 이어서 처리
+		if (isNewSchedule) {
+			PushSession(packetInfo.SessionIndex % m_WorkerCount, packetInfo.SessionIndex);
+		}
+	}
+
+	void LogicExecutor::PushSession(const int workerIndex, const int32_t sessionIndex)
+	{
+		{
+			auto& workerQueue = *m_WorkerQueueList[workerIndex];
+			std::lock_guard<std::mutex> guard(workerQueue.Lock);
+			workerQueue.SessionIndexList.push_back(sessionIndex);
+		}
+
+		// 잠든 워커가 개수를 확인한 뒤 기다리기 전에 깨우면 놓치므로 같은 잠금을 거쳐서 알림
+		++m_ReadySessionCount;
+		{
+			std::lock_guard<std::mutex> lock(m_WaitLock);
+		}
+		m_WaitCV.notify_one();
+	}
+
+	bool LogicExecutor::PopSession(const int workerIndex, int32_t& sessionIndex)
+	{
+		{
+			auto& workerQueue = *m_WorkerQueueList[workerIndex];
+			std::lock_guard<std::mutex> guard(workerQueue.Lock);
+			if (workerQueue.SessionIndexList.empty() == false) {
+				sessionIndex = workerQueue.SessionIndexList.front();
+				workerQueue.SessionIndexList.pop_front();
+				--m_ReadySessionCount;
+				return true;
+			}
+		}
+
+		for (int i = 1; i < m_WorkerCount; ++i) {
+			auto& victimQueue = *m_WorkerQueueList[(workerIndex + i) % m_WorkerCount];
+			std::lock_guard<std::mutex> guard(victimQueue.Lock);
+			if (victimQueue.SessionIndexList.empty() == false) {
+				sessionIndex = victimQueue.SessionIndexList.back();
+				victimQueue.SessionIndexList.pop_back();
+				--m_ReadySessionCount;
+				++m_StealCount;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void LogicExecutor::WorkerThreadFunc(const int workerIndex)
+	{
+		if (m_WorkerCpuList.empty() == false) {
+			NServerNetLib::ThreadAffinity::PinCurrentThread(m_WorkerCpuList[workerIndex % m_WorkerCpuList.size()]);
+		}
+
+		// 세션 큐와 교체해서 처리할 목록 (워커마다 재사용)
+		std::vector<RecvPacketInfo> packetList;
+		std::vector<int8_t> dataList;
+
+		while (true) {
+			int32_t sessionIndex = 0;
+			if (PopSession(workerIndex, sessionIndex)) {
+				RunSession(workerIndex, sessionIndex, packetList, dataList);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_WaitLock);
+			// 멈추라고 해도 대기열에 남은 세션은 모두 처리하고 끝냄
+			if (m_IsRun == false && m_ReadySessionCount == 0) {
+				break;
+			}
+
+			m_WaitCV.wait(lock, [this]() { return m_ReadySessionCount > 0 || m_IsRun == false; });
+		}
+	}
+
+	void LogicExecutor::RunSession(const int workerIndex, const int32_t sessionIndex, std::vector<RecvPacketInfo>& packetList, std::vector<int8_t>& dataList)
+	{
+		auto& sessionQueue = *m_SessionQueueList[sessionIndex];
+
+		packetList.clear();
+		dataList.clear();
+		{
+			std::lock_guard<std::mutex> guard(sessionQueue.Lock);
+			sessionQueue.PacketList.swap(packetList);
+			sessionQueue.DataList.swap(dataList);
+		}
+
+		int8_t* pData = dataList.data();
+		for (auto& packetInfo : packetList) {
+			packetInfo.pRefData = packetInfo.PacketBodySize > 0 ? pData : nullptr;
+			pData += packetInfo.PacketBodySize;
+
+			m_pRefPacketProc->Process(packetInfo);
+		}
+
+		// 처리하는 동안 새 패킷이 왔으면 다른 세션이 기다리지 않도록 대기열 뒤로 다시 올림
+		bool isReschedule = false;
+		{
+			std::lock_guard<std::mutex> guard(sessionQueue.Lock);
+			if (sessionQueue.PacketList.empty()) {
+				sessionQueue.IsScheduled = false;
+			}
+			else {
+				isReschedule = true;
+			}
+		}
+
+		if (isReschedule) {
+			PushSession(workerIndex, sessionIndex);
+		}
+	}
+}
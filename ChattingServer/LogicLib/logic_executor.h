@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "../ServerNetLib/define.h"
+
+namespace NLogicLib
+{
+	class PacketProcess;
+
+	using RecvPacketInfo = NServerNetLib::RecvPacketInfo;
+
+	// 받은 패킷을 세션별 직렬 큐에 넣고 여러 워커가 나눠서(work stealing) 처리
+	// - 한 세션의 큐는 실행 대기열에 한 번만 올라가므로 같은 세션의 패킷은 한 번에 한 워커만, 받은 순서대로 처리
+	// - 서로 다른 세션은 모든 워커에서 동시에 처리 (공유 상태는 PacketProcess 의 잠금으로 보호)
+	// - 워커마다 실행 대기열(세션 인덱스)을 두고, 자기 것은 앞에서 꺼내고 비면 다른 워커의 뒤에서 훔쳐옴
+	// 로직 스레드: Post, 워커 스레드: PacketProcess::Process
+	// 워커 수가 0 이면 Post 안에서 바로 처리 (캡처 재생처럼 처리 순서가 항상 같아야 할 때)
+	class LogicExecutor
+	{
+		struct SessionQueue
+		{
+			std::mutex Lock;
+			// 실행 대기열에 올라가 있거나 워커가 처리 중
+			bool IsScheduled = false;
+			// 바디는 도착 순서대로 이어 붙여 두고 꺼낼 때 위치를 계산 (TcpNetwork 의 패킷 큐와 같은 방식)
+			std::vector<RecvPacketInfo> PacketList;
+			std::vector<int8_t> DataList;
+		};
+
+		struct WorkerQueue
+		{
+			std::mutex Lock;
+			std::deque<int32_t> SessionIndexList;
+		};
+
+	public:
+		LogicExecutor();
+		~LogicExecutor();
+
+		// workerCpuList 가 비어 있지 않으면 워커를 목록의 CPU 에 차례로 고정 (워커가 더 많으면 처음부터 다시)
+		void Init(const int workerCount, const int32_t sessionPoolSize, PacketProcess* pPacketProc, const std::vector<int32_t>& workerCpuList = {});
+
+		void Start();
+
+		// 이미 넣은 패킷을 모두 처리한 뒤 워커를 멈춤
+		void Stop();
+
+		// 패킷을 바디까지 복사해서 세션 큐에 넣음 (pRefData 는 다음 GetPacketInfo 교체 전까지만 유효하므로)
+		void Post(const RecvPacketInfo& packetInfo);
+
+		int GetWorkerCount() const { return m_WorkerCount; }
+
+		uint64_t GetStealCount() const { return m_StealCount.load(std::memory_order_relaxed); }
+
+	private:
+		void WorkerThreadFunc(const int workerIndex);
+
+		// 자기 대기열 앞에서 꺼내고, 비어 있으면 다른 워커의 대기열 뒤에서 훔침
+		bool PopSession(const int workerIndex, int32_t& sessionIndex);
+
+		void PushSession(const int workerIndex, const int32_t sessionIndex);
+
+		// 세션 큐에 쌓인 패킷을 한 번에 꺼내서 순서대로 처리
+		void RunSession(const int workerIndex, const int32_t sessionIndex, std::vector<RecvPacketInfo>& packetList, std::vector<int8_t>& dataList);
+
+	private:
+		PacketProcess* m_pRefPacketProc = nullptr;
+
+		int m_WorkerCount = 0;
+		std::vector<int32_t> m_WorkerCpuList;
+		std::vector<std::thread> m_WorkerList;
+		std::atomic<bool> m_IsRun = false;
+
+		std::vector<std::unique_ptr<SessionQueue>> m_SessionQueueList;
+		std::vector<std::unique_ptr<WorkerQueue>> m_WorkerQueueList;
+
+		// 실행 대기열에 올라가 있는 세션 수 (0 이면 워커는 잠듦)
+		std::atomic<int64_t> m_ReadySessionCount = 0;
+		std::mutex m_WaitLock;
+		std::condition_variable m_WaitCV;
+
+		std::atomic<uint64_t> m_StealCount = 0;
+	};
+}
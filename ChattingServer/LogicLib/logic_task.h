@@ -0,0 +1,155 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+namespace NLogicLib
+{
+	// 코루틴 프레임을 크기별 고정 블록으로 재사용하는 풀 (핸들러마다 힙 할당하지 않도록)
+	// 프레임은 로직 워커에서 만들어지고 로직 스레드에서 끝날 수 있으므로 잠금 하나로 보호
+	class CoroutineFramePool
+	{
+		// 블록 앞에 붙여서 반환할 때 크기 등급을 찾음 (프레임 정렬을 지키도록 16 바이트)
+		struct alignas(16) BlockHeader
+		{
+			int32_t SizeClass;
+		};
+
+		struct FreeBlock
+		{
+			FreeBlock* pNext;
+		};
+
+		static constexpr int SIZE_CLASS_COUNT = 6;
+		// 64, 128, ... 2048 바이트. 더 큰 프레임은 풀을 거치지 않음
+		static constexpr size_t MIN_BLOCK_SIZE = 64;
+		static constexpr int32_t LARGE_SIZE_CLASS = -1;
+
+	public:
+		static CoroutineFramePool& Instance()
+		{
+			static CoroutineFramePool s_Pool;
+			return s_Pool;
+		}
+
+		void* Alloc(const size_t frameSize)
+		{
+			const auto sizeClass = GetSizeClass(frameSize + sizeof(BlockHeader));
+
+			BlockHeader* pHeader = nullptr;
+			if (sizeClass == LARGE_SIZE_CLASS) {
+				pHeader = static_cast<BlockHeader*>(::operator new(frameSize + sizeof(BlockHeader)));
+			}
+			else {
+				{
+					std::lock_guard<std::mutex> guard(m_Lock);
+					auto pFree = m_pFreeList[sizeClass];
+					if (pFree != nullptr) {
+						m_pFreeList[sizeClass] = pFree->pNext;
+						--m_FreeCount;
+						pHeader = reinterpret_cast<BlockHeader*>(pFree);
+					}
+				}
+
+				if (pHeader == nullptr) {
+					pHeader = static_cast<BlockHeader*>(::operator new(MIN_BLOCK_SIZE << sizeClass));
+				}
+			}
+
+			pHeader->SizeClass = sizeClass;
+			return pHeader + 1;
+		}
+
+		void Free(void* pFrame)
+		{
+			auto pHeader = static_cast<BlockHeader*>(pFrame) - 1;
+			const auto sizeClass = pHeader->SizeClass;
+			if (sizeClass == LARGE_SIZE_CLASS) {
+				::operator delete(pHeader);
+				return;
+			}
+
+			auto pFree = reinterpret_cast<FreeBlock*>(pHeader);
+			std::lock_guard<std::mutex> guard(m_Lock);
+			pFree->pNext = m_pFreeList[sizeClass];
+			m_pFreeList[sizeClass] = pFree;
+			++m_FreeCount;
+		}
+
+		// 재사용을 기다리는 블록 수
+		int64_t GetFreeCount()
+		{
+			std::lock_guard<std::mutex> guard(m_Lock);
+			return m_FreeCount;
+		}
+
+	private:
+		CoroutineFramePool() = default;
+
+		~CoroutineFramePool()
+		{
+			for (auto& pFree : m_pFreeList) {
+				while (pFree != nullptr) {
+					auto pNext = pFree->pNext;
+					::operator delete(pFree);
+					pFree = pNext;
+				}
+			}
+		}
+
+		static int32_t GetSizeClass(const size_t blockSize)
+		{
+			size_t classSize = MIN_BLOCK_SIZE;
+			for (int32_t i = 0; i < SIZE_CLASS_COUNT; ++i, classSize <<= 1) {
+				if (blockSize <= classSize) {
+					return i;
+				}
+			}
+			return LARGE_SIZE_CLASS;
+		}
+
+	private:
+		std::mutex m_Lock;
+		FreeBlock* m_pFreeList[SIZE_CLASS_COUNT] = { nullptr, };
+		int64_t m_FreeCount = 0;
+	};
+
+	// 여러 단계를 기다리는 패킷 처리(로그인 검증, 룸 입장 뒤 송신 등)를 콜백 대신 코루틴으로 작성하기 위한 반환 타입
+	// - 호출하면 첫 co_await 까지 바로 실행되고, 호출한 쪽은 결과를 기다리지 않음 (fire and forget)
+	// - 기다리는 것은 LoginWorkerPool::Verify, CoroutineScheduler::Sleep/WaitSendDrain 의 awaitable 로
+	// - 깨어난 뒤에는 로직 스레드가 CoroutineScheduler::Run 에서 이어서 실행하므로, 기다린 사이 세션이 끊기거나
+	//   재사용되었을 수 있음. 깨어나면 세션/유저 상태를 다시 확인할 것
+	// - 프레임은 CoroutineFramePool 에서 받고 코루틴이 끝나면 바로 돌려줌
+	class LogicTask
+	{
+	public:
+		struct promise_type
+		{
+			static void* operator new(const size_t frameSize)
+			{
+				return CoroutineFramePool::Instance().Alloc(frameSize);
+			}
+
+			static void operator delete(void* pFrame)
+			{
+				CoroutineFramePool::Instance().Free(pFrame);
+			}
+
+			LogicTask get_return_object() { return LogicTask(); }
+
+			std::suspend_never initial_suspend() noexcept { return {}; }
+
+			// 끝나면 프레임을 바로 해제
+			std::suspend_never final_suspend() noexcept { return {}; }
+
+			void return_void() {}
+
+			// 서버 코드는 예외를 쓰지 않으므로 올라오면 바로 종료
+			void unhandled_exception() { std::terminate(); }
+		};
+	};
+}
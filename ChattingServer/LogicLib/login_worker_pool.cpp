@@ -0,0 +1,118 @@
+#include <cstring>
+
+#include "credential_store.h"
+#include "coroutine_scheduler.h"
+#include "login_worker_pool.h"
+
+namespace NLogicLib
+{
+	LoginWorkerPool::LoginWorkerPool()
+	{
+	}
+
+	LoginWorkerPool::~LoginWorkerPool()
+	{
+		Stop();
+	}
+
+	void LoginWorkerPool::Init(const int workerCount, const CredentialStore* pCredentialStore, CoroutineScheduler* pScheduler)
+	{
+		m_WorkerCount = workerCount > 0 ? workerCount : 0;
+		m_pRefCredentialStore = pCredentialStore;
+		m_pRefScheduler = pScheduler;
+	}
+
+	void LoginWorkerPool::Start()
+	{
+		if (m_IsRun) {
+			return;
+		}
+
+		m_IsRun = true;
+		for (int i = 0; i < m_WorkerCount; ++i) {
+			m_WorkerList.emplace_back([this]() { WorkerThreadFunc(); });
+		}
+	}
+
+	void LoginWorkerPool::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_JobLock);
+			m_IsRun = false;
+		}
+		m_JobCV.notify_all();
+
+		for (auto& worker : m_WorkerList) {
+			if (worker.joinable()) {
+				worker.join();
+			}
+		}
+		m_WorkerList.clear();
+	}
+
+	bool LoginWorkerPool::PostJob(const LoginJob& job)
+	{
+		if (m_WorkerCount == 0) {
+			LoginJob inlineJob = job;
+			ProcessJob(inlineJob, false);
+			return false;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_JobLock);
+			m_JobQueue.push_back(job);
+		}
+		m_JobCV.notify_one();
+		return true;
+	}
+
+	void LoginWorkerPool::RunPendingJob()
+	{
+		std::deque<LoginJob> jobQueue;
+		{
+			std::lock_guard<std::mutex> lock(m_JobLock);
+			jobQueue.swap(m_JobQueue);
+		}
+
+		for (auto& job : jobQueue) {
+			ProcessJob(job, true);
+		}
+	}
+
+	void LoginWorkerPool::WorkerThreadFunc()
+	{
+		while (true) {
+			LoginJob job;
+			{
+				std::unique_lock<std::mutex> lock(m_JobLock);
+				m_JobCV.wait(lock, [this]() { return m_IsRun == false || m_JobQueue.empty() == false; });
+
+				if (m_IsRun == false) {
+					return;
+				}
+
+				job = m_JobQueue.front();
+				m_JobQueue.pop_front();
+			}
+
+			ProcessJob(job, true);
+		}
+	}
+
+	void LoginWorkerPool::ProcessJob(LoginJob& job, const bool isResume)
+	{
+		auto& result = *job.pResult;
+		result.SessionIndex = job.SessionIndex;
+		result.LoginSeq = job.LoginSeq;
+		result.Result = m_pRefCredentialStore->Verify(job.szID, job.szPW);
+		memcpy(result.szID, job.szID, sizeof(result.szID));
+
+		// 비밀번호는 검증이 끝나면 바로 지움
+		memset(job.szPW, 0, sizeof(job.szPW));
+
+		// 결과는 코루틴 프레임 안의 awaiter 에 있으므로 스케줄러에 넘긴 뒤로는 건드리지 않음
+		if (isResume) {
+			m_pRefScheduler->Resume(job.Waiter);
+		}
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <coroutine>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "../Common/Packet.h"
+#include "../Common/error_code.h"
+
+namespace NLogicLib
+{
+	class CredentialStore;
+	class CoroutineScheduler;
+
+	using ERROR_CODE = NCommon::ERROR_CODE;
+
+	struct LoginResult
+	{
+		int SessionIndex = 0;
+		int64_t LoginSeq = 0;
+		ERROR_CODE Result = ERROR_CODE::NONE;
+		char szID[NCommon::MAX_USER_ID_SIZE + 1] = { 0, };
+	};
+
+	struct LoginJob
+	{
+		int SessionIndex = 0;
+		// 검증하는 동안 세션이 끊기고 재사용되었는지 구분하는 값
+		int64_t LoginSeq = 0;
+		char szID[NCommon::MAX_USER_ID_SIZE + 1] = { 0, };
+		char szPW[NCommon::MAX_USER_PASSWORD_SIZE + 1] = { 0, };
+
+		// 결과를 써 둘 곳과 결과를 기다리는 코루틴
+		LoginResult* pResult = nullptr;
+		std::coroutine_handle<> Waiter;
+	};
+
+	// 느린 ID/PW 검증을 로직 스레드 밖에서 처리하고 결과를 기다리던 코루틴을 로직 스레드에서 이어서 실행
+	// 로직 스레드/워커: co_await Verify(job)
+	// 워커 스레드: 검증 후 결과를 써 두고 CoroutineScheduler::Resume
+	// 워커 수가 0 이면 co_await 안에서 바로 검증하고 멈추지 않고 이어감 (캡처 재생처럼 처리 순서가 항상 같아야 할 때)
+	class LoginWorkerPool
+	{
+	public:
+		class VerifyAwaiter
+		{
+		public:
+			VerifyAwaiter(LoginWorkerPool* pPool, const LoginJob& job) : m_pRefPool(pPool), m_Job(job) {}
+
+			bool await_ready() const { return false; }
+
+			// 워커에게 넘겼으면 true (멈춤), 바로 검증했으면 false (이어서 실행)
+			bool await_suspend(std::coroutine_handle<> handle)
+			{
+				m_Job.pResult = &m_Result;
+				m_Job.Waiter = handle;
+				return m_pRefPool->PostJob(m_Job);
+			}
+
+			LoginResult await_resume()
+			{
+				// 워커에게 넘긴 복사본과 따로 코루틴 프레임에 남은 비밀번호도 지움
+				memset(m_Job.szPW, 0, sizeof(m_Job.szPW));
+				return m_Result;
+			}
+
+		private:
+			LoginWorkerPool* m_pRefPool;
+			LoginJob m_Job;
+			LoginResult m_Result;
+		};
+
+	public:
+		LoginWorkerPool();
+		~LoginWorkerPool();
+
+		void Init(const int workerCount, const CredentialStore* pCredentialStore, CoroutineScheduler* pScheduler);
+
+		void Start();
+		void Stop();
+
+		// co_await 하면 검증 결과(LoginResult)를 돌려줌. 비밀번호는 검증이 끝나면 지움
+		VerifyAwaiter Verify(const LoginJob& job) { return VerifyAwaiter(this, job); }
+
+		// Stop 뒤에 큐에 남은 요청을 호출한 스레드에서 모두 검증 (무중단 재시작 전에 결과를 빠짐없이 보내기 위함)
+		void RunPendingJob();
+
+	private:
+		// 워커에게 넘겼으면 true, 워커가 없어서 바로 검증했으면 false
+		bool PostJob(const LoginJob& job);
+
+		void WorkerThreadFunc();
+
+		// 결과를 써 두고, 기다리는 코루틴이 멈춰 있으면(isResume) 스케줄러에 넘김
+		void ProcessJob(LoginJob& job, const bool isResume);
+
+	private:
+		const CredentialStore* m_pRefCredentialStore = nullptr;
+		CoroutineScheduler* m_pRefScheduler = nullptr;
+
+		int m_WorkerCount = 0;
+		std::vector<std::thread> m_WorkerList;
+		std::atomic<bool> m_IsRun = false;
+
+		std::mutex m_JobLock;
+		std::condition_variable m_JobCV;
+		std::deque<LoginJob> m_JobQueue;
+	};
+}
@@ -0,0 +1,735 @@
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+
+#include "../ServerNetLib/tcp_network.h"
+#include "../ServerNetLib/replay_network.h"
+#include "../ServerNetLib/loopback_network.h"
+#include "../ServerNetLib/udp_network.h"
+#include "../ServerNetLib/idle_strategy.h"
+#include "../ServerNetLib/metrics_exporter.h"
+#include "../ServerNetLib/shm_network.h"
+#include "../ServerNetLib/shm_gateway.h"
+#include "../ServerNetLib/cluster_network.h"
+#include "../ServerNetLib/thread_affinity.h"
+#include "console_logger.h"
+#include "async_logger.h"
+#include "ini_reader.h"
+#include "user_manager.h"
+#include "lobby_manager.h"
+#include "credential_store.h"
+#include "user_store.h"
+#include "chat_filter.h"
+#include "state_snapshot.h"
+#include "login_worker_pool.h"
+#include "coroutine_scheduler.h"
+#include "packet_process.h"
+#include "logic_executor.h"
+#include "main.h"
+
+namespace NLogicLib
+{
+	using LOG_LEVEL = NServerNetLib::LOG_LEVEL;
+	using NET_ERROR_CODE = NServerNetLib::NET_ERROR_CODE;
+	using IDLE_STRATEGY = NServerNetLib::IDLE_STRATEGY;
+
+	Main::Main()
+	{
+	}
+
+	Main::~Main()
+	{
+		Stop();
+		Release();
+	}
+
+	ERROR_CODE Main::Init(const char* pszConfigFileName, const bool isHandoffReceive, const bool isShmGateway)
+	{
+		m_pLogger = std::make_unique<ConsoleLog>();
+
+		auto loadResult = LoadConfig(pszConfigFileName);
+		if (loadResult != ERROR_CODE::NONE) {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 설정 파일(%s) 읽기 실패", __FUNCTION__, pszConfigFileName);
+			return loadResult;
+		}
+
+		if (m_pServerConfig->IsAsyncLog) {
+			auto pAsyncLog = std::make_unique<AsyncLog>(m_pServerConfig->LogFileName, m_pServerConfig->LogRingSize, (LOG_FULL_POLICY)m_pServerConfig->LogFullPolicy,
+				m_pServerConfig->LoggerThreadCpu);
+			if (pAsyncLog->IsOpened() == false) {
+				m_pLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 로그 파일(%s) 열기 실패", __FUNCTION__, m_pServerConfig->LogFileName);
+				return ERROR_CODE::MAIN_INIT_LOG_FILE_OPEN_FAIL;
+			}
+			m_pLogger = std::move(pAsyncLog);
+		}
+		m_pLogger->SetLevel((LOG_LEVEL)m_pServerConfig->LogMinLevel);
+		m_pServerConfig->IsHandoffReceive = isHandoffReceive;
+
+		ReportThreadTopology();
+
+		if (isShmGateway && m_pServerConfig->ShmFileName[0] == '\0') {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 게이트웨이로 시작하려면 ShmFileName 이 필요", __FUNCTION__);
+			return ERROR_CODE::MAIN_INIT_SHM_GATEWAY_INIT_FAIL;
+		}
+
+		// 루프백 스크립트가 있으면 소켓 대신 스크립트로 만든 패킷을 메모리 안에서 받음
+		if (m_pServerConfig->LoopbackScriptFileName[0] != '\0') {
+			auto pLoopbackNetwork = std::make_unique<NServerNetLib::LoopbackNetwork>();
+			m_pRefLoopbackNetwork = pLoopbackNetwork.get();
+			m_pNetwork = std::move(pLoopbackNetwork);
+		}
+		// 재생 파일이 있으면 소켓 대신 캡처 파일에서 패킷을 받음
+		else if (IsReplay()) {
+			m_pNetwork = std::make_unique<NServerNetLib::ReplayNetwork>();
+		}
+		// 공유 메모리 파일이 있으면 로직 프로세스는 소켓 대신 게이트웨이에게서 패킷을 받음
+		else if (isShmGateway == false && m_pServerConfig->ShmFileName[0] != '\0') {
+			m_pNetwork = std::make_unique<NServerNetLib::ShmNetwork>();
+		}
+		else {
+			m_pNetwork = std::make_unique<NServerNetLib::TcpNetwork>();
+		}
+		auto netResult = NET_ERROR_CODE::kNONE;
+		{
+			// 세션 버퍼를 네트워크 스레드가 돌 CPU 의 노드에 잡도록 그 CPU 에서 만듦
+			NServerNetLib::ScopedThreadAffinity networkAffinity(m_pServerConfig->NetworkThreadCpu);
+			netResult = m_pNetwork->Init(m_pServerConfig.get(), m_pLogger.get());
+		}
+		if (netResult != NET_ERROR_CODE::kNONE) {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 네트워크 초기화 실패. NetErrorCode(%d)", __FUNCTION__, (int)netResult);
+			return ERROR_CODE::MAIN_INIT_NETWORK_INIT_FAIL;
+		}
+
+		if (isShmGateway) {
+			m_pShmGateway = std::make_unique<NServerNetLib::ShmGateway>();
+			auto gatewayResult = m_pShmGateway->Init(m_pServerConfig.get(), m_pNetwork.get(), m_pLogger.get());
+			if (gatewayResult != NET_ERROR_CODE::kNONE) {
+				m_pLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 게이트웨이 초기화 실패. NetErrorCode(%d)", __FUNCTION__, (int)gatewayResult);
+				return ERROR_CODE::MAIN_INIT_SHM_GATEWAY_INIT_FAIL;
+			}
+
+			m_pLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 게이트웨이 초기화 성공. IdleStrategy(%d)", __FUNCTION__, (int)m_pServerConfig->IdleStrategy);
+			return ERROR_CODE::NONE;
+		}
+
+		// 노드 목록이 있으면 클라이언트 네트워크 위에 노드 사이 링크를 더함 (소켓을 직접 가진 프로세스만)
+		if (m_pServerConfig->ClusterNodeList[0] != '\0' && IsReplay() == false && m_pServerConfig->ShmFileName[0] == '\0') {
+			auto pClusterNetwork = std::make_unique<NServerNetLib::ClusterNetwork>(std::move(m_pNetwork));
+			m_pRefClusterNetwork = pClusterNetwork.get();
+			m_pNetwork = std::move(pClusterNetwork);
+
+			auto clusterResult = m_pNetwork->Init(m_pServerConfig.get(), m_pLogger.get());
+			if (clusterResult != NET_ERROR_CODE::kNONE) {
+				m_pLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 클러스터 초기화 실패. NetErrorCode(%d)", __FUNCTION__, (int)clusterResult);
+				return ERROR_CODE::MAIN_INIT_CLUSTER_INIT_FAIL;
+			}
+		}
+
+		if (m_pServerConfig->UdpPort != 0 && IsReplay() == false) {
+			m_pUdpNetwork = std::make_unique<NServerNetLib::UdpNetwork>();
+			auto udpResult = m_pUdpNetwork->Init(m_pServerConfig.get(), m_pNetwork->ClientSessionPoolSize(), m_pNetwork.get(), m_pLogger.get());
+			if (udpResult != NET_ERROR_CODE::kNONE) {
+				m_pLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | UDP 초기화 실패. NetErrorCode(%d)", __FUNCTION__, (int)udpResult);
+				return ERROR_CODE::MAIN_INIT_UDP_INIT_FAIL;
+			}
+		}
+
+		m_pMetricsExporter = std::make_unique<NServerNetLib::MetricsExporter>();
+		auto metricsResult = m_pMetricsExporter->Init(m_pServerConfig->MetricsAdminPort, m_pServerConfig->MetricsDumpIntervalSec,
+			m_pServerConfig->MetricsDumpFileName, m_pLogger.get());
+		if (metricsResult != NET_ERROR_CODE::kNONE) {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 수치 내보내기 초기화 실패. NetErrorCode(%d)", __FUNCTION__, (int)metricsResult);
+			return ERROR_CODE::MAIN_INIT_METRICS_INIT_FAIL;
+		}
+
+		// 유저/로비/룸 상태와 로직 워커 큐는 로직 스레드가 돌 CPU 의 노드에 잡도록 그 CPU 에서 만듦 (Init 이 끝나면 되돌림)
+		auto pLogicAffinity = std::make_unique<NServerNetLib::ScopedThreadAffinity>(m_pServerConfig->LogicThreadCpu);
+
+		m_pUserMgr = std::make_unique<UserManager>();
+		m_pUserMgr->Init(m_pServerConfig->MaxClientCount);
+
+		LobbyManagerConfig lobbyConfig;
+		lobbyConfig.MaxLobbyCount = m_pServerConfig->MaxLobbyCount;
+		lobbyConfig.MaxLobbyUserCount = m_pServerConfig->MaxLobbyUserCount;
+		lobbyConfig.MaxRoomCountByLobby = m_pServerConfig->MaxRoomCountByLobby;
+		lobbyConfig.MaxRoomUserCount = m_pServerConfig->MaxRoomUserCount;
+		lobbyConfig.ChatHistoryCount = m_pServerConfig->ChatHistoryCount;
+		lobbyConfig.MaxClientSendBufferSize = m_pServerConfig->MaxClientSendBufferSize;
+		lobbyConfig.SessionPoolSize = m_pNetwork->ClientSessionPoolSize();
+		m_pLobbyMgr = std::make_unique<LobbyManager>();
+		m_pLobbyMgr->Init(lobbyConfig, m_pNetwork.get(), m_pLogger.get());
+
+		m_pStateSnapshot = std::make_unique<StateSnapshot>();
+		// 재생할 때는 기록할 때와 같은 결과가 되도록 빈 로비에서 시작하고 남기지도 않음
+		m_pStateSnapshot->Init(IsReplay() ? "" : m_pServerConfig->SnapshotFileName, m_pLogger.get());
+		RestoreSnapshot();
+
+		m_pUserStore = std::make_unique<UserStore>();
+		// 재생할 때는 저장된 유저 레코드를 바꾸지 않도록 열지 않음
+		auto pszUserStoreFileName = IsReplay() ? "" : m_pServerConfig->UserStoreFileName;
+		if (m_pUserStore->Open(pszUserStoreFileName, m_pServerConfig->MaxUserStoreRecordCount, m_pServerConfig->UserStoreGroupCommitMilliSec, m_pLogger.get()) == false) {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 유저 저장 파일(%s) 열기 실패", __FUNCTION__, pszUserStoreFileName);
+			return ERROR_CODE::MAIN_INIT_USER_STORE_OPEN_FAIL;
+		}
+
+		m_pCredentialStore = std::make_unique<CredentialStore>();
+		// 캡처 파일에는 비밀번호가 지워져 있으므로 캡처를 재생할 때는 검증하지 않음
+		auto pszCredentialFileName = m_pServerConfig->ReplayFileName[0] != '\0' ? "" : m_pServerConfig->CredentialFileName;
+		if (m_pCredentialStore->Load(pszCredentialFileName, m_pUserStore.get()) == false) {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 계정 파일(%s) 읽기 실패", __FUNCTION__, pszCredentialFileName);
+			return ERROR_CODE::MAIN_INIT_CREDENTIAL_LOAD_FAIL;
+		}
+
+		if (m_pCredentialStore->IsEnabled() == false) {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 계정 파일이 설정되지 않아 비밀번호를 검증하지 않음", __FUNCTION__);
+		}
+
+		m_pChatFilter = std::make_unique<ChatFilter>();
+		// 재생할 때는 기록할 때와 같은 결과가 되도록 시작할 때 한 번만 읽음
+		auto chatFilterReloadSec = IsReplay() ? 0 : m_pServerConfig->ChatFilterReloadSec;
+		if (m_pChatFilter->Init(m_pServerConfig->ChatFilterFileName, chatFilterReloadSec, m_pLogger.get()) == false) {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 금칙어 파일(%s) 읽기 실패", __FUNCTION__, m_pServerConfig->ChatFilterFileName);
+			return ERROR_CODE::MAIN_INIT_CHAT_FILTER_LOAD_FAIL;
+		}
+
+		m_pCoroutineScheduler = std::make_unique<CoroutineScheduler>();
+		m_pCoroutineScheduler->Init(m_pNetwork->ClientSessionPoolSize(), m_pNetwork.get());
+
+		m_pLoginWorkerPool = std::make_unique<LoginWorkerPool>();
+		// 재생할 때는 로그인 결과가 항상 같은 순서로 처리되도록 로직 스레드에서 바로 검증
+		auto loginWorkerCount = IsReplay() ? 0 : m_pServerConfig->LoginWorkerCount;
+		m_pLoginWorkerPool->Init(loginWorkerCount, m_pCredentialStore.get(), m_pCoroutineScheduler.get());
+
+		m_pPacketProc = std::make_unique<PacketProcess>();
+		m_pPacketProc->Init(m_pNetwork.get(), m_pUdpNetwork.get(), m_pRefClusterNetwork, m_pUserMgr.get(), m_pLobbyMgr.get(), m_pLoginWorkerPool.get(),
+			m_pCoroutineScheduler.get(), m_pChatFilter.get(), m_pUserStore.get(), IsReplay(), m_pServerConfig.get(), m_pLogger.get());
+
+		m_pLogicExecutor = std::make_unique<LogicExecutor>();
+		// 재생할 때는 항상 같은 순서가 되도록 로직 스레드에서 바로 처리
+		auto logicWorkerCount = IsReplay() ? 0 : m_pServerConfig->LogicWorkerCount;
+		m_pLogicExecutor->Init(logicWorkerCount, m_pNetwork->ClientSessionPoolSize(), m_pPacketProc.get(),
+			NServerNetLib::ThreadAffinity::ParseCpuList(m_pServerConfig->LogicWorkerCpuList));
+
+		for (auto& sessionInfo : m_pNetwork->GetHandoffSessionList()) {
+			m_pPacketProc->RestoreHandoffSession(sessionInfo);
+		}
+
+		pLogicAffinity.reset();
+
+		m_pLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 초기화 성공. IdleStrategy(%d), LogicTick(%dms), LogicWorker(%d)", __FUNCTION__,
+			(int)m_pServerConfig->IdleStrategy, m_pServerConfig->LogicTickMilliSec, m_pLogicExecutor->GetWorkerCount());
+		return ERROR_CODE::NONE;
+	}
+
+	void Main::Start()
+	{
+		if (m_IsRun) {
+			return;
+		}
+
+		m_IsRun = true;
+		if (m_pShmGateway) {
+			m_NetworkThread = std::thread([this]() { NetworkThreadFunc(); });
+			m_GatewayThread = std::thread([this]() { GatewayThreadFunc(); });
+			return;
+		}
+
+		m_pUserStore->Start();
+		m_pStateSnapshot->Start();
+		m_pLoginWorkerPool->Start();
+		m_pLogicExecutor->Start();
+		m_pMetricsExporter->Start();
+		m_pChatFilter->Start();
+		m_NetworkThread = std::thread([this]() { NetworkThreadFunc(); });
+		m_LogicThread = std::thread([this]() { LogicThreadFunc(); });
+		if (m_pUdpNetwork) {
+			m_UdpThread = std::thread([this]() { UdpThreadFunc(); });
+		}
+	}
+
+	void Main::Stop()
+	{
+		m_IsRun = false;
+
+		if (m_NetworkThread.joinable()) {
+			m_NetworkThread.join();
+		}
+
+		if (m_LogicThread.joinable()) {
+			m_LogicThread.join();
+		}
+
+		if (m_UdpThread.joinable()) {
+			m_UdpThread.join();
+		}
+
+		if (m_GatewayThread.joinable()) {
+			m_GatewayThread.join();
+		}
+
+		// 로직 스레드가 넘긴 패킷을 모두 처리한 뒤 멈춤
+		if (m_pLogicExecutor) {
+			m_pLogicExecutor->Stop();
+		}
+
+		if (m_pLoginWorkerPool) {
+			m_pLoginWorkerPool->Stop();
+		}
+
+		// 로직 스레드가 멈춘 뒤에 남은 변경까지 내림
+		if (m_pUserStore) {
+			m_pUserStore->Stop();
+		}
+
+		// 모든 처리가 끝난 마지막 상태를 남김
+		if (m_pStateSnapshot) {
+			m_pStateSnapshot->Stop();
+			SaveSnapshot();
+		}
+
+		if (m_pMetricsExporter) {
+			m_pMetricsExporter->Stop();
+		}
+
+		if (m_pChatFilter) {
+			m_pChatFilter->Stop();
+		}
+	}
+
+	bool Main::Handoff()
+	{
+		// 게이트웨이의 세션은 로직 프로세스들과 공유 메모리로 묶여 있어 넘길 수 없음 (로직 프로세스는 그냥 다시 시작하면 됨)
+		if (m_pShmGateway || m_pServerConfig->ShmFileName[0] != '\0') {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 공유 메모리 게이트웨이/로직 프로세스는 넘기기를 지원하지 않음", __FUNCTION__);
+			return false;
+		}
+
+		Stop();
+
+		// 네트워크 스레드가 마지막으로 받은 패킷과 끝나지 않은 로그인 검증, 기다리던 코루틴까지 처리해서 응답을 송신 버퍼에 남김
+		while (true) {
+			auto packetInfo = m_pNetwork->GetPacketInfo();
+			if (packetInfo.PacketId == 0) {
+				break;
+			}
+			m_pPacketProc->Process(packetInfo);
+		}
+		m_pLoginWorkerPool->RunPendingJob();
+		m_pPacketProc->ResumeCoroutine(true);
+
+		// 새 프로세스가 같은 저장 파일을 열기 전에 마지막 변경까지 내림
+		m_pUserStore->Flush();
+		// 넘겨받은 세션의 유저는 로그인 상태로 되살아나므로 LOBBY_REJOIN_REQ 로 원래 자리에 돌아감
+		SaveSnapshot();
+
+		std::vector<NServerNetLib::HandoffSessionInfo> userTagList;
+		m_pPacketProc->GetHandoffUserList(userTagList);
+
+		auto handoffResult = m_pNetwork->HandoffSend(userTagList);
+		if (handoffResult != NET_ERROR_CODE::kNONE) {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 넘기기 실패, 계속 서비스. NetErrorCode(%d)", __FUNCTION__, (int)handoffResult);
+			Start();
+			return false;
+		}
+
+		// 이제 로비/룸 상태는 새 프로세스의 것이므로 종료할 때 스냅샷을 덮어쓰지 않음
+		m_pStateSnapshot->Init("", m_pLogger.get());
+		return true;
+	}
+
+	void Main::Release()
+	{
+		if (m_pShmGateway) {
+			m_pShmGateway->Release();
+		}
+
+		if (m_pUdpNetwork) {
+			m_pUdpNetwork->Release();
+		}
+
+		if (m_pNetwork) {
+			m_pNetwork->Release();
+		}
+	}
+
+	void Main::ReportThreadTopology()
+	{
+		using namespace NServerNetLib::ThreadAffinity;
+
+		const auto cpuCount = GetCpuCount();
+		m_pLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | CPU(%d), NUMA 노드 %s", __FUNCTION__, cpuCount, DescribeTopology().c_str());
+
+		const char* pszFunctionName = __FUNCTION__;
+		auto describeCpu = [&](const char* pszThreadName, const int32_t cpu) {
+			if (cpu < 0) {
+				return std::string(pszThreadName) + "(고정 안 함)";
+			}
+
+			if (cpu >= cpuCount) {
+				m_pLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | %s 스레드의 CPU(%d) 가 없음 (CPU 수 %d)", pszFunctionName, pszThreadName, cpu, cpuCount);
+			}
+			return std::string(pszThreadName) + "(cpu" + std::to_string(cpu) + "/node" + std::to_string(GetCpuNode(cpu)) + ")";
+		};
+
+		const auto& config = *m_pServerConfig;
+		std::string text = describeCpu("네트워크", config.NetworkThreadCpu) + " " + describeCpu("로직", config.LogicThreadCpu) + " " + describeCpu("로거", config.LoggerThreadCpu);
+
+		const auto workerCpuList = ParseCpuList(config.LogicWorkerCpuList);
+		for (size_t i = 0; i < workerCpuList.size() && i < config.LogicWorkerCount; ++i) {
+			text += " " + describeCpu(("워커" + std::to_string(i)).c_str(), workerCpuList[i]);
+		}
+		m_pLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 스레드 배치 %s", __FUNCTION__, text.c_str());
+
+		// 네트워크 스레드가 채운 수신 버퍼를 로직 스레드가 읽으므로 노드가 다르면 패킷마다 노드 사이 메모리 접근이 생김
+		if (config.NetworkThreadCpu >= 0 && config.LogicThreadCpu >= 0 && GetCpuNode(config.NetworkThreadCpu) != GetCpuNode(config.LogicThreadCpu)) {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 네트워크 스레드와 로직 스레드의 NUMA 노드가 다름", __FUNCTION__);
+		}
+	}
+
+	void Main::NetworkThreadFunc()
+	{
+		if (NServerNetLib::ThreadAffinity::PinCurrentThread(m_pServerConfig->NetworkThreadCpu) == false) {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 네트워크 스레드를 CPU(%d)에 고정하지 못함", __FUNCTION__, m_pServerConfig->NetworkThreadCpu);
+		}
+
+		NServerNetLib::IdleStrategy idleStrategy;
+		idleStrategy.Init(m_pServerConfig->IdleStrategy, m_pServerConfig->IdleSpinCount);
+
+		while (m_IsRun) {
+			// kBLOCK 이면 Run 안의 select 가 직접 블록
+			bool isWorked = m_pNetwork->Run();
+			idleStrategy.Idle(isWorked);
+		}
+	}
+
+	void Main::UdpThreadFunc()
+	{
+		// 데이터그램이 오면 바로 깨어나므로 블록 시간은 종료 확인 간격일 뿐
+		const auto waitMilliSec = std::max<int32_t>(1, m_pServerConfig->IdleBlockMicroSec / 1000);
+
+		while (m_IsRun) {
+			m_pUdpNetwork->Run(waitMilliSec);
+		}
+	}
+
+	void Main::GatewayThreadFunc()
+	{
+		NServerNetLib::IdleStrategy idleStrategy;
+		idleStrategy.Init(m_pServerConfig->IdleStrategy, m_pServerConfig->IdleSpinCount);
+
+		// 로직 프로세스의 송신 요청은 깨우는 수단이 없으므로 kBLOCK 이어도 짧게만 블록
+		const auto waitMicroSec = std::min<uint32_t>(m_pServerConfig->IdleBlockMicroSec, 100);
+
+		while (m_IsRun) {
+			bool isWorked = m_pShmGateway->Run();
+			if (isWorked || idleStrategy.GetStrategy() != IDLE_STRATEGY::kBLOCK) {
+				idleStrategy.Idle(isWorked);
+				continue;
+			}
+
+			m_pNetwork->WaitPacketInfo(waitMicroSec);
+		}
+	}
+
+	void Main::RestoreSnapshot()
+	{
+		SnapshotImage image;
+		int64_t saveTime = 0;
+		if (m_pStateSnapshot->Load(image, saveTime) == false) {
+			return;
+		}
+
+		const auto ageSec = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count() - saveTime;
+		if (ageSec > (int64_t)m_pServerConfig->SnapshotRejoinGraceSec) {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 스냅샷이 오래되어 복원하지 않음. 저장 후 지난 시간(%llds)", __FUNCTION__, (long long)ageSec);
+			return;
+		}
+
+		m_pLobbyMgr->RestoreSnapshot(image, m_pServerConfig->SnapshotRejoinGraceSec);
+		m_pLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 스냅샷 복원. 룸(%d), 유저(%d), 저장 후 지난 시간(%llds)", __FUNCTION__,
+			(int)image.RoomList.size(), (int)image.UserList.size(), (long long)ageSec);
+	}
+
+	void Main::SaveSnapshot()
+	{
+		if (m_pStateSnapshot == nullptr || m_pPacketProc == nullptr) {
+			return;
+		}
+
+		// 이전 스냅샷을 아직 쓰는 중이면 이번은 건너뜀
+		auto pImage = m_pStateSnapshot->BeginCapture();
+		if (pImage == nullptr) {
+			return;
+		}
+
+		m_pPacketProc->CaptureSnapshot(*pImage);
+		m_pStateSnapshot->EndCapture();
+	}
+
+	void Main::LogicThreadFunc()
+	{
+		if (NServerNetLib::ThreadAffinity::PinCurrentThread(m_pServerConfig->LogicThreadCpu) == false) {
+			m_pLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 로직 스레드를 CPU(%d)에 고정하지 못함", __FUNCTION__, m_pServerConfig->LogicThreadCpu);
+		}
+
+		NServerNetLib::IdleStrategy idleStrategy;
+		idleStrategy.Init(m_pServerConfig->IdleStrategy, m_pServerConfig->IdleSpinCount);
+
+		const bool isReplay = IsReplay();
+
+		// tick 도 로직 시계를 따라가야 재생할 때 로그인 대기 등의 검사가 기록할 때와 같은 패킷 사이에서 일어남
+		const auto tickInterval = std::chrono::milliseconds(m_pServerConfig->LogicTickMilliSec);
+		auto nextTickTime = m_pNetwork->GetLogicTime() + tickInterval;
+
+		const auto snapshotInterval = std::chrono::seconds(m_pServerConfig->SnapshotIntervalSec);
+		auto nextSnapshotTime = m_pNetwork->GetLogicTime() + snapshotInterval;
+
+		while (m_IsRun) {
+			bool isWorked = false;
+
+			// 쌓여 있는 패킷을 모두 처리
+			while (true) {
+				auto packetInfo = m_pNetwork->GetPacketInfo();
+				if (packetInfo.PacketId == 0) {
+					break;
+				}
+
+				m_pLogicExecutor->Post(packetInfo);
+				isWorked = true;
+
+				// 재생 중에는 다음 패킷보다 먼저 깨어난 코루틴(송신 버퍼 비움 대기 등)을 반영
+				if (isReplay) {
+					m_pPacketProc->ResumeCoroutine();
+				}
+			}
+
+			// 루프백 스크립트의 패킷을 모두 처리했으면(GetPacketInfo 가 결과를 남김) 로직 스레드를 끝냄
+			if (m_pRefLoopbackNetwork != nullptr && m_pRefLoopbackNetwork->IsFinished()) {
+				m_pPacketProc->ResumeCoroutine();
+				m_pLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 루프백 스크립트가 끝나서 로직 스레드를 멈춤", __FUNCTION__);
+				m_IsFinished = true;
+				break;
+			}
+
+			// 로그인 검증 결과는 패킷 대기(WaitPacketInfo)를 깨우지 않으므로 최대 IdleBlockMicroSec 만큼 늦게 처리될 수 있음
+			if (m_pPacketProc->ResumeCoroutine()) {
+				isWorked = true;
+			}
+
+			auto curTime = m_pNetwork->GetLogicTime();
+			if (curTime >= nextTickTime) {
+				m_pPacketProc->StateCheck();
+
+				if (curTime >= nextSnapshotTime) {
+					SaveSnapshot();
+					nextSnapshotTime = curTime + snapshotInterval;
+				}
+
+				nextTickTime += tickInterval;
+				// 처리가 밀려서 여러 주기가 지났으면 몰아서 실행하지 않고 현재 시간부터 다시 맞춤
+				if (nextTickTime <= curTime) {
+					nextTickTime = curTime + tickInterval;
+				}
+				isWorked = true;
+			}
+
+			// 이번 루프에서 모은 UDP 데이터그램을 한 번에 보냄
+			if (m_pUdpNetwork && m_pUdpNetwork->Flush()) {
+				isWorked = true;
+			}
+
+			if (isWorked || idleStrategy.GetStrategy() != IDLE_STRATEGY::kBLOCK) {
+				idleStrategy.Idle(isWorked);
+				continue;
+			}
+
+			// 패킷이 오거나 다음 tick 이나 코루틴 타이머 시간이 될 때까지만 블록
+			auto wakeTime = std::min(nextTickTime, m_pCoroutineScheduler->GetNextWakeTime());
+			auto waitMicroSec = std::chrono::duration_cast<std::chrono::microseconds>(wakeTime - curTime).count();
+			waitMicroSec = std::max<int64_t>(waitMicroSec, 0);
+			waitMicroSec = std::min<int64_t>(waitMicroSec, m_pServerConfig->IdleBlockMicroSec);
+			m_pNetwork->WaitPacketInfo((uint32_t)waitMicroSec);
+		}
+	}
+
+	ERROR_CODE Main::LoadConfig(const char* pszConfigFileName)
+	{
+		IniReader iniReader;
+		if (iniReader.Load(pszConfigFileName) == false) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+
+		m_pServerConfig = std::make_unique<NServerNetLib::ServerConfig>();
+		auto& config = *m_pServerConfig;
+
+		const char* pszSection = "Config";
+		config.Port = (uint16_t)iniReader.GetInt(pszSection, "Port", 32452);
+		config.BackLogCount = iniReader.GetInt(pszSection, "BackLogCount", 32);
+
+		config.MaxClientSocketOptRecvBufferSize = (uint16_t)iniReader.GetInt(pszSection, "MaxClientSockOptRecvBufferSize", 10240);
+		config.MaxClientSocketOptSendBufferSize = (uint16_t)iniReader.GetInt(pszSection, "MaxClientSockOptSendBufferSize", 10240);
+		config.MaxClientRecvBufferSize = (uint16_t)iniReader.GetInt(pszSection, "MaxClientRecvBufferSize", 8192);
+		config.MaxClientSendBufferSize = (uint16_t)iniReader.GetInt(pszSection, "MaxClientSendBufferSize", 8192);
+
+		config.IsLoginCheck = iniReader.GetInt(pszSection, "IsLoginCheck", 0) != 0;
+
+		config.MaxClientCount = iniReader.GetInt(pszSection, "MaxClientCount", 1000);
+		config.ExtraClientCount = iniReader.GetInt(pszSection, "ExtraClientCount", 64);
+
+		config.MaxLobbyCount = iniReader.GetInt(pszSection, "MaxLobbyCount", 2);
+		config.MaxLobbyUserCount = iniReader.GetInt(pszSection, "MaxLobbyUserCount", 50);
+		config.MaxRoomCountByLobby = iniReader.GetInt(pszSection, "MaxRoomCountByLobby", 20);
+		config.MaxRoomUserCount = iniReader.GetInt(pszSection, "MaxRoomUserCount", 4);
+		config.ChatHistoryCount = iniReader.GetInt(pszSection, "ChatHistoryCount", 5);
+
+		int idleStrategy = iniReader.GetInt(pszSection, "IdleStrategy", (int)IDLE_STRATEGY::kBLOCK);
+		idleStrategy = std::clamp(idleStrategy, (int)IDLE_STRATEGY::kBUSY_SPIN, (int)IDLE_STRATEGY::kBLOCK);
+		config.IdleStrategy = (IDLE_STRATEGY)idleStrategy;
+		config.IdleSpinCount = iniReader.GetInt(pszSection, "IdleSpinCount", 1000);
+		config.IdleBlockMicroSec = iniReader.GetInt(pszSection, "IdleBlockMicroSec", 1000);
+
+		// 0 이면 매 루프마다 tick 이 되므로 최소 1ms
+		config.LogicTickMilliSec = std::max(1, iniReader.GetInt(pszSection, "LogicTickMilliSec", 100));
+
+		config.LoginWorkerCount = std::max(1, iniReader.GetInt(pszSection, "LoginWorkerCount", 2));
+		auto credentialFileName = iniReader.GetString(pszSection, "CredentialFileName", "");
+		if (credentialFileName.size() >= sizeof(config.CredentialFileName)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.CredentialFileName, credentialFileName.c_str(), credentialFileName.size() + 1);
+		config.LoginFailDelayMilliSec = std::max(0, iniReader.GetInt(pszSection, "LoginFailDelayMilliSec", 0));
+
+		auto userStoreFileName = iniReader.GetString(pszSection, "UserStoreFileName", "");
+		if (userStoreFileName.size() >= sizeof(config.UserStoreFileName)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.UserStoreFileName, userStoreFileName.c_str(), userStoreFileName.size() + 1);
+		config.MaxUserStoreRecordCount = std::max(1, iniReader.GetInt(pszSection, "MaxUserStoreRecordCount", 1000000));
+		config.UserStoreGroupCommitMilliSec = std::max(1, iniReader.GetInt(pszSection, "UserStoreGroupCommitMilliSec", 10));
+
+		auto snapshotFileName = iniReader.GetString(pszSection, "SnapshotFileName", "");
+		if (snapshotFileName.size() >= sizeof(config.SnapshotFileName)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.SnapshotFileName, snapshotFileName.c_str(), snapshotFileName.size() + 1);
+		config.SnapshotIntervalSec = std::max(1, iniReader.GetInt(pszSection, "SnapshotIntervalSec", 5));
+		config.SnapshotRejoinGraceSec = std::max(0, iniReader.GetInt(pszSection, "SnapshotRejoinGraceSec", 60));
+
+		auto chatFilterFileName = iniReader.GetString(pszSection, "ChatFilterFileName", "");
+		if (chatFilterFileName.size() >= sizeof(config.ChatFilterFileName)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.ChatFilterFileName, chatFilterFileName.c_str(), chatFilterFileName.size() + 1);
+		config.ChatFilterReloadSec = std::max(0, iniReader.GetInt(pszSection, "ChatFilterReloadSec", 10));
+
+		config.ChatTokenPerSec = iniReader.GetInt(pszSection, "ChatTokenPerSec", 5);
+		config.ChatTokenBurst = iniReader.GetInt(pszSection, "ChatTokenBurst", 10);
+		config.RequestTokenPerSec = iniReader.GetInt(pszSection, "RequestTokenPerSec", 20);
+		config.RequestTokenBurst = iniReader.GetInt(pszSection, "RequestTokenBurst", 40);
+		config.FloodMaxDropCount = iniReader.GetInt(pszSection, "FloodMaxDropCount", 50);
+		config.FloodDropWindowMilliSec = iniReader.GetInt(pszSection, "FloodDropWindowMilliSec", 10000);
+
+		config.MetricsAdminPort = (uint16_t)iniReader.GetInt(pszSection, "MetricsAdminPort", 0);
+		config.MetricsDumpIntervalSec = iniReader.GetInt(pszSection, "MetricsDumpIntervalSec", 0);
+		auto metricsDumpFileName = iniReader.GetString(pszSection, "MetricsDumpFileName", "");
+		if (metricsDumpFileName.size() >= sizeof(config.MetricsDumpFileName)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.MetricsDumpFileName, metricsDumpFileName.c_str(), metricsDumpFileName.size() + 1);
+
+		config.IsAsyncLog = iniReader.GetInt(pszSection, "IsAsyncLog", 0) != 0;
+		auto logFileName = iniReader.GetString(pszSection, "LogFileName", "");
+		if (logFileName.size() >= sizeof(config.LogFileName)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.LogFileName, logFileName.c_str(), logFileName.size() + 1);
+		config.LogRingSize = std::max(16, iniReader.GetInt(pszSection, "LogRingSize", 1024));
+		int logFullPolicy = iniReader.GetInt(pszSection, "LogFullPolicy", (int)LOG_FULL_POLICY::kDROP);
+		config.LogFullPolicy = (int16_t)std::clamp(logFullPolicy, (int)LOG_FULL_POLICY::kDROP, (int)LOG_FULL_POLICY::kBLOCK);
+		int logMinLevel = iniReader.GetInt(pszSection, "LogMinLevel", (int)LOG_LEVEL::kL_TRACE);
+		config.LogMinLevel = (int16_t)std::clamp(logMinLevel, (int)LOG_LEVEL::kL_TRACE, (int)LOG_LEVEL::kL_INFO);
+		config.SessionLogPerSec = iniReader.GetInt(pszSection, "SessionLogPerSec", 0);
+		config.SessionLogSampleRate = iniReader.GetInt(pszSection, "SessionLogSampleRate", 0);
+
+		auto captureFileName = iniReader.GetString(pszSection, "CaptureFileName", "");
+		auto replayFileName = iniReader.GetString(pszSection, "ReplayFileName", "");
+		if (captureFileName.size() >= sizeof(config.CaptureFileName) || replayFileName.size() >= sizeof(config.ReplayFileName)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.CaptureFileName, captureFileName.c_str(), captureFileName.size() + 1);
+		memcpy(config.ReplayFileName, replayFileName.c_str(), replayFileName.size() + 1);
+		config.CaptureMaxFileSizeMB = std::max(1, iniReader.GetInt(pszSection, "CaptureMaxFileSizeMB", 256));
+		config.IsReplayMaxSpeed = iniReader.GetInt(pszSection, "IsReplayMaxSpeed", 0) != 0;
+
+		auto loopbackScriptFileName = iniReader.GetString(pszSection, "LoopbackScriptFileName", "");
+		auto loopbackOutputFileName = iniReader.GetString(pszSection, "LoopbackOutputFileName", "");
+		if (loopbackScriptFileName.size() >= sizeof(config.LoopbackScriptFileName) || loopbackOutputFileName.size() >= sizeof(config.LoopbackOutputFileName)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.LoopbackScriptFileName, loopbackScriptFileName.c_str(), loopbackScriptFileName.size() + 1);
+		memcpy(config.LoopbackOutputFileName, loopbackOutputFileName.c_str(), loopbackOutputFileName.size() + 1);
+		config.IsLoopbackVirtualClock = iniReader.GetInt(pszSection, "IsLoopbackVirtualClock", 1) != 0;
+		config.IsLoopbackCaptureSend = iniReader.GetInt(pszSection, "IsLoopbackCaptureSend", 0) != 0;
+
+		config.SendBufferHighWaterPercent = std::clamp(iniReader.GetInt(pszSection, "SendBufferHighWaterPercent", 75), 0, 100);
+		config.SendBufferLowWaterPercent = std::clamp(iniReader.GetInt(pszSection, "SendBufferLowWaterPercent", 25), 0, (int)config.SendBufferHighWaterPercent);
+		config.LaggardDisconnectMilliSec = iniReader.GetInt(pszSection, "LaggardDisconnectMilliSec", 10000);
+
+		auto handoffSocketPath = iniReader.GetString(pszSection, "HandoffSocketPath", "");
+		if (handoffSocketPath.size() >= sizeof(config.HandoffSocketPath)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.HandoffSocketPath, handoffSocketPath.c_str(), handoffSocketPath.size() + 1);
+		config.HandoffWaitSec = iniReader.GetInt(pszSection, "HandoffWaitSec", 60);
+		config.IsHandoffReceive = false;
+
+		config.UdpPort = (uint16_t)iniReader.GetInt(pszSection, "UdpPort", 0);
+		// 0 이면 같은 루프에서 계속 다시 보내므로 최소 1ms
+		config.UdpResendMilliSec = std::max(1, iniReader.GetInt(pszSection, "UdpResendMilliSec", 100));
+		config.UdpMaxResendCount = iniReader.GetInt(pszSection, "UdpMaxResendCount", 5);
+		config.GameStateTokenPerSec = iniReader.GetInt(pszSection, "GameStateTokenPerSec", 60);
+		config.GameStateTokenBurst = iniReader.GetInt(pszSection, "GameStateTokenBurst", 120);
+
+		config.LogicWorkerCount = std::max(0, iniReader.GetInt(pszSection, "LogicWorkerCount", 0));
+
+		config.NetworkThreadCpu = iniReader.GetInt(pszSection, "NetworkThreadCpu", -1);
+		config.LogicThreadCpu = iniReader.GetInt(pszSection, "LogicThreadCpu", -1);
+		config.LoggerThreadCpu = iniReader.GetInt(pszSection, "LoggerThreadCpu", -1);
+		auto logicWorkerCpuList = iniReader.GetString(pszSection, "LogicWorkerCpuList", "");
+		if (logicWorkerCpuList.size() >= sizeof(config.LogicWorkerCpuList)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.LogicWorkerCpuList, logicWorkerCpuList.c_str(), logicWorkerCpuList.size() + 1);
+
+		auto shmFileName = iniReader.GetString(pszSection, "ShmFileName", "");
+		if (shmFileName.size() >= sizeof(config.ShmFileName)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.ShmFileName, shmFileName.c_str(), shmFileName.size() + 1);
+		config.ShmLogicCount = std::max(1, iniReader.GetInt(pszSection, "ShmLogicCount", 1));
+		config.ShmLogicIndex = std::max(0, iniReader.GetInt(pszSection, "ShmLogicIndex", 0));
+		// 레코드 하나(최대 링의 1/4)에 가장 큰 패킷이 들어가도록 최소 64KB
+		config.ShmRingSizeKB = std::max(64, iniReader.GetInt(pszSection, "ShmRingSizeKB", 4096));
+
+		auto clusterNodeList = iniReader.GetString(pszSection, "ClusterNodeList", "");
+		auto clusterLobbyOwnerList = iniReader.GetString(pszSection, "ClusterLobbyOwnerList", "");
+		if (clusterNodeList.size() >= sizeof(config.ClusterNodeList) || clusterLobbyOwnerList.size() >= sizeof(config.ClusterLobbyOwnerList)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.ClusterNodeList, clusterNodeList.c_str(), clusterNodeList.size() + 1);
+		memcpy(config.ClusterLobbyOwnerList, clusterLobbyOwnerList.c_str(), clusterLobbyOwnerList.size() + 1);
+		config.ClusterNodeId = std::max(0, iniReader.GetInt(pszSection, "ClusterNodeId", 0));
+		config.ClusterProxySessionCount = std::max(0, iniReader.GetInt(pszSection, "ClusterProxySessionCount", 1000));
+		// 레코드 하나(가장 큰 패킷)보다 충분히 크도록 최소 64KB
+		config.ClusterLinkBufferKB = std::max(64, iniReader.GetInt(pszSection, "ClusterLinkBufferKB", 4096));
+		// 0 이면 링크 스레드가 쉬지 않고 돌므로 최소 50us
+		config.ClusterFlushMicroSec = std::max(50, iniReader.GetInt(pszSection, "ClusterFlushMicroSec", 500));
+		auto clusterSecret = iniReader.GetString(pszSection, "ClusterSecret", "");
+		if (clusterSecret.size() >= sizeof(config.ClusterSecret)) {
+			return ERROR_CODE::MAIN_INIT_CONFIG_LOAD_FAIL;
+		}
+		memcpy(config.ClusterSecret, clusterSecret.c_str(), clusterSecret.size() + 1);
+
+		return ERROR_CODE::NONE;
+	}
+}
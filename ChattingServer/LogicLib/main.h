@@ -0,0 +1,124 @@
+#pragma once
+
+#include <memory>
+#include <atomic>
+#include <thread>
+
+#include "../Common/error_code.h"
+#include "../ServerNetLib/define.h"
+
+namespace NServerNetLib
+{
+	class ITcpNetwork;
+	class UdpNetwork;
+	class ILog;
+	class MetricsExporter;
+	class ShmGateway;
+	class ClusterNetwork;
+	class LoopbackNetwork;
+}
+
+namespace NLogicLib
+{
+	class UserManager;
+	class LobbyManager;
+	class PacketProcess;
+	class CredentialStore;
+	class UserStore;
+	class LoginWorkerPool;
+	class LogicExecutor;
+	class CoroutineScheduler;
+	class ChatFilter;
+	class StateSnapshot;
+
+	using ERROR_CODE = NCommon::ERROR_CODE;
+
+	// 설정을 읽고 네트워크 스레드와 로직 스레드를 소유하는 서버 본체
+	class Main
+	{
+	public:
+		Main();
+		~Main();
+
+		// isHandoffReceive: 리슨 소켓과 세션을 이전 프로세스에게서 넘겨받아 시작 (무중단 재시작)
+		// isShmGateway: 소켓만 처리하고 패킷은 ShmFileName 공유 메모리로 로직 프로세스들에게 넘기는 게이트웨이로 시작
+		ERROR_CODE Init(const char* pszConfigFileName, const bool isHandoffReceive = false, const bool isShmGateway = false);
+
+		// 네트워크/로직/로직 워커/로그인 워커 스레드 시작 (게이트웨이는 네트워크/게이트웨이 스레드) (바로 반환)
+		void Start();
+
+		// 모든 스레드를 멈추고 끝날 때까지 기다림
+		void Stop();
+
+		// 루프백 스크립트를 모두 처리해서 로직 스레드가 멈췄는지 (이후 Stop 을 부르고 종료하면 됨)
+		bool IsFinished() const { return m_IsFinished; }
+
+		// 무중단 재시작: 스레드를 멈추고 리슨 소켓과 세션을 새 프로세스에게 넘김
+		// 성공하면 true (이제 종료하면 됨), 실패하면 스레드를 다시 시작하고 false
+		bool Handoff();
+
+	private:
+		ERROR_CODE LoadConfig(const char* pszConfigFileName);
+
+		// CPU/NUMA 노드 구성과 스레드를 고정할 CPU 를 로그로 남김
+		void ReportThreadTopology();
+
+		// 소켓 대신 캡처 파일이나 루프백 스크립트의 패킷을 받는 중인지 (같은 입력이면 같은 결과가 나오도록 워커 없이 로직 스레드 하나로 처리)
+		bool IsReplay() const { return m_pServerConfig->ReplayFileName[0] != '\0' || m_pServerConfig->LoopbackScriptFileName[0] != '\0'; }
+
+		// TcpNetwork::Run 반복 (소켓 처리)
+		void NetworkThreadFunc();
+
+		// 받은 패킷 처리 + 고정 주기 tick
+		void LogicThreadFunc();
+
+		// UdpNetwork::Run 반복 (UDP 수신)
+		void UdpThreadFunc();
+
+		// ShmGateway::Run 반복 (TcpNetwork 와 로직 프로세스 사이에서 패킷 전달)
+		void GatewayThreadFunc();
+
+		void Release();
+
+		// 스냅샷 파일이 있으면 로비/룸을 되살림
+		void RestoreSnapshot();
+
+		// 로비/룸 상태를 복사해서 스냅샷 기록 스레드에 넘김 (기록 스레드가 멈췄으면 바로 씀)
+		void SaveSnapshot();
+
+	private:
+		std::atomic<bool> m_IsRun = false;
+		std::atomic<bool> m_IsFinished = false;
+
+		std::thread m_NetworkThread;
+		std::thread m_LogicThread;
+		std::thread m_UdpThread;
+		std::thread m_GatewayThread;
+
+		std::unique_ptr<NServerNetLib::ServerConfig> m_pServerConfig;
+		std::unique_ptr<NServerNetLib::ILog> m_pLogger;
+
+		// ShmFileName 이 있으면 로직 프로세스는 ShmNetwork, 게이트웨이는 TcpNetwork
+		std::unique_ptr<NServerNetLib::ITcpNetwork> m_pNetwork;
+		// ClusterNodeList 가 있으면 m_pNetwork 가 ClusterNetwork (없으면 nullptr)
+		NServerNetLib::ClusterNetwork* m_pRefClusterNetwork = nullptr;
+		// LoopbackScriptFileName 이 있으면 m_pNetwork 가 LoopbackNetwork (없으면 nullptr)
+		NServerNetLib::LoopbackNetwork* m_pRefLoopbackNetwork = nullptr;
+		// 게이트웨이로 시작했을 때만 있음 (로직 관련 객체는 만들지 않음)
+		std::unique_ptr<NServerNetLib::ShmGateway> m_pShmGateway;
+		// UdpPort 가 0 이거나 재생 중이면 nullptr
+		std::unique_ptr<NServerNetLib::UdpNetwork> m_pUdpNetwork;
+		std::unique_ptr<NServerNetLib::MetricsExporter> m_pMetricsExporter;
+		std::unique_ptr<PacketProcess> m_pPacketProc;
+		std::unique_ptr<LogicExecutor> m_pLogicExecutor;
+		std::unique_ptr<UserManager> m_pUserMgr;
+		std::unique_ptr<LobbyManager> m_pLobbyMgr;
+
+		std::unique_ptr<UserStore> m_pUserStore;
+		std::unique_ptr<CredentialStore> m_pCredentialStore;
+		std::unique_ptr<LoginWorkerPool> m_pLoginWorkerPool;
+		std::unique_ptr<CoroutineScheduler> m_pCoroutineScheduler;
+		std::unique_ptr<ChatFilter> m_pChatFilter;
+		std::unique_ptr<StateSnapshot> m_pStateSnapshot;
+	};
+}
@@ -0,0 +1,318 @@
+#include <cstddef>
+
+#include "user_manager.h"
+#include "lobby_manager.h"
+#include "connected_user_manager.h"
+#include "coroutine_scheduler.h"
+#include "user_store.h"
+#include "../ServerNetLib/cluster_network.h"
+#include "packet_process.h"
+
+namespace NLogicLib
+{
+	using PACKET_ID = NCommon::PACKET_ID;
+	using SYS_PACKET_ID = NServerNetLib::PACKET_ID;
+
+	PacketProcess::PacketProcess()
+	{
+	}
+
+	PacketProcess::~PacketProcess()
+	{
+	}
+
+	void PacketProcess::Init(TcpNet* pNetwork, UdpNet* pUdpNetwork, NServerNetLib::ClusterNetwork* pClusterNetwork, UserManager* pUserMgr, LobbyManager* pLobbyMgr, LoginWorkerPool* pLoginWorkerPool,
+		CoroutineScheduler* pScheduler, const ChatFilter* pChatFilter, UserStore* pUserStore, const bool isReplay, const ServerConfig* pConfig, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_pRefNetwork = pNetwork;
+		m_pRefUdpNetwork = pUdpNetwork;
+		m_pRefClusterNetwork = pClusterNetwork;
+		m_pRefUserMgr = pUserMgr;
+		m_pRefLobbyMgr = pLobbyMgr;
+		m_pRefLoginWorkerPool = pLoginWorkerPool;
+		m_pRefScheduler = pScheduler;
+		m_pRefChatFilter = pChatFilter;
+		m_pRefUserStore = pUserStore;
+
+		// 재생할 때는 타이머가 실제 시간에 따라 달라지므로 기다리지 않음
+		m_LoginFailDelayMilliSec = isReplay ? 0 : pConfig->LoginFailDelayMilliSec;
+
+		m_pConnectedUserManager = std::make_unique<ConnectedUserManager>();
+		m_pConnectedUserManager->Init(pNetwork->ClientSessionPoolSize(), pNetwork, pConfig, pLogger);
+
+		for (int i = 0; i < (int)PACKET_ID::MAX; ++i) {
+			PacketFuncArray[i] = nullptr;
+		}
+
+		// 시스템 패킷(1 ~ 20)과 클라이언트 패킷(21 이상)이 같은 배열을 사용
+		PacketFuncArray[(int)SYS_PACKET_ID::kNTF_SYS_CONNECT_SESSION] = &PacketProcess::NtfSysConnctSession;
+		PacketFuncArray[(int)SYS_PACKET_ID::kNTF_SYS_CLOSE_SESSION] = &PacketProcess::NtfSysCloseSession;
+		PacketFuncArray[(int)SYS_PACKET_ID::kNTF_SYS_SEND_BUFFER_HIGH] = &PacketProcess::NtfSysSendBufferHigh;
+		PacketFuncArray[(int)SYS_PACKET_ID::kNTF_SYS_SEND_BUFFER_LOW] = &PacketProcess::NtfSysSendBufferLow;
+		// 클러스터 알림은 ClusterNetwork 가 만드는 패킷이므로 클러스터를 쓸 때만 받음
+		if (m_pRefClusterNetwork != nullptr) {
+			PacketFuncArray[(int)SYS_PACKET_ID::kNTF_SYS_CLUSTER_ATTACH] = &PacketProcess::NtfSysClusterAttach;
+			PacketFuncArray[(int)SYS_PACKET_ID::kNTF_SYS_CLUSTER_RESULT] = &PacketProcess::NtfSysClusterResult;
+		}
+
+		PacketFuncArray[(int)PACKET_ID::LOGIN_IN_REQ] = &PacketProcess::Login;
+
+		PacketFuncArray[(int)PACKET_ID::LOBBY_LIST_REQ] = &PacketProcess::LobbyList;
+		PacketFuncArray[(int)PACKET_ID::LOBBY_ENTER_REQ] = &PacketProcess::LobbyEnter;
+		PacketFuncArray[(int)PACKET_ID::LOBBY_REJOIN_REQ] = &PacketProcess::LobbyRejoin;
+		PacketFuncArray[(int)PACKET_ID::LOBBY_LEAVE_REQ] = &PacketProcess::LobbyLeave;
+		PacketFuncArray[(int)PACKET_ID::LOBBY_CHAT_REQ] = &PacketProcess::LobbyChat;
+		PacketFuncArray[(int)PACKET_ID::LOBBY_ROOM_LIST_REQ] = &PacketProcess::LobbyRoomList;
+
+		PacketFuncArray[(int)PACKET_ID::ROOM_ENTER_REQ] = &PacketProcess::RoomEnter;
+		PacketFuncArray[(int)PACKET_ID::ROOM_LEAVE_REQ] = &PacketProcess::RoomLeave;
+		PacketFuncArray[(int)PACKET_ID::ROOM_CHAT_REQ] = &PacketProcess::RoomChat;
+		PacketFuncArray[(int)PACKET_ID::ROOM_MASTER_GAME_START_REQ] = &PacketProcess::RoomMasterGameStart;
+		PacketFuncArray[(int)PACKET_ID::ROOM_GAME_START_REQ] = &PacketProcess::RoomGameStart;
+		PacketFuncArray[(int)PACKET_ID::ROOM_GAME_STATE_REQ] = &PacketProcess::RoomGameState;
+
+		PacketFuncArray[(int)PACKET_ID::DEV_ECHO_REQ] = &PacketProcess::DevEcho;
+
+		// 시스템 패킷을 빼고 처리 함수가 있는 클라이언트 패킷은 모두 제한 대상
+		for (int i = 0; i < (int)PACKET_ID::MAX; ++i) {
+			bool isClientPacket = PacketFuncArray[i] != nullptr && i > NServerNetLib::MAX_SYS_PACKET_ID;
+			PacketFloodClassArray[i] = isClientPacket ? FLOOD_CLASS::REQUEST : FLOOD_CLASS::NONE;
+		}
+		PacketFloodClassArray[(int)PACKET_ID::LOBBY_CHAT_REQ] = FLOOD_CLASS::CHAT;
+		PacketFloodClassArray[(int)PACKET_ID::ROOM_CHAT_REQ] = FLOOD_CLASS::CHAT;
+		PacketFloodClassArray[(int)PACKET_ID::ROOM_GAME_STATE_REQ] = FLOOD_CLASS::GAME_STATE;
+
+		// 모르는 것은 모두 EXCLUSIVE. 오래 걸리는 목록 만들기와 여러 명에게 보내는 것만 동시에 처리
+		for (int i = 0; i < (int)PACKET_ID::MAX; ++i) {
+			PacketLockArray[i] = PACKET_LOCK::EXCLUSIVE;
+		}
+		PacketLockArray[(int)PACKET_ID::LOBBY_LIST_REQ] = PACKET_LOCK::SHARED;
+		PacketLockArray[(int)PACKET_ID::LOBBY_CHAT_REQ] = PACKET_LOCK::SHARED;
+		PacketLockArray[(int)PACKET_ID::LOBBY_ROOM_LIST_REQ] = PACKET_LOCK::SHARED;
+		PacketLockArray[(int)PACKET_ID::ROOM_CHAT_REQ] = PACKET_LOCK::SHARED;
+		PacketLockArray[(int)PACKET_ID::ROOM_GAME_STATE_REQ] = PACKET_LOCK::SHARED;
+		PacketLockArray[(int)PACKET_ID::DEV_ECHO_REQ] = PACKET_LOCK::NONE;
+		PacketLockArray[(int)SYS_PACKET_ID::kNTF_SYS_CLUSTER_RESULT] = PACKET_LOCK::NONE;
+
+		// 로비/룸 요청은 모두 로비를 맡은 노드가 처리 (UDP 로 오는 게임 상태는 유저가 접속한 노드에서만)
+		for (int i = 0; i < (int)PACKET_ID::MAX; ++i) {
+			PacketClusterRouteArray[i] = false;
+		}
+		PacketClusterRouteArray[(int)PACKET_ID::LOBBY_LIST_REQ] = true;
+		PacketClusterRouteArray[(int)PACKET_ID::LOBBY_ENTER_REQ] = true;
+		PacketClusterRouteArray[(int)PACKET_ID::LOBBY_LEAVE_REQ] = true;
+		PacketClusterRouteArray[(int)PACKET_ID::LOBBY_CHAT_REQ] = true;
+		PacketClusterRouteArray[(int)PACKET_ID::LOBBY_ROOM_LIST_REQ] = true;
+		PacketClusterRouteArray[(int)PACKET_ID::ROOM_ENTER_REQ] = true;
+		PacketClusterRouteArray[(int)PACKET_ID::ROOM_LEAVE_REQ] = true;
+		PacketClusterRouteArray[(int)PACKET_ID::ROOM_CHAT_REQ] = true;
+		PacketClusterRouteArray[(int)PACKET_ID::ROOM_MASTER_GAME_START_REQ] = true;
+		PacketClusterRouteArray[(int)PACKET_ID::ROOM_GAME_START_REQ] = true;
+
+		if (m_pRefClusterNetwork != nullptr) {
+			m_pRefClusterNetwork->SetResultNotifyPacket((short)PACKET_ID::LOBBY_ENTER_RES, true);
+			m_pRefClusterNetwork->SetResultNotifyPacket((short)PACKET_ID::LOBBY_LEAVE_RES, true);
+		}
+
+		FloodControlConfig floodConfig;
+		floodConfig.TokenPerSec[(int)FLOOD_CLASS::CHAT] = pConfig->ChatTokenPerSec;
+		floodConfig.TokenBurst[(int)FLOOD_CLASS::CHAT] = pConfig->ChatTokenBurst;
+		floodConfig.TokenPerSec[(int)FLOOD_CLASS::REQUEST] = pConfig->RequestTokenPerSec;
+		floodConfig.TokenBurst[(int)FLOOD_CLASS::REQUEST] = pConfig->RequestTokenBurst;
+		floodConfig.TokenPerSec[(int)FLOOD_CLASS::GAME_STATE] = pConfig->GameStateTokenPerSec;
+		floodConfig.TokenBurst[(int)FLOOD_CLASS::GAME_STATE] = pConfig->GameStateTokenBurst;
+		floodConfig.MaxDropCount = pConfig->FloodMaxDropCount;
+		floodConfig.DropWindowMilliSec = pConfig->FloodDropWindowMilliSec;
+		m_pFloodControl = std::make_unique<FloodControl>();
+		m_pFloodControl->Init(pNetwork->ClientSessionPoolSize(), floodConfig, pNetwork, pLogger);
+
+		// 느린 세션에게는 채팅 알림을 버림 (응답과 입장/퇴장 알림은 상태가 어긋나므로 그대로 보냄)
+		pNetwork->SetLaggingDropPacket((short)PACKET_ID::LOBBY_CHAT_NTF, true);
+		pNetwork->SetLaggingDropPacket((short)PACKET_ID::ROOM_CHAT_NTF, true);
+
+		// 캡처 파일에는 비밀번호를 남기지 않음
+		pNetwork->SetCaptureMaskField((short)PACKET_ID::LOGIN_IN_REQ, (short)offsetof(NCommon::PktLogInReq, szPW), (short)sizeof(NCommon::PktLogInReq::szPW));
+
+		// UDP 로는 게임 상태만 받음 (로그인/룸 요청처럼 순서가 중요한 것은 TCP 로만)
+		if (m_pRefUdpNetwork != nullptr) {
+			m_pRefUdpNetwork->SetRecvPacket((short)PACKET_ID::ROOM_GAME_STATE_REQ, true);
+		}
+	}
+
+	void PacketProcess::Process(PacketInfo packetInfo)
+	{
+		auto packetId = packetInfo.PacketId;
+		if (packetId <= 0 || packetId >= (int)PACKET_ID::MAX) {
+			return;
+		}
+
+		if (PacketFuncArray[packetId] == nullptr) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 처리 함수가 없는 패킷. PacketId(%d)", __FUNCTION__, packetId);
+			return;
+		}
+
+		// 채팅처럼 여러 명에게 퍼지는 처리를 하기 전에 먼저 버림
+		if (m_pFloodControl->Check(packetInfo.SessionIndex, PacketFloodClassArray[packetId]) == false) {
+			return;
+		}
+
+		if (m_pRefClusterNetwork != nullptr && RouteClusterPacket(packetInfo)) {
+			return;
+		}
+
+		switch (PacketLockArray[packetId])
+		{
+		case PACKET_LOCK::NONE:
+			(this->*PacketFuncArray[packetId])(packetInfo);
+			break;
+		case PACKET_LOCK::SHARED:
+		{
+			std::shared_lock<std::shared_mutex> lock(m_StateLock);
+			(this->*PacketFuncArray[packetId])(packetInfo);
+			break;
+		}
+		default:
+		{
+			std::unique_lock<std::shared_mutex> lock(m_StateLock);
+			(this->*PacketFuncArray[packetId])(packetInfo);
+			break;
+		}
+		}
+	}
+
+	bool PacketProcess::ResumeCoroutine(const bool isExpireAll)
+	{
+		std::unique_lock<std::shared_mutex> lock(m_StateLock);
+		return m_pRefScheduler->Run(isExpireAll);
+	}
+
+	void PacketProcess::StateCheck()
+	{
+		std::unique_lock<std::shared_mutex> lock(m_StateLock);
+
+		m_pConnectedUserManager->LoginCheck();
+		m_pConnectedUserManager->SendLagCheck();
+		m_pRefLobbyMgr->CheckRejoinExpire();
+	}
+
+	void PacketProcess::CaptureSnapshot(SnapshotImage& image)
+	{
+		// 읽기만 하므로 다른 워커의 읽기 전용 패킷과 같이 실행
+		std::shared_lock<std::shared_mutex> lock(m_StateLock);
+		m_pRefLobbyMgr->CaptureSnapshot(image);
+	}
+
+	void PacketProcess::GetHandoffUserList(std::vector<NServerNetLib::HandoffSessionInfo>& userTagList)
+	{
+		userTagList.clear();
+
+		m_pRefUserMgr->ForEachUser([&](User* pUser) {
+			NServerNetLib::HandoffSessionInfo sessionInfo;
+			sessionInfo.SessionIndex = pUser->GetSessioIndex();
+			strncpy(sessionInfo.UserTag, pUser->GetID().c_str(), sizeof(sessionInfo.UserTag) - 1);
+			userTagList.push_back(sessionInfo);
+		});
+	}
+
+	void PacketProcess::RestoreHandoffSession(const NServerNetLib::HandoffSessionInfo& sessionInfo)
+	{
+		m_pConnectedUserManager->SetConnectSession(sessionInfo.SessionIndex);
+		m_pFloodControl->SetConnectSession(sessionInfo.SessionIndex);
+
+		if (sessionInfo.UserTag[0] == '\0') {
+			return;
+		}
+
+		auto addRet = m_pRefUserMgr->AddUser(sessionInfo.SessionIndex, sessionInfo.UserTag);
+		if (addRet != ERROR_CODE::NONE) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 넘겨받은 유저 로그인 복구 실패. 세션 인덱스(%d), ErrorCode(%d)", __FUNCTION__,
+				sessionInfo.SessionIndex, (int)addRet);
+			return;
+		}
+
+		m_pConnectedUserManager->SetLogin(sessionInfo.SessionIndex);
+
+		// UDP 채널은 넘겨받지 않으므로 새 토큰을 알려줌
+		NotifyUdpInfo(sessionInfo.SessionIndex);
+	}
+
+	ERROR_CODE PacketProcess::NtfSysConnctSession(PacketInfo packetInfo)
+	{
+		m_pConnectedUserManager->SetConnectSession(packetInfo.SessionIndex);
+		m_pFloodControl->SetConnectSession(packetInfo.SessionIndex);
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE PacketProcess::NtfSysCloseSession(PacketInfo packetInfo)
+	{
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+
+		if (errorCode == ERROR_CODE::NONE && pUser != nullptr) {
+			auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+			if (pLobby != nullptr) {
+				// 룸에 있었으면 룸의 다른 유저에게 나간 것을 알림
+				if (pUser->IsCurDomainInRoom()) {
+					auto pRoom = pLobby->GetRoom(pUser->GetRoomIndex());
+					if (pRoom != nullptr) {
+						pRoom->LeaveUser(pUser->GetIndex());
+						pRoom->NotifyLeaveUserInfo(pUser->GetID().c_str());
+					}
+				}
+
+				pLobby->LeaveUser(pUser->GetIndex());
+			}
+
+			m_pRefUserStore->RecordLogout(pUser->GetID().c_str());
+			m_pRefUserMgr->RemoveUser(packetInfo.SessionIndex);
+		}
+
+		if (m_pRefUdpNetwork != nullptr) {
+			m_pRefUdpNetwork->CloseSession(packetInfo.SessionIndex);
+		}
+
+		m_pRefScheduler->WakeSendDrain(packetInfo.SessionIndex, false);
+
+		// 다른 노드의 로비에 있었으면 그 노드에서도 나가게 함
+		if (m_pRefClusterNetwork != nullptr) {
+			m_pRefClusterNetwork->Detach(packetInfo.SessionIndex);
+		}
+
+		m_pConnectedUserManager->SetDisConnectSession(packetInfo.SessionIndex);
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE PacketProcess::NtfSysSendBufferHigh(PacketInfo packetInfo)
+	{
+		m_pConnectedUserManager->SetSendLagging(packetInfo.SessionIndex, true);
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE PacketProcess::NtfSysSendBufferLow(PacketInfo packetInfo)
+	{
+		m_pConnectedUserManager->SetSendLagging(packetInfo.SessionIndex, false);
+		m_pRefScheduler->WakeSendDrain(packetInfo.SessionIndex, true);
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE PacketProcess::DevEcho(PacketInfo packetInfo)
+	{
+		NCommon::PktDevEchoReq reqPkt;
+		ReadBody(packetInfo, reqPkt);
+
+		// 받은 데이터 크기보다 큰 크기를 요청해도 받은 만큼만 돌려줌
+		int dataSize = reqPkt.DataSize;
+		int recvDataSize = packetInfo.PacketBodySize - (int)sizeof(reqPkt.DataSize);
+		dataSize = std::max(0, std::min({ dataSize, recvDataSize, NCommon::DEV_ECHO_DATA_MAX_SIZE }));
+
+		NCommon::PktDevEchoRes resPkt;
+		resPkt.ErrorCode = (short)ERROR_CODE::NONE;
+		resPkt.DataSize = (short)dataSize;
+		memcpy(resPkt.Datas, reqPkt.Datas, dataSize);
+
+		// 사용하지 않는 Datas 뒷부분은 보내지 않음
+		short sendSize = (short)(sizeof(resPkt) - NCommon::DEV_ECHO_DATA_MAX_SIZE + dataSize);
+		m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::DEV_ECHO_RES, sendSize, (char*)&resPkt);
+		return ERROR_CODE::NONE;
+	}
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <shared_mutex>
+#include <cstring>
+#include <algorithm>
+
+#include "../Common/Packet.h"
+#include "../Common/error_code.h"
+#include "../ServerNetLib/define.h"
+#include "../ServerNetLib/interface_tcp_network.h"
+#include "../ServerNetLib/udp_network.h"
+#include "login_worker_pool.h"
+#include "logic_task.h"
+#include "flood_control.h"
+
+namespace NServerNetLib
+{
+	class ClusterNetwork;
+}
+
+namespace NLogicLib
+{
+	class UserManager;
+	class LobbyManager;
+	class ConnectedUserManager;
+	class CoroutineScheduler;
+	class ChatFilter;
+	class UserStore;
+	struct SnapshotImage;
+
+	using TcpNet = NServerNetLib::ITcpNetwork;
+	using UdpNet = NServerNetLib::UdpNetwork;
+	using ILog = NServerNetLib::ILog;
+	using ServerConfig = NServerNetLib::ServerConfig;
+	using ERROR_CODE = NCommon::ERROR_CODE;
+	using LOG_LEVEL = NServerNetLib::LOG_LEVEL;
+
+	// 처리 함수가 유저/로비/룸 상태(m_StateLock)를 어떻게 쓰는지
+	enum class PACKET_LOCK : int16_t
+	{
+		// 자기 세션 상태만 사용
+		NONE = 0,
+		// 읽기만 함 (룸/로비 채팅 기록은 ChatHistory 가 따로 잠금). 서로 다른 세션이 동시에 처리
+		SHARED = 1,
+		// 입장/퇴장처럼 상태를 바꿈. 혼자 처리
+		EXCLUSIVE = 2,
+	};
+
+	// 받은 패킷을 PacketId 별 처리 함수로 분배
+	// Process 는 로직 워커 여러 개가 서로 다른 세션의 패킷으로 동시에 호출할 수 있음 (같은 세션은 LogicExecutor 가 한 번에 하나만)
+	class PacketProcess
+	{
+		using PacketInfo = NServerNetLib::RecvPacketInfo;
+		typedef ERROR_CODE(PacketProcess::* PacketFunc)(PacketInfo);
+		PacketFunc PacketFuncArray[(int)NCommon::PACKET_ID::MAX];
+		FLOOD_CLASS PacketFloodClassArray[(int)NCommon::PACKET_ID::MAX];
+		PACKET_LOCK PacketLockArray[(int)NCommon::PACKET_ID::MAX];
+		// 다른 노드가 맡은 로비에 들어간 유저이면 그 노드로 넘기는 패킷
+		bool PacketClusterRouteArray[(int)NCommon::PACKET_ID::MAX];
+
+	public:
+		PacketProcess();
+		~PacketProcess();
+
+		// pUdpNetwork 는 UDP 채널을 쓰지 않으면 nullptr, pClusterNetwork 는 클러스터를 쓰지 않으면 nullptr (쓰면 pNetwork 와 같은 객체)
+		// isReplay 는 Main::IsReplay() (캡처 재생이나 루프백 스크립트로 돌 때 true)
+		void Init(TcpNet* pNetwork, UdpNet* pUdpNetwork, NServerNetLib::ClusterNetwork* pClusterNetwork, UserManager* pUserMgr, LobbyManager* pLobbyMgr, LoginWorkerPool* pLoginWorkerPool,
+			CoroutineScheduler* pScheduler, const ChatFilter* pChatFilter, UserStore* pUserStore, const bool isReplay, const ServerConfig* pConfig, ILog* pLogger);
+
+		void Process(PacketInfo packetInfo);
+
+		// 로그인 검증 결과, 타이머, 송신 버퍼 비움을 기다리던 처리(LogicTask)를 이어서 실행 (실행한 것이 있으면 true)
+		// isExpireAll: 무중단 재시작 전에 기다리는 것을 모두 끝내서 응답을 송신 버퍼에 남김
+		bool ResumeCoroutine(const bool isExpireAll = false);
+
+		// 로직 스레드의 고정 주기(tick) 마다 호출
+		void StateCheck();
+
+		// 로비/룸 상태를 image 에 복사 (로직 스레드의 tick 이나 멈춘 뒤에)
+		void CaptureSnapshot(SnapshotImage& image);
+
+		// 무중단 재시작: 로그인한 세션의 유저 ID 를 모아서 넘김
+		void GetHandoffUserList(std::vector<NServerNetLib::HandoffSessionInfo>& userTagList);
+
+		// 무중단 재시작: 넘겨받은 세션을 접속 상태로 만들고, 유저 ID 가 있으면 로그인 상태까지 되살림
+		void RestoreHandoffSession(const NServerNetLib::HandoffSessionInfo& sessionInfo);
+
+	private:
+		// 바디 크기가 구조체보다 작아도 안전하도록 0 으로 채운 구조체에 받은 만큼만 복사
+		template<class T>
+		static void ReadBody(const PacketInfo& packetInfo, T& body)
+		{
+			memset((void*)&body, 0, sizeof(T));
+			if (packetInfo.pRefData == nullptr || packetInfo.PacketBodySize <= 0) {
+				return;
+			}
+
+			size_t copySize = std::min((size_t)packetInfo.PacketBodySize, sizeof(T));
+			memcpy((void*)&body, packetInfo.pRefData, copySize);
+		}
+
+		ERROR_CODE NtfSysConnctSession(PacketInfo packetInfo);
+		ERROR_CODE NtfSysCloseSession(PacketInfo packetInfo);
+		ERROR_CODE NtfSysSendBufferHigh(PacketInfo packetInfo);
+		ERROR_CODE NtfSysSendBufferLow(PacketInfo packetInfo);
+
+		// 다른 노드가 맡은 로비로 들어가거나 이미 들어간 유저의 로비/룸 패킷이면 그 노드로 넘기고 true
+		bool RouteClusterPacket(PacketInfo packetInfo);
+		// 다른 노드에서 넘어온 유저(프록시 세션)를 로그인 상태로 만듦
+		ERROR_CODE NtfSysClusterAttach(PacketInfo packetInfo);
+		// 다른 노드의 로비 입장 실패/퇴장 성공이면 다시 이 노드에서 처리
+		ERROR_CODE NtfSysClusterResult(PacketInfo packetInfo);
+
+		ERROR_CODE Login(PacketInfo packetInfo);
+		// 검증 결과를 기다렸다가 (실패면 LoginFailDelayMilliSec 만큼 더 기다렸다가) 응답
+		LogicTask LoginTask(LoginJob job);
+		ERROR_CODE LoginComplete(const LoginResult& loginResult);
+		// 로그인한 세션의 UDP 채널을 열고 토큰을 TCP 로 알려줌
+		void NotifyUdpInfo(const int sessionIndex);
+
+		ERROR_CODE LobbyList(PacketInfo packetInfo);
+		ERROR_CODE LobbyEnter(PacketInfo packetInfo);
+		// 스냅샷에서 되살린 자리가 있으면 로비와 룸에 한 번에 들어감
+		ERROR_CODE LobbyRejoin(PacketInfo packetInfo);
+		ERROR_CODE LobbyLeave(PacketInfo packetInfo);
+		ERROR_CODE LobbyChat(PacketInfo packetInfo);
+		ERROR_CODE LobbyRoomList(PacketInfo packetInfo);
+
+		ERROR_CODE RoomEnter(PacketInfo packetInfo);
+		// 새로 들어온 유저의 송신 버퍼가 차 있으면 비워질 때까지 기다렸다가 최근 룸 채팅을 보냄
+		LogicTask SendRoomChatHistory(const int sessionIndex, const short lobbyIndex, const short roomIndex);
+		ERROR_CODE RoomLeave(PacketInfo packetInfo);
+		ERROR_CODE RoomChat(PacketInfo packetInfo);
+		ERROR_CODE RoomMasterGameStart(PacketInfo packetInfo);
+		ERROR_CODE RoomGameStart(PacketInfo packetInfo);
+		ERROR_CODE RoomGameState(PacketInfo packetInfo);
+
+		ERROR_CODE DevEcho(PacketInfo packetInfo);
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+		TcpNet* m_pRefNetwork = nullptr;
+		UdpNet* m_pRefUdpNetwork = nullptr;
+		NServerNetLib::ClusterNetwork* m_pRefClusterNetwork = nullptr;
+
+		UserManager* m_pRefUserMgr = nullptr;
+		LobbyManager* m_pRefLobbyMgr = nullptr;
+		LoginWorkerPool* m_pRefLoginWorkerPool = nullptr;
+		CoroutineScheduler* m_pRefScheduler = nullptr;
+		const ChatFilter* m_pRefChatFilter = nullptr;
+		UserStore* m_pRefUserStore = nullptr;
+
+		uint32_t m_LoginFailDelayMilliSec = 0;
+
+		// 유저/로비/룸/접속 상태 보호 (로직 스레드의 코루틴 재개와 tick 도 EXCLUSIVE 로 잡음)
+		std::shared_mutex m_StateLock;
+
+		std::unique_ptr<ConnectedUserManager> m_pConnectedUserManager;
+		std::unique_ptr<FloodControl> m_pFloodControl;
+	};
+}
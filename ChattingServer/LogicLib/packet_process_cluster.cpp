@@ -0,0 +1,126 @@
+#include <cstring>
+
+#include "../ServerNetLib/cluster_network.h"
+#include "user_manager.h"
+#include "connected_user_manager.h"
+#include "packet_process.h"
+
+namespace NLogicLib
+{
+	using PACKET_ID = NCommon::PACKET_ID;
+
+	bool PacketProcess::RouteClusterPacket(PacketInfo packetInfo)
+	{
+		const auto sessionIndex = packetInfo.SessionIndex;
+
+		// 다른 노드에서 넘어온 유저의 패킷은 이미 로비를 맡은 노드(이 노드)에 와 있음
+		if (PacketClusterRouteArray[packetInfo.PacketId] == false || m_pRefClusterNetwork->IsProxySession(sessionIndex)) {
+			return false;
+		}
+
+		if (m_pRefClusterNetwork->IsAttached(sessionIndex)) {
+			m_pRefClusterNetwork->Forward(sessionIndex, packetInfo.PacketId, packetInfo.PacketBodySize, (const char*)packetInfo.pRefData);
+			return true;
+		}
+
+		if (packetInfo.PacketId != (short)PACKET_ID::LOBBY_ENTER_REQ) {
+			return false;
+		}
+
+		NCommon::PktLobbyEnterReq reqPkt;
+		ReadBody(packetInfo, reqPkt);
+
+		const auto ownerNodeId = m_pRefClusterNetwork->GetLobbyOwnerNode(reqPkt.LobbyId);
+		if (ownerNodeId == m_pRefClusterNetwork->GetNodeId()) {
+			return false;
+		}
+
+		std::string userID;
+		{
+			std::shared_lock<std::shared_mutex> lock(m_StateLock);
+
+			// 로그인 전이거나 이미 이 노드의 로비에 있으면 이 노드의 LobbyEnter 가 에러로 응답
+			auto [errorCode, pUser] = m_pRefUserMgr->GetUser(sessionIndex);
+			if (errorCode != ERROR_CODE::NONE || pUser->IsCurDomainInLogIn() == false) {
+				return false;
+			}
+
+			userID = pUser->GetID();
+		}
+
+		auto attachRet = m_pRefClusterNetwork->Attach(sessionIndex, ownerNodeId, userID.c_str());
+		if (attachRet == NServerNetLib::NET_ERROR_CODE::kNONE) {
+			attachRet = m_pRefClusterNetwork->Forward(sessionIndex, packetInfo.PacketId, packetInfo.PacketBodySize, (const char*)packetInfo.pRefData);
+		}
+
+		if (attachRet != NServerNetLib::NET_ERROR_CODE::kNONE) {
+			m_pRefClusterNetwork->Detach(sessionIndex);
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 로비(%d)를 맡은 노드(%d)로 보내기 실패. NetError(%d)", __FUNCTION__,
+				reqPkt.LobbyId, ownerNodeId, (int)attachRet);
+
+			NCommon::PktLobbyEnterRes resPkt{};
+			resPkt.SetError(ERROR_CODE::LOBBY_ENTER_NODE_UNAVAILABLE);
+			m_pRefNetwork->SendData(sessionIndex, (short)PACKET_ID::LOBBY_ENTER_RES, sizeof(resPkt), (char*)&resPkt);
+		}
+
+		return true;
+	}
+
+	ERROR_CODE PacketProcess::NtfSysClusterAttach(PacketInfo packetInfo)
+	{
+		// 다른 노드의 링크로 받아 ClusterNetwork 가 만든 프록시 세션만 (클라이언트 세션이면 검증 없는 로그인이 됨)
+		if (m_pRefClusterNetwork->IsProxySession(packetInfo.SessionIndex) == false) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 프록시 세션이 아닌 세션(%d)의 요청을 버림", __FUNCTION__, packetInfo.SessionIndex);
+			return ERROR_CODE::USER_MGR_INVALID_SESSION_INDEX;
+		}
+
+		// 유저가 접속한 노드에서 이미 로그인을 마쳤으므로 검증 없이 로그인 상태로 만듦
+		char szID[NCommon::MAX_USER_ID_SIZE + 1] = { 0, };
+		if (packetInfo.PacketBodySize > 0) {
+			memcpy(szID, packetInfo.pRefData, std::min((int)packetInfo.PacketBodySize, NCommon::MAX_USER_ID_SIZE));
+		}
+
+		auto addRet = m_pRefUserMgr->AddUser(packetInfo.SessionIndex, szID);
+		if (addRet != ERROR_CODE::NONE) {
+			// 프록시 세션은 유저 없이 남고, 넘어온 로비 입장 요청이 실패하면 유저가 접속한 노드가 Detach 함
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 다른 노드에서 온 유저(%s) 추가 실패. Error(%d)", __FUNCTION__, szID, (int)addRet);
+			return addRet;
+		}
+
+		m_pConnectedUserManager->SetLogin(packetInfo.SessionIndex);
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE PacketProcess::NtfSysClusterResult(PacketInfo packetInfo)
+	{
+		NServerNetLib::ClusterResultInfo resultInfo;
+		ReadBody(packetInfo, resultInfo);
+
+		const auto sessionIndex = packetInfo.SessionIndex;
+
+		// 다른 노드로 보낸(Attach) 이 노드의 클라이언트 세션에 대한 결과만
+		if (m_pRefClusterNetwork->IsProxySession(sessionIndex)) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 프록시 세션(%d)의 결과 알림을 버림", __FUNCTION__, sessionIndex);
+			return ERROR_CODE::USER_MGR_INVALID_SESSION_INDEX;
+		}
+
+		if (resultInfo.PacketId == (short)PACKET_ID::LOBBY_ENTER_RES) {
+			// 이미 들어간 뒤에 다시 보낸 입장 요청의 실패는 상태를 바꾸지 않음
+			if (m_pRefClusterNetwork->IsJoined(sessionIndex)) {
+				return ERROR_CODE::NONE;
+			}
+
+			if (resultInfo.ErrorCode == (short)ERROR_CODE::NONE) {
+				m_pRefClusterNetwork->SetJoined(sessionIndex);
+			}
+			else {
+				m_pRefClusterNetwork->Detach(sessionIndex);
+			}
+		}
+		else if (resultInfo.PacketId == (short)PACKET_ID::LOBBY_LEAVE_RES && resultInfo.ErrorCode == (short)ERROR_CODE::NONE) {
+			m_pRefClusterNetwork->Detach(sessionIndex);
+		}
+
+		return ERROR_CODE::NONE;
+	}
+}
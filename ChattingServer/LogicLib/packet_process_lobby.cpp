@@ -0,0 +1,246 @@
+#include <algorithm>
+
+#include "user_manager.h"
+#include "lobby_manager.h"
+#include "utf_codec.h"
+#include "chat_filter.h"
+#include "packet_process.h"
+
+namespace NLogicLib
+{
+	using PACKET_ID = NCommon::PACKET_ID;
+
+	ERROR_CODE PacketProcess::LobbyEnter(PacketInfo packetInfo)
+	{
+		NCommon::PktLobbyEnterRes resPkt{};
+
+		auto sendResult = [&](const ERROR_CODE errorCode) {
+			resPkt.SetError(errorCode);
+			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::LOBBY_ENTER_RES, sizeof(resPkt), (char*)&resPkt);
+			return errorCode;
+		};
+
+		NCommon::PktLobbyEnterReq reqPkt;
+		ReadBody(packetInfo, reqPkt);
+
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (errorCode != ERROR_CODE::NONE) {
+			return sendResult(errorCode);
+		}
+
+		if (pUser->IsCurDomainInLogIn() == false) {
+			return sendResult(ERROR_CODE::LOBBY_ENTER_INVALID_DOMAIN);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(reqPkt.LobbyId);
+		if (pLobby == nullptr) {
+			return sendResult(ERROR_CODE::LOBBY_ENTER_INVALID_LOBBY_INDEX);
+		}
+
+		auto enterRet = pLobby->EnterUser(pUser);
+		if (enterRet != ERROR_CODE::NONE) {
+			return sendResult(enterRet);
+		}
+
+		resPkt.MaxUserCount = pLobby->MaxUserCount();
+		resPkt.MaxRoomCount = pLobby->MaxRoomCount();
+		sendResult(ERROR_CODE::NONE);
+
+		// 입장 응답 뒤에 최근 로비 채팅을 이어서 보냄
+		pLobby->SendChatHistory(packetInfo.SessionIndex);
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE PacketProcess::LobbyRejoin(PacketInfo packetInfo)
+	{
+		NCommon::PktLobbyRejoinRes resPkt;
+
+		auto sendResult = [&](const ERROR_CODE errorCode) {
+			resPkt.SetError(errorCode);
+			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::LOBBY_REJOIN_RES, sizeof(resPkt), (char*)&resPkt);
+			return errorCode;
+		};
+
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (errorCode != ERROR_CODE::NONE) {
+			return sendResult(errorCode);
+		}
+
+		if (pUser->IsCurDomainInLogIn() == false) {
+			return sendResult(ERROR_CODE::LOBBY_REJOIN_INVALID_DOMAIN);
+		}
+
+		RejoinInfo rejoinInfo;
+		if (m_pRefLobbyMgr->PopRejoinInfo(pUser->GetID(), rejoinInfo) == false) {
+			return sendResult(ERROR_CODE::LOBBY_REJOIN_NOT_FOUND);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(rejoinInfo.LobbyIndex);
+		if (pLobby == nullptr) {
+			return sendResult(ERROR_CODE::LOBBY_REJOIN_NOT_FOUND);
+		}
+
+		auto enterRet = pLobby->EnterUser(pUser);
+		if (enterRet != ERROR_CODE::NONE) {
+			return sendResult(enterRet);
+		}
+
+		// 룸에 자리가 없거나 그 사이 닫히고 다른 룸이 만들어졌으면 로비에만 들어감
+		auto pRoom = m_pRefLobbyMgr->GetRejoinRoom(rejoinInfo);
+		if (pRoom != nullptr && pRoom->EnterUser(pUser) == ERROR_CODE::NONE) {
+			pUser->EnterRoom(pLobby->GetIndex(), pRoom->GetIndex());
+			pRoom->NotifyEnterUserInfo(pUser->GetSessioIndex(), pUser->GetID().c_str());
+			resPkt.RoomIndex = pRoom->GetIndex();
+		}
+		else {
+			pRoom = nullptr;
+		}
+
+		resPkt.LobbyId = pLobby->GetIndex();
+		resPkt.MaxUserCount = pLobby->MaxUserCount();
+		resPkt.MaxRoomCount = pLobby->MaxRoomCount();
+		sendResult(ERROR_CODE::NONE);
+
+		// 입장 응답 뒤에 들어간 곳의 최근 채팅을 이어서 보냄
+		if (pRoom != nullptr) {
+			SendRoomChatHistory(packetInfo.SessionIndex, pLobby->GetIndex(), pRoom->GetIndex());
+		}
+		else {
+			pLobby->SendChatHistory(packetInfo.SessionIndex);
+		}
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE PacketProcess::LobbyLeave(PacketInfo packetInfo)
+	{
+		NCommon::PktLobbyLeaveRes resPkt;
+
+		auto sendResult = [&](const ERROR_CODE errorCode) {
+			resPkt.SetError(errorCode);
+			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::LOBBY_LEAVE_RES, sizeof(resPkt), (char*)&resPkt);
+			return errorCode;
+		};
+
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (errorCode != ERROR_CODE::NONE) {
+			return sendResult(errorCode);
+		}
+
+		if (pUser->IsCurDomainInLobby() == false) {
+			return sendResult(ERROR_CODE::LOBBY_LEAVE_INVALID_DOMAIN);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return sendResult(ERROR_CODE::LOBBY_LEAVE_INVALID_LOBBY_INDEX);
+		}
+
+		auto leaveRet = pLobby->LeaveUser(pUser->GetIndex());
+		if (leaveRet != ERROR_CODE::NONE) {
+			return sendResult(leaveRet);
+		}
+
+		pUser->LeaveLobby();
+		return sendResult(ERROR_CODE::NONE);
+	}
+
+	ERROR_CODE PacketProcess::LobbyChat(PacketInfo packetInfo)
+	{
+		NCommon::PktLobbyChatRes resPkt;
+
+		auto sendResult = [&](const ERROR_CODE errorCode) {
+			resPkt.SetError(errorCode);
+			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::LOBBY_CHAT_RES, sizeof(resPkt), (char*)&resPkt);
+			return errorCode;
+		};
+
+		NCommon::PktLobbyChatReq reqPkt;
+		ReadBody(packetInfo, reqPkt);
+		reqPkt.Msg[NCommon::MAX_LOBBY_CHAT_MSG_SIZE] = u'\0';
+
+		// 길이를 세면서 잘못된 UTF-16 을 같이 걸러냄 (알림에는 센 길이만큼만 복사)
+		auto msgLength = ScanUtf16(reqPkt.Msg, NCommon::MAX_LOBBY_CHAT_MSG_SIZE);
+		if (msgLength < 0) {
+			return sendResult(ERROR_CODE::LOBBY_CHAT_INVALID_MSG);
+		}
+
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (errorCode != ERROR_CODE::NONE) {
+			return sendResult(errorCode);
+		}
+
+		if (pUser->IsCurDomainInLobby() == false) {
+			return sendResult(ERROR_CODE::LOBBY_CHAT_INVALID_DOMAIN);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return sendResult(ERROR_CODE::LOBBY_CHAT_INVALID_LOBBY_INDEX);
+		}
+
+		sendResult(ERROR_CODE::NONE);
+
+		// 금칙어는 가려서 보냄 (보관하는 최근 채팅에도 가려진 채로 남음)
+		m_pRefChatFilter->Filter(reqPkt.Msg, msgLength);
+
+		pLobby->NotifyChat(pUser->GetSessioIndex(), pUser->GetID().c_str(), reqPkt.Msg, msgLength);
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE PacketProcess::LobbyRoomList(PacketInfo packetInfo)
+	{
+		NCommon::PktLobbyRoomListRes resPkt;
+
+		// 담은 룸 수만큼만 보냄
+		auto sendResult = [&](const ERROR_CODE errorCode) {
+			resPkt.SetError(errorCode);
+			auto sendSize = (short)(sizeof(resPkt) - (NCommon::MAX_ROOM_LIST_COUNT - resPkt.RoomCount) * sizeof(NCommon::RoomListInfo));
+			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::LOBBY_ROOM_LIST_RES, sendSize, (char*)&resPkt);
+			return errorCode;
+		};
+
+		NCommon::PktLobbyRoomListReq reqPkt;
+		ReadBody(packetInfo, reqPkt);
+
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (errorCode != ERROR_CODE::NONE) {
+			return sendResult(errorCode);
+		}
+
+		if (pUser->IsCurDomainInLobby() == false) {
+			return sendResult(ERROR_CODE::LOBBY_ROOM_LIST_INVALID_DOMAIN);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return sendResult(ERROR_CODE::LOBBY_ROOM_LIST_INVALID_LOBBY_INDEX);
+		}
+
+		if (reqPkt.GameState < 0 || reqPkt.GameState >= RoomOccupancyIndex::GAME_STATE_COUNT) {
+			return sendResult(ERROR_CODE::LOBBY_ROOM_LIST_INVALID_GAME_STATE);
+		}
+
+		// 룸을 하나씩 훑지 않고 색인에서 가장 꽉 찬 룸부터 꺼냄
+		short roomIndexList[NCommon::MAX_ROOM_LIST_COUNT];
+		auto roomCount = pLobby->GetRoomList((Room::GAME_STATE)reqPkt.GameState, reqPkt.MinFreeSeatCount, roomIndexList, NCommon::MAX_ROOM_LIST_COUNT);
+
+		for (int32_t i = 0; i < roomCount; ++i)
+		{
+			auto pRoom = pLobby->GetRoom(roomIndexList[i]);
+			auto& info = resPkt.RoomList[i];
+
+			info.RoomIndex = pRoom->GetIndex();
+			info.RoomUserCount = pRoom->GetUserCount();
+			info.RoomMaxUserCount = pRoom->MaxUserCount();
+			info.GameState = (char)pRoom->GetGameState();
+
+			// 제목 뒤에 이전 스택 내용이 실려 가지 않도록 비우고 씀
+			std::fill(std::begin(info.RoomTitle), std::end(info.RoomTitle), u'\0');
+			auto& title = pRoom->GetTitle();
+			Utf8ToUtf16(title.c_str(), (int32_t)title.size(), info.RoomTitle, NCommon::MAX_ROOM_TITLE_SIZE);
+		}
+		resPkt.RoomCount = (short)roomCount;
+
+		return sendResult(ERROR_CODE::NONE);
+	}
+}
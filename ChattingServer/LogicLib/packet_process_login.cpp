@@ -0,0 +1,130 @@
+#include "user_manager.h"
+#include "lobby_manager.h"
+#include "connected_user_manager.h"
+#include "coroutine_scheduler.h"
+#include "user_store.h"
+#include "packet_process.h"
+
+namespace NLogicLib
+{
+	using PACKET_ID = NCommon::PACKET_ID;
+
+	ERROR_CODE PacketProcess::Login(PacketInfo packetInfo)
+	{
+		NCommon::PktLogInRes resPkt;
+
+		auto sendResult = [&](const ERROR_CODE errorCode) {
+			resPkt.SetError(errorCode);
+			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::LOGIN_IN_RES, sizeof(resPkt), (char*)&resPkt);
+			return errorCode;
+		};
+
+		NCommon::PktLogInReq reqPkt;
+		ReadBody(packetInfo, reqPkt);
+		// 클라이언트가 널 문자로 끝내지 않았을 수 있으므로 끝을 보장
+		reqPkt.szID[NCommon::MAX_USER_ID_SIZE] = '\0';
+		reqPkt.szPW[NCommon::MAX_USER_PASSWORD_SIZE] = '\0';
+
+		if (m_pConnectedUserManager->IsLoginPending(packetInfo.SessionIndex)) {
+			return sendResult(ERROR_CODE::LOGIN_ALREADY_PENDING);
+		}
+
+		auto [userErrorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (pUser != nullptr) {
+			return sendResult(ERROR_CODE::USER_MGR_ID_DUPLICATION);
+		}
+
+		// 검증은 워커 풀에서 하고 응답은 LoginTask 가 결과를 받은 뒤 LoginComplete 에서 보냄
+		LoginJob job;
+		job.SessionIndex = packetInfo.SessionIndex;
+		job.LoginSeq = m_pConnectedUserManager->SetLoginPending(packetInfo.SessionIndex);
+		memcpy(job.szID, reqPkt.szID, sizeof(job.szID));
+		memcpy(job.szPW, reqPkt.szPW, sizeof(job.szPW));
+		LoginTask(job);
+
+		memset(job.szPW, 0, sizeof(job.szPW));
+		memset(reqPkt.szPW, 0, sizeof(reqPkt.szPW));
+		return ERROR_CODE::NONE;
+	}
+
+	LogicTask PacketProcess::LoginTask(LoginJob job)
+	{
+		auto loginResult = co_await m_pRefLoginWorkerPool->Verify(job);
+		memset(job.szPW, 0, sizeof(job.szPW));
+
+		// 기다리는 동안에도 로그인 대기 상태이므로 같은 세션은 다시 시도할 수 없음
+		if (loginResult.Result != ERROR_CODE::NONE && m_LoginFailDelayMilliSec > 0) {
+			co_await m_pRefScheduler->Sleep(m_LoginFailDelayMilliSec);
+		}
+
+		LoginComplete(loginResult);
+	}
+
+	ERROR_CODE PacketProcess::LoginComplete(const LoginResult& loginResult)
+	{
+		// 검증하는 동안 끊긴 세션의 결과는 응답 없이 버림
+		if (m_pConnectedUserManager->EndLoginPending(loginResult.SessionIndex, loginResult.LoginSeq) == false) {
+			return ERROR_CODE::NONE;
+		}
+
+		NCommon::PktLogInRes resPkt;
+
+		auto sendResult = [&](const ERROR_CODE errorCode) {
+			resPkt.SetError(errorCode);
+			m_pRefNetwork->SendData(loginResult.SessionIndex, (short)PACKET_ID::LOGIN_IN_RES, sizeof(resPkt), (char*)&resPkt);
+			return errorCode;
+		};
+
+		if (loginResult.Result != ERROR_CODE::NONE) {
+			SERVER_LOG(m_pRefLogger, LOG_LEVEL::kL_DEBUG, "%s | 로그인 검증 실패. 세션 인덱스(%d), ErrorCode(%d)", __FUNCTION__,
+				loginResult.SessionIndex, (int)loginResult.Result);
+			m_pRefUserStore->RecordLogin(loginResult.szID, false);
+			return sendResult(loginResult.Result);
+		}
+
+		// 같은 ID 가 동시에 검증될 수 있으므로 중복 확인은 결과를 받은 뒤 로직 스레드에서 함
+		auto addRet = m_pRefUserMgr->AddUser(loginResult.SessionIndex, loginResult.szID);
+		if (addRet != ERROR_CODE::NONE) {
+			return sendResult(addRet);
+		}
+
+		m_pConnectedUserManager->SetLogin(loginResult.SessionIndex);
+		m_pRefUserStore->RecordLogin(loginResult.szID, true);
+
+		sendResult(ERROR_CODE::NONE);
+
+		NotifyUdpInfo(loginResult.SessionIndex);
+		return ERROR_CODE::NONE;
+	}
+
+	void PacketProcess::NotifyUdpInfo(const int sessionIndex)
+	{
+		if (m_pRefUdpNetwork == nullptr) {
+			return;
+		}
+
+		NCommon::PktLogInUdpInfoNtf ntfPkt;
+		ntfPkt.SessionIndex = sessionIndex;
+		ntfPkt.Token = m_pRefUdpNetwork->OpenSession(sessionIndex);
+		ntfPkt.Port = m_pRefUdpNetwork->GetPort();
+		m_pRefNetwork->SendData(sessionIndex, (short)PACKET_ID::LOGIN_UDP_INFO_NTF, sizeof(ntfPkt), (char*)&ntfPkt);
+	}
+
+	ERROR_CODE PacketProcess::LobbyList(PacketInfo packetInfo)
+	{
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (errorCode == ERROR_CODE::NONE && pUser->IsCurDomainInLogIn() == false) {
+			errorCode = ERROR_CODE::LOBBY_LIST_INVALID_DOMAIN;
+		}
+
+		if (errorCode != ERROR_CODE::NONE) {
+			NCommon::PktLobbyListRes resPkt;
+			resPkt.SetError(errorCode);
+			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::LOBBY_LIST_RES, sizeof(NCommon::PktBase), (char*)&resPkt);
+			return errorCode;
+		}
+
+		m_pRefLobbyMgr->SendLobbyListInfo(packetInfo.SessionIndex);
+		return ERROR_CODE::NONE;
+	}
+}
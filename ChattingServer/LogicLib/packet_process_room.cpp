@@ -0,0 +1,331 @@
+#include "user_manager.h"
+#include "lobby_manager.h"
+#include "connected_user_manager.h"
+#include "coroutine_scheduler.h"
+#include "utf_codec.h"
+#include "chat_filter.h"
+#include "packet_process.h"
+
+namespace NLogicLib
+{
+	using PACKET_ID = NCommon::PACKET_ID;
+
+	ERROR_CODE PacketProcess::RoomEnter(PacketInfo packetInfo)
+	{
+		NCommon::PktRoomEnterRes resPkt;
+
+		auto sendResult = [&](const ERROR_CODE errorCode) {
+			resPkt.SetError(errorCode);
+			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::ROOM_ENTER_RES, sizeof(resPkt), (char*)&resPkt);
+			return errorCode;
+		};
+
+		NCommon::PktRoomEnterReq reqPkt;
+		ReadBody(packetInfo, reqPkt);
+		reqPkt.RoomTitle[NCommon::MAX_ROOM_TITLE_SIZE] = u'\0';
+
+		auto titleLength = ScanUtf16(reqPkt.RoomTitle, NCommon::MAX_ROOM_TITLE_SIZE);
+		if (reqPkt.IsCreate && titleLength < 0) {
+			return sendResult(ERROR_CODE::ROOM_ENTER_INVALID_TITLE);
+		}
+
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (errorCode != ERROR_CODE::NONE) {
+			return sendResult(errorCode);
+		}
+
+		if (pUser->IsCurDomainInLobby() == false) {
+			return sendResult(ERROR_CODE::ROOM_ENTER_INVALID_DOMAIN);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return sendResult(ERROR_CODE::ROOM_ENTER_INVALID_LOBBY_INDEX);
+		}
+
+		Room* pRoom = nullptr;
+		if (reqPkt.IsCreate) {
+			pRoom = pLobby->CreateRoom();
+			if (pRoom == nullptr) {
+				return sendResult(ERROR_CODE::ROOM_ENTER_EMPTY_ROOM);
+			}
+
+			pRoom->CreateRoom(reqPkt.RoomTitle, titleLength);
+		}
+		else if (reqPkt.RoomIndex == NCommon::QUICK_ENTER_ROOM_INDEX) {
+			pRoom = pLobby->FindQuickEnterRoom();
+			if (pRoom == nullptr) {
+				return sendResult(ERROR_CODE::ROOM_ENTER_NO_OPEN_ROOM);
+			}
+		}
+		else {
+			pRoom = pLobby->GetRoom(reqPkt.RoomIndex);
+			if (pRoom == nullptr) {
+				return sendResult(ERROR_CODE::ROOM_ENTER_INVALID_ROOM_INDEX);
+			}
+		}
+
+		auto enterRet = pRoom->EnterUser(pUser);
+		if (enterRet != ERROR_CODE::NONE) {
+			return sendResult(enterRet);
+		}
+
+		pUser->EnterRoom(pLobby->GetIndex(), pRoom->GetIndex());
+
+		// 룸에 있던 유저에게 새로 들어온 유저를 알림
+		pRoom->NotifyEnterUserInfo(pUser->GetSessioIndex(), pUser->GetID().c_str());
+
+		resPkt.RoomIndex = pRoom->GetIndex();
+		sendResult(ERROR_CODE::NONE);
+
+		// 입장 응답 뒤에 최근 룸 채팅을 이어서 보냄
+		SendRoomChatHistory(packetInfo.SessionIndex, pLobby->GetIndex(), pRoom->GetIndex());
+		return ERROR_CODE::NONE;
+	}
+
+	LogicTask PacketProcess::SendRoomChatHistory(const int sessionIndex, const short lobbyIndex, const short roomIndex)
+	{
+		// 송신 버퍼가 고수위를 넘은 상태로 몰아서 보내면 대부분 버려지므로 비워질 때까지 기다림
+		if (m_pConnectedUserManager->IsSendLagging(sessionIndex)) {
+			if (co_await m_pRefScheduler->WaitSendDrain(sessionIndex) == false) {
+				co_return;
+			}
+
+			// 기다리는 동안 룸을 나갔거나 다른 룸에 들어갔을 수 있음
+			auto [errorCode, pUser] = m_pRefUserMgr->GetUser(sessionIndex);
+			if (errorCode != ERROR_CODE::NONE || pUser->IsCurDomainInRoom() == false
+				|| pUser->GetLobbyIndex() != lobbyIndex || pUser->GetRoomIndex() != roomIndex) {
+				co_return;
+			}
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(lobbyIndex);
+		auto pRoom = pLobby != nullptr ? pLobby->GetRoom(roomIndex) : nullptr;
+		if (pRoom != nullptr) {
+			pRoom->SendChatHistory(sessionIndex);
+		}
+	}
+
+	ERROR_CODE PacketProcess::RoomLeave(PacketInfo packetInfo)
+	{
+		NCommon::PktRoomLeaveRes resPkt;
+
+		auto sendResult = [&](const ERROR_CODE errorCode) {
+			resPkt.SetError(errorCode);
+			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::ROOM_LEAVE_RES, sizeof(resPkt), (char*)&resPkt);
+			return errorCode;
+		};
+
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (errorCode != ERROR_CODE::NONE) {
+			return sendResult(errorCode);
+		}
+
+		if (pUser->IsCurDomainInRoom() == false) {
+			return sendResult(ERROR_CODE::ROOM_LEAVE_INVALID_DOMAIN);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return sendResult(ERROR_CODE::ROOM_LEAVE_INVALID_LOBBY_INDEX);
+		}
+
+		auto pRoom = pLobby->GetRoom(pUser->GetRoomIndex());
+		if (pRoom == nullptr) {
+			return sendResult(ERROR_CODE::ROOM_LEAVE_INVALID_ROOM_INDEX);
+		}
+
+		auto leaveRet = pRoom->LeaveUser(pUser->GetIndex());
+		if (leaveRet != ERROR_CODE::NONE) {
+			return sendResult(leaveRet);
+		}
+
+		pUser->LeaveRoom();
+
+		// 룸에 남은 유저에게 나간 유저를 알림
+		pRoom->NotifyLeaveUserInfo(pUser->GetID().c_str());
+
+		return sendResult(ERROR_CODE::NONE);
+	}
+
+	ERROR_CODE PacketProcess::RoomChat(PacketInfo packetInfo)
+	{
+		NCommon::PktRoomChatRes resPkt;
+
+		auto sendResult = [&](const ERROR_CODE errorCode) {
+			resPkt.SetError(errorCode);
+			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::ROOM_CHAT_RES, sizeof(resPkt), (char*)&resPkt);
+			return errorCode;
+		};
+
+		NCommon::PktRoomChatReq reqPkt;
+		ReadBody(packetInfo, reqPkt);
+		reqPkt.Msg[NCommon::MAX_ROOM_CHAT_MSG_SIZE] = u'\0';
+
+		auto msgLength = ScanUtf16(reqPkt.Msg, NCommon::MAX_ROOM_CHAT_MSG_SIZE);
+		if (msgLength < 0) {
+			return sendResult(ERROR_CODE::ROOM_CHAT_INVALID_MSG);
+		}
+
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (errorCode != ERROR_CODE::NONE) {
+			return sendResult(errorCode);
+		}
+
+		if (pUser->IsCurDomainInRoom() == false) {
+			return sendResult(ERROR_CODE::ROOM_CHAT_INVALID_DOMAIN);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return sendResult(ERROR_CODE::ROOM_CHAT_INVALID_LOBBY_INDEX);
+		}
+
+		auto pRoom = pLobby->GetRoom(pUser->GetRoomIndex());
+		if (pRoom == nullptr) {
+			return sendResult(ERROR_CODE::ROOM_CHAT_INVALID_ROOM_INDEX);
+		}
+
+		sendResult(ERROR_CODE::NONE);
+
+		// 금칙어는 가려서 보냄 (보관하는 최근 채팅에도 가려진 채로 남음)
+		m_pRefChatFilter->Filter(reqPkt.Msg, msgLength);
+
+		pRoom->NotifyChat(pUser->GetSessioIndex(), pUser->GetID().c_str(), reqPkt.Msg, msgLength);
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE PacketProcess::RoomMasterGameStart(PacketInfo packetInfo)
+	{
+		NCommon::PktRoomMaterGameStartRes resPkt;
+
+		auto sendResult = [&](const ERROR_CODE errorCode) {
+			resPkt.SetError(errorCode);
+			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::ROOM_MASTER_GAME_START_RES, sizeof(resPkt), (char*)&resPkt);
+			return errorCode;
+		};
+
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (errorCode != ERROR_CODE::NONE) {
+			return sendResult(errorCode);
+		}
+
+		if (pUser->IsCurDomainInRoom() == false) {
+			return sendResult(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_DOMAIN);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return sendResult(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_LOBBY_INDEX);
+		}
+
+		auto pRoom = pLobby->GetRoom(pUser->GetRoomIndex());
+		if (pRoom == nullptr) {
+			return sendResult(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_ROOM_INDEX);
+		}
+
+		auto startRet = pRoom->MasterGameStart(pUser->GetIndex());
+		if (startRet != ERROR_CODE::NONE) {
+			return sendResult(startRet);
+		}
+
+		// 방장 이외의 유저에게 게임 시작 요청을 알림
+		pRoom->NotifyMasterGameStart(pUser->GetSessioIndex());
+
+		return sendResult(ERROR_CODE::NONE);
+	}
+
+	ERROR_CODE PacketProcess::RoomGameStart(PacketInfo packetInfo)
+	{
+		NCommon::PktRoomGameStartRes resPkt;
+
+		auto sendResult = [&](const ERROR_CODE errorCode) {
+			resPkt.SetError(errorCode);
+			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::ROOM_GAME_START_RES, sizeof(resPkt), (char*)&resPkt);
+			return errorCode;
+		};
+
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (errorCode != ERROR_CODE::NONE) {
+			return sendResult(errorCode);
+		}
+
+		if (pUser->IsCurDomainInRoom() == false) {
+			return sendResult(ERROR_CODE::ROOM_GAME_START_INVALID_DOMAIN);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return sendResult(ERROR_CODE::ROOM_GAME_START_INVALID_LOBBY_INDEX);
+		}
+
+		auto pRoom = pLobby->GetRoom(pUser->GetRoomIndex());
+		if (pRoom == nullptr) {
+			return sendResult(ERROR_CODE::ROOM_GAME_START_INVALID_ROOM_INDEX);
+		}
+
+		auto startRet = pRoom->GameStart(pUser->GetIndex());
+		if (startRet != ERROR_CODE::NONE) {
+			return sendResult(startRet);
+		}
+
+		pRoom->NotifyGameStart(pUser->GetSessioIndex(), pUser->GetID().c_str());
+
+		return sendResult(ERROR_CODE::NONE);
+	}
+
+	ERROR_CODE PacketProcess::RoomGameState(PacketInfo packetInfo)
+	{
+		// 틱마다 오는 상태라 응답 없이 버리고 에러 코드만 반환
+		if (m_pRefUdpNetwork == nullptr) {
+			return ERROR_CODE::ROOM_GAME_STATE_UDP_DISABLED;
+		}
+
+		auto [errorCode, pUser] = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		if (errorCode != ERROR_CODE::NONE) {
+			return errorCode;
+		}
+
+		if (pUser->IsCurDomainInRoom() == false) {
+			return ERROR_CODE::ROOM_GAME_STATE_INVALID_DOMAIN;
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return ERROR_CODE::ROOM_GAME_STATE_INVALID_LOBBY_INDEX;
+		}
+
+		auto pRoom = pLobby->GetRoom(pUser->GetRoomIndex());
+		if (pRoom == nullptr) {
+			return ERROR_CODE::ROOM_GAME_STATE_INVALID_ROOM_INDEX;
+		}
+
+		if (pRoom->GetGameState() != Room::GAME_STATE::ING) {
+			return ERROR_CODE::ROOM_GAME_STATE_NOT_STARTED;
+		}
+
+		NCommon::PktRoomGameStateReq reqPkt;
+		ReadBody(packetInfo, reqPkt);
+
+		int dataSize = reqPkt.DataSize;
+		int recvDataSize = packetInfo.PacketBodySize - (int)sizeof(reqPkt.DataSize);
+		dataSize = std::max(0, std::min({ dataSize, recvDataSize, NCommon::MAX_GAME_STATE_DATA_SIZE }));
+
+		NCommon::PktRoomGameStateNtf ntfPkt;
+		memcpy(ntfPkt.UserID, pUser->GetID().c_str(), strnlen(pUser->GetID().c_str(), NCommon::MAX_USER_ID_SIZE));
+		ntfPkt.DataSize = (short)dataSize;
+		memcpy(ntfPkt.Datas, reqPkt.Datas, dataSize);
+
+		// 사용하지 않는 Datas 뒷부분은 보내지 않음. 늦은 상태는 다음 상태로 덮이므로 재전송하지 않음
+		short sendSize = (short)(sizeof(ntfPkt) - NCommon::MAX_GAME_STATE_DATA_SIZE + dataSize);
+		for (auto pMember : pRoom->GetUserList()) {
+			if (pMember->GetSessioIndex() == packetInfo.SessionIndex) {
+				continue;
+			}
+
+			m_pRefUdpNetwork->SendData(pMember->GetSessioIndex(), (short)PACKET_ID::ROOM_GAME_STATE_NTF, sendSize, (char*)&ntfPkt, false);
+		}
+
+		return ERROR_CODE::NONE;
+	}
+}
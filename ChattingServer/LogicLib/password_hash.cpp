@@ -0,0 +1,192 @@
+#include <cstring>
+#include <vector>
+
+#include "password_hash.h"
+
+namespace NLogicLib
+{
+	namespace
+	{
+		constexpr uint32_t ROUND_CONSTANT[64] = {
+			0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+			0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+			0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+			0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+			0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+			0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+			0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+			0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+		};
+
+		inline uint32_t RotateRight(uint32_t value, int count)
+		{
+			return (value >> count) | (value << (32 - count));
+		}
+	}
+
+	Sha256::Sha256()
+	{
+		m_State[0] = 0x6a09e667;
+		m_State[1] = 0xbb67ae85;
+		m_State[2] = 0x3c6ef372;
+		m_State[3] = 0xa54ff53a;
+		m_State[4] = 0x510e527f;
+		m_State[5] = 0x9b05688c;
+		m_State[6] = 0x1f83d9ab;
+		m_State[7] = 0x5be0cd19;
+	}
+
+	void Sha256::Transform(const uint8_t* pBlock)
+	{
+		uint32_t w[64];
+		for (int i = 0; i < 16; ++i) {
+			w[i] = ((uint32_t)pBlock[i * 4] << 24) | ((uint32_t)pBlock[i * 4 + 1] << 16) |
+				((uint32_t)pBlock[i * 4 + 2] << 8) | (uint32_t)pBlock[i * 4 + 3];
+		}
+
+		for (int i = 16; i < 64; ++i) {
+			uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+
+		uint32_t a = m_State[0], b = m_State[1], c = m_State[2], d = m_State[3];
+		uint32_t e = m_State[4], f = m_State[5], g = m_State[6], h = m_State[7];
+
+		for (int i = 0; i < 64; ++i) {
+			uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+			uint32_t ch = (e & f) ^ (~e & g);
+			uint32_t temp1 = h + s1 + ch + ROUND_CONSTANT[i] + w[i];
+			uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+			uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+			uint32_t temp2 = s0 + maj;
+
+			h = g;
+			g = f;
+			f = e;
+			e = d + temp1;
+			d = c;
+			c = b;
+			b = a;
+			a = temp1 + temp2;
+		}
+
+		m_State[0] += a;
+		m_State[1] += b;
+		m_State[2] += c;
+		m_State[3] += d;
+		m_State[4] += e;
+		m_State[5] += f;
+		m_State[6] += g;
+		m_State[7] += h;
+	}
+
+	void Sha256::Update(const uint8_t* pData, size_t size)
+	{
+		m_TotalSize += size;
+
+		while (size > 0) {
+			size_t copySize = SHA256_BLOCK_SIZE - m_BufferSize;
+			if (copySize > size) {
+				copySize = size;
+			}
+
+			memcpy(&m_Buffer[m_BufferSize], pData, copySize);
+			m_BufferSize += copySize;
+			pData += copySize;
+			size -= copySize;
+
+			if (m_BufferSize == SHA256_BLOCK_SIZE) {
+				Transform(m_Buffer);
+				m_BufferSize = 0;
+			}
+		}
+	}
+
+	void Sha256::Final(uint8_t* pHash)
+	{
+		uint64_t totalBits = m_TotalSize * 8;
+
+		// 0x80 + 0 채우기 + 마지막 8 바이트에 전체 비트 길이(빅엔디안)
+		uint8_t padding[SHA256_BLOCK_SIZE * 2] = { 0x80 };
+		size_t paddingSize = (m_BufferSize < 56) ? (56 - m_BufferSize) : (120 - m_BufferSize);
+		Update(padding, paddingSize);
+
+		uint8_t lengthBytes[8];
+		for (int i = 0; i < 8; ++i) {
+			lengthBytes[i] = (uint8_t)(totalBits >> (56 - i * 8));
+		}
+		Update(lengthBytes, 8);
+
+		for (int i = 0; i < 8; ++i) {
+			pHash[i * 4] = (uint8_t)(m_State[i] >> 24);
+			pHash[i * 4 + 1] = (uint8_t)(m_State[i] >> 16);
+			pHash[i * 4 + 2] = (uint8_t)(m_State[i] >> 8);
+			pHash[i * 4 + 3] = (uint8_t)(m_State[i]);
+		}
+	}
+
+	void HmacSha256(const uint8_t* pKey, size_t keySize, const uint8_t* pData, size_t dataSize, uint8_t* pHash)
+	{
+		uint8_t keyBlock[SHA256_BLOCK_SIZE] = { 0 };
+		if (keySize > SHA256_BLOCK_SIZE) {
+			Sha256 keyHash;
+			keyHash.Update(pKey, keySize);
+			keyHash.Final(keyBlock);
+		}
+		else {
+			memcpy(keyBlock, pKey, keySize);
+		}
+
+		uint8_t innerPad[SHA256_BLOCK_SIZE];
+		uint8_t outerPad[SHA256_BLOCK_SIZE];
+		for (size_t i = 0; i < SHA256_BLOCK_SIZE; ++i) {
+			innerPad[i] = keyBlock[i] ^ 0x36;
+			outerPad[i] = keyBlock[i] ^ 0x5c;
+		}
+
+		uint8_t innerHash[SHA256_HASH_SIZE];
+		Sha256 inner;
+		inner.Update(innerPad, SHA256_BLOCK_SIZE);
+		inner.Update(pData, dataSize);
+		inner.Final(innerHash);
+
+		Sha256 outer;
+		outer.Update(outerPad, SHA256_BLOCK_SIZE);
+		outer.Update(innerHash, SHA256_HASH_SIZE);
+		outer.Final(pHash);
+	}
+
+	void Pbkdf2Sha256(const uint8_t* pPassword, size_t passwordSize, const uint8_t* pSalt, size_t saltSize,
+		uint32_t iterationCount, uint8_t* pOut, size_t outSize)
+	{
+		std::vector<uint8_t> saltBlock(saltSize + 4);
+		memcpy(saltBlock.data(), pSalt, saltSize);
+
+		uint32_t blockIndex = 1;
+		while (outSize > 0) {
+			saltBlock[saltSize] = (uint8_t)(blockIndex >> 24);
+			saltBlock[saltSize + 1] = (uint8_t)(blockIndex >> 16);
+			saltBlock[saltSize + 2] = (uint8_t)(blockIndex >> 8);
+			saltBlock[saltSize + 3] = (uint8_t)(blockIndex);
+
+			uint8_t u[SHA256_HASH_SIZE];
+			uint8_t t[SHA256_HASH_SIZE];
+			HmacSha256(pPassword, passwordSize, saltBlock.data(), saltBlock.size(), u);
+			memcpy(t, u, SHA256_HASH_SIZE);
+
+			for (uint32_t i = 1; i < iterationCount; ++i) {
+				HmacSha256(pPassword, passwordSize, u, SHA256_HASH_SIZE, u);
+				for (size_t j = 0; j < SHA256_HASH_SIZE; ++j) {
+					t[j] ^= u[j];
+				}
+			}
+
+			size_t copySize = outSize < SHA256_HASH_SIZE ? outSize : SHA256_HASH_SIZE;
+			memcpy(pOut, t, copySize);
+			pOut += copySize;
+			outSize -= copySize;
+			++blockIndex;
+		}
+	}
+}
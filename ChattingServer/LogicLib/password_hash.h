@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace NLogicLib
+{
+	constexpr size_t SHA256_HASH_SIZE = 32;
+	constexpr size_t SHA256_BLOCK_SIZE = 64;
+
+	class Sha256
+	{
+	public:
+		Sha256();
+
+		void Update(const uint8_t* pData, size_t size);
+		void Final(uint8_t* pHash);
+
+	private:
+		void Transform(const uint8_t* pBlock);
+
+		uint32_t m_State[8];
+		uint64_t m_TotalSize = 0;
+		uint8_t m_Buffer[SHA256_BLOCK_SIZE];
+		size_t m_BufferSize = 0;
+	};
+
+	void HmacSha256(const uint8_t* pKey, size_t keySize, const uint8_t* pData, size_t dataSize, uint8_t* pHash);
+
+	// 솔트 + 반복 횟수로 일부러 느리게 만든 비밀번호 해시 (PBKDF2-HMAC-SHA256)
+	void Pbkdf2Sha256(const uint8_t* pPassword, size_t passwordSize, const uint8_t* pSalt, size_t saltSize,
+		uint32_t iterationCount, uint8_t* pOut, size_t outSize);
+}
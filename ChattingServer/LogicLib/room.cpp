@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <cstring>
+
+#include "../Common/Packet.h"
+#include "utf_codec.h"
+#include "room.h"
+
+namespace NLogicLib
+{
+	using PACKET_ID = NCommon::PACKET_ID;
+
+	Room::Room()
+	{
+	}
+
+	Room::~Room()
+	{
+	}
+
+	void Room::Init(const short index, const short maxUserCount, const short chatHistoryCount)
+	{
+		m_Index = index;
+		m_MaxUserCount = maxUserCount;
+
+		m_ChatHistory.Init(chatHistoryCount, (int16_t)PACKET_ID::ROOM_CHAT_NTF, sizeof(NCommon::PktRoomChatNtf));
+
+		// 최대 인원만큼 미리 잡아 두어 입장할 때 재할당이 없도록 함
+		m_UserList.reserve(maxUserCount);
+		m_GameStartUserList.reserve(maxUserCount);
+	}
+
+	void Room::SetNetwork(TcpNet* pNetwork, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_pRefNetwork = pNetwork;
+	}
+
+	void Room::SetTopic(TopicHub* pTopicHub, const int32_t topicId, const int32_t lobbyTopicId)
+	{
+		m_pRefTopicHub = pTopicHub;
+		m_TopicId = topicId;
+		m_LobbyTopicId = lobbyTopicId;
+	}
+
+	void Room::Clear()
+	{
+		m_IsUsed = false;
+		m_Title.clear();
+		m_UserList.clear();
+		m_GameState = GAME_STATE::NONE;
+		m_GameStartUserList.clear();
+		// 재사용되는 룸에 이전 룸의 채팅이 남지 않도록 비움
+		m_ChatHistory.Clear();
+	}
+
+	void Room::CreateRoom(const char16_t* pRoomTitle, const int titleLength)
+	{
+		m_IsUsed = true;
+		++m_Generation;
+
+		// 제목은 로그/목록에서 바로 쓰도록 UTF-8 로 바꿔 둠
+		char szTitle[NCommon::MAX_ROOM_TITLE_SIZE * MAX_UTF8_SIZE_PER_UTF16 + 1] = { 0, };
+		auto titleSize = Utf16ToUtf8(pRoomTitle, std::min(titleLength, NCommon::MAX_ROOM_TITLE_SIZE), szTitle, sizeof(szTitle) - 1);
+		m_Title.assign(szTitle, titleSize > 0 ? titleSize : 0);
+
+		UpdateOccupancy();
+	}
+
+	void Room::Restore(const char16_t* pRoomTitle, const int titleLength, const GAME_STATE gameState)
+	{
+		m_GameState = gameState == GAME_STATE::ING ? GAME_STATE::ING : GAME_STATE::NONE;
+		CreateRoom(pRoomTitle, titleLength);
+	}
+
+	bool Room::CloseIfEmpty()
+	{
+		if (m_IsUsed == false || m_UserList.empty() == false) {
+			return false;
+		}
+
+		Clear();
+		UpdateOccupancy();
+		return true;
+	}
+
+	ERROR_CODE Room::EnterUser(User* pUser)
+	{
+		if (m_IsUsed == false) {
+			return ERROR_CODE::ROOM_ENTER_NOT_CREATED;
+		}
+
+		if (m_UserList.size() == (size_t)m_MaxUserCount) {
+			return ERROR_CODE::ROOM_ENTER_MEMBER_FULL;
+		}
+
+		m_UserList.push_back(pUser);
+
+		m_pRefTopicHub->Unsubscribe(m_LobbyTopicId, pUser->GetSessioIndex());
+		m_pRefTopicHub->Subscribe(m_TopicId, pUser->GetSessioIndex());
+
+		UpdateOccupancy();
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE Room::LeaveUser(const short userIndex)
+	{
+		if (m_IsUsed == false) {
+			return ERROR_CODE::ROOM_LEAVE_NOT_CREATED;
+		}
+
+		auto iter = std::find_if(m_UserList.begin(), m_UserList.end(),
+			[userIndex](User* pUser) { return pUser->GetIndex() == userIndex; });
+		if (iter == m_UserList.end()) {
+			return ERROR_CODE::ROOM_LEAVE_NOT_MEMBER;
+		}
+
+		m_pRefTopicHub->Unsubscribe(m_TopicId, (*iter)->GetSessioIndex());
+		m_pRefTopicHub->Subscribe(m_LobbyTopicId, (*iter)->GetSessioIndex());
+
+		m_UserList.erase(iter);
+
+		// 게임 시작 대기 중에 누가 나가면 시작 요청을 처음부터 다시 받음
+		if (m_GameState == GAME_STATE::WAITING) {
+			m_GameState = GAME_STATE::NONE;
+			m_GameStartUserList.clear();
+		}
+
+		if (m_UserList.empty()) {
+			Clear();
+		}
+
+		UpdateOccupancy();
+		return ERROR_CODE::NONE;
+	}
+
+	bool Room::IsMaster(const short userIndex) const
+	{
+		if (m_UserList.empty()) {
+			return false;
+		}
+
+		return m_UserList.front()->GetIndex() == userIndex;
+	}
+
+	ERROR_CODE Room::MasterGameStart(const short userIndex)
+	{
+		if (IsMaster(userIndex) == false) {
+			return ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_MASTER;
+		}
+
+		if (m_GameState != GAME_STATE::NONE) {
+			return ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_GAME_STATE;
+		}
+
+		if (m_UserList.size() < 2) {
+			return ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_USER_COUNT;
+		}
+
+		m_GameState = GAME_STATE::WAITING;
+		m_GameStartUserList.clear();
+
+		UpdateOccupancy();
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE Room::GameStart(const short userIndex)
+	{
+		if (m_GameState != GAME_STATE::WAITING) {
+			return ERROR_CODE::ROOM_GAME_START_INVALID_GAME_STATE;
+		}
+
+		if (IsMaster(userIndex)) {
+			return ERROR_CODE::ROOM_GAME_START_MASTER_USER;
+		}
+
+		auto iter = std::find(m_GameStartUserList.begin(), m_GameStartUserList.end(), userIndex);
+		if (iter != m_GameStartUserList.end()) {
+			return ERROR_CODE::ROOM_GAME_START_ALREADY_REQUESTED;
+		}
+
+		m_GameStartUserList.push_back(userIndex);
+
+		// 방장을 뺀 모든 유저가 시작 요청을 보내면 게임 시작
+		if (m_GameStartUserList.size() == (m_UserList.size() - 1)) {
+			m_GameState = GAME_STATE::ING;
+			UpdateOccupancy();
+		}
+
+		return ERROR_CODE::NONE;
+	}
+
+	void Room::UpdateOccupancy()
+	{
+		if (m_pRefOccupancyIndex != nullptr) {
+			m_pRefOccupancyIndex->Update(m_Index, m_IsUsed, (int32_t)m_GameState, GetUserCount());
+		}
+	}
+
+	void Room::SendToAllUser(const short packetId, const short dataSize, const char* pData, const int passSessionIndex)
+	{
+		m_pRefTopicHub->Publish(m_TopicId, packetId, dataSize, pData, passSessionIndex);
+	}
+
+	void Room::NotifyEnterUserInfo(const int sessionIndex, const char* pszUserID)
+	{
+		NCommon::PktRoomEnterUserInfoNtf pkt;
+		memcpy(pkt.UserID, pszUserID, strnlen(pszUserID, NCommon::MAX_USER_ID_SIZE));
+
+		SendToAllUser((short)PACKET_ID::ROOM_ENTER_NEW_USER_NTF, sizeof(pkt), (char*)&pkt, sessionIndex);
+	}
+
+	void Room::NotifyLeaveUserInfo(const char* pszUserID)
+	{
+		if (m_IsUsed == false) {
+			return;
+		}
+
+		NCommon::PktRoomLeaveUserInfoNtf pkt;
+		memcpy(pkt.UserID, pszUserID, strnlen(pszUserID, NCommon::MAX_USER_ID_SIZE));
+
+		SendToAllUser((short)PACKET_ID::ROOM_LEAVE_USER_NTF, sizeof(pkt), (char*)&pkt);
+	}
+
+	void Room::NotifyChat(const int sessionIndex, const char* pszUserID, const char16_t* pMsg, const int msgLength)
+	{
+		NCommon::PktRoomChatNtf pkt;
+		memcpy(pkt.UserID, pszUserID, strnlen(pszUserID, NCommon::MAX_USER_ID_SIZE));
+		memcpy(pkt.Msg, pMsg, std::min(msgLength, NCommon::MAX_ROOM_CHAT_MSG_SIZE) * sizeof(char16_t));
+
+		m_ChatHistory.Add((char*)&pkt, sizeof(pkt));
+
+		SendToAllUser((short)PACKET_ID::ROOM_CHAT_NTF, sizeof(pkt), (char*)&pkt, sessionIndex);
+	}
+
+	void Room::SendChatHistory(const int sessionIndex)
+	{
+		m_ChatHistory.SendTo(m_pRefNetwork, sessionIndex);
+	}
+
+	void Room::NotifyMasterGameStart(const int sessionIndex)
+	{
+		// 바디가 없는 통보
+		SendToAllUser((short)PACKET_ID::ROOM_MASTER_GAME_START_NTF, 0, nullptr, sessionIndex);
+	}
+
+	void Room::NotifyGameStart(const int sessionIndex, const char* pszUserID)
+	{
+		NCommon::PktRoomGameStartNtf pkt;
+		memcpy(pkt.UserID, pszUserID, strnlen(pszUserID, NCommon::MAX_USER_ID_SIZE));
+
+		SendToAllUser((short)PACKET_ID::ROOM_GAME_START_NTF, sizeof(pkt), (char*)&pkt, sessionIndex);
+	}
+}
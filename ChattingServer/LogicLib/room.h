@@ -0,0 +1,125 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "../ServerNetLib/interface_tcp_network.h"
+#include "../Common/error_code.h"
+#include "user.h"
+#include "chat_history.h"
+#include "topic_hub.h"
+#include "room_occupancy_index.h"
+
+namespace NLogicLib
+{
+	using TcpNet = NServerNetLib::ITcpNetwork;
+	using ILog = NServerNetLib::ILog;
+	using ERROR_CODE = NCommon::ERROR_CODE;
+
+	class Room
+	{
+	public:
+		// 방장이 시작 요청(WAITING) -> 나머지 유저가 모두 시작 요청(ING)
+		enum class GAME_STATE
+		{
+			NONE = 0,
+			WAITING = 1,
+			ING = 2,
+		};
+
+	public:
+		Room();
+		virtual ~Room();
+
+		void Init(const short index, const short maxUserCount, const short chatHistoryCount);
+
+		void SetNetwork(TcpNet* pNetwork, ILog* pLogger);
+
+		// 룸에 들어오면 로비 토픽에서 룸 토픽으로 옮기고, 나가면 되돌림
+		void SetTopic(TopicHub* pTopicHub, const int32_t topicId, const int32_t lobbyTopicId);
+
+		// 입장/퇴장/게임 상태가 바뀔 때마다 로비의 색인에 알림
+		void SetOccupancyIndex(RoomOccupancyIndex* pOccupancyIndex) { m_pRefOccupancyIndex = pOccupancyIndex; }
+
+		void Clear();
+
+		short GetIndex() const { return m_Index; }
+
+		bool IsUsed() const { return m_IsUsed; }
+
+		// CreateRoom 마다 늘어남 (같은 자리에 새로 만든 룸을 이전 룸과 구분)
+		uint32_t GetGeneration() const { return m_Generation; }
+
+		short MaxUserCount() const { return m_MaxUserCount; }
+
+		short GetUserCount() const { return (short)m_UserList.size(); }
+
+		GAME_STATE GetGameState() const { return m_GameState; }
+
+		const std::vector<User*>& GetUserList() const { return m_UserList; }
+
+		// titleLength 는 검사가 끝난 pRoomTitle 의 길이 (UTF-16 유닛 수)
+		void CreateRoom(const char16_t* pRoomTitle, const int titleLength);
+
+		// 스냅샷에서 되살린 룸. 시작 요청을 모으던 중(WAITING)이면 누가 요청했는지는 남기지 않으므로 처음(NONE)부터 다시
+		void Restore(const char16_t* pRoomTitle, const int titleLength, const GAME_STATE gameState);
+
+		// 유저가 없는 룸이면 닫고 true
+		bool CloseIfEmpty();
+
+		// UTF-8
+		const std::string& GetTitle() const { return m_Title; }
+
+		ERROR_CODE EnterUser(User* pUser);
+
+		ERROR_CODE LeaveUser(const short userIndex);
+
+		// 먼저 들어온 유저가 방장
+		bool IsMaster(const short userIndex) const;
+
+		ERROR_CODE MasterGameStart(const short userIndex);
+
+		ERROR_CODE GameStart(const short userIndex);
+
+		void SendToAllUser(const short packetId, const short dataSize, const char* pData, const int passSessionIndex = -1);
+
+		void NotifyEnterUserInfo(const int sessionIndex, const char* pszUserID);
+
+		void NotifyLeaveUserInfo(const char* pszUserID);
+
+		void NotifyChat(const int sessionIndex, const char* pszUserID, const char16_t* pMsg, const int msgLength);
+
+		// 새로 들어온 유저에게 최근 채팅을 한 번에 보냄
+		void SendChatHistory(const int sessionIndex);
+
+		void NotifyMasterGameStart(const int sessionIndex);
+
+		void NotifyGameStart(const int sessionIndex, const char* pszUserID);
+
+	private:
+		void UpdateOccupancy();
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+		TcpNet* m_pRefNetwork = nullptr;
+		TopicHub* m_pRefTopicHub = nullptr;
+		int32_t m_TopicId = -1;
+		int32_t m_LobbyTopicId = -1;
+		RoomOccupancyIndex* m_pRefOccupancyIndex = nullptr;
+
+		short m_Index = -1;
+		short m_MaxUserCount = 0;
+
+		bool m_IsUsed = false;
+		uint32_t m_Generation = 0;
+		std::string m_Title;
+
+		std::vector<User*> m_UserList;
+
+		GAME_STATE m_GameState = GAME_STATE::NONE;
+		// 방장의 시작 요청 후 시작 요청을 보낸 유저 인덱스
+		std::vector<short> m_GameStartUserList;
+
+		ChatHistory m_ChatHistory;
+	};
+}
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <bit>
+
+#include "room_occupancy_index.h"
+
+namespace NLogicLib
+{
+	void RoomOccupancyIndex::Init(const short roomCount, const short maxRoomUserCount)
+	{
+		m_MaxRoomUserCount = maxRoomUserCount;
+
+		m_LinkList.assign(roomCount, Link());
+		m_HeadList.assign(GetBucket(GAME_STATE_COUNT, 0), -1);
+		std::fill(std::begin(m_NonEmptyMaskList), std::end(m_NonEmptyMaskList), 0);
+
+		// 앞에 넣으므로 뒤에서부터 넣어야 0 번 룸부터 만들어짐
+		for (int i = roomCount - 1; i >= 0; --i) {
+			LinkFront(UNUSED_BUCKET, (short)i);
+		}
+	}
+
+	void RoomOccupancyIndex::Update(const short roomIndex, const bool isUsed, const int32_t gameState, const short userCount)
+	{
+		if (roomIndex < 0 || roomIndex >= (short)m_LinkList.size()) {
+			return;
+		}
+
+		auto bucket = UNUSED_BUCKET;
+		if (isUsed && gameState >= 0 && gameState < GAME_STATE_COUNT) {
+			auto freeSeatCount = std::clamp(m_MaxRoomUserCount - userCount, 0, MAX_FREE_SEAT_BUCKET);
+			bucket = GetBucket(gameState, freeSeatCount);
+		}
+
+		if (m_LinkList[roomIndex].Bucket == bucket) {
+			return;
+		}
+
+		Unlink(roomIndex);
+		LinkFront(bucket, roomIndex);
+	}
+
+	short RoomOccupancyIndex::FindFullestRoom(const int32_t gameState, const short minFreeSeatCount) const
+	{
+		auto mask = GetBucketMask(gameState, minFreeSeatCount);
+		if (mask == 0) {
+			return -1;
+		}
+
+		return m_HeadList[GetBucket(gameState, std::countr_zero(mask))];
+	}
+
+	int32_t RoomOccupancyIndex::GetRoomList(const int32_t gameState, const short minFreeSeatCount, short* pRoomIndexList, const int32_t maxCount) const
+	{
+		int32_t count = 0;
+
+		// 켜진 버킷만 빈 자리가 적은 것부터 들름
+		auto mask = GetBucketMask(gameState, minFreeSeatCount);
+		while (mask != 0 && count < maxCount) {
+			const auto freeSeatCount = std::countr_zero(mask);
+			mask &= mask - 1;
+
+			for (auto roomIndex = m_HeadList[GetBucket(gameState, freeSeatCount)]; roomIndex >= 0 && count < maxCount; roomIndex = m_LinkList[roomIndex].Next) {
+				pRoomIndexList[count++] = roomIndex;
+			}
+		}
+
+		return count;
+	}
+
+	uint64_t RoomOccupancyIndex::GetBucketMask(const int32_t gameState, const short minFreeSeatCount) const
+	{
+		if (gameState < 0 || gameState >= GAME_STATE_COUNT) {
+			return 0;
+		}
+
+		auto minBucket = std::clamp((int32_t)minFreeSeatCount, 0, MAX_FREE_SEAT_BUCKET);
+		return m_NonEmptyMaskList[gameState] & (~0ULL << minBucket);
+	}
+
+	void RoomOccupancyIndex::LinkFront(const int32_t bucket, const short roomIndex)
+	{
+		auto& link = m_LinkList[roomIndex];
+		link.Bucket = bucket;
+		link.Prev = -1;
+		link.Next = m_HeadList[bucket];
+
+		if (link.Next >= 0) {
+			m_LinkList[link.Next].Prev = roomIndex;
+		}
+		m_HeadList[bucket] = roomIndex;
+
+		if (bucket != UNUSED_BUCKET) {
+			const auto stateBucket = bucket - 1;
+			m_NonEmptyMaskList[stateBucket / (MAX_FREE_SEAT_BUCKET + 1)] |= 1ULL << (stateBucket % (MAX_FREE_SEAT_BUCKET + 1));
+		}
+	}
+
+	void RoomOccupancyIndex::Unlink(const short roomIndex)
+	{
+		auto& link = m_LinkList[roomIndex];
+		const auto bucket = link.Bucket;
+		if (bucket < 0) {
+			return;
+		}
+
+		if (link.Prev >= 0) {
+			m_LinkList[link.Prev].Next = link.Next;
+		}
+		else {
+			m_HeadList[bucket] = link.Next;
+		}
+
+		if (link.Next >= 0) {
+			m_LinkList[link.Next].Prev = link.Prev;
+		}
+
+		link = Link();
+
+		// 버킷이 비면 찾을 때 들르지 않도록 비트를 끔
+		if (bucket != UNUSED_BUCKET && m_HeadList[bucket] < 0) {
+			const auto stateBucket = bucket - 1;
+			m_NonEmptyMaskList[stateBucket / (MAX_FREE_SEAT_BUCKET + 1)] &= ~(1ULL << (stateBucket % (MAX_FREE_SEAT_BUCKET + 1)));
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace NLogicLib
+{
+	// 로비 하나의 룸을 (게임 상태, 빈 자리 수) 버킷별 연결 리스트로 나눠 둔 색인 (빠른 입장, 룸 목록 필터)
+	// - 룸마다 이전/다음/버킷 링크 한 칸을 미리 잡아 두고 룸 인덱스로 잇는 침투형(intrusive) 리스트라서 옮길 때 할당이 없음
+	// - 게임 상태마다 비어 있지 않은 버킷의 비트마스크를 두어 "빈 자리가 N 개 이상인 가장 꽉 찬 룸" 을 countr_zero 한 번으로 찾음
+	// - 사용하지 않는 룸도 리스트 하나로 모아 두어 룸 만들기도 룸 수와 상관없이 바로 찾음
+	// 룸 상태가 바뀔 때마다 Room 이 Update 를 호출 (상태 잠금 EXCLUSIVE 안), 찾기는 SHARED 이상 안에서 호출
+	class RoomOccupancyIndex
+	{
+	public:
+		// Room::GAME_STATE 의 개수
+		static constexpr int32_t GAME_STATE_COUNT = 3;
+		// 빈 자리 수 버킷은 비트마스크 하나에 들어가는 만큼 (더 많이 빈 룸은 마지막 버킷에 같이 둠)
+		static constexpr int32_t MAX_FREE_SEAT_BUCKET = 63;
+
+		void Init(const short roomCount, const short maxRoomUserCount);
+
+		// 버킷이 바뀌지 않으면 아무것도 하지 않음
+		void Update(const short roomIndex, const bool isUsed, const int32_t gameState, const short userCount);
+
+		// 사용하지 않는 룸 (없으면 -1)
+		short GetUnusedRoom() const { return m_HeadList[UNUSED_BUCKET]; }
+
+		// gameState 이고 빈 자리가 minFreeSeatCount 이상인 룸 중 가장 꽉 찬 룸 (없으면 -1)
+		short FindFullestRoom(const int32_t gameState, const short minFreeSeatCount) const;
+
+		// 위 조건의 룸을 가장 꽉 찬 것부터 maxCount 개까지 pRoomIndexList 에 담고 담은 수를 돌려줌
+		int32_t GetRoomList(const int32_t gameState, const short minFreeSeatCount, short* pRoomIndexList, const int32_t maxCount) const;
+
+	private:
+		struct Link
+		{
+			short Prev = -1;
+			short Next = -1;
+			int32_t Bucket = -1;
+		};
+
+		static constexpr int32_t UNUSED_BUCKET = 0;
+
+		static int32_t GetBucket(const int32_t gameState, const int32_t freeSeatCount) { return 1 + gameState * (MAX_FREE_SEAT_BUCKET + 1) + freeSeatCount; }
+
+		// minFreeSeatCount 이상인 버킷의 비트
+		uint64_t GetBucketMask(const int32_t gameState, const short minFreeSeatCount) const;
+
+		void LinkFront(const int32_t bucket, const short roomIndex);
+		void Unlink(const short roomIndex);
+
+	private:
+		short m_MaxRoomUserCount = 0;
+
+		std::vector<Link> m_LinkList;
+		std::vector<short> m_HeadList;
+
+		// 게임 상태별로 룸이 하나라도 있는 빈 자리 수 버킷의 비트
+		uint64_t m_NonEmptyMaskList[GAME_STATE_COUNT] = { 0, };
+	};
+}
@@ -0,0 +1,262 @@
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <filesystem>
+
+#include "utf_codec.h"
+#include "state_snapshot.h"
+
+namespace NLogicLib
+{
+	using LOG_LEVEL = NServerNetLib::LOG_LEVEL;
+
+	namespace
+	{
+		constexpr char SNAPSHOT_MAGIC[4] = { 'S', 'N', 'A', 'P' };
+		// 깨진 헤더로 큰 메모리를 잡지 않도록
+		constexpr int32_t MAX_SNAPSHOT_ENTRY_COUNT = 1 << 22;
+
+		int64_t NowUnixTime()
+		{
+			return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		}
+
+		// FNV-1a
+		uint32_t Checksum(const SnapshotImage& image)
+		{
+			uint32_t hash = 2166136261u;
+			auto mix = [&hash](const void* pData, const size_t size) {
+				auto pByte = static_cast<const uint8_t*>(pData);
+				for (size_t i = 0; i < size; ++i) {
+					hash = (hash ^ pByte[i]) * 16777619u;
+				}
+			};
+
+			mix(image.RoomList.data(), image.RoomList.size() * sizeof(SnapshotRoom));
+			mix(image.UserList.data(), image.UserList.size() * sizeof(SnapshotUser));
+			return hash;
+		}
+
+		bool SyncFile(FILE* pFile)
+		{
+			if (fflush(pFile) != 0) {
+				return false;
+			}
+#ifdef _WIN32
+			return _commit(_fileno(pFile)) == 0;
+#else
+			return fsync(fileno(pFile)) == 0;
+#endif
+		}
+	}
+
+	void SnapshotImage::Clear()
+	{
+		RoomList.clear();
+		UserList.clear();
+	}
+
+	void SnapshotImage::AddRoom(const int16_t lobbyIndex, const int16_t roomIndex, const int16_t gameState, const std::string& title)
+	{
+		auto& room = RoomList.emplace_back();
+		room.LobbyIndex = lobbyIndex;
+		room.RoomIndex = roomIndex;
+		room.GameState = gameState;
+		Utf8ToUtf16(title.c_str(), (int32_t)title.size(), room.Title, NCommon::MAX_ROOM_TITLE_SIZE);
+	}
+
+	void SnapshotImage::AddUser(const char* pszID, const int16_t lobbyIndex, const int16_t roomIndex)
+	{
+		auto& user = UserList.emplace_back();
+		strncpy(user.szID, pszID, NCommon::MAX_USER_ID_SIZE);
+		user.LobbyIndex = lobbyIndex;
+		user.RoomIndex = roomIndex;
+	}
+
+	StateSnapshot::StateSnapshot()
+	{
+	}
+
+	StateSnapshot::~StateSnapshot()
+	{
+		Stop();
+	}
+
+	void StateSnapshot::Init(const char* pszFileName, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_FileName = pszFileName != nullptr ? pszFileName : "";
+	}
+
+	void StateSnapshot::Start()
+	{
+		if (IsEnabled() == false || m_Thread.joinable()) {
+			return;
+		}
+
+		m_IsRun = true;
+		m_Thread = std::thread([this]() { ThreadFunc(); });
+	}
+
+	void StateSnapshot::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			m_IsRun = false;
+		}
+		m_CV.notify_one();
+
+		if (m_Thread.joinable()) {
+			m_Thread.join();
+		}
+	}
+
+	SnapshotImage* StateSnapshot::BeginCapture()
+	{
+		if (IsEnabled() == false) {
+			return nullptr;
+		}
+
+		std::lock_guard<std::mutex> lock(m_Lock);
+		for (int i = 0; i < 2; ++i) {
+			if (i != m_PendingIndex && i != m_WritingIndex) {
+				m_CaptureIndex = i;
+				m_ImageList[i].Clear();
+				return &m_ImageList[i];
+			}
+		}
+
+		return nullptr;
+	}
+
+	void StateSnapshot::EndCapture()
+	{
+		std::unique_lock<std::mutex> lock(m_Lock);
+		const auto captureIndex = m_CaptureIndex;
+		m_CaptureIndex = -1;
+		if (captureIndex < 0) {
+			return;
+		}
+
+		if (m_IsRun) {
+			m_PendingIndex = captureIndex;
+			lock.unlock();
+			m_CV.notify_one();
+			return;
+		}
+
+		m_WritingIndex = captureIndex;
+		lock.unlock();
+
+		Write(m_ImageList[captureIndex]);
+
+		lock.lock();
+		m_WritingIndex = -1;
+	}
+
+	bool StateSnapshot::Load(SnapshotImage& image, int64_t& saveTime) const
+	{
+		image.Clear();
+		if (IsEnabled() == false) {
+			return false;
+		}
+
+		auto pFile = fopen(m_FileName.c_str(), "rb");
+		if (pFile == nullptr) {
+			return false;
+		}
+
+		SnapshotFileHeader header;
+		auto isValid = fread(&header, sizeof(header), 1, pFile) == 1
+			&& memcmp(header.Magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0
+			&& header.Version == STATE_SNAPSHOT_VERSION
+			&& header.RoomCount >= 0 && header.RoomCount <= MAX_SNAPSHOT_ENTRY_COUNT
+			&& header.UserCount >= 0 && header.UserCount <= MAX_SNAPSHOT_ENTRY_COUNT;
+
+		if (isValid) {
+			image.RoomList.resize(header.RoomCount);
+			image.UserList.resize(header.UserCount);
+			isValid = fread(image.RoomList.data(), sizeof(SnapshotRoom), image.RoomList.size(), pFile) == image.RoomList.size()
+				&& fread(image.UserList.data(), sizeof(SnapshotUser), image.UserList.size(), pFile) == image.UserList.size()
+				&& Checksum(image) == header.Checksum;
+		}
+		fclose(pFile);
+
+		if (isValid == false) {
+			image.Clear();
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 스냅샷 파일이 깨짐. 복원하지 않음 (%s)", __FUNCTION__, m_FileName.c_str());
+			return false;
+		}
+
+		saveTime = header.SaveTime;
+		return true;
+	}
+
+	void StateSnapshot::ThreadFunc()
+	{
+		std::unique_lock<std::mutex> lock(m_Lock);
+		while (true)
+		{
+			m_CV.wait(lock, [this]() { return m_PendingIndex >= 0 || m_IsRun == false; });
+
+			// 멈출 때도 넘겨받은 이미지는 마저 씀
+			if (m_PendingIndex < 0) {
+				return;
+			}
+
+			const auto writingIndex = m_PendingIndex;
+			m_WritingIndex = writingIndex;
+			m_PendingIndex = -1;
+			lock.unlock();
+
+			Write(m_ImageList[writingIndex]);
+
+			lock.lock();
+			m_WritingIndex = -1;
+		}
+	}
+
+	bool StateSnapshot::Write(const SnapshotImage& image)
+	{
+		SnapshotFileHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.Magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+		header.Version = STATE_SNAPSHOT_VERSION;
+		header.SaveTime = NowUnixTime();
+		header.RoomCount = (int32_t)image.RoomList.size();
+		header.UserCount = (int32_t)image.UserList.size();
+		header.Checksum = Checksum(image);
+
+		const auto tempFileName = m_FileName + ".tmp";
+		auto pFile = fopen(tempFileName.c_str(), "wb");
+		if (pFile == nullptr) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 스냅샷 파일 열기 실패 (%s)", __FUNCTION__, tempFileName.c_str());
+			return false;
+		}
+
+		auto isWritten = fwrite(&header, sizeof(header), 1, pFile) == 1
+			&& fwrite(image.RoomList.data(), sizeof(SnapshotRoom), image.RoomList.size(), pFile) == image.RoomList.size()
+			&& fwrite(image.UserList.data(), sizeof(SnapshotUser), image.UserList.size(), pFile) == image.UserList.size()
+			&& SyncFile(pFile);
+		fclose(pFile);
+
+		// 다 쓴 뒤에만 바꾸므로 읽는 쪽은 항상 온전한 이전/새 파일 중 하나를 봄
+		std::error_code errorCode;
+		if (isWritten) {
+			std::filesystem::rename(tempFileName, m_FileName, errorCode);
+		}
+
+		if (isWritten == false || errorCode) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 스냅샷 파일 쓰기 실패 (%s)", __FUNCTION__, m_FileName.c_str());
+			return false;
+		}
+
+		return true;
+	}
+}
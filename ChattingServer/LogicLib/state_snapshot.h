@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "../Common/Packet.h"
+#include "../ServerNetLib/interface_log.h"
+
+namespace NLogicLib
+{
+	using ILog = NServerNetLib::ILog;
+
+	constexpr uint32_t STATE_SNAPSHOT_VERSION = 1;
+
+	// 스냅샷 파일 맨 앞에 한 번. 바로 뒤에 룸 RoomCount 개, 유저 UserCount 개가 이어짐
+	struct SnapshotFileHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		// 저장한 시간 (unix time, second)
+		int64_t SaveTime;
+		int32_t RoomCount;
+		int32_t UserCount;
+		// 룸/유저 영역의 체크섬
+		uint32_t Checksum;
+		uint32_t Reserve;
+	};
+
+	struct SnapshotRoom
+	{
+		int16_t LobbyIndex = -1;
+		int16_t RoomIndex = -1;
+		int16_t GameState = 0;
+		char16_t Title[NCommon::MAX_ROOM_TITLE_SIZE + 1] = { 0, };
+	};
+
+	// RoomIndex 가 -1 이면 룸에 들어가지 않은 로비 유저. 같은 룸의 유저는 들어온 순서대로 (첫 번째가 방장)
+	struct SnapshotUser
+	{
+		char szID[NCommon::MAX_USER_ID_SIZE + 1] = { 0, };
+		int8_t Reserve = 0;
+		int16_t LobbyIndex = -1;
+		int16_t RoomIndex = -1;
+	};
+
+	// 로비/룸 상태를 그대로 이어 붙인 평평한 이미지 (파일에도 이 배치 그대로 씀)
+	struct SnapshotImage
+	{
+		std::vector<SnapshotRoom> RoomList;
+		std::vector<SnapshotUser> UserList;
+
+		// 잡아 둔 메모리는 그대로 두고 다음 스냅샷에 다시 씀
+		void Clear();
+
+		// pszTitle 은 UTF-8
+		void AddRoom(const int16_t lobbyIndex, const int16_t roomIndex, const int16_t gameState, const std::string& title);
+
+		void AddUser(const char* pszID, const int16_t lobbyIndex, const int16_t roomIndex);
+	};
+
+	// 로비/룸 상태를 주기적으로 파일에 남기고 다시 시작할 때 읽어 오는 스냅샷
+	// - 이미지 버퍼 두 개를 번갈아 씀 (double buffer)
+	//   로직 스레드는 비어 있는 버퍼에 상태를 복사만 하고(BeginCapture/EndCapture), 파일 쓰기는 기록 스레드가 다른 버퍼로 함
+	//   두 버퍼가 모두 쓰는 중이거나 쓸 차례를 기다리면 이번 스냅샷은 건너뜀
+	// - 임시 파일에 다 쓰고 fsync 한 뒤 이름을 바꾸므로 쓰다가 멈춰도 이전 스냅샷이 남음
+	// BeginCapture/EndCapture 는 한 스레드(로직 스레드, 멈춘 뒤에는 메인 스레드)에서만 호출
+	class StateSnapshot
+	{
+	public:
+		StateSnapshot();
+		~StateSnapshot();
+
+		// 파일 이름이 비어 있으면 저장/복원하지 않음
+		void Init(const char* pszFileName, ILog* pLogger);
+
+		bool IsEnabled() const { return m_FileName.empty() == false; }
+
+		void Start();
+
+		// 넘겨받은 이미지를 모두 쓴 뒤 기록 스레드를 멈춤
+		void Stop();
+
+		// 채울 이미지 (비어 있는 버퍼가 없으면 nullptr)
+		SnapshotImage* BeginCapture();
+
+		// 채운 이미지를 기록 스레드에 넘김. 기록 스레드가 없으면 호출한 스레드에서 바로 씀
+		void EndCapture();
+
+		// 파일이 없거나 깨졌으면 false
+		bool Load(SnapshotImage& image, int64_t& saveTime) const;
+
+	private:
+		void ThreadFunc();
+
+		bool Write(const SnapshotImage& image);
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+		std::string m_FileName;
+
+		SnapshotImage m_ImageList[2];
+
+		// 아래 버퍼 번호는 m_Lock 안에서만 바꿈 (-1 이면 없음)
+		std::mutex m_Lock;
+		std::condition_variable m_CV;
+		int m_CaptureIndex = -1;
+		int m_PendingIndex = -1;
+		int m_WritingIndex = -1;
+		bool m_IsRun = false;
+
+		std::thread m_Thread;
+	};
+}
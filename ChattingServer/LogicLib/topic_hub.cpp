@@ -0,0 +1,125 @@
+#include <bit>
+
+#include "topic_hub.h"
+
+namespace NLogicLib
+{
+	namespace
+	{
+		constexpr int32_t BIT_PER_WORD = 64;
+	}
+
+	void TopicHub::Init(const int32_t topicCount, const int32_t sessionPoolSize, TcpNet* pNetwork)
+	{
+		m_pRefNetwork = pNetwork;
+
+		m_TopicCount = topicCount > 0 ? topicCount : 0;
+		m_SessionPoolSize = sessionPoolSize > 0 ? sessionPoolSize : 0;
+		m_WordCount = (m_SessionPoolSize + BIT_PER_WORD - 1) / BIT_PER_WORD;
+		m_SummaryWordCount = (m_WordCount + BIT_PER_WORD - 1) / BIT_PER_WORD;
+		m_TopicStride = m_WordCount + m_SummaryWordCount;
+
+		m_BitList.assign((size_t)m_TopicCount * m_TopicStride, 0);
+		m_SubscriberCountList.assign(m_TopicCount, 0);
+	}
+
+	void TopicHub::Subscribe(const int32_t topicId, const int32_t sessionIndex)
+	{
+		if (IsValid(topicId, sessionIndex) == false) {
+			return;
+		}
+
+		const auto wordIndex = sessionIndex / BIT_PER_WORD;
+		const auto bit = 1ULL << (sessionIndex % BIT_PER_WORD);
+
+		auto& word = GetWordList(topicId)[wordIndex];
+		if ((word & bit) != 0) {
+			return;
+		}
+
+		word |= bit;
+		GetSummaryList(topicId)[wordIndex / BIT_PER_WORD] |= 1ULL << (wordIndex % BIT_PER_WORD);
+		++m_SubscriberCountList[topicId];
+	}
+
+	void TopicHub::Unsubscribe(const int32_t topicId, const int32_t sessionIndex)
+	{
+		if (IsValid(topicId, sessionIndex) == false) {
+			return;
+		}
+
+		const auto wordIndex = sessionIndex / BIT_PER_WORD;
+		const auto bit = 1ULL << (sessionIndex % BIT_PER_WORD);
+
+		auto& word = GetWordList(topicId)[wordIndex];
+		if ((word & bit) == 0) {
+			return;
+		}
+
+		word &= ~bit;
+		// 워드가 비면 발행할 때 들르지 않도록 요약 비트도 끔
+		if (word == 0) {
+			GetSummaryList(topicId)[wordIndex / BIT_PER_WORD] &= ~(1ULL << (wordIndex % BIT_PER_WORD));
+		}
+		--m_SubscriberCountList[topicId];
+	}
+
+	bool TopicHub::IsSubscribed(const int32_t topicId, const int32_t sessionIndex) const
+	{
+		if (IsValid(topicId, sessionIndex) == false) {
+			return false;
+		}
+
+		return (GetWordList(topicId)[sessionIndex / BIT_PER_WORD] & (1ULL << (sessionIndex % BIT_PER_WORD))) != 0;
+	}
+
+	int32_t TopicHub::GetSubscriberCount(const int32_t topicId) const
+	{
+		if (topicId < 0 || topicId >= m_TopicCount) {
+			return 0;
+		}
+
+		return m_SubscriberCountList[topicId];
+	}
+
+	int32_t TopicHub::Publish(const int32_t topicId, const int16_t packetId, const int16_t bodySize, const char* pBody, const int32_t exceptSessionIndex)
+	{
+		if (topicId < 0 || topicId >= m_TopicCount || m_SubscriberCountList[topicId] == 0) {
+			return 0;
+		}
+
+		const auto pWordList = GetWordList(topicId);
+		const auto pSummaryList = GetSummaryList(topicId);
+		int32_t sendCount = 0;
+
+		for (int32_t summaryIndex = 0; summaryIndex < m_SummaryWordCount; ++summaryIndex) {
+			auto summary = pSummaryList[summaryIndex];
+
+			// 켜진 비트를 가장 낮은 것부터 하나씩 꺼 가며 찾음 (꺼진 비트는 들르지 않음)
+			while (summary != 0) {
+				const auto wordIndex = summaryIndex * BIT_PER_WORD + std::countr_zero(summary);
+				summary &= summary - 1;
+
+				auto word = pWordList[wordIndex];
+				while (word != 0) {
+					const auto sessionIndex = wordIndex * BIT_PER_WORD + std::countr_zero(word);
+					word &= word - 1;
+
+					if (sessionIndex == exceptSessionIndex) {
+						continue;
+					}
+
+					m_pRefNetwork->SendData(sessionIndex, packetId, bodySize, pBody);
+					++sendCount;
+				}
+			}
+		}
+
+		return sendCount;
+	}
+
+	bool TopicHub::IsValid(const int32_t topicId, const int32_t sessionIndex) const
+	{
+		return topicId >= 0 && topicId < m_TopicCount && sessionIndex >= 0 && sessionIndex < m_SessionPoolSize;
+	}
+}
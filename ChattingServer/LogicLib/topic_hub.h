@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "../ServerNetLib/interface_tcp_network.h"
+
+namespace NLogicLib
+{
+	using TcpNet = NServerNetLib::ITcpNetwork;
+
+	// "토픽을 구독한 모든 세션에게 보냄" 을 처리하는 발행/구독 (로비 채팅, 룸 알림 등)
+	// - 토픽마다 세션 인덱스 비트셋을 두고, 64비트 워드 중 비어 있지 않은 워드를 가리키는 요약 비트셋을 한 단계 더 둠
+	//   발행은 요약 비트 → 워드 비트 순서로 켜진 비트만 찾아가므로 세션 풀 크기가 아니라 구독자 수에 비례
+	// - 모든 토픽의 비트셋은 한 배열에 이어 붙여 Init 에서 한 번만 할당 (토픽별 컨테이너/노드 할당 없음)
+	// - 구독/해지는 비트 하나와 요약 비트 하나만 바꾸는 O(1)
+	// 구독/해지는 상태 잠금(EXCLUSIVE) 안에서, 발행은 SHARED 이상 안에서 호출
+	class TopicHub
+	{
+	public:
+		void Init(const int32_t topicCount, const int32_t sessionPoolSize, TcpNet* pNetwork);
+
+		int32_t TopicCount() const { return m_TopicCount; }
+
+		// 이미 구독 중이면 아무것도 하지 않음
+		void Subscribe(const int32_t topicId, const int32_t sessionIndex);
+
+		// 구독 중이 아니면 아무것도 하지 않음
+		void Unsubscribe(const int32_t topicId, const int32_t sessionIndex);
+
+		bool IsSubscribed(const int32_t topicId, const int32_t sessionIndex) const;
+
+		int32_t GetSubscriberCount(const int32_t topicId) const;
+
+		// 같은 바디를 구독자마다 SendData 로 넣음 (exceptSessionIndex 는 보내지 않을 세션, 없으면 -1). 보낸 세션 수를 돌려줌
+		int32_t Publish(const int32_t topicId, const int16_t packetId, const int16_t bodySize, const char* pBody, const int32_t exceptSessionIndex = -1);
+
+	private:
+		bool IsValid(const int32_t topicId, const int32_t sessionIndex) const;
+
+		uint64_t* GetWordList(const int32_t topicId) { return &m_BitList[(size_t)topicId * m_TopicStride]; }
+		const uint64_t* GetWordList(const int32_t topicId) const { return &m_BitList[(size_t)topicId * m_TopicStride]; }
+
+		// 워드 비트셋 바로 뒤에 요약 비트셋
+		uint64_t* GetSummaryList(const int32_t topicId) { return GetWordList(topicId) + m_WordCount; }
+		const uint64_t* GetSummaryList(const int32_t topicId) const { return GetWordList(topicId) + m_WordCount; }
+
+	private:
+		TcpNet* m_pRefNetwork = nullptr;
+
+		int32_t m_TopicCount = 0;
+		int32_t m_SessionPoolSize = 0;
+		// 토픽 하나의 세션 비트셋 워드 수 / 요약 비트셋 워드 수 / 둘을 합친 크기
+		int32_t m_WordCount = 0;
+		int32_t m_SummaryWordCount = 0;
+		int32_t m_TopicStride = 0;
+
+		std::vector<uint64_t> m_BitList;
+		std::vector<int32_t> m_SubscriberCountList;
+	};
+}
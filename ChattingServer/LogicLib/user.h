@@ -0,0 +1,106 @@
+#pragma once
+
+#include <string>
+
+namespace NLogicLib
+{
+	class User
+	{
+	public:
+		// 유저가 현재 어디에 있는지 (로그인 -> 로비 -> 룸 순서로 이동)
+		enum class DOMAIN_STATE
+		{
+			NONE = 0,
+			LOGIN = 1,
+			LOBBY = 2,
+			ROOM = 3,
+		};
+
+	public:
+		User() {}
+		virtual ~User() {}
+
+		void Init(const short index)
+		{
+			m_Index = index;
+		}
+
+		void Clear()
+		{
+			m_SessionIndex = 0;
+			m_ID = "";
+			m_IsConfirm = false;
+			m_CurDomainState = DOMAIN_STATE::NONE;
+			m_LobbyIndex = -1;
+			m_RoomIndex = -1;
+		}
+
+		void Set(const int sessionIndex, const char* pszID)
+		{
+			m_IsConfirm = true;
+			m_CurDomainState = DOMAIN_STATE::LOGIN;
+
+			m_SessionIndex = sessionIndex;
+			m_ID = pszID;
+		}
+
+		short GetIndex() const { return m_Index; }
+
+		int GetSessioIndex() const { return m_SessionIndex; }
+
+		const std::string& GetID() const { return m_ID; }
+
+		bool IsConfirm() const { return m_IsConfirm; }
+
+		short GetLobbyIndex() const { return m_LobbyIndex; }
+
+		short GetRoomIndex() const { return m_RoomIndex; }
+
+		void EnterLobby(const short lobbyIndex)
+		{
+			m_LobbyIndex = lobbyIndex;
+			m_CurDomainState = DOMAIN_STATE::LOBBY;
+		}
+
+		void LeaveLobby()
+		{
+			m_LobbyIndex = -1;
+			m_CurDomainState = DOMAIN_STATE::LOGIN;
+		}
+
+		void EnterRoom(const short lobbyIndex, const short roomIndex)
+		{
+			m_LobbyIndex = lobbyIndex;
+			m_RoomIndex = roomIndex;
+			m_CurDomainState = DOMAIN_STATE::ROOM;
+		}
+
+		// 룸에서 나가면 룸이 있던 로비로 돌아감
+		void LeaveRoom()
+		{
+			m_RoomIndex = -1;
+			m_CurDomainState = DOMAIN_STATE::LOBBY;
+		}
+
+		bool IsCurDomainInLogIn() const { return m_CurDomainState == DOMAIN_STATE::LOGIN; }
+
+		bool IsCurDomainInLobby() const { return m_CurDomainState == DOMAIN_STATE::LOBBY; }
+
+		bool IsCurDomainInRoom() const { return m_CurDomainState == DOMAIN_STATE::ROOM; }
+
+	protected:
+		short m_Index = -1;
+
+		int m_SessionIndex = -1;
+
+		std::string m_ID;
+
+		bool m_IsConfirm = false;
+
+		DOMAIN_STATE m_CurDomainState = DOMAIN_STATE::NONE;
+
+		short m_LobbyIndex = -1;
+
+		short m_RoomIndex = -1;
+	};
+}
@@ -0,0 +1,109 @@
+#include "user_manager.h"
+
+namespace NLogicLib
+{
+	UserManager::UserManager()
+	{
+	}
+
+	UserManager::~UserManager()
+	{
+	}
+
+	void UserManager::Init(const int maxUserCount)
+	{
+		for (int i = 0; i < maxUserCount; ++i) {
+			User user;
+			user.Init((short)i);
+			user.Clear();
+
+			m_UserObjPool.push_back(user);
+			m_UserObjPoolIndex.push_back(i);
+		}
+	}
+
+	User* UserManager::AllocUserObjPoolIndex()
+	{
+		if (m_UserObjPoolIndex.empty()) {
+			return nullptr;
+		}
+
+		int index = m_UserObjPoolIndex.front();
+		m_UserObjPoolIndex.pop_front();
+		return &m_UserObjPool[index];
+	}
+
+	void UserManager::ReleaseUserObjPoolIndex(const int index)
+	{
+		m_UserObjPoolIndex.push_back(index);
+		m_UserObjPool[index].Clear();
+	}
+
+	ERROR_CODE UserManager::AddUser(const int sessionIndex, const char* pszID)
+	{
+		// 같은 ID 로 다시 로그인하거나, 이미 로그인한 세션이 다시 로그인하는 경우
+		if (FindUser(pszID) != nullptr || FindUser(sessionIndex) != nullptr) {
+			return ERROR_CODE::USER_MGR_ID_DUPLICATION;
+		}
+
+		User* pUser = AllocUserObjPoolIndex();
+		if (pUser == nullptr) {
+			return ERROR_CODE::USER_MGR_MAX_USER_COUNT;
+		}
+
+		pUser->Set(sessionIndex, pszID);
+
+		m_UserSessionDic.insert({ sessionIndex, pUser });
+		m_UserIDDic.insert({ pUser->GetID(), pUser });
+
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE UserManager::RemoveUser(const int sessionIndex)
+	{
+		User* pUser = FindUser(sessionIndex);
+		if (pUser == nullptr) {
+			return ERROR_CODE::USER_MGR_REMOVE_INVALID_SESSION;
+		}
+
+		m_UserSessionDic.erase(sessionIndex);
+		m_UserIDDic.erase(pUser->GetID());
+		ReleaseUserObjPoolIndex(pUser->GetIndex());
+
+		return ERROR_CODE::NONE;
+	}
+
+	std::tuple<ERROR_CODE, User*> UserManager::GetUser(const int sessionIndex)
+	{
+		User* pUser = FindUser(sessionIndex);
+		if (pUser == nullptr) {
+			return { ERROR_CODE::USER_MGR_INVALID_SESSION_INDEX, nullptr };
+		}
+
+		if (pUser->IsConfirm() == false) {
+			return { ERROR_CODE::USER_MGR_NOT_CONFIRM_USER, nullptr };
+		}
+
+		return { ERROR_CODE::NONE, pUser };
+	}
+
+	User* UserManager::FindUser(const int sessionIndex)
+	{
+		auto findIter = m_UserSessionDic.find(sessionIndex);
+		if (findIter == m_UserSessionDic.end()) {
+			return nullptr;
+		}
+
+		return findIter->second;
+	}
+
+	User* UserManager::FindUser(const char* pszID)
+	{
+		auto findIter = m_UserIDDic.find(pszID);
+		if (findIter == m_UserIDDic.end()) {
+			return nullptr;
+		}
+
+		return findIter->second;
+	}
+}
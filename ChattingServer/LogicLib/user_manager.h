@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <tuple>
+
+#include "../Common/error_code.h"
+#include "user.h"
+
+namespace NLogicLib
+{
+	using ERROR_CODE = NCommon::ERROR_CODE;
+
+	// 로그인한 유저 객체를 미리 만들어 두고(pool) 세션 인덱스, ID 로 찾음
+	class UserManager
+	{
+	public:
+		UserManager();
+		virtual ~UserManager();
+
+		void Init(const int maxUserCount);
+
+		ERROR_CODE AddUser(const int sessionIndex, const char* pszID);
+		ERROR_CODE RemoveUser(const int sessionIndex);
+
+		std::tuple<ERROR_CODE, User*> GetUser(const int sessionIndex);
+
+		template<class Func>
+		void ForEachUser(Func&& func)
+		{
+			for (auto& [sessionIndex, pUser] : m_UserSessionDic) {
+				func(pUser);
+			}
+		}
+
+	private:
+		User* AllocUserObjPoolIndex();
+		void ReleaseUserObjPoolIndex(const int index);
+
+		User* FindUser(const int sessionIndex);
+		User* FindUser(const char* pszID);
+
+	private:
+		std::vector<User> m_UserObjPool;
+		std::deque<int> m_UserObjPoolIndex;
+
+		std::unordered_map<int, User*> m_UserSessionDic;
+		std::unordered_map<std::string, User*> m_UserIDDic;
+	};
+}
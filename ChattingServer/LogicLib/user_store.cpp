@@ -0,0 +1,478 @@
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+
+#include "user_store.h"
+
+namespace NLogicLib
+{
+	using LOG_LEVEL = NServerNetLib::LOG_LEVEL;
+
+	namespace
+	{
+		// 로그가 이만큼 쌓이면 체크포인트
+		constexpr uint64_t CHECKPOINT_LOG_SIZE = 16 * 1024 * 1024;
+
+		int64_t NowUnixTime()
+		{
+			return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		}
+
+		bool SyncFile(FILE* pFile)
+		{
+			if (fflush(pFile) != 0) {
+				return false;
+			}
+#ifdef _WIN32
+			return _commit(_fileno(pFile)) == 0;
+#else
+			return fdatasync(fileno(pFile)) == 0;
+#endif
+		}
+	}
+
+	UserStore::UserStore()
+	{
+	}
+
+	UserStore::~UserStore()
+	{
+		Stop();
+		Close();
+	}
+
+	bool UserStore::Open(const char* pszFileName, const int32_t maxRecordCount, const uint32_t groupCommitMilliSec, ILog* pLogger)
+	{
+		Close();
+		m_pRefLogger = pLogger;
+		m_GroupCommitMilliSec = std::max<uint32_t>(1, groupCommitMilliSec);
+
+		if (pszFileName == nullptr || pszFileName[0] == '\0') {
+			return true;
+		}
+
+		const auto startTime = std::chrono::steady_clock::now();
+
+		// 레코드를 미리 잡아 둬도 쓰지 않은 부분은 디스크를 차지하지 않음 (sparse)
+		const auto minSize = sizeof(UserStoreFileHeader) + (uint64_t)std::max(1, maxRecordCount) * sizeof(UserRecord);
+		if (m_File.OpenReadWrite(pszFileName, minSize) == false) {
+			return false;
+		}
+
+		m_pHeader = (UserStoreFileHeader*)m_File.GetData();
+		m_pRecordList = (UserRecord*)(m_File.GetData() + sizeof(UserStoreFileHeader));
+		m_MaxRecordCount = (int32_t)std::min<uint64_t>((m_File.GetSize() - sizeof(UserStoreFileHeader)) / sizeof(UserRecord), INT32_MAX - 1);
+
+		// 새로 만든 파일은 0 으로 채워져 있음
+		if (m_pHeader->Magic[0] == '\0') {
+			memcpy(m_pHeader->Magic, "USRS", sizeof(m_pHeader->Magic));
+			m_pHeader->Version = USER_STORE_VERSION;
+			m_pHeader->RecordSize = sizeof(UserRecord);
+			m_pHeader->RecordCount = 0;
+		}
+
+		if (memcmp(m_pHeader->Magic, "USRS", sizeof(m_pHeader->Magic)) != 0 || m_pHeader->Version != USER_STORE_VERSION
+			|| m_pHeader->RecordSize != sizeof(UserRecord) || m_pHeader->RecordCount > (uint32_t)m_MaxRecordCount) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 유저 저장 파일(%s)의 형식이 다름", __FUNCTION__, pszFileName);
+			Close();
+			return false;
+		}
+
+		m_LogFileName = std::string(pszFileName) + ".wal";
+		auto replayCount = ReplayLog();
+		if (replayCount < 0 || OpenLog() == false) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 유저 저장 로그(%s) 처리 실패", __FUNCTION__, m_LogFileName.c_str());
+			Close();
+			return false;
+		}
+
+		BuildIndex();
+
+		auto elapsedMilliSec = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 유저 저장소 열기 성공. 레코드(%d/%d), 비밀번호(%d), 다시 적용한 로그(%d), 걸린 시간(%lldms)", __FUNCTION__,
+			GetRecordCount(), m_MaxRecordCount, m_CredentialCount, replayCount, (long long)elapsedMilliSec);
+		return true;
+	}
+
+	void UserStore::Close()
+	{
+		if (m_pLogFile != nullptr) {
+			fclose(m_pLogFile);
+			m_pLogFile = nullptr;
+		}
+
+		m_File.Close(0);
+		m_pHeader = nullptr;
+		m_pRecordList = nullptr;
+		m_MaxRecordCount = 0;
+		m_CredentialCount = 0;
+		m_IndexTable.clear();
+		m_IndexMask = 0;
+		m_LogSize = 0;
+		m_IsCheckpointNeeded = false;
+	}
+
+	void UserStore::Start()
+	{
+		if (IsOpened() == false || m_IsRun) {
+			return;
+		}
+
+		// 시작 전에 가져온 계정을 먼저 디스크에 내려 둠
+		Flush();
+
+		m_IsRun = true;
+		m_Thread = std::thread([this]() { ThreadFunc(); });
+	}
+
+	void UserStore::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_PendingLock);
+			m_IsRun = false;
+		}
+		m_PendingCV.notify_all();
+
+		if (m_Thread.joinable()) {
+			m_Thread.join();
+		}
+
+		Flush();
+	}
+
+	void UserStore::Flush()
+	{
+		if (IsOpened() == false) {
+			return;
+		}
+
+		std::vector<UserStoreLogEntry> entryList;
+		{
+			std::lock_guard<std::mutex> lock(m_PendingLock);
+			entryList.swap(m_PendingList);
+		}
+		WriteLog(entryList);
+
+		if (m_IsCheckpointNeeded || m_LogSize > 0) {
+			Checkpoint();
+		}
+	}
+
+	int32_t UserStore::Find(const char* pszID) const
+	{
+		if (m_IndexTable.empty()) {
+			return -1;
+		}
+
+		const auto hash = HashID(pszID);
+		const auto tag = hash & 0xFFFFFFFF00000000ULL;
+
+		for (auto pos = hash & m_IndexMask; ; pos = (pos + 1) & m_IndexMask) {
+			const auto slot = m_IndexTable[pos];
+			if (slot == 0) {
+				return -1;
+			}
+
+			// 해시 위 32비트가 같을 때만 ID 를 비교
+			if ((slot & 0xFFFFFFFF00000000ULL) == tag) {
+				const auto recordIndex = (int32_t)(slot & 0xFFFFFFFF) - 1;
+				if (strcmp(m_pRecordList[recordIndex].szID, pszID) == 0) {
+					return recordIndex;
+				}
+			}
+		}
+	}
+
+	const UserRecord* UserStore::GetRecord(const int32_t recordIndex) const
+	{
+		if (m_pHeader == nullptr || recordIndex < 0 || recordIndex >= (int32_t)m_pHeader->RecordCount) {
+			return nullptr;
+		}
+
+		return &m_pRecordList[recordIndex];
+	}
+
+	int32_t UserStore::Add(const char* pszID)
+	{
+		if (IsOpened() == false || pszID[0] == '\0' || strlen(pszID) > (size_t)NCommon::MAX_USER_ID_SIZE) {
+			return -1;
+		}
+
+		const auto recordIndex = (int32_t)m_pHeader->RecordCount;
+		if (recordIndex >= m_MaxRecordCount || Find(pszID) >= 0) {
+			return -1;
+		}
+
+		auto& record = m_pRecordList[recordIndex];
+		record = UserRecord();
+		strcpy(record.szID, pszID);
+
+		InsertIndex(recordIndex);
+		m_pHeader->RecordCount = recordIndex + 1;
+
+		Commit(recordIndex);
+		return recordIndex;
+	}
+
+	void UserStore::SetCredential(const int32_t recordIndex, const UserCredential& credential)
+	{
+		if (GetRecord(recordIndex) == nullptr) {
+			return;
+		}
+
+		auto& record = m_pRecordList[recordIndex];
+		m_CredentialCount += (credential.IterationCount != 0) - (record.Credential.IterationCount != 0);
+		record.Credential = credential;
+
+		Commit(recordIndex);
+	}
+
+	void UserStore::SetStat(const int32_t recordIndex, const UserStat& stat)
+	{
+		if (GetRecord(recordIndex) == nullptr) {
+			return;
+		}
+
+		// 로그인 워커가 같이 읽는 ID/비밀번호 칸은 건드리지 않음
+		m_pRecordList[recordIndex].Stat = stat;
+
+		Commit(recordIndex);
+	}
+
+	void UserStore::RecordLogin(const char* pszID, const bool isSuccess)
+	{
+		if (IsOpened() == false) {
+			return;
+		}
+
+		auto recordIndex = Find(pszID);
+		if (recordIndex < 0 && isSuccess) {
+			recordIndex = Add(pszID);
+		}
+
+		auto pRecord = GetRecord(recordIndex);
+		if (pRecord == nullptr) {
+			return;
+		}
+
+		auto stat = pRecord->Stat;
+		if (isSuccess) {
+			++stat.LoginCount;
+			stat.LastLoginTime = NowUnixTime();
+		}
+		else {
+			++stat.LoginFailCount;
+		}
+		SetStat(recordIndex, stat);
+	}
+
+	void UserStore::RecordLogout(const char* pszID)
+	{
+		auto recordIndex = Find(pszID);
+		auto pRecord = GetRecord(recordIndex);
+		if (pRecord == nullptr) {
+			return;
+		}
+
+		auto stat = pRecord->Stat;
+		stat.LastLogoutTime = NowUnixTime();
+		SetStat(recordIndex, stat);
+	}
+
+	uint64_t UserStore::HashID(const char* pszID)
+	{
+		// FNV-1a 뒤에 섞어서 위/아래 비트를 모두 고르게 씀
+		uint64_t hash = 14695981039346656037ULL;
+		for (auto p = (const uint8_t*)pszID; *p != 0; ++p) {
+			hash = (hash ^ *p) * 1099511628211ULL;
+		}
+
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDULL;
+		hash ^= hash >> 33;
+		return hash;
+	}
+
+	uint32_t UserStore::Checksum(const UserStoreLogEntry& entry)
+	{
+		uint32_t checksum = 2166136261U;
+		auto addBytes = [&checksum](const void* pData, const size_t size) {
+			for (size_t i = 0; i < size; ++i) {
+				checksum = (checksum ^ ((const uint8_t*)pData)[i]) * 16777619U;
+			}
+		};
+
+		addBytes(&entry.RecordIndex, sizeof(entry.RecordIndex));
+		addBytes(&entry.Record, sizeof(entry.Record));
+		return checksum;
+	}
+
+	int32_t UserStore::ReplayLog()
+	{
+		auto pFile = fopen(m_LogFileName.c_str(), "rb");
+		if (pFile == nullptr) {
+			return 0;
+		}
+
+		// 끝이 잘렸거나 체크섬이 맞지 않는 항목부터는 쓰다가 멈춘 것이므로 버림
+		int32_t replayCount = 0;
+		UserStoreLogEntry entry;
+		while (fread(&entry, sizeof(entry), 1, pFile) == 1) {
+			if (entry.Checksum != Checksum(entry) || entry.RecordIndex >= (uint32_t)m_MaxRecordCount) {
+				break;
+			}
+
+			m_pRecordList[entry.RecordIndex] = entry.Record;
+			m_pHeader->RecordCount = std::max(m_pHeader->RecordCount, entry.RecordIndex + 1);
+			++replayCount;
+		}
+		fclose(pFile);
+
+		// 다시 적용한 내용을 디스크에 내린 뒤에야 로그를 비울 수 있음
+		if (replayCount > 0 && m_File.Flush() == false) {
+			return -1;
+		}
+
+		return replayCount;
+	}
+
+	void UserStore::BuildIndex()
+	{
+		// 잡아 둔 레코드가 모두 차도 절반만 쓰이도록
+		uint64_t tableSize = 16;
+		while (tableSize < (uint64_t)m_MaxRecordCount * 2) {
+			tableSize <<= 1;
+		}
+		m_IndexTable.assign(tableSize, 0);
+		m_IndexMask = tableSize - 1;
+
+		m_CredentialCount = 0;
+		int32_t duplicateCount = 0;
+
+		const auto recordCount = (int32_t)m_pHeader->RecordCount;
+		for (int32_t i = 0; i < recordCount; ++i) {
+			auto& record = m_pRecordList[i];
+			record.szID[NCommon::MAX_USER_ID_SIZE] = '\0';
+
+			if (InsertIndex(i) == false) {
+				++duplicateCount;
+				continue;
+			}
+
+			if (record.Credential.IterationCount != 0) {
+				++m_CredentialCount;
+			}
+		}
+
+		if (duplicateCount > 0) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 같은 ID 의 레코드는 앞의 것만 사용. 무시한 레코드(%d)", __FUNCTION__, duplicateCount);
+		}
+	}
+
+	bool UserStore::InsertIndex(const int32_t recordIndex)
+	{
+		const auto pszID = m_pRecordList[recordIndex].szID;
+		const auto hash = HashID(pszID);
+		const auto tag = hash & 0xFFFFFFFF00000000ULL;
+
+		for (auto pos = hash & m_IndexMask; ; pos = (pos + 1) & m_IndexMask) {
+			const auto slot = m_IndexTable[pos];
+			if (slot == 0) {
+				m_IndexTable[pos] = tag | (uint64_t)(recordIndex + 1);
+				return true;
+			}
+
+			if ((slot & 0xFFFFFFFF00000000ULL) == tag && strcmp(m_pRecordList[(slot & 0xFFFFFFFF) - 1].szID, pszID) == 0) {
+				return false;
+			}
+		}
+	}
+
+	void UserStore::Commit(const int32_t recordIndex)
+	{
+		// 기록 스레드가 없으면 다음 Flush 의 체크포인트로 한 번에 내림 (시작할 때 가져오기, 넘기기 전 마무리)
+		if (m_IsRun == false) {
+			m_IsCheckpointNeeded = true;
+			return;
+		}
+
+		UserStoreLogEntry entry;
+		entry.RecordIndex = (uint32_t)recordIndex;
+		entry.Record = m_pRecordList[recordIndex];
+		entry.Checksum = Checksum(entry);
+
+		std::lock_guard<std::mutex> lock(m_PendingLock);
+		m_PendingList.push_back(entry);
+	}
+
+	void UserStore::ThreadFunc()
+	{
+		std::vector<UserStoreLogEntry> entryList;
+
+		while (m_IsRun) {
+			{
+				std::unique_lock<std::mutex> lock(m_PendingLock);
+				// 그동안 들어온 변경을 모아서 한 번에 씀
+				m_PendingCV.wait_for(lock, std::chrono::milliseconds(m_GroupCommitMilliSec), [this]() { return m_IsRun == false; });
+				entryList.swap(m_PendingList);
+			}
+
+			WriteLog(entryList);
+			entryList.clear();
+		}
+	}
+
+	void UserStore::WriteLog(std::vector<UserStoreLogEntry>& entryList)
+	{
+		if (entryList.empty() || m_pLogFile == nullptr) {
+			return;
+		}
+
+		const auto writeSize = entryList.size() * sizeof(UserStoreLogEntry);
+		if (fwrite(entryList.data(), sizeof(UserStoreLogEntry), entryList.size(), m_pLogFile) != entryList.size() || SyncFile(m_pLogFile) == false) {
+			// 매핑에는 이미 들어가 있으므로 다음 체크포인트에서 디스크에 내려감
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 유저 저장 로그 쓰기 실패. 항목(%d)", __FUNCTION__, (int)entryList.size());
+			m_IsCheckpointNeeded = true;
+		}
+		m_LogSize += writeSize;
+
+		if (m_LogSize >= CHECKPOINT_LOG_SIZE || m_IsCheckpointNeeded) {
+			Checkpoint();
+		}
+	}
+
+	void UserStore::Checkpoint()
+	{
+		// 로그에 있는 변경은 모두 매핑에 들어가 있으므로 매핑을 내린 뒤에는 로그가 필요 없음
+		// 그 사이에 바뀐 레코드는 대기열에 있다가 비운 로그에 다시 쓰임
+		if (m_File.Flush() == false) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 유저 저장 파일 디스크 쓰기 실패", __FUNCTION__);
+			return;
+		}
+
+		if (OpenLog() == false) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 유저 저장 로그(%s) 열기 실패", __FUNCTION__, m_LogFileName.c_str());
+			return;
+		}
+
+		m_IsCheckpointNeeded = false;
+	}
+
+	bool UserStore::OpenLog()
+	{
+		if (m_pLogFile != nullptr) {
+			fclose(m_pLogFile);
+		}
+
+		// 비우고 처음부터 씀
+		m_pLogFile = fopen(m_LogFileName.c_str(), "wb");
+		m_LogSize = 0;
+		return m_pLogFile != nullptr;
+	}
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "../Common/Packet.h"
+#include "../ServerNetLib/interface_log.h"
+#include "../ServerNetLib/packet_capture.h"
+
+namespace NLogicLib
+{
+	using ILog = NServerNetLib::ILog;
+
+	constexpr int32_t MAX_USER_SALT_SIZE = 32;
+	constexpr int32_t MAX_USER_HASH_SIZE = 32;
+
+	// 비밀번호 검증 정보 (IterationCount 가 0 이면 비밀번호 없음)
+	struct UserCredential
+	{
+		uint32_t IterationCount = 0;
+		uint8_t SaltSize = 0;
+		uint8_t HashSize = 0;
+		uint8_t Salt[MAX_USER_SALT_SIZE] = { 0, };
+		uint8_t Hash[MAX_USER_HASH_SIZE] = { 0, };
+	};
+
+	struct UserStat
+	{
+		uint32_t LoginCount = 0;
+		uint32_t LoginFailCount = 0;
+		// unix time (second)
+		int64_t LastLoginTime = 0;
+		int64_t LastLogoutTime = 0;
+	};
+
+	// 저장 파일의 레코드 한 칸 (배치가 바뀌면 USER_STORE_VERSION 을 올림)
+	struct UserRecord
+	{
+		char szID[NCommon::MAX_USER_ID_SIZE + 1] = { 0, };
+		UserCredential Credential;
+		UserStat Stat;
+		uint8_t Reserve[8] = { 0, };
+	};
+	static_assert(sizeof(UserRecord) == 128, "UserRecord 크기가 바뀌면 USER_STORE_VERSION 을 올려야 함");
+
+	constexpr uint32_t USER_STORE_VERSION = 1;
+
+	// 저장 파일 맨 앞에 한 번. 바로 뒤에 레코드가 파일 끝까지 이어짐
+	struct UserStoreFileHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint32_t RecordSize;
+		// 앞에서부터 쓰인 레코드 수 (지우지 않으므로 중간에 빈 칸이 없음)
+		uint32_t RecordCount;
+		uint8_t Reserve[48];
+	};
+
+	// 로그 파일의 항목 하나 (바뀐 레코드 전체를 그대로 남김)
+	struct UserStoreLogEntry
+	{
+		uint32_t RecordIndex;
+		// 쓰다가 끊겨서 끝이 잘린 항목을 걸러냄
+		uint32_t Checksum;
+		UserRecord Record;
+	};
+
+	// 외부 DB 없이 유저 레코드(ID, 비밀번호 해시, 로그인 통계)를 보관하는 저장소
+	// - 고정 크기 레코드를 이어 붙인 파일을 통째로 메모리에 매핑하고, 시작할 때 한 번 훑어서 ID 해시 색인(open addressing)을 만듦
+	//   색인은 잡아 둔 레코드 수의 두 배 크기로 만들어 두므로 추가할 때 다시 만들지 않고, 로그인 때 찾기는 메모리 읽기뿐
+	// - 바뀐 레코드는 매핑에 바로 쓰고 레코드 전체를 로그(파일 이름 + ".wal") 대기열에 넣음
+	//   기록 스레드가 GroupCommitMilliSec 마다 모인 것을 한 번에 쓰고 fsync 도 한 번만 함 (group commit). 로직 스레드는 디스크를 기다리지 않음
+	// - 로그가 커지면 매핑을 디스크에 내린 뒤(체크포인트) 로그를 비움. 시작할 때 남은 로그를 다시 적용해서 멈추기 직전 상태로 되돌림
+	// 찾기는 여러 스레드에서 잠금 없이, 추가/변경은 로직 스레드(상태 잠금 EXCLUSIVE 안)나 시작할 때만 호출
+	// 추가는 색인을 바꾸므로 로그인 워커가 찾지 않을 때(시작할 때 계정 가져오기, 비밀번호를 검증하지 않는 개발용 모드)에만 일어남
+	class UserStore
+	{
+	public:
+		UserStore();
+		~UserStore();
+
+		// 파일 이름이 비어 있으면 저장하지 않음. maxRecordCount 는 파일을 새로 만들 때 잡아 둘 레코드 수 (있는 파일이 더 크면 파일 크기대로)
+		bool Open(const char* pszFileName, const int32_t maxRecordCount, const uint32_t groupCommitMilliSec, ILog* pLogger);
+
+		void Start();
+
+		// 기록 스레드를 멈추고 남은 변경을 모두 디스크에 내림
+		void Stop();
+
+		// 기록 스레드가 멈춘 동안 쌓인 변경을 호출한 스레드에서 디스크에 내림 (무중단 재시작으로 넘기기 전에)
+		void Flush();
+
+		bool IsOpened() const { return m_pHeader != nullptr; }
+
+		int32_t GetRecordCount() const { return m_pHeader != nullptr ? (int32_t)m_pHeader->RecordCount : 0; }
+
+		// 비밀번호가 있는 레코드 수 (시작할 때 확인용)
+		int32_t GetCredentialCount() const { return m_CredentialCount; }
+
+		// 없으면 -1
+		int32_t Find(const char* pszID) const;
+
+		const UserRecord* GetRecord(const int32_t recordIndex) const;
+
+		// 새 레코드의 인덱스 (가득 찼거나 이미 있거나 ID 가 너무 길면 -1)
+		int32_t Add(const char* pszID);
+
+		void SetCredential(const int32_t recordIndex, const UserCredential& credential);
+
+		void SetStat(const int32_t recordIndex, const UserStat& stat);
+
+		// 로그인에 성공한 ID 의 레코드가 없으면 새로 만듦 (비밀번호를 검증할 때는 항상 있음)
+		void RecordLogin(const char* pszID, const bool isSuccess);
+
+		void RecordLogout(const char* pszID);
+
+	private:
+		static uint64_t HashID(const char* pszID);
+
+		static uint32_t Checksum(const UserStoreLogEntry& entry);
+
+		// 남은 로그를 매핑에 다시 적용하고 적용한 항목 수를 돌려줌
+		int32_t ReplayLog();
+
+		void BuildIndex();
+
+		bool InsertIndex(const int32_t recordIndex);
+
+		// 바뀐 레코드를 로그 대기열에 넣음
+		void Commit(const int32_t recordIndex);
+
+		void ThreadFunc();
+
+		void WriteLog(std::vector<UserStoreLogEntry>& entryList);
+
+		void Checkpoint();
+
+		bool OpenLog();
+
+		void Close();
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+
+		NServerNetLib::MappedFile m_File;
+		UserStoreFileHeader* m_pHeader = nullptr;
+		UserRecord* m_pRecordList = nullptr;
+		int32_t m_MaxRecordCount = 0;
+		int32_t m_CredentialCount = 0;
+
+		// 위 32비트는 ID 해시, 아래 32비트는 레코드 인덱스 + 1 (0 이면 빈 칸)
+		std::vector<uint64_t> m_IndexTable;
+		uint64_t m_IndexMask = 0;
+
+		std::string m_LogFileName;
+		// 기록 스레드만 사용 (멈춘 동안은 Flush 를 호출한 스레드)
+		FILE* m_pLogFile = nullptr;
+		uint64_t m_LogSize = 0;
+		// 기록 스레드 없이 매핑만 바뀌어서 체크포인트가 필요
+		bool m_IsCheckpointNeeded = false;
+
+		uint32_t m_GroupCommitMilliSec = 10;
+		std::mutex m_PendingLock;
+		std::condition_variable m_PendingCV;
+		std::vector<UserStoreLogEntry> m_PendingList;
+
+		std::thread m_Thread;
+		std::atomic<bool> m_IsRun = false;
+	};
+}
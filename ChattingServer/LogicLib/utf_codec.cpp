@@ -0,0 +1,356 @@
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTF_CODEC_SSE2 1
+#include <emmintrin.h>
+#else
+#define UTF_CODEC_SSE2 0
+#endif
+
+#include "utf_codec.h"
+
+namespace NLogicLib
+{
+	namespace
+	{
+		constexpr char32_t MAX_CODE_POINT = 0x10FFFF;
+
+		bool IsSurrogate(const uint32_t value) { return value >= 0xD800 && value <= 0xDFFF; }
+		bool IsHighSurrogate(const uint32_t unit) { return (unit & 0xFC00) == 0xD800; }
+		bool IsLowSurrogate(const uint32_t unit) { return (unit & 0xFC00) == 0xDC00; }
+
+		// pSrc[i] 부터 한 글자를 읽어 읽은 유닛 수를 돌려줌 (잘못되었으면 0)
+		int32_t DecodeUtf16(const char16_t* pSrc, const int32_t i, const int32_t length, char32_t& codePoint)
+		{
+			const uint32_t unit = pSrc[i];
+			if (IsSurrogate(unit) == false) {
+				codePoint = unit;
+				return 1;
+			}
+
+			if (IsHighSurrogate(unit) && i + 1 < length && IsLowSurrogate(pSrc[i + 1])) {
+				codePoint = 0x10000 + ((unit - 0xD800) << 10) + ((uint32_t)pSrc[i + 1] - 0xDC00);
+				return 2;
+			}
+
+			return 0;
+		}
+
+		int32_t DecodeUtf8(const char* pSrc, const int32_t i, const int32_t length, char32_t& codePoint)
+		{
+			const auto lead = (uint8_t)pSrc[i];
+			if (lead < 0x80) {
+				codePoint = lead;
+				return 1;
+			}
+
+			int32_t count = 0;
+			char32_t minValue = 0;
+			if ((lead & 0xE0) == 0xC0) {
+				count = 2;
+				codePoint = lead & 0x1F;
+				minValue = 0x80;
+			}
+			else if ((lead & 0xF0) == 0xE0) {
+				count = 3;
+				codePoint = lead & 0x0F;
+				minValue = 0x800;
+			}
+			else if ((lead & 0xF8) == 0xF0) {
+				count = 4;
+				codePoint = lead & 0x07;
+				minValue = 0x10000;
+			}
+			else {
+				return 0;
+			}
+
+			if (i + count > length) {
+				return 0;
+			}
+
+			for (int32_t k = 1; k < count; ++k) {
+				const auto next = (uint8_t)pSrc[i + k];
+				if ((next & 0xC0) != 0x80) {
+					return 0;
+				}
+				codePoint = (codePoint << 6) | (next & 0x3F);
+			}
+
+			// 필요보다 길게 쓴 표현, 서로게이트 영역, 범위 밖은 잘못된 입력
+			if (codePoint < minValue || codePoint > MAX_CODE_POINT || IsSurrogate(codePoint)) {
+				return 0;
+			}
+
+			return count;
+		}
+
+		// 쓴 바이트 수 (자리가 모자라면 0)
+		int32_t EncodeUtf8(const char32_t codePoint, char* pDest, const int32_t capacity)
+		{
+			if (codePoint < 0x80) {
+				if (capacity < 1) {
+					return 0;
+				}
+				pDest[0] = (char)codePoint;
+				return 1;
+			}
+
+			if (codePoint < 0x800) {
+				if (capacity < 2) {
+					return 0;
+				}
+				pDest[0] = (char)(0xC0 | (codePoint >> 6));
+				pDest[1] = (char)(0x80 | (codePoint & 0x3F));
+				return 2;
+			}
+
+			if (codePoint < 0x10000) {
+				if (capacity < 3) {
+					return 0;
+				}
+				pDest[0] = (char)(0xE0 | (codePoint >> 12));
+				pDest[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+				pDest[2] = (char)(0x80 | (codePoint & 0x3F));
+				return 3;
+			}
+
+			if (capacity < 4) {
+				return 0;
+			}
+			pDest[0] = (char)(0xF0 | (codePoint >> 18));
+			pDest[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+			pDest[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+			pDest[3] = (char)(0x80 | (codePoint & 0x3F));
+			return 4;
+		}
+
+		// 쓴 유닛 수 (자리가 모자라면 0). codePoint 는 검사가 끝난 값
+		int32_t EncodeUtf16(const char32_t codePoint, char16_t* pDest, const int32_t capacity)
+		{
+			if (codePoint < 0x10000) {
+				if (capacity < 1) {
+					return 0;
+				}
+				pDest[0] = (char16_t)codePoint;
+				return 1;
+			}
+
+			if (capacity < 2) {
+				return 0;
+			}
+			pDest[0] = (char16_t)(0xD800 + ((codePoint - 0x10000) >> 10));
+			pDest[1] = (char16_t)(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+			return 2;
+		}
+
+#if UTF_CODEC_SSE2
+		// 8 유닛 중 서로게이트인 유닛의 바이트 마스크 (유닛마다 2비트)
+		int SurrogateMask16(const __m128i units)
+		{
+			const auto masked = _mm_and_si128(units, _mm_set1_epi16((short)0xF800));
+			return _mm_movemask_epi8(_mm_cmpeq_epi16(masked, _mm_set1_epi16((short)0xD800)));
+		}
+#endif
+	}
+
+	int32_t ScanUtf16(const char16_t* pText, const int32_t maxLength)
+	{
+		int32_t i = 0;
+		while (i < maxLength) {
+			int32_t blockEnd = maxLength;
+
+#if UTF_CODEC_SSE2
+			if (i + 8 <= maxLength) {
+				const auto units = _mm_loadu_si128((const __m128i*)(pText + i));
+				const int zeroMask = _mm_movemask_epi8(_mm_cmpeq_epi16(units, _mm_setzero_si128()));
+				const int surrogateMask = SurrogateMask16(units);
+
+				if ((zeroMask | surrogateMask) == 0) {
+					i += 8;
+					continue;
+				}
+
+				// 널 문자 앞에 서로게이트가 없으면 여기서 끝
+				if (zeroMask != 0) {
+					const int zeroByte = std::countr_zero((unsigned)zeroMask);
+					if ((surrogateMask & ((1 << zeroByte) - 1)) == 0) {
+						return i + zeroByte / 2;
+					}
+				}
+
+				// 서로게이트가 있는 블록만 아래에서 한 유닛씩 검사
+				blockEnd = i + 8;
+			}
+#endif
+
+			while (i < blockEnd) {
+				const uint32_t unit = pText[i];
+				if (unit == 0) {
+					return i;
+				}
+
+				if (IsSurrogate(unit) == false) {
+					++i;
+					continue;
+				}
+
+				if (IsHighSurrogate(unit) && i + 1 < maxLength && IsLowSurrogate(pText[i + 1])) {
+					i += 2;
+					continue;
+				}
+
+				return -1;
+			}
+		}
+
+		return maxLength;
+	}
+
+	int32_t Utf16ToUtf8(const char16_t* pSrc, const int32_t srcLength, char* pDest, const int32_t destCapacity)
+	{
+		int32_t i = 0;
+		int32_t o = 0;
+		while (i < srcLength) {
+#if UTF_CODEC_SSE2
+			// 8 유닛이 모두 ASCII 면 바이트로 좁혀서 한 번에 씀
+			if (i + 8 <= srcLength && o + 8 <= destCapacity) {
+				const auto units = _mm_loadu_si128((const __m128i*)(pSrc + i));
+				const auto nonAscii = _mm_and_si128(units, _mm_set1_epi16((short)0xFF80));
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, _mm_setzero_si128())) == 0xFFFF) {
+					_mm_storel_epi64((__m128i*)(pDest + o), _mm_packus_epi16(units, units));
+					i += 8;
+					o += 8;
+					continue;
+				}
+			}
+#endif
+
+			char32_t codePoint = 0;
+			const auto readCount = DecodeUtf16(pSrc, i, srcLength, codePoint);
+			if (readCount == 0) {
+				return -1;
+			}
+
+			const auto writeCount = EncodeUtf8(codePoint, pDest + o, destCapacity - o);
+			if (writeCount == 0) {
+				return -1;
+			}
+
+			i += readCount;
+			o += writeCount;
+		}
+
+		return o;
+	}
+
+	int32_t Utf8ToUtf16(const char* pSrc, const int32_t srcLength, char16_t* pDest, const int32_t destCapacity)
+	{
+		int32_t i = 0;
+		int32_t o = 0;
+		while (i < srcLength) {
+#if UTF_CODEC_SSE2
+			// 16 바이트가 모두 ASCII 면 0 을 끼워 넓혀서 한 번에 씀
+			if (i + 16 <= srcLength && o + 16 <= destCapacity) {
+				const auto bytes = _mm_loadu_si128((const __m128i*)(pSrc + i));
+				if (_mm_movemask_epi8(bytes) == 0) {
+					_mm_storeu_si128((__m128i*)(pDest + o), _mm_unpacklo_epi8(bytes, _mm_setzero_si128()));
+					_mm_storeu_si128((__m128i*)(pDest + o + 8), _mm_unpackhi_epi8(bytes, _mm_setzero_si128()));
+					i += 16;
+					o += 16;
+					continue;
+				}
+			}
+#endif
+
+			char32_t codePoint = 0;
+			const auto readCount = DecodeUtf8(pSrc, i, srcLength, codePoint);
+			if (readCount == 0) {
+				return -1;
+			}
+
+			const auto writeCount = EncodeUtf16(codePoint, pDest + o, destCapacity - o);
+			if (writeCount == 0) {
+				return -1;
+			}
+
+			i += readCount;
+			o += writeCount;
+		}
+
+		return o;
+	}
+
+	int32_t Utf16ToUtf32(const char16_t* pSrc, const int32_t srcLength, char32_t* pDest, const int32_t destCapacity)
+	{
+		int32_t i = 0;
+		int32_t o = 0;
+		while (i < srcLength) {
+#if UTF_CODEC_SSE2
+			// 8 유닛에 서로게이트가 없으면 0 을 끼워 32비트로 넓힘
+			if (i + 8 <= srcLength && o + 8 <= destCapacity) {
+				const auto units = _mm_loadu_si128((const __m128i*)(pSrc + i));
+				if (SurrogateMask16(units) == 0) {
+					_mm_storeu_si128((__m128i*)(pDest + o), _mm_unpacklo_epi16(units, _mm_setzero_si128()));
+					_mm_storeu_si128((__m128i*)(pDest + o + 4), _mm_unpackhi_epi16(units, _mm_setzero_si128()));
+					i += 8;
+					o += 8;
+					continue;
+				}
+			}
+#endif
+
+			char32_t codePoint = 0;
+			const auto readCount = DecodeUtf16(pSrc, i, srcLength, codePoint);
+			if (readCount == 0 || o >= destCapacity) {
+				return -1;
+			}
+
+			pDest[o] = codePoint;
+			i += readCount;
+			++o;
+		}
+
+		return o;
+	}
+
+	int32_t Utf32ToUtf16(const char32_t* pSrc, const int32_t srcLength, char16_t* pDest, const int32_t destCapacity)
+	{
+		int32_t i = 0;
+		int32_t o = 0;
+		while (i < srcLength) {
+#if UTF_CODEC_SSE2
+			// 4 글자가 모두 서로게이트가 아닌 BMP 면 16비트로 좁힘
+			// (SSE2 에는 부호 없는 32→16 포화 변환이 없으므로 0x8000 을 빼서 부호 있는 변환을 쓰고 다시 되돌림)
+			if (i + 4 <= srcLength && o + 4 <= destCapacity) {
+				const auto codePoints = _mm_loadu_si128((const __m128i*)(pSrc + i));
+				const auto isBmp = _mm_cmpeq_epi32(_mm_srli_epi32(codePoints, 16), _mm_setzero_si128());
+				const auto surrogate = _mm_cmpeq_epi32(_mm_and_si128(codePoints, _mm_set1_epi32(0xF800)), _mm_set1_epi32(0xD800));
+				if (_mm_movemask_epi8(isBmp) == 0xFFFF && _mm_movemask_epi8(surrogate) == 0) {
+					const auto biased = _mm_sub_epi32(codePoints, _mm_set1_epi32(0x8000));
+					const auto packed = _mm_xor_si128(_mm_packs_epi32(biased, biased), _mm_set1_epi16((short)0x8000));
+					_mm_storel_epi64((__m128i*)(pDest + o), packed);
+					i += 4;
+					o += 4;
+					continue;
+				}
+			}
+#endif
+
+			const char32_t codePoint = pSrc[i];
+			if (codePoint > MAX_CODE_POINT || IsSurrogate(codePoint)) {
+				return -1;
+			}
+
+			const auto writeCount = EncodeUtf16(codePoint, pDest + o, destCapacity - o);
+			if (writeCount == 0) {
+				return -1;
+			}
+
+			++i;
+			o += writeCount;
+		}
+
+		return o;
+	}
+}
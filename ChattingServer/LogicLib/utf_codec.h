@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace NLogicLib
+{
+	// 패킷 문자열(UTF-16)과 UTF-8/UTF-32 사이의 변환과 검사
+	// - SSE2 가 있으면 8~16 유닛씩 한 번에 검사/변환하고, 서로게이트나 ASCII 가 아닌 문자가 섞인 곳만 한 글자씩 처리
+	// - 잘못된 입력(짝이 맞지 않는 서로게이트, 너무 길게 쓴 UTF-8, 범위 밖 코드 포인트)은 변환하면서 같이 걸러 -1 을 돌려줌
+	// - 변환 함수는 널 문자를 붙이지 않고 쓴 유닛 수를 돌려줌 (pDest 가 모자라도 -1)
+
+	// UTF-16 한 글자가 UTF-8 로 가장 길어지는 바이트 수 (서로게이트 쌍 2 유닛은 4 바이트)
+	constexpr int32_t MAX_UTF8_SIZE_PER_UTF16 = 3;
+
+	// 널 문자 전까지의 길이를 세면서 서로게이트 짝을 검사 (널 문자가 없으면 maxLength). 잘못된 문자열이면 -1
+	// pText 는 maxLength 유닛까지 읽을 수 있어야 함
+	int32_t ScanUtf16(const char16_t* pText, const int32_t maxLength);
+
+	int32_t Utf16ToUtf8(const char16_t* pSrc, const int32_t srcLength, char* pDest, const int32_t destCapacity);
+
+	int32_t Utf8ToUtf16(const char* pSrc, const int32_t srcLength, char16_t* pDest, const int32_t destCapacity);
+
+	int32_t Utf16ToUtf32(const char16_t* pSrc, const int32_t srcLength, char32_t* pDest, const int32_t destCapacity);
+
+	int32_t Utf32ToUtf16(const char32_t* pSrc, const int32_t srcLength, char16_t* pDest, const int32_t destCapacity);
+}
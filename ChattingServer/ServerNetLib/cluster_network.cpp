@@ -0,0 +1,1025 @@
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <sys/ioctl.h>
+#include <cerrno>
+#endif
+
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#include "cluster_network.h"
+
+namespace NServerNetLib
+{
+	namespace
+	{
+		// 링크가 끊겼을 때 다시 연결을 시도하는 간격
+		constexpr auto RECONNECT_INTERVAL = std::chrono::seconds(1);
+		// 레코드 하나의 최대 크기 (PacketHeader::TotalSize 가 int16_t)
+		constexpr int32_t MAX_RECORD_SIZE = 0x7FFF;
+		constexpr int32_t MAX_RECORD_BODY_SIZE = MAX_RECORD_SIZE - (int32_t)sizeof(ClusterRecordHeader);
+		// 받기 버퍼 (레코드 두 개는 항상 들어가도록)
+		constexpr size_t LINK_RECV_BUFFER_SIZE = MAX_RECORD_SIZE * 2;
+
+#ifdef _WIN32
+		constexpr int SEND_FLAGS = 0;
+#else
+		// 상대 노드가 끊겼을 때 SIGPIPE 로 프로세스가 죽지 않도록
+		constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#endif
+
+		int32_t GetLastNetError()
+		{
+#ifdef _WIN32
+			return WSAGetLastError();
+#else
+			return errno;
+#endif
+		}
+
+		bool SetNonBlockSocket(const SOCKET sockFD)
+		{
+			unsigned long mode = 1;
+#ifdef _WIN32
+			return ioctlsocket(sockFD, FIONBIO, &mode) != SOCKET_ERROR;
+#else
+			return ioctl(sockFD, FIONBIO, &mode) != -1;
+#endif
+		}
+
+		// 레코드는 링크 스레드가 모아서 보내므로 Nagle 로 한 번 더 늦출 필요가 없음
+		void SetNoDelay(const SOCKET sockFD)
+		{
+			int32_t noDelay = 1;
+			setsockopt(sockFD, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, sizeof(noDelay));
+		}
+
+		int64_t MakeProxyKey(const int32_t nodeId, const int32_t remoteSessionIndex)
+		{
+			return ((int64_t)nodeId << 32) | (uint32_t)remoteSessionIndex;
+		}
+
+		// "a,b,c" 를 나눔 (앞뒤 공백은 버림)
+		std::vector<std::string> SplitList(const char* pszList)
+		{
+			std::vector<std::string> itemList;
+			std::string item;
+			for (const char* p = pszList; ; ++p) {
+				if (*p == ',' || *p == '\0') {
+					auto begin = item.find_first_not_of(" \t");
+					auto end = item.find_last_not_of(" \t");
+					itemList.push_back(begin == std::string::npos ? "" : item.substr(begin, end - begin + 1));
+					item.clear();
+
+					if (*p == '\0') {
+						break;
+					}
+					continue;
+				}
+				item += *p;
+			}
+			return itemList;
+		}
+	}
+
+	ClusterNetwork::ClusterNetwork(std::unique_ptr<ITcpNetwork> pLocalNetwork)
+		: m_pLocalNetwork(std::move(pLocalNetwork))
+	{
+	}
+
+	ClusterNetwork::~ClusterNetwork()
+	{
+		StopLinkThread();
+	}
+
+	NET_ERROR_CODE ClusterNetwork::Init(const ServerConfig* pConfig, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_LocalSessionCount = m_pLocalNetwork->ClientSessionPoolSize();
+		m_LinkBufferSize = pConfig->ClusterLinkBufferKB * 1024;
+		m_FlushMicroSec = pConfig->ClusterFlushMicroSec;
+		m_Secret = pConfig->ClusterSecret;
+
+		auto loadResult = LoadNodeList(pConfig);
+		if (loadResult != NET_ERROR_CODE::kNONE) {
+			return loadResult;
+		}
+
+		if (m_Secret.empty()) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | ClusterSecret 이 없어 링크는 연결해 온 주소로만 확인함", __FUNCTION__);
+		}
+
+		auto listenResult = BindLinkListen();
+		if (listenResult != NET_ERROR_CODE::kNONE) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 노드 링크 리슨 실패. 포트(%d)", __FUNCTION__, m_OutboundList[m_NodeId]->Port);
+			return listenResult;
+		}
+
+		m_FrontAttachList.assign(m_LocalSessionCount, FrontAttach());
+
+		m_ProxyList.assign(pConfig->ClusterProxySessionCount, ProxySession());
+		for (int32_t i = 0; i < (int32_t)m_ProxyList.size(); ++i) {
+			m_FreeProxyList.push_back(m_LocalSessionCount + i);
+		}
+
+		m_IsRun = true;
+		m_LinkThread = std::thread([this]() { LinkThreadFunc(); });
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 클러스터 노드(%d/%d), 링크 포트(%d), 프록시 세션(%d)", __FUNCTION__,
+			m_NodeId, (int)m_OutboundList.size(), m_OutboundList[m_NodeId]->Port, (int)m_ProxyList.size());
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	NET_ERROR_CODE ClusterNetwork::LoadNodeList(const ServerConfig* pConfig)
+	{
+		auto nodeList = SplitList(pConfig->ClusterNodeList);
+		if (nodeList.empty() || nodeList.size() > MAX_CLUSTER_NODE_COUNT || pConfig->ClusterNodeId >= nodeList.size()) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 노드 목록(%s)과 노드 번호(%u)가 맞지 않음", __FUNCTION__,
+				pConfig->ClusterNodeList, pConfig->ClusterNodeId);
+			return NET_ERROR_CODE::kCLUSTER_INVALID_CONFIG;
+		}
+		m_NodeId = (int32_t)pConfig->ClusterNodeId;
+
+		for (auto& node : nodeList) {
+			auto colonPos = node.rfind(':');
+			auto port = colonPos != std::string::npos ? atoi(node.c_str() + colonPos + 1) : 0;
+			if (port <= 0 || port > 65535) {
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 노드 주소(%s)가 IP:포트 가 아님", __FUNCTION__, node.c_str());
+				return NET_ERROR_CODE::kCLUSTER_INVALID_CONFIG;
+			}
+
+			auto pLink = std::make_unique<OutboundLink>();
+			pLink->IP = node.substr(0, colonPos);
+			pLink->Port = (uint16_t)port;
+
+			// 연결해 온 주소로 노드를 확인하므로 모든 주소(0.0.0.0)는 쓸 수 없음
+			in_addr addr;
+			if (inet_pton(AF_INET, pLink->IP.c_str(), &addr) != 1 || addr.s_addr == htonl(INADDR_ANY)) {
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 노드 주소(%s)의 IP 가 잘못됨", __FUNCTION__, node.c_str());
+				return NET_ERROR_CODE::kCLUSTER_INVALID_CONFIG;
+			}
+			pLink->Addr = addr.s_addr;
+			m_OutboundList.push_back(std::move(pLink));
+		}
+
+		if (pConfig->ClusterLobbyOwnerList[0] == '\0') {
+			return NET_ERROR_CODE::kNONE;
+		}
+
+		for (auto& owner : SplitList(pConfig->ClusterLobbyOwnerList)) {
+			auto nodeId = atoi(owner.c_str());
+			if (owner.empty() || nodeId < 0 || nodeId >= (int32_t)m_OutboundList.size()) {
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 로비 주인 표(%s)에 없는 노드 번호", __FUNCTION__, pConfig->ClusterLobbyOwnerList);
+				return NET_ERROR_CODE::kCLUSTER_INVALID_CONFIG;
+			}
+			m_LobbyOwnerList.push_back(nodeId);
+		}
+
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	NET_ERROR_CODE ClusterNetwork::BindLinkListen()
+	{
+		auto& selfNode = *m_OutboundList[m_NodeId];
+
+		m_ListenSockFD = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		if (m_ListenSockFD == INVALID_SOCKET) {
+			return NET_ERROR_CODE::kSERVER_SOCKET_CREATE_FAIL;
+		}
+
+		int32_t n = 1;
+		setsockopt(m_ListenSockFD, SOL_SOCKET, SO_REUSEADDR, (char*)&n, sizeof(n));
+
+		struct sockaddr_in listen_addr;
+		memset(&listen_addr, 0, sizeof(listen_addr));
+		listen_addr.sin_family = AF_INET;
+		listen_addr.sin_port = htons(selfNode.Port);
+		if (inet_pton(AF_INET, selfNode.IP.c_str(), &listen_addr.sin_addr) != 1) {
+			return NET_ERROR_CODE::kCLUSTER_INVALID_CONFIG;
+		}
+
+		if (bind(m_ListenSockFD, (struct sockaddr*)&listen_addr, sizeof(listen_addr)) < 0) {
+			return NET_ERROR_CODE::kCLUSTER_LINK_LISTEN_FAIL;
+		}
+
+		if (listen(m_ListenSockFD, MAX_CLUSTER_NODE_COUNT) == SOCKET_ERROR || SetNonBlockSocket(m_ListenSockFD) == false) {
+			return NET_ERROR_CODE::kCLUSTER_LINK_LISTEN_FAIL;
+		}
+
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	void ClusterNetwork::Release()
+	{
+		StopLinkThread();
+
+		for (auto& pLink : m_InboundList) {
+			CloseSocket(pLink->SockFD);
+		}
+		m_InboundList.clear();
+
+		for (auto& pLink : m_OutboundList) {
+			CloseSocket(pLink->SockFD);
+			pLink->SockFD = INVALID_SOCKET;
+		}
+
+		CloseSocket(m_ListenSockFD);
+		m_ListenSockFD = INVALID_SOCKET;
+
+		if (m_pLocalNetwork) {
+			m_pLocalNetwork->Release();
+		}
+	}
+
+	void ClusterNetwork::StopLinkThread()
+	{
+		m_IsRun = false;
+		if (m_LinkThread.joinable()) {
+			m_LinkThread.join();
+		}
+	}
+
+	NET_ERROR_CODE ClusterNetwork::SendData(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pMsg)
+	{
+		if (IsProxySession(sessionIndex) == false) {
+			return m_pLocalNetwork->SendData(sessionIndex, packetId, bodySize, pMsg);
+		}
+
+		ProxySession proxySession;
+		{
+			std::lock_guard<std::mutex> guard(m_ProxyLock);
+			if (sessionIndex >= ClientSessionPoolSize()) {
+				return NET_ERROR_CODE::kSEND_CLOSE_SOCKET;
+			}
+			proxySession = m_ProxyList[sessionIndex - m_LocalSessionCount];
+		}
+
+		if (proxySession.NodeId < 0) {
+			return NET_ERROR_CODE::kSEND_CLOSE_SOCKET;
+		}
+
+		return PushRecord(proxySession.NodeId, CLUSTER_COMMAND::kSEND, proxySession.RemoteSessionIndex, proxySession.AttachId, packetId, pMsg, bodySize);
+	}
+
+	NET_ERROR_CODE ClusterNetwork::SendRawData(const int32_t sessionIndex, const char* pData, const int32_t size)
+	{
+		if (IsProxySession(sessionIndex) == false) {
+			return m_pLocalNetwork->SendRawData(sessionIndex, pData, size);
+		}
+
+		if (size <= 0) {
+			return NET_ERROR_CODE::kSEND_SIZE_ZERO;
+		}
+
+		ProxySession proxySession;
+		{
+			std::lock_guard<std::mutex> guard(m_ProxyLock);
+			if (sessionIndex >= ClientSessionPoolSize()) {
+				return NET_ERROR_CODE::kSEND_CLOSE_SOCKET;
+			}
+			proxySession = m_ProxyList[sessionIndex - m_LocalSessionCount];
+		}
+
+		if (proxySession.NodeId < 0) {
+			return NET_ERROR_CODE::kSEND_CLOSE_SOCKET;
+		}
+
+		// 레코드 하나에 다 들어가지 않으면 패킷 경계에서 나눔
+		int32_t readPos = 0;
+		while (readPos < size) {
+			int32_t chunkSize = 0;
+			while (readPos + chunkSize + PACKET_HEADER_SIZE <= size) {
+				auto pHeader = (const PacketHeader*)(pData + readPos + chunkSize);
+				if (pHeader->TotalSize < PACKET_HEADER_SIZE || chunkSize + pHeader->TotalSize > MAX_RECORD_BODY_SIZE) {
+					break;
+				}
+				chunkSize += pHeader->TotalSize;
+			}
+
+			if (chunkSize == 0) {
+				return NET_ERROR_CODE::kCLIENT_SEND_BUFFER_FULL;
+			}
+
+			auto pushResult = PushRecord(proxySession.NodeId, CLUSTER_COMMAND::kSEND_RAW, proxySession.RemoteSessionIndex, proxySession.AttachId,
+				0, pData + readPos, chunkSize);
+			if (pushResult != NET_ERROR_CODE::kNONE) {
+				return pushResult;
+			}
+			readPos += chunkSize;
+		}
+
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	void ClusterNetwork::ForcingClose(const int32_t sessionIndex)
+	{
+		if (IsProxySession(sessionIndex) == false) {
+			m_pLocalNetwork->ForcingClose(sessionIndex);
+			return;
+		}
+
+		ProxySession proxySession;
+		{
+			std::lock_guard<std::mutex> guard(m_ProxyLock);
+			if (sessionIndex >= ClientSessionPoolSize()) {
+				return;
+			}
+			proxySession = m_ProxyList[sessionIndex - m_LocalSessionCount];
+		}
+
+		if (proxySession.NodeId >= 0) {
+			PushRecord(proxySession.NodeId, CLUSTER_COMMAND::kCLOSE, proxySession.RemoteSessionIndex, proxySession.AttachId, 0, nullptr, 0);
+		}
+	}
+
+	int32_t ClusterNetwork::GetLobbyOwnerNode(const int32_t lobbyIndex) const
+	{
+		if (lobbyIndex < 0) {
+			return m_NodeId;
+		}
+
+		if (lobbyIndex < (int32_t)m_LobbyOwnerList.size()) {
+			return m_LobbyOwnerList[lobbyIndex];
+		}
+
+		return lobbyIndex % (int32_t)m_OutboundList.size();
+	}
+
+	NET_ERROR_CODE ClusterNetwork::Attach(const int32_t sessionIndex, const int32_t nodeId, const char* pszUserID)
+	{
+		if (sessionIndex < 0 || IsProxySession(sessionIndex) || nodeId < 0 || nodeId >= (int32_t)m_OutboundList.size() || nodeId == m_NodeId) {
+			return NET_ERROR_CODE::kCLUSTER_INVALID_CONFIG;
+		}
+
+		if (m_OutboundList[nodeId]->IsConnected == false) {
+			return NET_ERROR_CODE::kCLUSTER_NODE_NOT_CONNECTED;
+		}
+
+		int32_t attachId = 0;
+		{
+			std::lock_guard<std::mutex> guard(m_AttachLock);
+			attachId = ++m_LastAttachId;
+
+			auto& frontAttach = m_FrontAttachList[sessionIndex];
+			frontAttach.NodeId = nodeId;
+			frontAttach.AttachId = attachId;
+			frontAttach.IsJoined = false;
+		}
+
+		auto pushResult = PushRecord(nodeId, CLUSTER_COMMAND::kATTACH, sessionIndex, attachId, 0, pszUserID, (int32_t)strlen(pszUserID) + 1);
+		if (pushResult != NET_ERROR_CODE::kNONE) {
+			std::lock_guard<std::mutex> guard(m_AttachLock);
+			m_FrontAttachList[sessionIndex] = FrontAttach();
+		}
+		return pushResult;
+	}
+
+	bool ClusterNetwork::IsAttached(const int32_t sessionIndex)
+	{
+		if (sessionIndex < 0 || IsProxySession(sessionIndex)) {
+			return false;
+		}
+
+		std::lock_guard<std::mutex> guard(m_AttachLock);
+		return m_FrontAttachList[sessionIndex].NodeId >= 0;
+	}
+
+	bool ClusterNetwork::IsJoined(const int32_t sessionIndex)
+	{
+		if (sessionIndex < 0 || IsProxySession(sessionIndex)) {
+			return false;
+		}
+
+		std::lock_guard<std::mutex> guard(m_AttachLock);
+		return m_FrontAttachList[sessionIndex].IsJoined;
+	}
+
+	void ClusterNetwork::SetJoined(const int32_t sessionIndex)
+	{
+		if (sessionIndex < 0 || IsProxySession(sessionIndex)) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> guard(m_AttachLock);
+		auto& frontAttach = m_FrontAttachList[sessionIndex];
+		if (frontAttach.NodeId >= 0) {
+			frontAttach.IsJoined = true;
+		}
+	}
+
+	NET_ERROR_CODE ClusterNetwork::Forward(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pBody)
+	{
+		if (sessionIndex < 0 || IsProxySession(sessionIndex)) {
+			return NET_ERROR_CODE::kCLUSTER_NOT_ATTACHED;
+		}
+
+		FrontAttach frontAttach;
+		{
+			std::lock_guard<std::mutex> guard(m_AttachLock);
+			frontAttach = m_FrontAttachList[sessionIndex];
+		}
+
+		if (frontAttach.NodeId < 0) {
+			return NET_ERROR_CODE::kCLUSTER_NOT_ATTACHED;
+		}
+
+		return PushRecord(frontAttach.NodeId, CLUSTER_COMMAND::kFORWARD, sessionIndex, frontAttach.AttachId, packetId, pBody, bodySize);
+	}
+
+	void ClusterNetwork::Detach(const int32_t sessionIndex)
+	{
+		if (sessionIndex < 0 || IsProxySession(sessionIndex)) {
+			return;
+		}
+
+		FrontAttach frontAttach;
+		{
+			std::lock_guard<std::mutex> guard(m_AttachLock);
+			frontAttach = m_FrontAttachList[sessionIndex];
+			m_FrontAttachList[sessionIndex] = FrontAttach();
+		}
+
+		if (frontAttach.NodeId >= 0) {
+			PushRecord(frontAttach.NodeId, CLUSTER_COMMAND::kDETACH, sessionIndex, frontAttach.AttachId, 0, nullptr, 0);
+		}
+	}
+
+	void ClusterNetwork::SetResultNotifyPacket(const int16_t packetId, const bool isNotify)
+	{
+		if (packetId < 0 || packetId >= MAX_PACKET_ID) {
+			return;
+		}
+
+		m_IsResultNotifyPacket[packetId] = isNotify;
+	}
+
+	NET_ERROR_CODE ClusterNetwork::PushRecord(const int32_t nodeId, const CLUSTER_COMMAND command, const int32_t sessionIndex, const int32_t attachId,
+		const int16_t packetId, const char* pBody, const int32_t bodySize)
+	{
+		if (bodySize < 0 || bodySize > MAX_RECORD_BODY_SIZE) {
+			return NET_ERROR_CODE::kCLIENT_SEND_BUFFER_FULL;
+		}
+
+		auto& link = *m_OutboundList[nodeId];
+		if (link.IsConnected == false) {
+			return NET_ERROR_CODE::kCLUSTER_NODE_NOT_CONNECTED;
+		}
+
+		ClusterRecordHeader header;
+		header.TotalSize = (int16_t)(sizeof(ClusterRecordHeader) + bodySize);
+		header.Id = (int16_t)command;
+		header.Reserve = 0;
+		header.SessionIndex = sessionIndex;
+		header.AttachId = attachId;
+		header.PacketId = packetId;
+
+		std::lock_guard<std::mutex> guard(link.PendingLock);
+		if (link.PendingBuffer.size() + header.TotalSize > m_LinkBufferSize) {
+			return NET_ERROR_CODE::kCLUSTER_LINK_BUFFER_FULL;
+		}
+
+		link.PendingBuffer.insert(link.PendingBuffer.end(), (const char*)&header, (const char*)&header + sizeof(header));
+		if (bodySize > 0) {
+			link.PendingBuffer.insert(link.PendingBuffer.end(), pBody, pBody + bodySize);
+		}
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	void ClusterNetwork::LinkThreadFunc()
+	{
+		while (m_IsRun) {
+			fd_set read_set;
+			fd_set write_set;
+			FD_ZERO(&read_set);
+			FD_ZERO(&write_set);
+
+			SOCKET maxSockFD = m_ListenSockFD;
+			FD_SET(m_ListenSockFD, &read_set);
+
+			for (auto& pLink : m_InboundList) {
+				FD_SET(pLink->SockFD, &read_set);
+				maxSockFD = std::max(maxSockFD, pLink->SockFD);
+			}
+
+			for (auto& pLink : m_OutboundList) {
+				if (pLink->SockFD == INVALID_SOCKET) {
+					continue;
+				}
+
+				// 보내기만 하는 링크이므로 읽기는 끊김 확인용. 연결 중이거나 다 보내지 못했을 때만 쓰기 감시
+				FD_SET(pLink->SockFD, &read_set);
+				if (pLink->IsConnecting || pLink->SendingPos < pLink->SendingBuffer.size()) {
+					FD_SET(pLink->SockFD, &write_set);
+				}
+				maxSockFD = std::max(maxSockFD, pLink->SockFD);
+			}
+
+			// 로직이 쓴 레코드는 깨우지 않으므로 이 간격마다 모아서 보냄
+			timeval timeout{ (long)(m_FlushMicroSec / 1000000), (long)(m_FlushMicroSec % 1000000) };
+#ifdef _WIN32
+			int32_t selectResult = select(0, &read_set, &write_set, nullptr, &timeout);
+#else
+			int32_t selectResult = select(maxSockFD + 1, &read_set, &write_set, nullptr, &timeout);
+#endif
+			if (selectResult < 0) {
+				FD_ZERO(&read_set);
+				FD_ZERO(&write_set);
+			}
+
+			if (FD_ISSET(m_ListenSockFD, &read_set)) {
+				AcceptInbound();
+			}
+
+			for (size_t i = 0; i < m_InboundList.size(); ) {
+				auto& link = *m_InboundList[i];
+				if (FD_ISSET(link.SockFD, &read_set) && RecvInbound(link) == false) {
+					CloseInbound(link);
+					m_InboundList.erase(m_InboundList.begin() + i);
+					continue;
+				}
+				++i;
+			}
+
+			const auto curTime = std::chrono::steady_clock::now();
+			for (int32_t nodeId = 0; nodeId < (int32_t)m_OutboundList.size(); ++nodeId) {
+				if (nodeId == m_NodeId) {
+					continue;
+				}
+
+				auto& link = *m_OutboundList[nodeId];
+				if (link.SockFD == INVALID_SOCKET) {
+					if (curTime >= link.NextConnectTime) {
+						StartConnect(nodeId, link);
+					}
+					continue;
+				}
+
+				if (link.IsConnecting) {
+					if (FD_ISSET(link.SockFD, &write_set)) {
+						CheckConnect(nodeId, link);
+					}
+					continue;
+				}
+
+				bool isClosed = false;
+				if (FD_ISSET(link.SockFD, &read_set)) {
+					char discard[256];
+					auto recvSize = recv(link.SockFD, discard, sizeof(discard), 0);
+					isClosed = recvSize == 0 || (recvSize < 0 && GetLastNetError() != WSAEWOULDBLOCK);
+				}
+
+				if (isClosed || FlushOutbound(link) == false) {
+					CloseOutbound(nodeId, link);
+				}
+			}
+		}
+	}
+
+	void ClusterNetwork::AcceptInbound()
+	{
+		while (true) {
+			struct sockaddr_in peer_addr;
+			socklen_t peerAddrLen = sizeof(peer_addr);
+			SOCKET sockFD = accept(m_ListenSockFD, (struct sockaddr*)&peer_addr, &peerAddrLen);
+			if (sockFD == INVALID_SOCKET) {
+				return;
+			}
+
+			// 노드 목록에 없는 주소에서 온 연결은 kHELLO 를 기다리지 않고 바로 끊음
+			if (IsNodeAddr(peer_addr.sin_addr.s_addr) == false) {
+				char szIP[MAX_IP_LEN] = { 0, };
+				inet_ntop(AF_INET, &peer_addr.sin_addr, szIP, sizeof(szIP) - 1);
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 노드 목록에 없는 주소(%s)의 링크 연결을 끊음", __FUNCTION__, szIP);
+				CloseSocket(sockFD);
+				continue;
+			}
+
+			if (m_InboundList.size() >= MAX_CLUSTER_NODE_COUNT * 2 || SetNonBlockSocket(sockFD) == false) {
+				CloseSocket(sockFD);
+				continue;
+			}
+
+			auto pLink = std::make_unique<InboundLink>();
+			pLink->SockFD = sockFD;
+			pLink->PeerAddr = peer_addr.sin_addr.s_addr;
+			pLink->RecvBuffer.resize(LINK_RECV_BUFFER_SIZE);
+			m_InboundList.push_back(std::move(pLink));
+		}
+	}
+
+	bool ClusterNetwork::RecvInbound(InboundLink& link)
+	{
+		auto recvSize = recv(link.SockFD, link.RecvBuffer.data() + link.RecvSize, (int)(link.RecvBuffer.size() - link.RecvSize), 0);
+		if (recvSize == 0) {
+			return false;
+		}
+
+		if (recvSize < 0) {
+			return GetLastNetError() == WSAEWOULDBLOCK;
+		}
+		link.RecvSize += recvSize;
+
+		size_t readPos = 0;
+		while (link.RecvSize - readPos >= sizeof(ClusterRecordHeader)) {
+			ClusterRecordHeader header;
+			memcpy(&header, link.RecvBuffer.data() + readPos, sizeof(header));
+			if (header.TotalSize < (int16_t)sizeof(ClusterRecordHeader)) {
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 잘못된 레코드 크기(%d). 노드(%d)", __FUNCTION__, header.TotalSize, link.NodeId);
+				return false;
+			}
+
+			if (link.RecvSize - readPos < (size_t)header.TotalSize) {
+				break;
+			}
+
+			auto pBody = link.RecvBuffer.data() + readPos + sizeof(ClusterRecordHeader);
+			if (ProcessRecord(link, header, pBody, header.TotalSize - (int32_t)sizeof(ClusterRecordHeader)) == false) {
+				return false;
+			}
+			readPos += header.TotalSize;
+		}
+
+		// 남은 조각을 앞으로 당김
+		if (readPos > 0) {
+			memmove(link.RecvBuffer.data(), link.RecvBuffer.data() + readPos, link.RecvSize - readPos);
+			link.RecvSize -= readPos;
+		}
+		return true;
+	}
+
+	bool ClusterNetwork::ProcessRecord(InboundLink& link, const ClusterRecordHeader& header, const char* pBody, const int32_t bodySize)
+	{
+		auto command = (CLUSTER_COMMAND)header.Id;
+
+		if (link.NodeId < 0) {
+			auto nodeId = CheckHello(link, command, pBody, bodySize);
+			if (nodeId < 0) {
+				return false;
+			}
+
+			link.NodeId = nodeId;
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 노드(%d)가 연결함", __FUNCTION__, nodeId);
+			return true;
+		}
+
+		switch (command)
+		{
+		case CLUSTER_COMMAND::kATTACH:
+		{
+			char szUserID[HANDOFF_USER_TAG_SIZE] = { 0, };
+			memcpy(szUserID, pBody, std::min<int32_t>(bodySize, sizeof(szUserID) - 1));
+			OpenProxySession(link.NodeId, header.SessionIndex, header.AttachId, szUserID);
+			break;
+		}
+		case CLUSTER_COMMAND::kFORWARD:
+		{
+			auto proxySessionIndex = FindProxySession(link.NodeId, header.SessionIndex, header.AttachId);
+			if (proxySessionIndex >= 0 && bodySize <= MAX_PACKET_BODY_SIZE) {
+				m_pLocalNetwork->PostPacket(proxySessionIndex, header.PacketId, (int16_t)bodySize, (const int8_t*)pBody);
+			}
+			break;
+		}
+		case CLUSTER_COMMAND::kDETACH:
+		{
+			auto proxySessionIndex = FindProxySession(link.NodeId, header.SessionIndex, header.AttachId);
+			if (proxySessionIndex >= 0) {
+				CloseProxySession(proxySessionIndex);
+			}
+			break;
+		}
+		case CLUSTER_COMMAND::kSEND:
+			if (IsFrontAttachValid(header.SessionIndex, link.NodeId, header.AttachId)) {
+				m_pLocalNetwork->SendData(header.SessionIndex, header.PacketId, (int16_t)bodySize, pBody);
+
+				if (header.PacketId >= 0 && header.PacketId < MAX_PACKET_ID && m_IsResultNotifyPacket[header.PacketId]) {
+					ClusterResultInfo resultInfo;
+					resultInfo.PacketId = header.PacketId;
+					resultInfo.ErrorCode = 0;
+					memcpy(&resultInfo.ErrorCode, pBody, std::min<int32_t>(bodySize, sizeof(resultInfo.ErrorCode)));
+					m_pLocalNetwork->PostPacket(header.SessionIndex, (int16_t)PACKET_ID::kNTF_SYS_CLUSTER_RESULT, sizeof(resultInfo), (const int8_t*)&resultInfo);
+				}
+			}
+			break;
+		case CLUSTER_COMMAND::kSEND_RAW:
+			if (IsFrontAttachValid(header.SessionIndex, link.NodeId, header.AttachId)) {
+				m_pLocalNetwork->SendRawData(header.SessionIndex, pBody, bodySize);
+			}
+			break;
+		case CLUSTER_COMMAND::kCLOSE:
+			if (IsFrontAttachValid(header.SessionIndex, link.NodeId, header.AttachId)) {
+				m_pLocalNetwork->ForcingClose(header.SessionIndex);
+			}
+			break;
+		default:
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 알 수 없는 레코드. Command(%d), 노드(%d)", __FUNCTION__, (int)command, link.NodeId);
+			return false;
+		}
+
+		return true;
+	}
+
+	int32_t ClusterNetwork::CheckHello(const InboundLink& link, const CLUSTER_COMMAND command, const char* pBody, const int32_t bodySize)
+	{
+		int32_t nodeId = -1;
+		if (command == CLUSTER_COMMAND::kHELLO && bodySize >= (int32_t)sizeof(nodeId)) {
+			memcpy(&nodeId, pBody, sizeof(nodeId));
+		}
+
+		if (nodeId < 0 || nodeId >= (int32_t)m_OutboundList.size() || nodeId == m_NodeId) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 노드 번호를 알리지 않은 링크. Command(%d), 노드(%d)", __FUNCTION__, (int)command, nodeId);
+			return -1;
+		}
+
+		if (link.PeerAddr != m_OutboundList[nodeId]->Addr) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 노드(%d)의 주소가 아닌 곳에서 온 링크", __FUNCTION__, nodeId);
+			return -1;
+		}
+
+		// 비밀이 맞는지는 길이가 같을 때 모든 바이트를 비교해서 확인 (앞부분만 맞는지를 시간으로 알 수 없도록)
+		auto pSecret = pBody + sizeof(nodeId);
+		auto secretSize = bodySize - (int32_t)sizeof(nodeId);
+		uint8_t diff = secretSize == (int32_t)m_Secret.size() ? 0 : 1;
+		for (int32_t i = 0; i < (int32_t)m_Secret.size(); ++i) {
+			diff |= (uint8_t)(m_Secret[i] ^ (i < secretSize ? pSecret[i] : 0));
+		}
+		if (diff != 0) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 노드(%d)의 링크가 보낸 공유 비밀이 다름", __FUNCTION__, nodeId);
+			return -1;
+		}
+
+		return nodeId;
+	}
+
+	bool ClusterNetwork::IsNodeAddr(const uint32_t addr) const
+	{
+		for (int32_t nodeId = 0; nodeId < (int32_t)m_OutboundList.size(); ++nodeId) {
+			if (nodeId != m_NodeId && m_OutboundList[nodeId]->Addr == addr) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void ClusterNetwork::CloseInbound(InboundLink& link)
+	{
+		CloseSocket(link.SockFD);
+		link.SockFD = INVALID_SOCKET;
+
+		if (link.NodeId >= 0) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 노드(%d)에서 온 링크가 끊김", __FUNCTION__, link.NodeId);
+			CloseProxySessionByNode(link.NodeId);
+		}
+	}
+
+	void ClusterNetwork::StartConnect(const int32_t nodeId, OutboundLink& link)
+	{
+		link.NextConnectTime = std::chrono::steady_clock::now() + RECONNECT_INTERVAL;
+
+		struct sockaddr_in node_addr;
+		memset(&node_addr, 0, sizeof(node_addr));
+		node_addr.sin_family = AF_INET;
+		node_addr.sin_port = htons(link.Port);
+		if (inet_pton(AF_INET, link.IP.c_str(), &node_addr.sin_addr) != 1) {
+			return;
+		}
+
+		SOCKET sockFD = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		if (sockFD == INVALID_SOCKET) {
+			return;
+		}
+
+		if (SetNonBlockSocket(sockFD) == false) {
+			CloseSocket(sockFD);
+			return;
+		}
+		SetNoDelay(sockFD);
+
+		link.SockFD = sockFD;
+		link.IsConnecting = true;
+
+		if (connect(sockFD, (struct sockaddr*)&node_addr, sizeof(node_addr)) == 0) {
+			CheckConnect(nodeId, link);
+			return;
+		}
+
+		auto netError = GetLastNetError();
+#ifdef _WIN32
+		const bool isInProgress = netError == WSAEWOULDBLOCK;
+#else
+		const bool isInProgress = netError == EINPROGRESS;
+#endif
+		if (isInProgress == false) {
+			CloseSocket(sockFD);
+			link.SockFD = INVALID_SOCKET;
+			link.IsConnecting = false;
+		}
+	}
+
+	void ClusterNetwork::CheckConnect(const int32_t nodeId, OutboundLink& link)
+	{
+		int32_t sockError = 0;
+		socklen_t sockErrorLen = sizeof(sockError);
+		getsockopt(link.SockFD, SOL_SOCKET, SO_ERROR, (char*)&sockError, &sockErrorLen);
+		if (sockError != 0) {
+			CloseSocket(link.SockFD);
+			link.SockFD = INVALID_SOCKET;
+			link.IsConnecting = false;
+			return;
+		}
+
+		link.IsConnecting = false;
+
+		// 받는 쪽이 어느 노드의 링크인지 알도록 맨 먼저 보냄
+		ClusterRecordHeader header;
+		memset(&header, 0, sizeof(header));
+		header.TotalSize = (int16_t)(sizeof(ClusterRecordHeader) + sizeof(m_NodeId) + m_Secret.size());
+		header.Id = (int16_t)CLUSTER_COMMAND::kHELLO;
+		link.SendingBuffer.assign((const char*)&header, (const char*)&header + sizeof(header));
+		link.SendingBuffer.insert(link.SendingBuffer.end(), (const char*)&m_NodeId, (const char*)&m_NodeId + sizeof(m_NodeId));
+		link.SendingBuffer.insert(link.SendingBuffer.end(), m_Secret.begin(), m_Secret.end());
+		link.SendingPos = 0;
+
+		link.IsConnected = true;
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 노드(%d, %s:%d)에 연결", __FUNCTION__, nodeId, link.IP.c_str(), link.Port);
+	}
+
+	bool ClusterNetwork::FlushOutbound(OutboundLink& link)
+	{
+		// 보내던 것을 다 보냈으면 그동안 쌓인 레코드를 한 번에 가져옴
+		if (link.SendingPos >= link.SendingBuffer.size()) {
+			link.SendingBuffer.clear();
+			link.SendingPos = 0;
+
+			std::lock_guard<std::mutex> guard(link.PendingLock);
+			link.SendingBuffer.swap(link.PendingBuffer);
+		}
+
+		while (link.SendingPos < link.SendingBuffer.size()) {
+			auto sendSize = send(link.SockFD, link.SendingBuffer.data() + link.SendingPos, (int)(link.SendingBuffer.size() - link.SendingPos), SEND_FLAGS);
+			if (sendSize < 0) {
+				return GetLastNetError() == WSAEWOULDBLOCK;
+			}
+			link.SendingPos += sendSize;
+		}
+
+		return true;
+	}
+
+	void ClusterNetwork::CloseOutbound(const int32_t nodeId, OutboundLink& link)
+	{
+		link.IsConnected = false;
+		CloseSocket(link.SockFD);
+		link.SockFD = INVALID_SOCKET;
+		link.NextConnectTime = std::chrono::steady_clock::now() + RECONNECT_INTERVAL;
+
+		link.SendingBuffer.clear();
+		link.SendingPos = 0;
+		{
+			std::lock_guard<std::mutex> guard(link.PendingLock);
+			link.PendingBuffer.clear();
+		}
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 노드(%d)로 가는 링크가 끊김", __FUNCTION__, nodeId);
+		CloseFrontSessionByNode(nodeId);
+	}
+
+	void ClusterNetwork::OpenProxySession(const int32_t nodeId, const int32_t remoteSessionIndex, const int32_t attachId, const char* pszUserID)
+	{
+		int32_t oldProxySessionIndex = -1;
+		int32_t proxySessionIndex = -1;
+		{
+			std::lock_guard<std::mutex> guard(m_ProxyLock);
+
+			// 이전 접속의 DETACH 를 받지 못했으면 먼저 정리
+			auto findIter = m_ProxyDic.find(MakeProxyKey(nodeId, remoteSessionIndex));
+			if (findIter != m_ProxyDic.end()) {
+				oldProxySessionIndex = findIter->second;
+			}
+
+			if (oldProxySessionIndex < 0 && m_FreeProxyList.empty() == false) {
+				proxySessionIndex = m_FreeProxyList.front();
+				m_FreeProxyList.pop_front();
+
+				auto& proxySession = m_ProxyList[proxySessionIndex - m_LocalSessionCount];
+				proxySession.NodeId = nodeId;
+				proxySession.RemoteSessionIndex = remoteSessionIndex;
+				proxySession.AttachId = attachId;
+				m_ProxyDic[MakeProxyKey(nodeId, remoteSessionIndex)] = proxySessionIndex;
+			}
+		}
+
+		if (oldProxySessionIndex >= 0) {
+			CloseProxySession(oldProxySessionIndex);
+			OpenProxySession(nodeId, remoteSessionIndex, attachId, pszUserID);
+			return;
+		}
+
+		if (proxySessionIndex < 0) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 프록시 세션이 모자람. 노드(%d), 세션 인덱스(%d)", __FUNCTION__, nodeId, remoteSessionIndex);
+			PushRecord(nodeId, CLUSTER_COMMAND::kCLOSE, remoteSessionIndex, attachId, 0, nullptr, 0);
+			return;
+		}
+
+		m_pLocalNetwork->PostPacket(proxySessionIndex, (int16_t)PACKET_ID::kNTF_SYS_CONNECT_SESSION, 0, nullptr);
+		m_pLocalNetwork->PostPacket(proxySessionIndex, (int16_t)PACKET_ID::kNTF_SYS_CLUSTER_ATTACH, (int16_t)(strlen(pszUserID) + 1), (const int8_t*)pszUserID);
+	}
+
+	int32_t ClusterNetwork::FindProxySession(const int32_t nodeId, const int32_t remoteSessionIndex, const int32_t attachId)
+	{
+		std::lock_guard<std::mutex> guard(m_ProxyLock);
+
+		auto findIter = m_ProxyDic.find(MakeProxyKey(nodeId, remoteSessionIndex));
+		if (findIter == m_ProxyDic.end()) {
+			return -1;
+		}
+
+		auto& proxySession = m_ProxyList[findIter->second - m_LocalSessionCount];
+		return proxySession.AttachId == attachId ? findIter->second : -1;
+	}
+
+	void ClusterNetwork::CloseProxySession(const int32_t proxySessionIndex)
+	{
+		{
+			std::lock_guard<std::mutex> guard(m_ProxyLock);
+
+			auto& proxySession = m_ProxyList[proxySessionIndex - m_LocalSessionCount];
+			if (proxySession.NodeId < 0) {
+				return;
+			}
+
+			m_ProxyDic.erase(MakeProxyKey(proxySession.NodeId, proxySession.RemoteSessionIndex));
+			proxySession = ProxySession();
+			// 바로 다시 쓰면 로직이 아직 처리하지 않은 이전 유저의 송신이 새 유저에게 갈 수 있으므로 맨 뒤로
+			m_FreeProxyList.push_back(proxySessionIndex);
+		}
+
+		m_pLocalNetwork->PostPacket(proxySessionIndex, (int16_t)PACKET_ID::kNTF_SYS_CLOSE_SESSION, 0, nullptr);
+	}
+
+	void ClusterNetwork::CloseProxySessionByNode(const int32_t nodeId)
+	{
+		std::vector<int32_t> closeList;
+		{
+			std::lock_guard<std::mutex> guard(m_ProxyLock);
+			for (int32_t i = 0; i < (int32_t)m_ProxyList.size(); ++i) {
+				if (m_ProxyList[i].NodeId == nodeId) {
+					closeList.push_back(m_LocalSessionCount + i);
+				}
+			}
+		}
+
+		for (auto proxySessionIndex : closeList) {
+			CloseProxySession(proxySessionIndex);
+		}
+	}
+
+	void ClusterNetwork::CloseFrontSessionByNode(const int32_t nodeId)
+	{
+		// 유저는 그 노드의 로비에 있다고 알고 있으므로 이 노드로 되돌리지 않고 끊어서 다시 접속하게 함
+		std::vector<int32_t> closeList;
+		{
+			std::lock_guard<std::mutex> guard(m_AttachLock);
+			for (int32_t i = 0; i < (int32_t)m_FrontAttachList.size(); ++i) {
+				if (m_FrontAttachList[i].NodeId == nodeId) {
+					m_FrontAttachList[i] = FrontAttach();
+					closeList.push_back(i);
+				}
+			}
+		}
+
+		for (auto sessionIndex : closeList) {
+			m_pLocalNetwork->ForcingClose(sessionIndex);
+		}
+	}
+
+	bool ClusterNetwork::IsFrontAttachValid(const int32_t sessionIndex, const int32_t nodeId, const int32_t attachId)
+	{
+		if (sessionIndex < 0 || IsProxySession(sessionIndex)) {
+			return false;
+		}
+
+		std::lock_guard<std::mutex> guard(m_AttachLock);
+		auto& frontAttach = m_FrontAttachList[sessionIndex];
+		return frontAttach.NodeId == nodeId && frontAttach.AttachId == attachId;
+	}
+
+	void ClusterNetwork::CloseSocket(const SOCKET sockFD)
+	{
+		if (sockFD == INVALID_SOCKET) {
+			return;
+		}
+
+#ifdef _WIN32
+		closesocket(sockFD);
+#else
+		close(sockFD);
+#endif
+	}
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <unordered_map>
+
+#include "tcp_network.h"
+
+namespace NServerNetLib
+{
+	// 노드 사이 링크 레코드 종류 (PacketHeader::Id 에 넣음)
+	enum class CLUSTER_COMMAND : int16_t
+	{
+		// 연결한 쪽이 처음 한 번 자기 노드 번호를 알림 (바디: int32_t 노드 번호 + 공유 비밀 ClusterSecret)
+		// 받는 쪽은 연결해 온 주소가 그 노드의 주소이고 비밀이 같을 때만 링크로 받음
+		kHELLO = 1,
+
+		// 유저가 접속한 노드 → 로비를 맡은 노드
+		// 유저가 로비로 들어가려 함 (바디: 유저 ID)
+		kATTACH = 2,
+		// 클라이언트가 보낸 로비/룸 패킷
+		kFORWARD = 3,
+		// 로비를 나갔거나 접속이 끊김
+		kDETACH = 4,
+
+		// 로비를 맡은 노드 → 유저가 접속한 노드
+		// 클라이언트에게 보낼 패킷
+		kSEND = 5,
+		// 헤더가 붙은 패킷 묶음
+		kSEND_RAW = 6,
+		// 클라이언트 접속을 끊음
+		kCLOSE = 7,
+	};
+
+#pragma pack(push, 1)
+	// 링크 레코드 = ClusterRecordHeader + 바디 (TotalSize 는 바디까지 포함)
+	struct ClusterRecordHeader : PacketHeader
+	{
+		// 유저가 접속한 노드에서의 세션 인덱스
+		int32_t SessionIndex;
+		// 세션 인덱스가 다른 접속에 다시 쓰였을 때 이전 접속에 대한 레코드를 구분
+		int32_t AttachId;
+		// kFORWARD/kSEND 의 클라이언트 패킷 ID
+		int16_t PacketId;
+	};
+
+	// kNTF_SYS_CLUSTER_RESULT 의 바디
+	struct ClusterResultInfo
+	{
+		int16_t PacketId;
+		int16_t ErrorCode;
+	};
+#pragma pack(pop)
+
+	constexpr int MAX_CLUSTER_NODE_COUNT = 16;
+
+	// 로비를 노드(서버 프로세스)마다 나눠 맡는 클러스터 구성의 네트워크
+	// - 클라이언트 소켓은 안에 있는 ITcpNetwork(TcpNetwork)가 그대로 처리하고, 이 클래스는 노드 사이 링크만 추가로 처리
+	// - 다른 노드가 맡은 로비에 들어간 유저(Attach)의 로비/룸 패킷은 그 노드로 넘기고(Forward), 그 노드가 보낸 응답/알림은 클라이언트에게 그대로 보냄
+	// - 다른 노드에서 넘어온 유저는 세션 인덱스 [로컬 세션 수, ClientSessionPoolSize()) 의 프록시 세션이 됨. 로직은 일반 세션과 똑같이 처리하고
+	//   프록시 세션에 보내는 SendData/SendRawData/ForcingClose 는 유저가 접속한 노드로 넘어감
+	// - 링크는 노드마다 보내는 용도로 하나씩 연결하고(끊기면 1초마다 다시 연결) 받는 것은 다른 노드가 연결해 온 링크로 받음
+	//   로직 스레드들이 쓴 레코드는 링크 스레드가 ClusterFlushMicroSec 마다 모아서 한 번에 보냄
+	// 로직 스레드/워커: SendData 등과 Attach/Forward/Detach, 링크 스레드: 노드 사이 송수신
+	class ClusterNetwork : public ITcpNetwork
+	{
+		struct FrontAttach
+		{
+			// 로비를 맡은 노드 (-1 이면 이 노드에서 처리)
+			int32_t NodeId = -1;
+			int32_t AttachId = 0;
+			// 로비 입장 응답을 성공으로 받았는지
+			bool IsJoined = false;
+		};
+
+		struct ProxySession
+		{
+			// 유저가 접속한 노드 (-1 이면 사용하지 않는 프록시 세션)
+			int32_t NodeId = -1;
+			int32_t RemoteSessionIndex = 0;
+			int32_t AttachId = 0;
+		};
+
+		struct OutboundLink
+		{
+			std::string IP;
+			uint16_t Port = 0;
+			// IP 를 바꾼 값 (network byte order, 연결해 온 주소 확인용)
+			uint32_t Addr = 0;
+
+			SOCKET SockFD = INVALID_SOCKET;
+			bool IsConnecting = false;
+			std::atomic<bool> IsConnected = false;
+			std::chrono::steady_clock::time_point NextConnectTime;
+
+			// 로직 스레드들이 쓴 레코드
+			std::mutex PendingLock;
+			std::vector<char> PendingBuffer;
+
+			// 링크 스레드가 보내는 중인 레코드
+			std::vector<char> SendingBuffer;
+			size_t SendingPos = 0;
+		};
+
+		struct InboundLink
+		{
+			SOCKET SockFD = INVALID_SOCKET;
+			// 연결해 온 주소 (network byte order)
+			uint32_t PeerAddr = 0;
+			// kHELLO 를 받기 전에는 -1
+			int32_t NodeId = -1;
+			std::vector<char> RecvBuffer;
+			size_t RecvSize = 0;
+		};
+
+	public:
+		// pLocalNetwork 는 Init 이 끝난 클라이언트 네트워크
+		explicit ClusterNetwork(std::unique_ptr<ITcpNetwork> pLocalNetwork);
+		virtual ~ClusterNetwork();
+
+		// 노드 목록과 로비 주인 표를 읽고 링크 리슨 소켓을 연 뒤 링크 스레드를 시작
+		NET_ERROR_CODE Init(const ServerConfig* pConfig, ILog* pLogger) override;
+
+		NET_ERROR_CODE SendData(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pMsg) override;
+
+		NET_ERROR_CODE SendRawData(const int32_t sessionIndex, const char* pData, const int32_t size) override;
+
+		bool Run() override { return m_pLocalNetwork->Run(); }
+
+		void Release() override;
+
+		void ForcingClose(const int32_t sessionIndex) override;
+
+		void SetLaggingDropPacket(const int16_t packetId, const bool isDrop) override { m_pLocalNetwork->SetLaggingDropPacket(packetId, isDrop); }
+
+		void SetCaptureMaskField(const int16_t packetId, const int16_t offset, const int16_t size) override { m_pLocalNetwork->SetCaptureMaskField(packetId, offset, size); }
+
+		int32_t ClientSessionPoolSize() override { return m_LocalSessionCount + (int32_t)m_ProxyList.size(); }
+
+		RecvPacketInfo GetPacketInfo() override { return m_pLocalNetwork->GetPacketInfo(); }
+
+		void WaitPacketInfo(const uint32_t waitMicroSec) override { m_pLocalNetwork->WaitPacketInfo(waitMicroSec); }
+
+		void PostPacket(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody) override
+		{
+			m_pLocalNetwork->PostPacket(sessionIndex, packetId, bodySize, pBody);
+		}
+
+		const std::vector<HandoffSessionInfo>& GetHandoffSessionList() override { return m_pLocalNetwork->GetHandoffSessionList(); }
+
+		std::chrono::steady_clock::time_point GetLogicTime() override { return m_pLocalNetwork->GetLogicTime(); }
+
+		int32_t GetNodeId() const { return m_NodeId; }
+
+		// 로비를 맡은 노드 번호
+		int32_t GetLobbyOwnerNode(const int32_t lobbyIndex) const;
+
+		bool IsProxySession(const int32_t sessionIndex) const { return sessionIndex >= m_LocalSessionCount; }
+
+		// 로컬 세션의 유저를 nodeId 노드가 맡은 로비로 보냄. 이후 로비/룸 패킷은 Forward 로 넘김
+		NET_ERROR_CODE Attach(const int32_t sessionIndex, const int32_t nodeId, const char* pszUserID);
+
+		bool IsAttached(const int32_t sessionIndex);
+
+		bool IsJoined(const int32_t sessionIndex);
+
+		void SetJoined(const int32_t sessionIndex);
+
+		NET_ERROR_CODE Forward(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pBody);
+
+		// 다시 이 노드에서 처리 (Attach 하지 않은 세션이면 아무것도 하지 않음)
+		void Detach(const int32_t sessionIndex);
+
+		// 다른 노드가 보낸 이 패킷을 클라이언트에게 보낸 뒤 kNTF_SYS_CLUSTER_RESULT 로 로직에도 알림 (로비 입장/퇴장 결과 확인용)
+		void SetResultNotifyPacket(const int16_t packetId, const bool isNotify);
+
+	private:
+		NET_ERROR_CODE LoadNodeList(const ServerConfig* pConfig);
+		NET_ERROR_CODE BindLinkListen();
+		void StopLinkThread();
+
+		NET_ERROR_CODE PushRecord(const int32_t nodeId, const CLUSTER_COMMAND command, const int32_t sessionIndex, const int32_t attachId,
+			const int16_t packetId, const char* pBody, const int32_t bodySize);
+
+		void LinkThreadFunc();
+
+		void AcceptInbound();
+		// 연결이 끊겼으면 false
+		bool RecvInbound(InboundLink& link);
+		bool ProcessRecord(InboundLink& link, const ClusterRecordHeader& header, const char* pBody, const int32_t bodySize);
+		// kHELLO 의 노드 번호, 연결해 온 주소, 공유 비밀을 확인 (틀리면 -1)
+		int32_t CheckHello(const InboundLink& link, const CLUSTER_COMMAND command, const char* pBody, const int32_t bodySize);
+		bool IsNodeAddr(const uint32_t addr) const;
+		void CloseInbound(InboundLink& link);
+
+		void StartConnect(const int32_t nodeId, OutboundLink& link);
+		void CheckConnect(const int32_t nodeId, OutboundLink& link);
+		// 보낼 레코드를 보냄. 연결이 끊겼으면 false
+		bool FlushOutbound(OutboundLink& link);
+		void CloseOutbound(const int32_t nodeId, OutboundLink& link);
+
+		// 다른 노드에서 온 유저를 프록시 세션으로 만들고 접속과 로그인을 로직에 알림
+		void OpenProxySession(const int32_t nodeId, const int32_t remoteSessionIndex, const int32_t attachId, const char* pszUserID);
+		// 프록시 세션을 찾음 (없거나 AttachId 가 다르면 -1)
+		int32_t FindProxySession(const int32_t nodeId, const int32_t remoteSessionIndex, const int32_t attachId);
+		void CloseProxySession(const int32_t proxySessionIndex);
+		// 노드와의 링크가 끊기면 그 노드에서 온 유저를 모두 끊음
+		void CloseProxySessionByNode(const int32_t nodeId);
+
+		// 로비를 맡은 노드와의 링크가 끊기면 그 노드로 보낸 유저의 접속을 끊음
+		void CloseFrontSessionByNode(const int32_t nodeId);
+		bool IsFrontAttachValid(const int32_t sessionIndex, const int32_t nodeId, const int32_t attachId);
+
+		static void CloseSocket(const SOCKET sockFD);
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+		std::unique_ptr<ITcpNetwork> m_pLocalNetwork;
+
+		int32_t m_NodeId = 0;
+		int32_t m_LocalSessionCount = 0;
+		std::string m_Secret;
+		uint32_t m_LinkBufferSize = 0;
+		uint32_t m_FlushMicroSec = 0;
+
+		// 로비 인덱스 → 노드 번호 (적지 않은 로비는 로비 인덱스 % 노드 수)
+		std::vector<int32_t> m_LobbyOwnerList;
+
+		// 노드 번호 순서. 자기 노드 자리는 링크를 만들지 않음
+		std::vector<std::unique_ptr<OutboundLink>> m_OutboundList;
+		std::vector<std::unique_ptr<InboundLink>> m_InboundList;
+		SOCKET m_ListenSockFD = INVALID_SOCKET;
+
+		std::mutex m_AttachLock;
+		std::vector<FrontAttach> m_FrontAttachList;
+		int32_t m_LastAttachId = 0;
+
+		std::mutex m_ProxyLock;
+		std::vector<ProxySession> m_ProxyList;
+		std::deque<int32_t> m_FreeProxyList;
+		// (노드 번호 << 32 | 접속한 노드의 세션 인덱스) → 프록시 세션 인덱스
+		std::unordered_map<int64_t, int32_t> m_ProxyDic;
+
+		bool m_IsResultNotifyPacket[MAX_PACKET_ID] = { false, };
+
+		std::thread m_LinkThread;
+		std::atomic<bool> m_IsRun = false;
+	};
+}
@@ -4,6 +4,24 @@
 
 namespace NServerNetLib
 {
+	// 처리할 일이 없을 때 스레드가 기다리는 방식
+	enum class IDLE_STRATEGY : int16_t
+	{
+		// 쉬지 않고 계속 확인 (지연 최소, CPU 코어 하나를 계속 점유)
+		kBUSY_SPIN = 0,
+		// 일정 횟수 동안 확인 후 다른 스레드에게 양보(yield)
+		kSPIN_YIELD = 1,
+		// 타임아웃까지 블록 (지연은 늘지만 유휴 CPU 사용 없음)
+		kBLOCK = 2,
+	};
+
+	// 설정에 들어가는 파일 경로 최대 길이
+	constexpr int MAX_FILE_PATH_LEN = 260;
+	// 설정에 들어가는 목록(쉼표로 구분) 최대 길이
+	constexpr int MAX_CONFIG_LIST_LEN = 512;
+	// 클러스터 링크 공유 비밀 최대 길이
+	constexpr int MAX_CLUSTER_SECRET_LEN = 64;
+
 	struct ServerConfig
 	{
 		// 16비트 부호 없는 정수형이라 값 범위가 0부터 65535까지 << 포트와 동일
@@ -27,12 +45,159 @@ namespace NServerNetLib
 		uint32_t MaxLobbyUserCount;
 		uint32_t MaxRoomCountByLobby;
 		uint32_t MaxRoomUserCount;
+
+		// 룸/로비마다 보관해서 새로 들어온 유저에게 보내줄 최근 채팅 수
+		uint32_t ChatHistoryCount;
+
+		// 네트워크/로직 스레드의 유휴 대기 방식
+		IDLE_STRATEGY IdleStrategy;
+		// kSPIN_YIELD 에서 yield 전까지 확인할 횟수
+		uint32_t IdleSpinCount;
+		// kBLOCK 에서 한 번에 블록할 최대 시간 (micro second)
+		uint32_t IdleBlockMicroSec;
+
+		// 로직 스레드의 고정 주기 처리(tick) 간격 (milli second)
+		uint32_t LogicTickMilliSec;
+
+		// 로그인 ID/PW 검증을 처리할 워커 스레드 수
+		uint32_t LoginWorkerCount;
+		// 로컬 계정 파일 (비어 있으면 검증하지 않음)
+		char CredentialFileName[MAX_FILE_PATH_LEN];
+		// 검증에 실패하면 이 시간만큼 기다렸다가 응답 (milli second, 0 이면 바로). 기다리는 동안은 다시 로그인할 수 없음
+		uint32_t LoginFailDelayMilliSec;
+
+		// 유저 레코드 저장 파일 (비어 있으면 저장하지 않음. 로그는 파일 이름 + ".wal")
+		char UserStoreFileName[MAX_FILE_PATH_LEN];
+		// 저장 파일을 새로 만들 때 잡아 둘 레코드 수
+		uint32_t MaxUserStoreRecordCount;
+		// 바뀐 레코드를 모아서 로그에 쓰는 간격 (milli second)
+		uint32_t UserStoreGroupCommitMilliSec;
+
+		// 로비/룸 상태 스냅샷 파일 (비어 있으면 저장/복원하지 않음)
+		char SnapshotFileName[MAX_FILE_PATH_LEN];
+		// 스냅샷을 남기는 간격 (second)
+		uint32_t SnapshotIntervalSec;
+		// 다시 시작한 뒤 유저가 이전 자리로 돌아오기를 기다리는 시간 (second). 이보다 오래된 스냅샷은 복원하지 않음
+		uint32_t SnapshotRejoinGraceSec;
+
+		// 채팅 금칙어 파일 (비어 있으면 필터링하지 않음)
+		char ChatFilterFileName[MAX_FILE_PATH_LEN];
+		// 금칙어 파일이 바뀌었는지 확인하는 간격 (second, 0 이면 시작할 때만 읽음)
+		uint32_t ChatFilterReloadSec;
+
+		// 세션별 초당 허용 패킷 수와 몰아서 허용할 최대 수 (0 이면 제한 없음)
+		uint32_t ChatTokenPerSec;
+		uint32_t ChatTokenBurst;
+		uint32_t RequestTokenPerSec;
+		uint32_t RequestTokenBurst;
+		// FloodDropWindowMilliSec 안에 이만큼 버려지면 접속을 끊음 (0 이면 끊지 않음)
+		uint32_t FloodMaxDropCount;
+		uint32_t FloodDropWindowMilliSec;
+
+		// 수치(metrics) 스냅샷을 주는 관리용 포트 (127.0.0.1 만, 0 이면 사용 안 함)
+		uint16_t MetricsAdminPort;
+		// 수치 덤프 파일을 덮어쓰는 주기 (0 이면 사용 안 함)
+		uint32_t MetricsDumpIntervalSec;
+		char MetricsDumpFileName[MAX_FILE_PATH_LEN];
+
+		// 로그를 별도 기록 스레드에서 모아서 쓸지 여부 (false 면 ConsoleLog)
+		bool IsAsyncLog;
+		// 비동기 로그를 쓸 파일 (비어 있으면 콘솔)
+		char LogFileName[MAX_FILE_PATH_LEN];
+		// 스레드별 로그 링 크기 (2의 거듭제곱으로 올림)
+		uint32_t LogRingSize;
+		// 링이 가득 찼을 때 (0: 버림, 1: 자리가 날 때까지 기다림)
+		int16_t LogFullPolicy;
+		// 실행 중 최소 로그 레벨 (LOG_LEVEL 값, 이보다 낮은 레벨은 포맷하지 않음)
+		int16_t LogMinLevel;
+		// 세션 접속 로그를 초당 몇 개까지 남길지 (0 이면 제한 없음)
+		uint32_t SessionLogPerSec;
+		// 초과분 중 몇 개마다 1개를 남길지 (0 이면 모두 생략)
+		uint32_t SessionLogSampleRate;
+
+		// 받은 패킷과 접속/끊김을 기록할 캡처 파일 (비어 있으면 기록하지 않음)
+		char CaptureFileName[MAX_FILE_PATH_LEN];
+		// 캡처 파일 최대 크기 (가득 차면 그 뒤로는 기록하지 않음)
+		uint32_t CaptureMaxFileSizeMB;
+		// 재생할 캡처 파일 (지정하면 소켓 대신 파일의 패킷을 로직에 넘김)
+		char ReplayFileName[MAX_FILE_PATH_LEN];
+		// 기록된 시간 간격을 무시하고 최대 속도로 재생
+		bool IsReplayMaxSpeed;
+		// 지정하면 소켓 대신 이 스크립트로 만든 패킷을 메모리 안에서 로직에 넘김 (ReplayFileName 보다 먼저)
+		char LoopbackScriptFileName[MAX_FILE_PATH_LEN];
+		// 가상 시계: 스크립트의 wait 를 실제로 기다리지 않고 다음 패킷으로 건너뜀
+		bool IsLoopbackVirtualClock;
+		// 보낸 패킷을 세션별 버퍼에 모음 (false 면 수/크기만 셈)
+		bool IsLoopbackCaptureSend;
+		// 보낸 패킷을 가상 시간과 함께 캡처 형식으로 남길 파일 (비어 있으면 남기지 않음)
+		char LoopbackOutputFileName[MAX_FILE_PATH_LEN];
+
+		// 송신 버퍼가 이 비율(%) 이상 차면 느린 세션(laggard)으로 로직에 알리고, 이 비율 이하로 비면 회복을 알림
+		uint32_t SendBufferHighWaterPercent;
+		uint32_t SendBufferLowWaterPercent;
+		// 느린 상태가 이 시간 넘게 이어지면 접속을 끊음 (0 이면 끊지 않음)
+		uint32_t LaggardDisconnectMilliSec;
+
+		// 무중단 재시작 때 이전 프로세스와 소켓을 주고받는 Unix 소켓 경로 (비어 있으면 사용 안 함)
+		char HandoffSocketPath[MAX_FILE_PATH_LEN];
+		// 이전 프로세스가 넘겨줄 때까지, 넘겨준 쪽이 새 프로세스의 응답을 받을 때까지 기다리는 최대 시간
+		uint32_t HandoffWaitSec;
+		// 실행 인자로 정함: true 면 리슨 소켓을 새로 만들지 않고 이전 프로세스에게서 받음
+		bool IsHandoffReceive;
+
+		// 게임 중인 룸의 상태를 주고받는 UDP 포트 (0 이면 사용 안 함)
+		uint16_t UdpPort;
+		// reliable 데이터그램에 ack 가 없을 때 다시 보내는 간격과 최대 횟수
+		uint32_t UdpResendMilliSec;
+		uint32_t UdpMaxResendCount;
+		// 세션별 초당 허용 게임 상태 패킷 수와 몰아서 허용할 최대 수 (0 이면 제한 없음)
+		uint32_t GameStateTokenPerSec;
+		uint32_t GameStateTokenBurst;
+
+		// 패킷 처리 함수를 나눠서 실행할 로직 워커 수 (0 이면 로직 스레드 하나에서 모두 처리)
+		// 같은 세션의 패킷은 워커 수와 관계없이 항상 받은 순서대로 처리
+		uint32_t LogicWorkerCount;
+
+		// 스레드를 고정할 CPU 번호 (-1 이면 고정하지 않음)
+		// 네트워크 스레드를 고정하면 세션 송수신 버퍼를, 로직 스레드를 고정하면 유저/로비/룸 상태를 그 CPU 의 NUMA 노드에 잡음
+		int32_t NetworkThreadCpu;
+		int32_t LogicThreadCpu;
+		int32_t LoggerThreadCpu;
+		// 로직 워커를 차례로 고정할 CPU 목록 (예: "4-7,12". 워커가 더 많으면 처음부터 다시 씀. 비어 있으면 고정하지 않음)
+		char LogicWorkerCpuList[MAX_CONFIG_LIST_LEN];
+
+		// 게이트웨이(소켓)와 로직 프로세스가 패킷을 주고받는 공유 메모리 파일 (비어 있으면 한 프로세스에서 모두 처리)
+		// 게이트웨이는 실행 인자 --gateway 로 띄우고, 로직 프로세스는 같은 파일을 지정하면 소켓 대신 이 파일로 패킷을 받음
+		char ShmFileName[MAX_FILE_PATH_LEN];
+		// 게이트웨이: 붙을 로직 프로세스 수 (세션 인덱스 % 수 로 나눠서 보냄)
+		uint32_t ShmLogicCount;
+		// 로직 프로세스: 자기 번호 (0 ~ ShmLogicCount - 1)
+		uint32_t ShmLogicIndex;
+		// 게이트웨이: 로직 프로세스마다 방향별 링 크기 (KB, 2 의 거듭제곱으로 올림)
+		uint32_t ShmRingSizeKB;
+
+		// 로비를 여러 노드(서버 프로세스)가 나눠 맡는 클러스터 구성. 노드 번호 순서대로 노드끼리 연결할 "IP:포트" 를 쉼표로 구분 (비어 있으면 사용 안 함)
+		char ClusterNodeList[MAX_CONFIG_LIST_LEN];
+		// 이 서버의 노드 번호 (ClusterNodeList 에서의 순서)
+		uint32_t ClusterNodeId;
+		// 로비 인덱스 순서대로 그 로비를 맡는 노드 번호를 쉼표로 구분 (적지 않은 로비는 로비 인덱스 % 노드 수). 모든 노드가 같은 값이어야 함
+		char ClusterLobbyOwnerList[MAX_CONFIG_LIST_LEN];
+		// 다른 노드에서 들어온 유저에게 줄 프록시 세션 수
+		uint32_t ClusterProxySessionCount;
+		// 노드마다 보내지 못하고 쌓아둘 최대 크기 (KB, 넘치면 버림)
+		uint32_t ClusterLinkBufferKB;
+		// 노드 사이 레코드를 모아서 보내는 간격 (micro second)
+		uint32_t ClusterFlushMicroSec;
+		// 노드 사이 링크의 kHELLO 에 넣어 확인하는 공유 비밀 (모든 노드가 같은 값. 비어 있으면 주소만 확인)
+		char ClusterSecret[MAX_CLUSTER_SECRET_LEN];
 	};
 
 	// IP 문자열 최대 길이 
 	constexpr int MAX_IP_LEN = 32;
 	// 최대 패킷 크기
 	constexpr int MAX_PACKET_BODY_SIZE = 1024;
+	// 패킷 ID 범위 (0 ~ MAX_PACKET_ID - 1)
+	constexpr int MAX_PACKET_ID = 256;
 
 	struct ClientSession
 	{
@@ -47,6 +212,7 @@ namespace NServerNetLib
 			RemainingDataSize = 0;
 			PrevReadPosInRecvBuffer = 0;
 			SendSize = 0;
+			IsSendLagging = false;
 		}
 
 		int32_t Index = 0;
@@ -61,6 +227,17 @@ namespace NServerNetLib
 
 		char* pSendBuffer = nullptr;
 		int32_t SendSize = 0;
+		// 송신 버퍼가 고수위(high watermark)를 넘어 아직 저수위 아래로 내려오지 않은 상태
+		bool IsSendLagging = false;
+	};
+
+	// 무중단 재시작 때 세션과 함께 넘기는 로직 쪽 정보 (예: 로그인한 유저 ID)
+	constexpr int HANDOFF_USER_TAG_SIZE = 32;
+
+	struct HandoffSessionInfo
+	{
+		int32_t SessionIndex = 0;
+		char UserTag[HANDOFF_USER_TAG_SIZE] = { 0, };
 	};
 
 	struct RecvPacketInfo
@@ -85,7 +262,16 @@ namespace NServerNetLib
 	{
 		kNTF_SYS_CONNECT_SESSION = 1,
 		kNTF_SYS_CLOSE_SESSION = 2,
+		// 송신 버퍼가 고수위를 넘음 / 저수위 아래로 회복
+		kNTF_SYS_SEND_BUFFER_HIGH = 3,
+		kNTF_SYS_SEND_BUFFER_LOW = 4,
+		// 클러스터: 다른 노드에서 넘어온 유저의 로그인 (바디: 유저 ID)
+		kNTF_SYS_CLUSTER_ATTACH = 5,
+		// 클러스터: 다른 노드가 맡은 로비의 입장/퇴장 결과 (바디: ClusterResultInfo)
+		kNTF_SYS_CLUSTER_RESULT = 6,
 	};
+	// 시스템 패킷 ID 는 이 값까지 (클라이언트 패킷은 21 부터)
+	constexpr int16_t MAX_SYS_PACKET_ID = 20;
 
 // 구조체(또는 공용체 등)의 메모리 정렬(padding)을 1바이트 단위로 맞춤을 의미
 // 컴파일러는 보통 구조체 크기를 멤버 중 가장 큰 타입의 정렬 단위 기준으로 맞춤
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <thread>
+
+#include "define.h"
+
+namespace NServerNetLib
+{
+	// 처리할 일이 없을 때 스레드를 어떻게 쉬게 할지 결정
+	// kBLOCK 은 select/조건 변수 등 호출하는 쪽에서 직접 블록하므로 여기서는 아무것도 하지 않음
+	class IdleStrategy
+	{
+	public:
+		IdleStrategy() = default;
+
+		void Init(const IDLE_STRATEGY strategy, const uint32_t spinCount)
+		{
+			m_Strategy = strategy;
+			m_SpinCount = spinCount;
+			m_IdleCount = 0;
+		}
+
+		IDLE_STRATEGY GetStrategy() const { return m_Strategy; }
+
+		// 한 번의 루프가 끝날 때마다 호출 (isWorked == 이번 루프에서 처리한 일이 있는지)
+		void Idle(const bool isWorked)
+		{
+			if (isWorked) {
+				m_IdleCount = 0;
+				return;
+			}
+
+			if (m_Strategy != IDLE_STRATEGY::kSPIN_YIELD) {
+				return;
+			}
+
+			// 일정 횟수는 계속 확인하고, 그 이후부터는 다른 스레드에게 CPU 를 양보
+			if (m_IdleCount < m_SpinCount) {
+				++m_IdleCount;
+				return;
+			}
+
+			std::this_thread::yield();
+		}
+
+	private:
+		IDLE_STRATEGY m_Strategy = IDLE_STRATEGY::kBLOCK;
+		uint32_t m_SpinCount = 0;
+		uint32_t m_IdleCount = 0;
+	};
+}
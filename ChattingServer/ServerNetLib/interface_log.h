@@ -2,11 +2,27 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <atomic>
 
 // 특정 경고 메시지를 무시
 // 함수의 매개변수 중 사용하지 않는 매개변수에 대해서 경고 4100을 발생 X
 #pragma warning(disable : 4100)
 
+// 빌드 시 정하는 최소 로그 레벨 (LOG_LEVEL 값). 이보다 낮은 레벨의 SERVER_LOG 는 인자 계산까지 통째로 빠짐
+// 예: 배포 빌드에서 -DSERVER_LOG_MIN_LEVEL=3 이면 TRACE/DEBUG 제거
+#ifndef SERVER_LOG_MIN_LEVEL
+#define SERVER_LOG_MIN_LEVEL 1
+#endif
+
+// 레벨 검사를 포맷/인자 계산보다 먼저 하는 로그 매크로 (자주 불리는 곳의 TRACE/DEBUG 용)
+#define SERVER_LOG(pLogger, level, ...) \
+	do { \
+		if ((int)(level) >= SERVER_LOG_MIN_LEVEL && (pLogger)->IsEnabled(level)) { \
+			(pLogger)->WriteLog(level, __VA_ARGS__); \
+		} \
+	} while (0)
+
 // 네트워크 서버 라이브러리
 namespace NServerNetLib
 {
@@ -29,9 +45,23 @@ namespace NServerNetLib
 		ILog() {}
 		virtual ~ILog() {}
 
+		// 실행 중에 바꿀 수 있는 최소 로그 레벨 (이보다 낮으면 포맷하지 않고 버림)
+		void SetLevel(const LOG_LEVEL level) { m_MinLevel.store((int16_t)level, std::memory_order_relaxed); }
+		LOG_LEVEL GetLevel() const { return (LOG_LEVEL)m_MinLevel.load(std::memory_order_relaxed); }
+
+		bool IsEnabled(const LOG_LEVEL level) const
+		{
+			return (int)level >= SERVER_LOG_MIN_LEVEL && (int16_t)level >= m_MinLevel.load(std::memory_order_relaxed);
+		}
+
 		// pFormat에는 "Value: %d, Name: %s"처럼 문자열 포맷
 		virtual void WriteLog(const LOG_LEVEL level, const char* pFormat, ...)
 		{
+			// 꺼진 레벨은 1KB 버퍼 포맷 비용을 쓰지 않음
+			if (IsEnabled(level) == false) {
+				return;
+			}
+
 			char szText[MAX_LOG_STRING_LENGTH];
 
 			// args에는 그 포맷에 들어갈 실제 값들(예: 정수, 문자열)이 가변 인자로 처리
@@ -73,6 +103,9 @@ namespace NServerNetLib
 		virtual void Warn(const char* format) = 0;
 		virtual void Error(const char* format) = 0;
 		virtual void Info(const char* format) = 0;
+
+	private:
+		std::atomic<int16_t> m_MinLevel = (int16_t)LOG_LEVEL::kL_TRACE;
 	};
 
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <vector>
+#include <chrono>
+
 #include "define.h"
 #include "server_network_error_code.h"
 #include "interface_log.h"
@@ -20,15 +23,44 @@ namespace NServerNetLib
 			return NET_ERROR_CODE::kNONE;
 		}
 
-		virtual void Run() {}
+		// 이미 헤더가 붙은 패킷(여러 개 가능)을 그대로 송신 버퍼에 복사
+		virtual NET_ERROR_CODE SendRawData(const int32_t sessionIndex, const char* pData, const int32_t size) {
+			return NET_ERROR_CODE::kNONE;
+		}
+
+		// 한 번의 네트워크 처리 루프 (처리한 소켓 이벤트가 있으면 true)
+		virtual bool Run() { return false; }
 
 		virtual void Release() {}
 
 		virtual void ForcingClose(const int32_t sessionIndex) {}
 
+		// 느린 세션(송신 버퍼 고수위)에게는 이 패킷을 보내지 않고 버림 (채팅 알림처럼 놓쳐도 되는 것만)
+		virtual void SetLaggingDropPacket(const int16_t packetId, const bool isDrop) {}
+
+		// 캡처 파일에 기록할 때 이 패킷 바디의 [offset, offset + size) 를 0 으로 채움 (비밀번호처럼 파일에 남기면 안 되는 값)
+		virtual void SetCaptureMaskField(const int16_t packetId, const int16_t offset, const int16_t size) {}
+
 		virtual int32_t ClientSessionPoolSize() { return 0;  }
 
 		virtual RecvPacketInfo GetPacketInfo() { return RecvPacketInfo(); }
 
+		// 받은 패킷이 없으면 최대 waitMicroSec 동안 도착을 기다림
+		virtual void WaitPacketInfo(const uint32_t waitMicroSec) {}
+
+		// 다른 전송(UDP)에서 받은 패킷을 TCP 패킷과 같은 로직 큐에 넣음 (아무 스레드에서나 호출 가능)
+		virtual void PostPacket(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody) {}
+
+		// 무중단 재시작: 리슨 소켓과 접속 중인 세션(소켓, 버퍼)을 새 프로세스에게 넘김 (네트워크 스레드를 멈춘 뒤 호출)
+		// 넘기기 전에 연결부터 해보고, 실패하면 아무것도 바꾸지 않음
+		virtual NET_ERROR_CODE HandoffSend(const std::vector<HandoffSessionInfo>& userTagList) { return NET_ERROR_CODE::kHANDOFF_NOT_SUPPORTED; }
+
+		// 무중단 재시작: Init 에서 넘겨받은 세션 목록 (로직이 로그인 상태를 되살리는 데 사용)
+		virtual const std::vector<HandoffSessionInfo>& GetHandoffSessionList() { static std::vector<HandoffSessionInfo> empty; return empty; }
+
+		// 로직이 시간 제한(폭주 제한, 로그인 대기, 코루틴 타이머 등)에 쓰는 시계 (아무 스레드에서나 호출 가능)
+		// 루프백 가상 시계나 최대 속도 재생에서는 실제 시간 대신 패킷에 기록된 시간을 따라감
+		virtual std::chrono::steady_clock::time_point GetLogicTime() { return std::chrono::steady_clock::now(); }
+
 	};
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+
+namespace NServerNetLib
+{
+	// 접속/끊김처럼 몰려서 발생할 수 있는 로그의 양을 제한 (한 스레드에서만 사용)
+	// - 창(window)마다 앞의 MaxCountPerWindow 개는 모두 남김
+	// - 그 뒤로는 SampleRate 개마다 1개만 남김 (0 이면 모두 생략)
+	// - 생략된 수는 다음에 남기는 로그에 함께 알려줌
+	class LogRateLimiter
+	{
+	public:
+		// maxCountPerWindow 가 0 이면 제한하지 않음
+		void Init(const uint32_t maxCountPerWindow, const uint32_t windowMilliSec, const uint32_t sampleRate)
+		{
+			m_MaxCountPerWindow = maxCountPerWindow;
+			m_Window = std::chrono::milliseconds(windowMilliSec > 0 ? windowMilliSec : 1000);
+			m_SampleRate = sampleRate;
+			m_WindowCount = 0;
+			m_SuppressedCount = 0;
+		}
+
+		// 이번 로그를 남겨야 하면 true. suppressedCount 에는 그동안 생략된 수 (남길 때만 0 으로 초기화)
+		bool Allow(uint32_t& suppressedCount)
+		{
+			suppressedCount = 0;
+			if (m_MaxCountPerWindow == 0) {
+				return true;
+			}
+
+			auto curTime = std::chrono::steady_clock::now();
+			if (curTime - m_WindowStartTime >= m_Window) {
+				m_WindowStartTime = curTime;
+				m_WindowCount = 0;
+			}
+
+			++m_WindowCount;
+			bool isAllow = m_WindowCount <= m_MaxCountPerWindow;
+			if (isAllow == false && m_SampleRate > 0) {
+				isAllow = (m_WindowCount - m_MaxCountPerWindow) % m_SampleRate == 0;
+			}
+
+			if (isAllow == false) {
+				++m_SuppressedCount;
+				return false;
+			}
+
+			suppressedCount = m_SuppressedCount;
+			m_SuppressedCount = 0;
+			return true;
+		}
+
+	private:
+		uint32_t m_MaxCountPerWindow = 0;
+		std::chrono::milliseconds m_Window = std::chrono::milliseconds(1000);
+		uint32_t m_SampleRate = 0;
+
+		std::chrono::steady_clock::time_point m_WindowStartTime;
+		uint32_t m_WindowCount = 0;
+		uint32_t m_SuppressedCount = 0;
+	};
+}
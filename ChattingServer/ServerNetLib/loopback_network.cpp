@@ -0,0 +1,420 @@
+#include <cstring>
+#include <thread>
+#include <algorithm>
+
+#include "loopback_network.h"
+
+namespace NServerNetLib
+{
+	namespace
+	{
+		// 스크립트를 한 번에 이만큼씩 패킷으로 풀어서 넣음 (스크립트 전체를 미리 풀면 메모리가 커짐)
+		constexpr int32_t SCRIPT_EMIT_PACKET_COUNT = 4096;
+		// 읽은 앞부분이 이보다 커지면 바디 큐를 당겨서 정리
+		constexpr size_t QUEUE_BODY_COMPACT_SIZE = 1024 * 1024;
+		// 응답 지연 표본 최대 수 (넘으면 더 모으지 않음)
+		constexpr size_t MAX_LATENCY_SAMPLE_COUNT = 1 << 22;
+	}
+
+	NET_ERROR_CODE LoopbackNetwork::Init(const ServerConfig* pConfig, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_SessionPoolSize = pConfig->MaxClientCount + pConfig->ExtraClientCount;
+		m_MaxSendBufferSize = pConfig->MaxClientSendBufferSize;
+		m_IsVirtualClock = pConfig->IsLoopbackVirtualClock;
+		// 출력 파일이 있으면 남길 것을 모아야 하므로 켠 것으로 봄
+		m_IsCaptureSend = pConfig->IsLoopbackCaptureSend || pConfig->LoopbackOutputFileName[0] != '\0';
+		m_SessionList.resize(m_SessionPoolSize);
+		m_StartTime = std::chrono::steady_clock::now();
+
+		if (pConfig->LoopbackOutputFileName[0] != '\0'
+			&& m_Output.Open(pConfig->LoopbackOutputFileName, (uint64_t)pConfig->CaptureMaxFileSizeMB * 1024 * 1024) == false) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 출력 파일(%s) 열기 실패", __FUNCTION__, pConfig->LoopbackOutputFileName);
+			return NET_ERROR_CODE::kCAPTURE_FILE_OPEN_FAIL;
+		}
+
+		if (pConfig->LoopbackScriptFileName[0] != '\0') {
+			int32_t errorLine = 0;
+			if (m_Script.Load(pConfig->LoopbackScriptFileName, errorLine) == false) {
+				if (errorLine == 0) {
+					m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 스크립트 파일(%s) 열기 실패", __FUNCTION__, pConfig->LoopbackScriptFileName);
+					return NET_ERROR_CODE::kLOOPBACK_SCRIPT_OPEN_FAIL;
+				}
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 스크립트 파일(%s) %d 번째 줄이 잘못됨", __FUNCTION__, pConfig->LoopbackScriptFileName, errorLine);
+				return NET_ERROR_CODE::kLOOPBACK_SCRIPT_INVALID;
+			}
+
+			m_IsAutoDrain = true;
+			SetGenerator([this](LoopbackNetwork& network) { return m_Script.Emit(&network, SCRIPT_EMIT_PACKET_COUNT); });
+		}
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 루프백 네트워크(%s). 명령 수(%d), 가상 시계(%d), 보낸 것 모으기(%d), 출력(%s)", __FUNCTION__,
+			pConfig->LoopbackScriptFileName, m_Script.GetCommandCount(), m_IsVirtualClock ? 1 : 0, m_IsCaptureSend ? 1 : 0, pConfig->LoopbackOutputFileName);
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	NET_ERROR_CODE LoopbackNetwork::SendData(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pMsg)
+	{
+		PacketHeader header{ (int16_t)(PACKET_HEADER_SIZE + bodySize), packetId, (uint8_t)0 };
+		return AppendSendData(sessionIndex, 1, (const char*)&header, PACKET_HEADER_SIZE, pMsg, bodySize);
+	}
+
+	NET_ERROR_CODE LoopbackNetwork::SendRawData(const int32_t sessionIndex, const char* pData, const int32_t size)
+	{
+		// 여러 패킷이 붙어 있을 수 있으므로 헤더를 따라가며 셈
+		int32_t packetCount = 0;
+		for (int32_t pos = 0; pos + PACKET_HEADER_SIZE <= size; ++packetCount) {
+			PacketHeader header;
+			memcpy(&header, pData + pos, PACKET_HEADER_SIZE);
+			if (header.TotalSize < PACKET_HEADER_SIZE) {
+				break;
+			}
+			pos += header.TotalSize;
+		}
+
+		return AppendSendData(sessionIndex, packetCount, pData, size, nullptr, 0);
+	}
+
+	bool LoopbackNetwork::Run()
+	{
+		// 소켓이 없으므로 네트워크 스레드가 할 일은 없음
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		return false;
+	}
+
+	void LoopbackNetwork::Release()
+	{
+		// 마지막 패킷의 응답까지 남김
+		if (m_IsAutoDrain) {
+			DrainSendBuffer();
+		}
+		m_Output.Close();
+	}
+
+	void LoopbackNetwork::ForcingClose(const int32_t sessionIndex)
+	{
+		if (sessionIndex < 0 || sessionIndex >= m_SessionPoolSize) {
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_SendLock);
+			auto& session = m_SessionList[sessionIndex];
+			if (session.IsConnected == false || session.IsCloseQueued) {
+				return;
+			}
+			session.IsCloseQueued = true;
+			++m_ForcingCloseCount;
+		}
+
+		// 소켓을 닫은 것처럼 끊김을 알림
+		CloseSession(sessionIndex);
+	}
+
+	RecvPacketInfo LoopbackNetwork::GetPacketInfo()
+	{
+		// 앞 패킷의 응답은 다음 패킷을 넘기기 전에 가상 클라이언트가 모두 읽은 것으로 봄
+		if (m_IsAutoDrain) {
+			DrainSendBuffer();
+		}
+
+		std::unique_lock<std::mutex> lock(m_QueueLock);
+		if (m_Queue.empty() && m_Generator && m_IsGeneratorDone == false) {
+			lock.unlock();
+			m_IsGeneratorDone = m_Generator(*this) == false;
+			lock.lock();
+		}
+
+		while (m_Queue.empty() == false)
+		{
+			const auto packet = m_Queue.front();
+			if (packet.TimeMicroSec > NowMicroSec()) {
+				if (m_IsVirtualClock == false) {
+					return RecvPacketInfo();
+				}
+				m_VirtualTimeMicroSec = packet.TimeMicroSec;
+			}
+			m_Queue.pop_front();
+
+			m_CurrentBody.assign(m_QueueBody.begin() + m_QueueBodyReadPos, m_QueueBody.begin() + m_QueueBodyReadPos + packet.BodySize);
+			m_QueueBodyReadPos += packet.BodySize;
+			if (m_Queue.empty()) {
+				m_QueueBody.clear();
+				m_QueueBodyReadPos = 0;
+			}
+			else if (m_QueueBodyReadPos > QUEUE_BODY_COMPACT_SIZE && m_QueueBodyReadPos * 2 > m_QueueBody.size()) {
+				m_QueueBody.erase(m_QueueBody.begin(), m_QueueBody.begin() + m_QueueBodyReadPos);
+				m_QueueBodyReadPos = 0;
+			}
+			lock.unlock();
+
+			if (UpdateSession(packet) == false) {
+				++m_SkipPacketCount;
+				lock.lock();
+				continue;
+			}
+
+			if (m_IsStarted == false) {
+				m_IsStarted = true;
+				m_FirstDeliverTime = std::chrono::steady_clock::now();
+			}
+			++m_DeliverPacketCount;
+
+			RecvPacketInfo packetInfo;
+			packetInfo.SessionIndex = packet.SessionIndex;
+			packetInfo.PacketId = packet.PacketId;
+			packetInfo.PacketBodySize = packet.BodySize;
+			packetInfo.pRefData = m_CurrentBody.data();
+			return packetInfo;
+		}
+		lock.unlock();
+
+		if (m_Generator && m_IsGeneratorDone && m_IsFinished == false) {
+			ReportFinish();
+		}
+		return RecvPacketInfo();
+	}
+
+	void LoopbackNetwork::WaitPacketInfo(const uint32_t waitMicroSec)
+	{
+		int64_t sleepMicroSec = waitMicroSec;
+		{
+			std::lock_guard<std::mutex> lock(m_QueueLock);
+			if (m_Queue.empty() == false) {
+				// 가상 시계는 다음 패킷까지 바로 건너뜀
+				sleepMicroSec = m_IsVirtualClock ? 0 : std::min<int64_t>(sleepMicroSec, m_Queue.front().TimeMicroSec - NowMicroSec());
+			}
+			else if (m_Generator && m_IsGeneratorDone == false) {
+				sleepMicroSec = 0;
+			}
+		}
+
+		if (sleepMicroSec > 0) {
+			std::this_thread::sleep_for(std::chrono::microseconds(sleepMicroSec));
+		}
+	}
+
+	void LoopbackNetwork::PostPacket(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody)
+	{
+		InjectPacket(sessionIndex, packetId, bodySize, pBody);
+	}
+
+	void LoopbackNetwork::InjectPacket(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody, const int64_t timeMicroSec)
+	{
+		if (sessionIndex < 0 || sessionIndex >= m_SessionPoolSize || bodySize < 0 || bodySize > MAX_PACKET_BODY_SIZE) {
+			++m_SkipPacketCount;
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_QueueLock);
+		const auto queueTimeMicroSec = std::max(timeMicroSec >= 0 ? timeMicroSec : NowMicroSec(), m_LastQueueTimeMicroSec);
+		m_LastQueueTimeMicroSec = queueTimeMicroSec;
+
+		m_Queue.push_back({ queueTimeMicroSec, sessionIndex, packetId, bodySize });
+		if (bodySize > 0) {
+			m_QueueBody.insert(m_QueueBody.end(), pBody, pBody + bodySize);
+		}
+	}
+
+	void LoopbackNetwork::ConnectSession(const int32_t sessionIndex, const int64_t timeMicroSec)
+	{
+		InjectPacket(sessionIndex, (int16_t)PACKET_ID::kNTF_SYS_CONNECT_SESSION, 0, nullptr, timeMicroSec);
+	}
+
+	void LoopbackNetwork::CloseSession(const int32_t sessionIndex, const int64_t timeMicroSec)
+	{
+		InjectPacket(sessionIndex, (int16_t)PACKET_ID::kNTF_SYS_CLOSE_SESSION, 0, nullptr, timeMicroSec);
+	}
+
+	void LoopbackNetwork::SetGenerator(PacketGenerator generator)
+	{
+		m_Generator = std::move(generator);
+		m_IsGeneratorDone = false;
+	}
+
+	int64_t LoopbackNetwork::NowMicroSec() const
+	{
+		return m_IsVirtualClock ? m_VirtualTimeMicroSec.load() : GetRealElapsedMicroSec();
+	}
+
+	void LoopbackNetwork::AdvanceClock(const int64_t microSec)
+	{
+		if (m_IsVirtualClock && microSec > 0) {
+			m_VirtualTimeMicroSec += microSec;
+		}
+	}
+
+	void LoopbackNetwork::TakeSendData(const int32_t sessionIndex, std::vector<char>& data)
+	{
+		data.clear();
+		if (sessionIndex < 0 || sessionIndex >= m_SessionPoolSize) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_SendLock);
+		data.swap(m_SessionList[sessionIndex].SendBuffer);
+	}
+
+	int64_t LoopbackNetwork::GetRealElapsedMicroSec() const
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_StartTime).count();
+	}
+
+	bool LoopbackNetwork::UpdateSession(const QueuedPacket& packet)
+	{
+		std::lock_guard<std::mutex> lock(m_SendLock);
+		auto& session = m_SessionList[packet.SessionIndex];
+
+		switch ((PACKET_ID)packet.PacketId)
+		{
+		case PACKET_ID::kNTF_SYS_CONNECT_SESSION:
+			if (session.IsConnected) {
+				return false;
+			}
+			session.IsConnected = true;
+			session.IsCloseQueued = false;
+			session.IsWaitingResponse = false;
+			return true;
+
+		case PACKET_ID::kNTF_SYS_CLOSE_SESSION:
+			if (session.IsConnected == false) {
+				return false;
+			}
+			session.IsConnected = false;
+			session.IsCloseQueued = false;
+			session.IsWaitingResponse = false;
+			return true;
+
+		default:
+			// 끊긴(끊기는 중인) 세션에는 실제 네트워크에서도 패킷이 오지 않음
+			if (session.IsConnected == false || session.IsCloseQueued) {
+				return false;
+			}
+			session.IsWaitingResponse = true;
+			session.DeliverTime = std::chrono::steady_clock::now();
+			return true;
+		}
+	}
+
+	NET_ERROR_CODE LoopbackNetwork::AppendSendData(const int32_t sessionIndex, const int32_t packetCount, const char* pHeader, const int32_t headerSize, const char* pBody, const int32_t bodySize)
+	{
+		if (sessionIndex < 0 || sessionIndex >= m_SessionPoolSize) {
+			return NET_ERROR_CODE::kSEND_CLOSE_SOCKET;
+		}
+
+		std::lock_guard<std::mutex> lock(m_SendLock);
+		auto& session = m_SessionList[sessionIndex];
+		if (session.IsConnected == false || session.IsCloseQueued) {
+			return NET_ERROR_CODE::kSEND_CLOSE_SOCKET;
+		}
+
+		RecordLatency(session);
+
+		if (m_IsCaptureSend) {
+			if ((int32_t)session.SendBuffer.size() + headerSize + bodySize > m_MaxSendBufferSize) {
+				++m_SendBufferFullCount;
+				return NET_ERROR_CODE::kCLIENT_SEND_BUFFER_FULL;
+			}
+
+			if (m_IsAutoDrain && session.SendBuffer.empty()) {
+				m_DirtySessionList.push_back(sessionIndex);
+			}
+			session.SendBuffer.insert(session.SendBuffer.end(), pHeader, pHeader + headerSize);
+			if (bodySize > 0) {
+				session.SendBuffer.insert(session.SendBuffer.end(), pBody, pBody + bodySize);
+			}
+		}
+
+		session.SendPacketCount += packetCount;
+		session.SendBytes += headerSize + bodySize;
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	void LoopbackNetwork::RecordLatency(LoopbackSession& session)
+	{
+		if (session.IsWaitingResponse == false) {
+			return;
+		}
+		session.IsWaitingResponse = false;
+
+		if (m_LatencyList.size() < MAX_LATENCY_SAMPLE_COUNT) {
+			auto latencyNanoSec = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - session.DeliverTime).count();
+			m_LatencyList.push_back((uint32_t)std::min<int64_t>(latencyNanoSec, UINT32_MAX));
+		}
+	}
+
+	void LoopbackNetwork::DrainSendBuffer()
+	{
+		std::lock_guard<std::mutex> lock(m_SendLock);
+		if (m_DirtySessionList.empty()) {
+			return;
+		}
+
+		const auto timeMicroSec = NowMicroSec();
+		const auto isOutputFull = m_Output.IsFull();
+		for (auto sessionIndex : m_DirtySessionList) {
+			auto& sendBuffer = m_SessionList[sessionIndex].SendBuffer;
+
+			if (m_Output.IsOpened()) {
+				for (size_t pos = 0; pos + PACKET_HEADER_SIZE <= sendBuffer.size();) {
+					PacketHeader header;
+					memcpy(&header, sendBuffer.data() + pos, PACKET_HEADER_SIZE);
+					if (header.TotalSize < PACKET_HEADER_SIZE || pos + header.TotalSize > sendBuffer.size()) {
+						break;
+					}
+
+					m_Output.Write(sessionIndex, header.Id, header.TotalSize - PACKET_HEADER_SIZE,
+						(const int8_t*)sendBuffer.data() + pos + PACKET_HEADER_SIZE, timeMicroSec);
+					pos += header.TotalSize;
+				}
+			}
+
+			sendBuffer.clear();
+		}
+		m_DirtySessionList.clear();
+
+		if (isOutputFull == false && m_Output.IsFull()) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 출력 파일이 가득 참. 이후 보낸 패킷은 남기지 않음", __FUNCTION__);
+		}
+	}
+
+	void LoopbackNetwork::ReportFinish()
+	{
+		m_IsFinished = true;
+
+		auto elapsedMicroSec = std::max<int64_t>(1, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_FirstDeliverTime).count());
+
+		std::lock_guard<std::mutex> lock(m_SendLock);
+
+		uint64_t sendPacketCount = 0;
+		uint64_t sendBytes = 0;
+		for (auto& session : m_SessionList) {
+			sendPacketCount += session.SendPacketCount;
+			sendBytes += session.SendBytes;
+		}
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 루프백 실행 완료. 넘긴 패킷(%llu), 건너뛴 패킷(%llu), 실제 시간(%lldus), 초당 패킷(%.0f), 가상 시간(%lldus), 보낸 패킷(%llu), 보낸 바이트(%llu), 송신 버퍼 가득 참(%llu), 강제 종료 요청(%llu)",
+			__FUNCTION__, (unsigned long long)m_DeliverPacketCount, (unsigned long long)m_SkipPacketCount.load(), (long long)elapsedMicroSec,
+			m_DeliverPacketCount * 1000000.0 / elapsedMicroSec, (long long)NowMicroSec(), (unsigned long long)sendPacketCount, (unsigned long long)sendBytes,
+			(unsigned long long)m_SendBufferFullCount, (unsigned long long)m_ForcingCloseCount);
+
+		if (m_LatencyList.empty()) {
+			return;
+		}
+
+		// 백분위만 필요하므로 정렬 대신 nth_element
+		auto percentile = [this](const double ratio) {
+			auto nth = m_LatencyList.begin() + (size_t)((m_LatencyList.size() - 1) * ratio);
+			std::nth_element(m_LatencyList.begin(), nth, m_LatencyList.end());
+			return *nth;
+		};
+
+		const auto p50 = percentile(0.5);
+		const auto p99 = percentile(0.99);
+		const auto p999 = percentile(0.999);
+		const auto maxLatency = *std::max_element(m_LatencyList.begin(), m_LatencyList.end());
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 응답 지연(ns). 표본(%llu), p50(%u), p99(%u), p99.9(%u), 최대(%u)", __FUNCTION__,
+			(unsigned long long)m_LatencyList.size(), p50, p99, p999, maxLatency);
+	}
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+#include "interface_tcp_network.h"
+#include "packet_capture.h"
+#include "loopback_script.h"
+
+namespace NServerNetLib
+{
+	// 소켓 없이 메모리 안의 가상 세션으로 로직을 돌리는 ITcpNetwork (커널을 거치지 않는 로직 벤치마크/회귀 확인용)
+	// - 받는 쪽: 스크립트나 생성 함수가 넣은(InjectPacket) 패킷을 넣은 시간 순서대로 GetPacketInfo 로 넘김
+	//   접속/끊김도 kNTF_SYS_CONNECT_SESSION/kNTF_SYS_CLOSE_SESSION 패킷으로 넣음
+	// - 시계: 가상 시계면 다음 패킷의 시간으로 바로 건너뛰므로 wait 를 실제로 기다리지 않고 매번 같은 순서로 재현됨
+	//   가상 시계는 넣는 시간과 출력 파일의 시간에만 쓰이고, 로직의 타이머(StateCheck, 코루틴 대기)는 그대로 실제 시간
+	// - 보내는 쪽: 세션별 수/크기를 세고, 보낸 것 모으기를 켜면 헤더가 붙은 그대로 세션별 버퍼에 모음 (TakeSendData 로 꺼냄)
+	//   스크립트로 돌 때는 다음 패킷을 넘기기 전에 버퍼를 비우고, 출력 파일이 있으면 캡처 형식으로 가상 시간과 함께 남김
+	// - 패킷을 넘긴 뒤 그 세션에 처음 보낼 때까지의 실제 시간을 응답 지연으로 모아 끝날 때 백분위를 남김
+	// 느린 세션 흉내(송신 버퍼 고수위, 지연 전송)는 하지 않음
+	class LoopbackNetwork : public ITcpNetwork
+	{
+	public:
+		// 넣을 패킷이 없을 때 로직 스레드에서 불러 더 넣게 함 (더 넣을 것이 없으면 false)
+		using PacketGenerator = std::function<bool(LoopbackNetwork&)>;
+
+		LoopbackNetwork() = default;
+		virtual ~LoopbackNetwork() = default;
+
+		// 설정에 스크립트 파일이 있으면 읽어서 생성 함수로 씀
+		NET_ERROR_CODE Init(const ServerConfig* pConfig, ILog* pLogger) override;
+
+		NET_ERROR_CODE SendData(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pMsg) override;
+
+		NET_ERROR_CODE SendRawData(const int32_t sessionIndex, const char* pData, const int32_t size) override;
+
+		bool Run() override;
+
+		void Release() override;
+
+		void ForcingClose(const int32_t sessionIndex) override;
+
+		int32_t ClientSessionPoolSize() override { return m_SessionPoolSize; }
+
+		RecvPacketInfo GetPacketInfo() override;
+
+		void WaitPacketInfo(const uint32_t waitMicroSec) override;
+
+		void PostPacket(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody) override;
+
+		// 시작 시간 + NowMicroSec
+		std::chrono::steady_clock::time_point GetLogicTime() override { return m_StartTime + std::chrono::microseconds(NowMicroSec()); }
+
+		// timeMicroSec 는 시작부터의 시간 (음수면 지금). 앞에 넣은 패킷보다 이르면 그 패킷의 시간으로 맞춤 (아무 스레드에서나 호출 가능)
+		void InjectPacket(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody, const int64_t timeMicroSec = -1);
+
+		void ConnectSession(const int32_t sessionIndex, const int64_t timeMicroSec = -1);
+
+		void CloseSession(const int32_t sessionIndex, const int64_t timeMicroSec = -1);
+
+		// 로직 스레드를 돌리기 전에 설정
+		void SetGenerator(PacketGenerator generator);
+
+		void SetCaptureSend(const bool isCapture) { m_IsCaptureSend = isCapture; }
+
+		// 시작부터의 시간 (가상 시계면 마지막으로 넘긴 패킷의 시간 + AdvanceClock)
+		int64_t NowMicroSec() const;
+
+		// 가상 시계를 앞으로 돌림 (실제 시계면 무시)
+		void AdvanceClock(const int64_t microSec);
+
+		// 세션에 보낸 패킷(헤더 포함)을 꺼내고 버퍼를 비움
+		void TakeSendData(const int32_t sessionIndex, std::vector<char>& data);
+
+		// 생성 함수가 끝났고 넣은 패킷도 모두 넘김
+		bool IsFinished() const { return m_IsFinished; }
+
+	private:
+		struct QueuedPacket
+		{
+			int64_t TimeMicroSec;
+			int32_t SessionIndex;
+			int16_t PacketId;
+			int16_t BodySize;
+		};
+
+		struct LoopbackSession
+		{
+			bool IsConnected = false;
+			bool IsCloseQueued = false;
+			// 넘긴 패킷의 첫 응답을 기다리는 중
+			bool IsWaitingResponse = false;
+			std::chrono::steady_clock::time_point DeliverTime;
+
+			std::vector<char> SendBuffer;
+			uint64_t SendPacketCount = 0;
+			uint64_t SendBytes = 0;
+		};
+
+		int64_t GetRealElapsedMicroSec() const;
+
+		// 넘기기 전에 세션 상태를 바꿈. 넘기지 않을 패킷(끊긴 세션의 패킷 등)이면 false
+		bool UpdateSession(const QueuedPacket& packet);
+
+		// pHeader 와 pBody 를 이어서 세션 버퍼에 모음 (pBody 는 nullptr 가능)
+		NET_ERROR_CODE AppendSendData(const int32_t sessionIndex, const int32_t packetCount, const char* pHeader, const int32_t headerSize, const char* pBody, const int32_t bodySize);
+
+		void RecordLatency(LoopbackSession& session);
+
+		// 세션별 버퍼에 모인 패킷을 출력 파일에 남기고 비움 (스크립트로 돌 때만)
+		void DrainSendBuffer();
+
+		void ReportFinish();
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+
+		int32_t m_SessionPoolSize = 0;
+		int32_t m_MaxSendBufferSize = 0;
+		bool m_IsVirtualClock = true;
+		bool m_IsCaptureSend = false;
+		bool m_IsAutoDrain = false;
+
+		LoopbackScript m_Script;
+		PacketGenerator m_Generator;
+		bool m_IsGeneratorDone = false;
+
+		// 넣은 패킷 (바디는 m_QueueBody 에 차례로 이어 붙임)
+		std::mutex m_QueueLock;
+		std::deque<QueuedPacket> m_Queue;
+		std::vector<int8_t> m_QueueBody;
+		size_t m_QueueBodyReadPos = 0;
+		int64_t m_LastQueueTimeMicroSec = 0;
+
+		// 로직이 처리하는 동안 유지되도록 넘긴 패킷의 바디를 복사해 둠
+		std::vector<int8_t> m_CurrentBody;
+
+		std::atomic<int64_t> m_VirtualTimeMicroSec = 0;
+		// 실제 시계의 시작 (Init)
+		std::chrono::steady_clock::time_point m_StartTime;
+		// 처리량 측정의 시작 (첫 패킷을 넘긴 때)
+		std::chrono::steady_clock::time_point m_FirstDeliverTime;
+		bool m_IsStarted = false;
+		bool m_IsFinished = false;
+
+		// 세션 상태와 보낸 패킷
+		std::mutex m_SendLock;
+		std::vector<LoopbackSession> m_SessionList;
+		std::vector<int32_t> m_DirtySessionList;
+		std::vector<uint32_t> m_LatencyList;
+		PacketCaptureWriter m_Output;
+
+		uint64_t m_DeliverPacketCount = 0;
+		std::atomic<uint64_t> m_SkipPacketCount = 0;
+		uint64_t m_SendBufferFullCount = 0;
+		uint64_t m_ForcingCloseCount = 0;
+	};
+}
@@ -0,0 +1,396 @@
+#include <cstdlib>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "define.h"
+#include "loopback_network.h"
+#include "loopback_script.h"
+
+namespace NServerNetLib
+{
+	namespace
+	{
+		// 문자열 항목 하나의 최대 길이 (바디 최대 크기보다 길 수 없음)
+		constexpr int32_t MAX_TEXT_ITEM_LENGTH = MAX_PACKET_BODY_SIZE;
+		// 잘못 적은 범위로 한 줄에 너무 많은 패킷을 만들지 않도록
+		constexpr int64_t MAX_SESSION_RANGE_COUNT = 1 << 20;
+
+		bool ParseInt(const std::string& text, int64_t& value)
+		{
+			if (text.empty()) {
+				return false;
+			}
+
+			char* pEnd = nullptr;
+			value = strtoll(text.c_str(), &pEnd, 0);
+			return *pEnd == '\0';
+		}
+
+		// "3" 또는 "0-99"
+		bool ParseSessionRange(const std::string& text, int32_t& firstSession, int32_t& lastSession)
+		{
+			int64_t first = 0;
+			int64_t last = 0;
+			const auto dashPos = text.find('-', 1);
+			if (dashPos == std::string::npos) {
+				if (ParseInt(text, first) == false) {
+					return false;
+				}
+				last = first;
+			}
+			else if (ParseInt(text.substr(0, dashPos), first) == false || ParseInt(text.substr(dashPos + 1), last) == false) {
+				return false;
+			}
+
+			if (first < 0 || last < first || last - first >= MAX_SESSION_RANGE_COUNT || last > INT32_MAX) {
+				return false;
+			}
+
+			firstSession = (int32_t)first;
+			lastSession = (int32_t)last;
+			return true;
+		}
+
+		void AppendInt(std::vector<int8_t>& bytes, const int64_t value, const int32_t size)
+		{
+			for (int32_t i = 0; i < size; ++i) {
+				bytes.push_back((int8_t)((value >> (i * 8)) & 0xFF));
+			}
+		}
+
+		int32_t HexValue(const char ch)
+		{
+			if (ch >= '0' && ch <= '9') {
+				return ch - '0';
+			}
+			if (ch >= 'a' && ch <= 'f') {
+				return ch - 'a' + 10;
+			}
+			if (ch >= 'A' && ch <= 'F') {
+				return ch - 'A' + 10;
+			}
+			return -1;
+		}
+
+		// 잘못된 바이트는 U+FFFD 로 바꿈
+		void Utf8ToUtf16(const std::string& text, std::vector<char16_t>& unitList)
+		{
+			unitList.clear();
+			size_t i = 0;
+			while (i < text.size()) {
+				const auto lead = (uint8_t)text[i];
+				int32_t followCount = 0;
+				char32_t codePoint = 0;
+				if (lead < 0x80) {
+					codePoint = lead;
+				}
+				else if ((lead & 0xE0) == 0xC0) {
+					followCount = 1;
+					codePoint = lead & 0x1F;
+				}
+				else if ((lead & 0xF0) == 0xE0) {
+					followCount = 2;
+					codePoint = lead & 0x0F;
+				}
+				else if ((lead & 0xF8) == 0xF0) {
+					followCount = 3;
+					codePoint = lead & 0x07;
+				}
+				else {
+					codePoint = 0xFFFD;
+				}
+				++i;
+
+				for (int32_t j = 0; j < followCount; ++j, ++i) {
+					if (i >= text.size() || ((uint8_t)text[i] & 0xC0) != 0x80) {
+						codePoint = 0xFFFD;
+						break;
+					}
+					codePoint = (codePoint << 6) | ((uint8_t)text[i] & 0x3F);
+				}
+
+				if (codePoint >= 0x10000 && codePoint <= 0x10FFFF) {
+					codePoint -= 0x10000;
+					unitList.push_back((char16_t)(0xD800 + (codePoint >> 10)));
+					unitList.push_back((char16_t)(0xDC00 + (codePoint & 0x3FF)));
+				}
+				else {
+					unitList.push_back(codePoint > 0x10FFFF ? (char16_t)0xFFFD : (char16_t)codePoint);
+				}
+			}
+		}
+	}
+
+	bool LoopbackScript::Load(const char* pszFileName, int32_t& errorLine)
+	{
+		m_CommandList.clear();
+		m_CommandIndex = 0;
+		m_RepeatStack.clear();
+		m_TimeMicroSec = 0;
+		errorLine = 0;
+
+		std::ifstream file(pszFileName);
+		if (file.is_open() == false) {
+			return false;
+		}
+
+		std::vector<int32_t> repeatStack;
+		std::string line;
+		while (std::getline(file, line)) {
+			++errorLine;
+			if (ParseLine(line, repeatStack) == false) {
+				return false;
+			}
+		}
+
+		// 닫히지 않은 repeat
+		if (repeatStack.empty() == false) {
+			++errorLine;
+			return false;
+		}
+
+		errorLine = 0;
+		return true;
+	}
+
+	bool LoopbackScript::Emit(LoopbackNetwork* pNetwork, const int32_t maxPacketCount)
+	{
+		const auto commandCount = (int32_t)m_CommandList.size();
+		int32_t packetCount = 0;
+
+		while (m_CommandIndex < commandCount && packetCount < maxPacketCount)
+		{
+			const auto& command = m_CommandList[m_CommandIndex];
+			switch (command.Type)
+			{
+			case COMMAND_TYPE::kCONNECT:
+			case COMMAND_TYPE::kCLOSE:
+				for (auto i = command.FirstSession; i <= command.LastSession; ++i) {
+					if (command.Type == COMMAND_TYPE::kCONNECT) {
+						pNetwork->ConnectSession(i, m_TimeMicroSec);
+					}
+					else {
+						pNetwork->CloseSession(i, m_TimeMicroSec);
+					}
+				}
+				packetCount += command.LastSession - command.FirstSession + 1;
+				++m_CommandIndex;
+				break;
+
+			case COMMAND_TYPE::kSEND:
+				for (auto i = command.FirstSession; i <= command.LastSession; ++i) {
+					BuildBody(command, i, m_Body);
+					pNetwork->InjectPacket(i, command.PacketId, (int16_t)m_Body.size(), m_Body.data(), m_TimeMicroSec);
+				}
+				packetCount += command.LastSession - command.FirstSession + 1;
+				++m_CommandIndex;
+				break;
+
+			case COMMAND_TYPE::kWAIT:
+				m_TimeMicroSec += command.WaitMicroSec;
+				++m_CommandIndex;
+				break;
+
+			case COMMAND_TYPE::kREPEAT:
+				if (command.RepeatCount <= 0) {
+					m_CommandIndex = command.MatchIndex + 1;
+					break;
+				}
+				m_RepeatStack.push_back({ m_CommandIndex, command.RepeatCount });
+				++m_CommandIndex;
+				break;
+
+			case COMMAND_TYPE::kEND:
+			{
+				auto& repeat = m_RepeatStack.back();
+				if (--repeat.RemainCount > 0) {
+					m_CommandIndex = repeat.CommandIndex + 1;
+				}
+				else {
+					m_RepeatStack.pop_back();
+					++m_CommandIndex;
+				}
+				break;
+			}
+			}
+		}
+
+		return m_CommandIndex < commandCount;
+	}
+
+	bool LoopbackScript::ParseLine(const std::string& line, std::vector<int32_t>& repeatStack)
+	{
+		std::istringstream stream(line.substr(0, line.find('#')));
+		std::vector<std::string> tokenList;
+		std::string token;
+		while (stream >> token) {
+			tokenList.push_back(token);
+		}
+
+		if (tokenList.empty()) {
+			return true;
+		}
+
+		Command command;
+		const auto& name = tokenList[0];
+		int64_t value = 0;
+
+		if (name == "connect" || name == "close") {
+			if (tokenList.size() != 2 || ParseSessionRange(tokenList[1], command.FirstSession, command.LastSession) == false) {
+				return false;
+			}
+			command.Type = name == "connect" ? COMMAND_TYPE::kCONNECT : COMMAND_TYPE::kCLOSE;
+		}
+		else if (name == "send") {
+			if (tokenList.size() < 3 || ParseSessionRange(tokenList[1], command.FirstSession, command.LastSession) == false) {
+				return false;
+			}
+
+			// 시스템 패킷(접속/끊김)은 connect/close 로만 넣음
+			if (ParseInt(tokenList[2], value) == false || value <= (int64_t)PACKET_ID::kNTF_SYS_CLOSE_SESSION || value >= MAX_PACKET_ID) {
+				return false;
+			}
+			command.Type = COMMAND_TYPE::kSEND;
+			command.PacketId = (int16_t)value;
+
+			int32_t bodySize = 0;
+			for (size_t i = 3; i < tokenList.size(); ++i) {
+				auto& item = command.ItemList.emplace_back();
+				if (ParseBodyItem(tokenList[i], item) == false) {
+					return false;
+				}
+				bodySize += item.HasSessionIndex ? item.Length * (item.IsUtf16 ? 2 : 1) : (int32_t)item.Bytes.size();
+			}
+
+			if (bodySize > MAX_PACKET_BODY_SIZE) {
+				return false;
+			}
+		}
+		else if (name == "wait") {
+			if (tokenList.size() != 2) {
+				return false;
+			}
+
+			char* pEnd = nullptr;
+			const auto milliSec = strtod(tokenList[1].c_str(), &pEnd);
+			if (*pEnd != '\0' || milliSec < 0) {
+				return false;
+			}
+			command.Type = COMMAND_TYPE::kWAIT;
+			command.WaitMicroSec = (int64_t)(milliSec * 1000);
+		}
+		else if (name == "repeat") {
+			if (tokenList.size() != 2 || ParseInt(tokenList[1], value) == false || value < 0 || value > INT32_MAX) {
+				return false;
+			}
+			command.Type = COMMAND_TYPE::kREPEAT;
+			command.RepeatCount = (int32_t)value;
+			repeatStack.push_back((int32_t)m_CommandList.size());
+		}
+		else if (name == "end") {
+			if (tokenList.size() != 1 || repeatStack.empty()) {
+				return false;
+			}
+			command.Type = COMMAND_TYPE::kEND;
+			m_CommandList[repeatStack.back()].MatchIndex = (int32_t)m_CommandList.size();
+			repeatStack.pop_back();
+		}
+		else {
+			return false;
+		}
+
+		m_CommandList.push_back(std::move(command));
+		return true;
+	}
+
+	bool LoopbackScript::ParseBodyItem(const std::string& token, BodyItem& item)
+	{
+		const auto colonPos = token.find(':');
+		if (colonPos == std::string::npos) {
+			return false;
+		}
+
+		const auto type = token.substr(0, colonPos);
+		const auto text = token.substr(colonPos + 1);
+		int64_t value = 0;
+
+		if (type == "i8" || type == "i16" || type == "i32") {
+			if (ParseInt(text, value) == false) {
+				return false;
+			}
+			AppendInt(item.Bytes, value, type == "i8" ? 1 : (type == "i16" ? 2 : 4));
+			return true;
+		}
+
+		if (type == "h") {
+			if (text.size() % 2 != 0) {
+				return false;
+			}
+			for (size_t i = 0; i < text.size(); i += 2) {
+				const auto high = HexValue(text[i]);
+				const auto low = HexValue(text[i + 1]);
+				if (high < 0 || low < 0) {
+					return false;
+				}
+				item.Bytes.push_back((int8_t)((high << 4) | low));
+			}
+			return true;
+		}
+
+		if (type.size() >= 2 && (type[0] == 's' || type[0] == 'u')) {
+			if (ParseInt(type.substr(1), value) == false || value <= 0 || value > MAX_TEXT_ITEM_LENGTH) {
+				return false;
+			}
+			item.Text = text;
+			item.Length = (int32_t)value;
+			item.IsUtf16 = type[0] == 'u';
+			item.HasSessionIndex = text.find("%d") != std::string::npos;
+
+			if (item.HasSessionIndex == false) {
+				BuildText(item, 0, item.Bytes);
+			}
+			return true;
+		}
+
+		return false;
+	}
+
+	void LoopbackScript::BuildText(const BodyItem& item, const int32_t sessionIndex, std::vector<int8_t>& body)
+	{
+		auto text = item.Text;
+		if (item.HasSessionIndex) {
+			const auto sessionText = std::to_string(sessionIndex);
+			for (auto pos = text.find("%d"); pos != std::string::npos; pos = text.find("%d", pos + sessionText.size())) {
+				text.replace(pos, 2, sessionText);
+			}
+		}
+
+		if (item.IsUtf16 == false) {
+			const auto copySize = std::min<int32_t>((int32_t)text.size(), item.Length);
+			body.insert(body.end(), text.begin(), text.begin() + copySize);
+			body.insert(body.end(), item.Length - copySize, 0);
+			return;
+		}
+
+		std::vector<char16_t> unitList;
+		Utf8ToUtf16(text, unitList);
+		for (int32_t i = 0; i < item.Length; ++i) {
+			AppendInt(body, i < (int32_t)unitList.size() ? unitList[i] : 0, 2);
+		}
+	}
+
+	void LoopbackScript::BuildBody(const Command& command, const int32_t sessionIndex, std::vector<int8_t>& body) const
+	{
+		body.clear();
+		for (auto& item : command.ItemList) {
+			if (item.HasSessionIndex) {
+				BuildText(item, sessionIndex, body);
+			}
+			else {
+				body.insert(body.end(), item.Bytes.begin(), item.Bytes.end());
+			}
+		}
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace NServerNetLib
+{
+	class LoopbackNetwork;
+
+	// 루프백 네트워크에 넣을 패킷을 만드는 텍스트 스크립트 (한 줄에 명령 하나, # 뒤는 주석)
+	//   connect <세션>                 세션은 3 처럼 하나 또는 0-99 처럼 범위 (범위면 세션마다 한 번씩)
+	//   close <세션>
+	//   send <세션> <패킷ID> [바디 항목...]
+	//   wait <ms>                      이후 패킷을 ms 뒤의 시간에 넣음
+	//   repeat <횟수> ... end          (중첩 가능)
+	// 바디 항목은 차례로 이어 붙임 (정수는 little-endian)
+	//   i8:<값> i16:<값> i32:<값>  h:<16진수>  s<바이트 수>:<문자열>  u<글자 수>:<문자열>(UTF-16)
+	//   문자열은 공백 없이 쓰고, 남는 자리는 0 으로 채우며 %d 는 세션 번호로 바뀜 (예: send 0-99 21 s17:user%d s17:pw)
+	class LoopbackScript
+	{
+	public:
+		// 실패하면 false 와 잘못된 줄 번호
+		bool Load(const char* pszFileName, int32_t& errorLine);
+
+		// 이어서 실행하다가 넣은 패킷이 maxPacketCount 이상이 되면 멈춤 (스크립트가 끝났으면 false)
+		bool Emit(LoopbackNetwork* pNetwork, const int32_t maxPacketCount);
+
+		int32_t GetCommandCount() const { return (int32_t)m_CommandList.size(); }
+
+	private:
+		enum class COMMAND_TYPE : int16_t
+		{
+			kCONNECT = 0,
+			kCLOSE,
+			kSEND,
+			kWAIT,
+			kREPEAT,
+			kEND,
+		};
+
+		// 세션 번호가 들어가지 않는 항목은 읽을 때 미리 바이트로 만들어 둠
+		struct BodyItem
+		{
+			std::vector<int8_t> Bytes;
+			std::string Text;
+			int32_t Length = 0;
+			bool IsUtf16 = false;
+			bool HasSessionIndex = false;
+		};
+
+		struct Command
+		{
+			COMMAND_TYPE Type = COMMAND_TYPE::kCONNECT;
+			int32_t FirstSession = 0;
+			int32_t LastSession = 0;
+			int16_t PacketId = 0;
+			int64_t WaitMicroSec = 0;
+			int32_t RepeatCount = 0;
+			// repeat 는 짝이 되는 end 의 위치
+			int32_t MatchIndex = -1;
+			std::vector<BodyItem> ItemList;
+		};
+
+		struct RepeatState
+		{
+			int32_t CommandIndex;
+			int32_t RemainCount;
+		};
+
+		bool ParseLine(const std::string& line, std::vector<int32_t>& repeatStack);
+
+		static bool ParseBodyItem(const std::string& token, BodyItem& item);
+
+		static void BuildText(const BodyItem& item, const int32_t sessionIndex, std::vector<int8_t>& body);
+
+		void BuildBody(const Command& command, const int32_t sessionIndex, std::vector<int8_t>& body) const;
+
+	private:
+		std::vector<Command> m_CommandList;
+
+		// 실행 위치 (Emit 을 여러 번 나눠 불러도 이어서 실행)
+		int32_t m_CommandIndex = 0;
+		std::vector<RepeatState> m_RepeatStack;
+		int64_t m_TimeMicroSec = 0;
+		std::vector<int8_t> m_Body;
+	};
+}
@@ -0,0 +1,115 @@
+#include <cstdio>
+
+#include "metrics.h"
+
+namespace NServerNetLib
+{
+	Metrics& Metrics::Instance()
+	{
+		static Metrics instance;
+		return instance;
+	}
+
+	MetricsShard& Metrics::Local()
+	{
+		thread_local MetricsShard* pShard = Instance().RegisterShard();
+		return *pShard;
+	}
+
+	MetricsShard* Metrics::RegisterShard()
+	{
+		std::lock_guard<std::mutex> guard(m_ShardLock);
+		m_ShardList.push_back(std::make_unique<MetricsShard>());
+		return m_ShardList.back().get();
+	}
+
+	void Metrics::SetPacketQueueDepth(const uint64_t depth)
+	{
+		m_PacketQueueDepth.store(depth, std::memory_order_relaxed);
+
+		auto maxDepth = m_PacketQueueDepthMax.load(std::memory_order_relaxed);
+		while (depth > maxDepth && m_PacketQueueDepthMax.compare_exchange_weak(maxDepth, depth, std::memory_order_relaxed) == false) {
+		}
+	}
+
+	void Metrics::TakeSnapshot(MetricsSnapshot& snapshot)
+	{
+		snapshot = MetricsSnapshot();
+		snapshot.ConnectedSessionCount = m_ConnectedSessionCount.load(std::memory_order_relaxed);
+		snapshot.PacketQueueDepth = m_PacketQueueDepth.load(std::memory_order_relaxed);
+		snapshot.PacketQueueDepthMax = m_PacketQueueDepthMax.load(std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> guard(m_ShardLock);
+		for (auto& pShard : m_ShardList) {
+			snapshot.AcceptCount += pShard->AcceptCount.Get();
+			snapshot.SendBufferFullCount += pShard->SendBufferFullCount.Get();
+			snapshot.SendLagDropCount += pShard->SendLagDropCount.Get();
+
+			for (int i = 0; i < METRICS_MAX_NET_ERROR_CODE; ++i) {
+				snapshot.AcceptRejectCount[i] += pShard->AcceptRejectCount[i].Get();
+			}
+
+			for (int i = 0; i < METRICS_MAX_CLOSE_CASE; ++i) {
+				snapshot.CloseCount[i] += pShard->CloseCount[i].Get();
+			}
+
+			for (int i = 0; i < METRICS_MAX_PACKET_ID; ++i) {
+				snapshot.RecvPacketCount[i] += pShard->RecvPacketCount[i].Get();
+				snapshot.RecvBytes[i] += pShard->RecvBytes[i].Get();
+				snapshot.SendPacketCount[i] += pShard->SendPacketCount[i].Get();
+				snapshot.SendBytes[i] += pShard->SendBytes[i].Get();
+			}
+		}
+	}
+
+	std::string MetricsSnapshot::ToText() const
+	{
+		std::string text;
+		char line[128];
+
+		auto append = [&](const char* pszName, const char* pszLabel, const int labelValue, const uint64_t value) {
+			if (pszLabel != nullptr) {
+				snprintf(line, sizeof(line), "%s{%s=\"%d\"} %llu\n", pszName, pszLabel, labelValue, (unsigned long long)value);
+			}
+			else {
+				snprintf(line, sizeof(line), "%s %llu\n", pszName, (unsigned long long)value);
+			}
+			text += line;
+		};
+
+		append("connected_sessions", nullptr, 0, ConnectedSessionCount);
+		append("packet_queue_depth", nullptr, 0, PacketQueueDepth);
+		append("packet_queue_depth_max", nullptr, 0, PacketQueueDepthMax);
+		append("accept_total", nullptr, 0, AcceptCount);
+		append("send_buffer_full_total", nullptr, 0, SendBufferFullCount);
+		append("send_lag_drop_total", nullptr, 0, SendLagDropCount);
+
+		for (int i = 0; i < METRICS_MAX_NET_ERROR_CODE; ++i) {
+			if (AcceptRejectCount[i] > 0) {
+				append("accept_reject_total", "net_error_code", i, AcceptRejectCount[i]);
+			}
+		}
+
+		for (int i = 0; i < METRICS_MAX_CLOSE_CASE; ++i) {
+			if (CloseCount[i] > 0) {
+				append("close_total", "close_case", i, CloseCount[i]);
+			}
+		}
+
+		for (int i = 0; i < METRICS_MAX_PACKET_ID; ++i) {
+			if (RecvPacketCount[i] > 0) {
+				append("recv_packets_total", "packet_id", i, RecvPacketCount[i]);
+				append("recv_bytes_total", "packet_id", i, RecvBytes[i]);
+			}
+		}
+
+		for (int i = 0; i < METRICS_MAX_PACKET_ID; ++i) {
+			if (SendPacketCount[i] > 0) {
+				append("send_packets_total", "packet_id", i, SendPacketCount[i]);
+				append("send_bytes_total", "packet_id", i, SendBytes[i]);
+			}
+		}
+
+		return text;
+	}
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "define.h"
+#include "server_network_error_code.h"
+
+namespace NServerNetLib
+{
+	// 패킷 ID, 에러 코드, 종료 사유를 배열 인덱스로 바로 쓰기 위한 크기
+	constexpr int METRICS_MAX_PACKET_ID = 256;
+	constexpr int METRICS_MAX_NET_ERROR_CODE = 64;
+	constexpr int METRICS_MAX_CLOSE_CASE = 8;
+
+	// 한 스레드만 증가시키는 카운터 (다른 스레드는 스냅샷에서 읽기만 하므로 lock 없는 load/store 로 충분)
+	class MetricsCounter
+	{
+	public:
+		void Add(const uint64_t value)
+		{
+			m_Value.store(m_Value.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		uint64_t Get() const { return m_Value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<uint64_t> m_Value = 0;
+	};
+
+	// 스레드 하나가 쓰는 카운터 묶음
+	struct MetricsShard
+	{
+		void AddAccept() { AcceptCount.Add(1); }
+
+		void AddAcceptReject(const NET_ERROR_CODE errorCode)
+		{
+			AcceptRejectCount[(int)errorCode & (METRICS_MAX_NET_ERROR_CODE - 1)].Add(1);
+		}
+
+		void AddClose(const SOCKET_CLOSE_CASE closeCase)
+		{
+			CloseCount[(int)closeCase & (METRICS_MAX_CLOSE_CASE - 1)].Add(1);
+		}
+
+		void AddRecvPacket(const int16_t packetId, const int32_t totalSize)
+		{
+			auto index = (uint16_t)packetId & (METRICS_MAX_PACKET_ID - 1);
+			RecvPacketCount[index].Add(1);
+			RecvBytes[index].Add(totalSize);
+		}
+
+		void AddSendPacket(const int16_t packetId, const int32_t totalSize)
+		{
+			auto index = (uint16_t)packetId & (METRICS_MAX_PACKET_ID - 1);
+			SendPacketCount[index].Add(1);
+			SendBytes[index].Add(totalSize);
+		}
+
+		void AddSendBufferFull() { SendBufferFullCount.Add(1); }
+		void AddSendLagDrop() { SendLagDropCount.Add(1); }
+
+		MetricsCounter AcceptCount;
+		MetricsCounter AcceptRejectCount[METRICS_MAX_NET_ERROR_CODE];
+		MetricsCounter CloseCount[METRICS_MAX_CLOSE_CASE];
+		MetricsCounter RecvPacketCount[METRICS_MAX_PACKET_ID];
+		MetricsCounter RecvBytes[METRICS_MAX_PACKET_ID];
+		MetricsCounter SendPacketCount[METRICS_MAX_PACKET_ID];
+		MetricsCounter SendBytes[METRICS_MAX_PACKET_ID];
+		MetricsCounter SendBufferFullCount;
+		MetricsCounter SendLagDropCount;
+	};
+
+	// 모든 스레드의 카운터를 합친 값
+	struct MetricsSnapshot
+	{
+		uint64_t ConnectedSessionCount = 0;
+		uint64_t PacketQueueDepth = 0;
+		uint64_t PacketQueueDepthMax = 0;
+
+		uint64_t AcceptCount = 0;
+		uint64_t AcceptRejectCount[METRICS_MAX_NET_ERROR_CODE] = { 0, };
+		uint64_t CloseCount[METRICS_MAX_CLOSE_CASE] = { 0, };
+		uint64_t RecvPacketCount[METRICS_MAX_PACKET_ID] = { 0, };
+		uint64_t RecvBytes[METRICS_MAX_PACKET_ID] = { 0, };
+		uint64_t SendPacketCount[METRICS_MAX_PACKET_ID] = { 0, };
+		uint64_t SendBytes[METRICS_MAX_PACKET_ID] = { 0, };
+		uint64_t SendBufferFullCount = 0;
+		uint64_t SendLagDropCount = 0;
+
+		// "이름{라벨} 값" 한 줄씩 (0 인 항목은 생략)
+		std::string ToText() const;
+	};
+
+	// 프로세스 전체 수치 저장소
+	// 카운터는 스레드별 MetricsShard 에 쌓고 스냅샷을 만들 때만 합침
+	class Metrics
+	{
+	public:
+		static Metrics& Instance();
+
+		// 호출한 스레드 전용 카운터 묶음 (처음 호출할 때 등록)
+		static MetricsShard& Local();
+
+		void SetConnectedSessionCount(const uint64_t count) { m_ConnectedSessionCount.store(count, std::memory_order_relaxed); }
+
+		void SetPacketQueueDepth(const uint64_t depth);
+
+		void TakeSnapshot(MetricsSnapshot& snapshot);
+
+	private:
+		MetricsShard* RegisterShard();
+
+	private:
+		// 스레드가 끝나도 누적 값은 남아야 하므로 묶음은 지우지 않음
+		std::mutex m_ShardLock;
+		std::vector<std::unique_ptr<MetricsShard>> m_ShardList;
+
+		std::atomic<uint64_t> m_ConnectedSessionCount = 0;
+		std::atomic<uint64_t> m_PacketQueueDepth = 0;
+		std::atomic<uint64_t> m_PacketQueueDepthMax = 0;
+	};
+}
@@ -0,0 +1,184 @@
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+
+#include "interface_log.h"
+#include "metrics_exporter.h"
+
+namespace NServerNetLib
+{
+	MetricsExporter::MetricsExporter()
+	{
+	}
+
+	MetricsExporter::~MetricsExporter()
+	{
+		Stop();
+
+		if (m_AdminSockFD != INVALID_SOCKET) {
+#ifdef _WIN32
+			closesocket(m_AdminSockFD);
+#else
+			close(m_AdminSockFD);
+#endif
+			m_AdminSockFD = INVALID_SOCKET;
+		}
+	}
+
+	NET_ERROR_CODE MetricsExporter::Init(const uint16_t adminPort, const uint32_t dumpIntervalSec, const char* pszDumpFileName, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_DumpIntervalSec = dumpIntervalSec;
+		m_DumpFileName = pszDumpFileName != nullptr ? pszDumpFileName : "";
+
+		if (adminPort == 0) {
+			return NET_ERROR_CODE::kNONE;
+		}
+
+		m_AdminSockFD = socket(AF_INET, SOCK_STREAM, 0);
+		if (m_AdminSockFD == INVALID_SOCKET) {
+			return NET_ERROR_CODE::kSERVER_SOCKET_CREATE_FAIL;
+		}
+
+		int32_t n = 1;
+		setsockopt(m_AdminSockFD, SOL_SOCKET, SO_REUSEADDR, (char*)&n, sizeof(n));
+
+		// 외부에서 접근할 수 없도록 루프백에만 바인딩
+		struct sockaddr_in admin_addr;
+		memset(&admin_addr, 0, sizeof(admin_addr));
+		admin_addr.sin_family = AF_INET;
+		admin_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		admin_addr.sin_port = htons(adminPort);
+
+		if (bind(m_AdminSockFD, (struct sockaddr*)&admin_addr, sizeof(admin_addr)) < 0) {
+			return NET_ERROR_CODE::kSERVER_SOCKET_BIND_FAIL;
+		}
+
+		if (listen(m_AdminSockFD, 8) == SOCKET_ERROR) {
+			return NET_ERROR_CODE::kSERVER_SOCKET_LISTEN_FAIL;
+		}
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 관리용 수치 포트(127.0.0.1:%d)", __FUNCTION__, adminPort);
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	void MetricsExporter::Start()
+	{
+		if (m_IsRun || (m_AdminSockFD == INVALID_SOCKET && (m_DumpIntervalSec == 0 || m_DumpFileName.empty()))) {
+			return;
+		}
+
+		m_IsRun = true;
+		m_Thread = std::thread([this]() { ThreadFunc(); });
+	}
+
+	void MetricsExporter::Stop()
+	{
+		m_IsRun = false;
+
+		if (m_Thread.joinable()) {
+			m_Thread.join();
+		}
+	}
+
+	void MetricsExporter::ThreadFunc()
+	{
+		auto nextDumpTime = std::chrono::steady_clock::now() + std::chrono::seconds(m_DumpIntervalSec);
+
+		while (m_IsRun) {
+			if (m_AdminSockFD != INVALID_SOCKET) {
+				// 종료 요청을 늦지 않게 확인하도록 100ms 씩만 기다림
+				fd_set read_set;
+				FD_ZERO(&read_set);
+				FD_SET(m_AdminSockFD, &read_set);
+				timeval timeout{ 0, 100 * 1000 };
+#ifdef _WIN32
+				int32_t selectResult = select(0, &read_set, nullptr, nullptr, &timeout);
+#else
+				int32_t selectResult = select(m_AdminSockFD + 1, &read_set, nullptr, nullptr, &timeout);
+#endif
+				if (selectResult > 0 && FD_ISSET(m_AdminSockFD, &read_set)) {
+					ServeAdminClient();
+				}
+			}
+			else {
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			}
+
+			if (m_DumpIntervalSec == 0 || m_DumpFileName.empty()) {
+				continue;
+			}
+
+			auto curTime = std::chrono::steady_clock::now();
+			if (curTime >= nextDumpTime) {
+				WriteDumpFile();
+				nextDumpTime = curTime + std::chrono::seconds(m_DumpIntervalSec);
+			}
+		}
+	}
+
+	void MetricsExporter::ServeAdminClient()
+	{
+		SOCKET clientSockFD = accept(m_AdminSockFD, nullptr, nullptr);
+		if (clientSockFD == INVALID_SOCKET) {
+			return;
+		}
+
+		MetricsSnapshot snapshot;
+		Metrics::Instance().TakeSnapshot(snapshot);
+		auto text = snapshot.ToText();
+
+		// 텍스트가 작으므로 블로킹 소켓으로 한 번에 보내고 닫음
+		// 관리 클라이언트가 먼저 끊어도 SIGPIPE 로 서버가 죽지 않도록 MSG_NOSIGNAL
+#ifdef _WIN32
+		constexpr int sendFlags = 0;
+#else
+		constexpr int sendFlags = MSG_NOSIGNAL;
+#endif
+		size_t sendPos = 0;
+		while (sendPos < text.size()) {
+			auto sendSize = send(clientSockFD, text.data() + sendPos, (int)(text.size() - sendPos), sendFlags);
+			if (sendSize <= 0) {
+				break;
+			}
+			sendPos += sendSize;
+		}
+
+#ifdef _WIN32
+		closesocket(clientSockFD);
+#else
+		close(clientSockFD);
+#endif
+	}
+
+	void MetricsExporter::WriteDumpFile()
+	{
+		MetricsSnapshot snapshot;
+		Metrics::Instance().TakeSnapshot(snapshot);
+		auto text = snapshot.ToText();
+
+		// 읽는 쪽이 쓰다 만 파일을 보지 않도록 임시 파일에 쓰고 이름을 바꿈
+		auto tempFileName = m_DumpFileName + ".tmp";
+		FILE* pFile = fopen(tempFileName.c_str(), "wb");
+		if (pFile == nullptr) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 수치 덤프 파일(%s) 열기 실패", __FUNCTION__, tempFileName.c_str());
+			return;
+		}
+
+		fwrite(text.data(), 1, text.size(), pFile);
+		fclose(pFile);
+
+#ifdef _WIN32
+		remove(m_DumpFileName.c_str());
+#endif
+		rename(tempFileName.c_str(), m_DumpFileName.c_str());
+	}
+}
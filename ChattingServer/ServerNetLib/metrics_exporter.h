@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <thread>
+#include <atomic>
+
+#include "tcp_network.h"
+#include "metrics.h"
+
+namespace NServerNetLib
+{
+	// Metrics 스냅샷을 밖으로 내보냄
+	// - 관리용 포트(127.0.0.1 만): 접속하면 현재 스냅샷을 텍스트로 보내고 끊음
+	// - 덤프 파일: 일정 주기마다 스냅샷으로 덮어씀
+	class MetricsExporter
+	{
+	public:
+		MetricsExporter();
+		~MetricsExporter();
+
+		// adminPort, dumpIntervalSec 가 0 이면 해당 기능은 사용하지 않음
+		NET_ERROR_CODE Init(const uint16_t adminPort, const uint32_t dumpIntervalSec, const char* pszDumpFileName, ILog* pLogger);
+
+		void Start();
+		void Stop();
+
+	private:
+		void ThreadFunc();
+
+		void ServeAdminClient();
+		void WriteDumpFile();
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+
+		SOCKET m_AdminSockFD = INVALID_SOCKET;
+		uint32_t m_DumpIntervalSec = 0;
+		std::string m_DumpFileName;
+
+		std::thread m_Thread;
+		std::atomic<bool> m_IsRun = false;
+	};
+}
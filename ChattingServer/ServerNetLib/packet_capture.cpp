@@ -0,0 +1,416 @@
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+#include <algorithm>
+
+#include "packet_capture.h"
+
+namespace NServerNetLib
+{
+	namespace
+	{
+		int64_t NowMicroSec()
+		{
+			return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+	}
+
+	bool MappedFile::OpenWrite(const char* pszFileName, const uint64_t maxSize)
+	{
+		Close(0);
+		m_IsWrite = true;
+		m_FileName = pszFileName;
+		m_Size = maxSize;
+
+#ifdef _WIN32
+		m_hFile = CreateFileA(pszFileName, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_hFile == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+
+		m_hMapping = CreateFileMappingA(m_hFile, nullptr, PAGE_READWRITE, (DWORD)(maxSize >> 32), (DWORD)maxSize, nullptr);
+		if (m_hMapping == nullptr) {
+			Close(0);
+			return false;
+		}
+
+		m_pData = (char*)MapViewOfFile(m_hMapping, FILE_MAP_WRITE, 0, 0, (SIZE_T)maxSize);
+#else
+		m_FD = open(pszFileName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (m_FD < 0) {
+			return false;
+		}
+
+		if (ftruncate(m_FD, (off_t)maxSize) != 0) {
+			Close(0);
+			return false;
+		}
+
+		void* pData = mmap(nullptr, maxSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_FD, 0);
+		m_pData = pData != MAP_FAILED ? (char*)pData : nullptr;
+#endif
+		if (m_pData == nullptr) {
+			Close(0);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool MappedFile::OpenRead(const char* pszFileName)
+	{
+		Close(0);
+		m_IsWrite = false;
+		m_FileName = pszFileName;
+
+#ifdef _WIN32
+		m_hFile = CreateFileA(pszFileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_hFile == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		GetFileSizeEx(m_hFile, &fileSize);
+		m_Size = (uint64_t)fileSize.QuadPart;
+
+		m_hMapping = m_Size > 0 ? CreateFileMappingA(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+		if (m_hMapping == nullptr) {
+			Close(0);
+			return false;
+		}
+
+		m_pData = (char*)MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+#else
+		m_FD = open(pszFileName, O_RDONLY);
+		if (m_FD < 0) {
+			return false;
+		}
+
+		struct stat fileStat;
+		if (fstat(m_FD, &fileStat) != 0 || fileStat.st_size == 0) {
+			Close(0);
+			return false;
+		}
+		m_Size = (uint64_t)fileStat.st_size;
+
+		void* pData = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_FD, 0);
+		m_pData = pData != MAP_FAILED ? (char*)pData : nullptr;
+		if (m_pData != nullptr) {
+			// 처음부터 끝까지 한 번 읽으므로 미리 읽어두도록 알림
+			madvise(m_pData, m_Size, MADV_SEQUENTIAL);
+		}
+#endif
+		if (m_pData == nullptr) {
+			Close(0);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool MappedFile::OpenShared(const char* pszFileName, const uint64_t createSize)
+	{
+		Close(0);
+		m_IsWrite = false;
+		m_FileName = pszFileName;
+
+		const bool isCreate = createSize > 0;
+		if (isCreate) {
+			remove(pszFileName);
+		}
+
+#ifdef _WIN32
+		m_hFile = CreateFileA(pszFileName, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+			isCreate ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_hFile == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+
+		if (isCreate) {
+			m_Size = createSize;
+		}
+		else {
+			LARGE_INTEGER fileSize;
+			GetFileSizeEx(m_hFile, &fileSize);
+			m_Size = (uint64_t)fileSize.QuadPart;
+		}
+
+		m_hMapping = m_Size > 0 ? CreateFileMappingA(m_hFile, nullptr, PAGE_READWRITE, (DWORD)(m_Size >> 32), (DWORD)m_Size, nullptr) : nullptr;
+		if (m_hMapping == nullptr) {
+			Close(0);
+			return false;
+		}
+
+		m_pData = (char*)MapViewOfFile(m_hMapping, FILE_MAP_WRITE, 0, 0, (SIZE_T)m_Size);
+#else
+		m_FD = isCreate ? open(pszFileName, O_RDWR | O_CREAT | O_EXCL, 0600) : open(pszFileName, O_RDWR);
+		if (m_FD < 0) {
+			return false;
+		}
+
+		if (isCreate) {
+			m_Size = createSize;
+			if (ftruncate(m_FD, (off_t)createSize) != 0) {
+				Close(0);
+				return false;
+			}
+		}
+		else {
+			struct stat fileStat;
+			if (fstat(m_FD, &fileStat) != 0 || fileStat.st_size == 0) {
+				Close(0);
+				return false;
+			}
+			m_Size = (uint64_t)fileStat.st_size;
+		}
+
+		void* pData = mmap(nullptr, m_Size, PROT_READ | PROT_WRITE, MAP_SHARED, m_FD, 0);
+		m_pData = pData != MAP_FAILED ? (char*)pData : nullptr;
+#endif
+		if (m_pData == nullptr) {
+			Close(0);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool MappedFile::OpenReadWrite(const char* pszFileName, const uint64_t minSize)
+	{
+		Close(0);
+		m_IsWrite = true;
+		m_FileName = pszFileName;
+
+#ifdef _WIN32
+		m_hFile = CreateFileA(pszFileName, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_hFile == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		GetFileSizeEx(m_hFile, &fileSize);
+		m_Size = (uint64_t)fileSize.QuadPart > minSize ? (uint64_t)fileSize.QuadPart : minSize;
+
+		// 매핑 크기가 파일보다 크면 파일이 그만큼 늘어남
+		m_hMapping = m_Size > 0 ? CreateFileMappingA(m_hFile, nullptr, PAGE_READWRITE, (DWORD)(m_Size >> 32), (DWORD)m_Size, nullptr) : nullptr;
+		if (m_hMapping == nullptr) {
+			Close(0);
+			return false;
+		}
+
+		m_pData = (char*)MapViewOfFile(m_hMapping, FILE_MAP_WRITE, 0, 0, (SIZE_T)m_Size);
+#else
+		m_FD = open(pszFileName, O_RDWR | O_CREAT, 0644);
+		if (m_FD < 0) {
+			return false;
+		}
+
+		struct stat fileStat;
+		if (fstat(m_FD, &fileStat) != 0) {
+			Close(0);
+			return false;
+		}
+		m_Size = (uint64_t)fileStat.st_size > minSize ? (uint64_t)fileStat.st_size : minSize;
+
+		if (m_Size == 0 || ((uint64_t)fileStat.st_size < m_Size && ftruncate(m_FD, (off_t)m_Size) != 0)) {
+			Close(0);
+			return false;
+		}
+
+		void* pData = mmap(nullptr, m_Size, PROT_READ | PROT_WRITE, MAP_SHARED, m_FD, 0);
+		m_pData = pData != MAP_FAILED ? (char*)pData : nullptr;
+#endif
+		if (m_pData == nullptr) {
+			Close(0);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool MappedFile::Flush()
+	{
+		if (m_pData == nullptr) {
+			return false;
+		}
+
+#ifdef _WIN32
+		return FlushViewOfFile(m_pData, 0) && FlushFileBuffers(m_hFile);
+#else
+		return msync(m_pData, m_Size, MS_SYNC) == 0;
+#endif
+	}
+
+	void MappedFile::Close(const uint64_t truncateSize)
+	{
+#ifdef _WIN32
+		if (m_pData != nullptr) {
+			FlushViewOfFile(m_pData, 0);
+			UnmapViewOfFile(m_pData);
+		}
+
+		if (m_hMapping != nullptr) {
+			CloseHandle(m_hMapping);
+		}
+
+		if (m_hFile != INVALID_HANDLE_VALUE) {
+			if (m_IsWrite && truncateSize > 0) {
+				LARGE_INTEGER pos;
+				pos.QuadPart = (LONGLONG)truncateSize;
+				SetFilePointerEx(m_hFile, pos, nullptr, FILE_BEGIN);
+				SetEndOfFile(m_hFile);
+			}
+			CloseHandle(m_hFile);
+		}
+
+		m_hMapping = nullptr;
+		m_hFile = INVALID_HANDLE_VALUE;
+#else
+		if (m_pData != nullptr) {
+			if (m_IsWrite) {
+				msync(m_pData, m_Size, MS_SYNC);
+			}
+			munmap(m_pData, m_Size);
+		}
+
+		if (m_FD >= 0) {
+			if (m_IsWrite && truncateSize > 0) {
+				if (ftruncate(m_FD, (off_t)truncateSize) != 0) {
+					// 잘라내지 못해도 헤더의 DataSize 로 끝을 알 수 있음
+				}
+			}
+			close(m_FD);
+		}
+
+		m_FD = -1;
+#endif
+		m_pData = nullptr;
+		m_Size = 0;
+	}
+
+	bool PacketCaptureWriter::Open(const char* pszFileName, const uint64_t maxFileSize)
+	{
+		if (maxFileSize <= sizeof(PacketCaptureFileHeader) || m_File.OpenWrite(pszFileName, maxFileSize) == false) {
+			return false;
+		}
+
+		m_pHeader = (PacketCaptureFileHeader*)m_File.GetData();
+		memcpy(m_pHeader->Magic, "PCAP", sizeof(m_pHeader->Magic));
+		m_pHeader->Version = PACKET_CAPTURE_VERSION;
+		m_pHeader->DataSize = 0;
+		m_pHeader->RecordCount = 0;
+
+		m_WritePos = sizeof(PacketCaptureFileHeader);
+		m_StartTimeMicroSec = NowMicroSec();
+		m_IsFull = false;
+		return true;
+	}
+
+	void PacketCaptureWriter::Close()
+	{
+		if (m_File.IsOpened() == false) {
+			return;
+		}
+
+		m_File.Close(m_WritePos);
+		m_pHeader = nullptr;
+	}
+
+	bool PacketCaptureWriter::Write(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody, const int64_t timeMicroSec)
+	{
+		if (m_IsFull || m_File.IsOpened() == false) {
+			return false;
+		}
+
+		auto recordSize = sizeof(PacketCaptureRecord) + (bodySize > 0 ? bodySize : 0);
+		if (m_WritePos + recordSize > m_File.GetSize()) {
+			m_IsFull = true;
+			return false;
+		}
+
+		PacketCaptureRecord record;
+		record.TimeMicroSec = timeMicroSec >= 0 ? timeMicroSec : NowMicroSec() - m_StartTimeMicroSec;
+		record.SessionIndex = sessionIndex;
+		record.PacketId = packetId;
+		record.BodySize = bodySize > 0 ? bodySize : 0;
+
+		char* pDest = m_File.GetData() + m_WritePos;
+		memcpy(pDest, &record, sizeof(record));
+		if (record.BodySize > 0) {
+			memcpy(pDest + sizeof(record), pBody, record.BodySize);
+
+			if (packetId >= 0 && packetId < MAX_PACKET_ID && m_MaskSizeList[packetId] > 0 && m_MaskOffsetList[packetId] < record.BodySize) {
+				auto maskSize = std::min<int32_t>(m_MaskSizeList[packetId], record.BodySize - m_MaskOffsetList[packetId]);
+				memset(pDest + sizeof(record) + m_MaskOffsetList[packetId], 0, maskSize);
+			}
+		}
+
+		m_WritePos += recordSize;
+
+		// 비정상 종료로 잘라내지 못해도 헤더만 보면 어디까지 유효한지 알 수 있도록 매번 갱신
+		m_pHeader->DataSize = m_WritePos - sizeof(PacketCaptureFileHeader);
+		++m_pHeader->RecordCount;
+		return true;
+	}
+
+	void PacketCaptureWriter::SetMaskField(const int16_t packetId, const int16_t offset, const int16_t size)
+	{
+		if (packetId < 0 || packetId >= MAX_PACKET_ID || offset < 0 || size < 0) {
+			return;
+		}
+
+		m_MaskOffsetList[packetId] = offset;
+		m_MaskSizeList[packetId] = size;
+	}
+
+	bool PacketCaptureReader::Open(const char* pszFileName)
+	{
+		if (m_File.OpenRead(pszFileName) == false) {
+			return false;
+		}
+
+		if (m_File.GetSize() < sizeof(PacketCaptureFileHeader)) {
+			m_File.Close(0);
+			return false;
+		}
+
+		auto pHeader = (const PacketCaptureFileHeader*)m_File.GetData();
+		if (memcmp(pHeader->Magic, "PCAP", sizeof(pHeader->Magic)) != 0 || pHeader->Version != PACKET_CAPTURE_VERSION) {
+			m_File.Close(0);
+			return false;
+		}
+
+		m_DataEnd = sizeof(PacketCaptureFileHeader) + pHeader->DataSize;
+		if (m_DataEnd > m_File.GetSize()) {
+			m_DataEnd = m_File.GetSize();
+		}
+
+		m_RecordCount = pHeader->RecordCount;
+		Rewind();
+		return true;
+	}
+
+	bool PacketCaptureReader::Next(PacketCaptureRecord& record, const int8_t*& pBody)
+	{
+		if (m_ReadPos + sizeof(PacketCaptureRecord) > m_DataEnd) {
+			return false;
+		}
+
+		const char* pSrc = m_File.GetData() + m_ReadPos;
+		memcpy(&record, pSrc, sizeof(record));
+		if (record.BodySize < 0 || m_ReadPos + sizeof(record) + record.BodySize > m_DataEnd) {
+			return false;
+		}
+
+		pBody = (const int8_t*)(pSrc + sizeof(record));
+		m_ReadPos += sizeof(record) + record.BodySize;
+		return true;
+	}
+}
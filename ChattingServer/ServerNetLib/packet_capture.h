@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "define.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace NServerNetLib
+{
+#pragma pack(push, 1)
+	// 캡처 파일 맨 앞에 한 번
+	struct PacketCaptureFileHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		// 헤더 뒤에 실제로 쓰인 레코드 영역 크기
+		uint64_t DataSize;
+		uint64_t RecordCount;
+	};
+
+	// 받은 패킷 하나 (접속/끊김은 kNTF_SYS_CONNECT_SESSION/kNTF_SYS_CLOSE_SESSION 으로 기록). 바로 뒤에 바디가 붙음
+	struct PacketCaptureRecord
+	{
+		// 캡처 시작부터 지난 시간
+		int64_t TimeMicroSec;
+		int32_t SessionIndex;
+		int16_t PacketId;
+		int16_t BodySize;
+	};
+#pragma pack(pop)
+
+	constexpr uint32_t PACKET_CAPTURE_VERSION = 1;
+
+	// 파일을 메모리에 매핑 (쓰기용은 최대 크기로 만들어 두고 닫을 때 쓴 만큼 잘라냄)
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile() { Close(0); }
+
+		bool OpenWrite(const char* pszFileName, const uint64_t maxSize);
+		bool OpenRead(const char* pszFileName);
+
+		// 여러 프로세스가 같이 읽고 쓰는 매핑. createSize 가 0 보다 크면 이전 파일을 지우고 그 크기로 새로 만들고, 0 이면 있는 파일을 엶
+		// (이전 파일을 매핑하고 있던 프로세스는 지운 파일을 계속 보므로 새 파일의 내용과 섞이지 않음)
+		bool OpenShared(const char* pszFileName, const uint64_t createSize);
+
+		// 있으면 내용을 그대로 두고 열고 없으면 만듦. minSize 보다 작으면 그 크기까지 늘림 (늘린 부분은 0)
+		bool OpenReadWrite(const char* pszFileName, const uint64_t minSize);
+
+		// 매핑에 쓴 내용을 디스크까지 내려 보냄
+		bool Flush();
+
+		// truncateSize 가 0 보다 크면 쓰기용 파일을 그 크기로 잘라냄
+		void Close(const uint64_t truncateSize);
+
+		bool IsOpened() const { return m_pData != nullptr; }
+		char* GetData() const { return m_pData; }
+		uint64_t GetSize() const { return m_Size; }
+
+	private:
+		char* m_pData = nullptr;
+		uint64_t m_Size = 0;
+		bool m_IsWrite = false;
+		std::string m_FileName;
+
+#ifdef _WIN32
+		HANDLE m_hFile = INVALID_HANDLE_VALUE;
+		HANDLE m_hMapping = nullptr;
+#else
+		int m_FD = -1;
+#endif
+	};
+
+	// 네트워크 스레드에서만 호출 (잠금 없음)
+	class PacketCaptureWriter
+	{
+	public:
+		bool Open(const char* pszFileName, const uint64_t maxFileSize);
+		void Close();
+
+		bool IsOpened() const { return m_File.IsOpened(); }
+		// 파일이 가득 차서 더 이상 기록하지 않는 상태
+		bool IsFull() const { return m_IsFull; }
+
+		// 가득 차면 false (이후 기록은 모두 무시). timeMicroSec 가 음수면 Open 부터 지난 실제 시간을 기록
+		bool Write(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody, const int64_t timeMicroSec = -1);
+
+		// 이 패킷을 기록할 때 바디의 [offset, offset + size) 를 0 으로 채움 (패킷마다 한 구간, size 0 이면 해제)
+		void SetMaskField(const int16_t packetId, const int16_t offset, const int16_t size);
+
+	private:
+		MappedFile m_File;
+		PacketCaptureFileHeader* m_pHeader = nullptr;
+		uint64_t m_WritePos = 0;
+		int64_t m_StartTimeMicroSec = 0;
+		bool m_IsFull = false;
+
+		int16_t m_MaskOffsetList[MAX_PACKET_ID] = { 0, };
+		int16_t m_MaskSizeList[MAX_PACKET_ID] = { 0, };
+	};
+
+	class PacketCaptureReader
+	{
+	public:
+		bool Open(const char* pszFileName);
+		void Close() { m_File.Close(0); }
+
+		// 다음 레코드. 바디는 매핑된 파일 안을 가리키므로 Close 전까지 유효
+		bool Next(PacketCaptureRecord& record, const int8_t*& pBody);
+
+		void Rewind() { m_ReadPos = sizeof(PacketCaptureFileHeader); }
+
+		uint64_t GetRecordCount() const { return m_RecordCount; }
+
+	private:
+		MappedFile m_File;
+		uint64_t m_DataEnd = 0;
+		uint64_t m_ReadPos = 0;
+		uint64_t m_RecordCount = 0;
+	};
+}
@@ -0,0 +1,156 @@
+#include <thread>
+#include <algorithm>
+
+#include "replay_network.h"
+
+namespace NServerNetLib
+{
+	NET_ERROR_CODE ReplayNetwork::Init(const ServerConfig* pConfig, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_IsMaxSpeed = pConfig->IsReplayMaxSpeed;
+		m_SessionPoolSize = pConfig->MaxClientCount + pConfig->ExtraClientCount;
+		m_LogicStartTime = std::chrono::steady_clock::now();
+
+		if (m_Reader.Open(pConfig->ReplayFileName) == false) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 캡처 파일(%s) 열기 실패", __FUNCTION__, pConfig->ReplayFileName);
+			return NET_ERROR_CODE::kCAPTURE_FILE_OPEN_FAIL;
+		}
+
+		m_SendPacketCountList.assign(m_SessionPoolSize, 0);
+		m_SendBytesList.assign(m_SessionPoolSize, 0);
+
+		m_HasNextRecord = ReadNextRecord();
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 캡처 재생(%s). 레코드 수(%llu), 최대 속도(%d)", __FUNCTION__,
+			pConfig->ReplayFileName, (unsigned long long)m_Reader.GetRecordCount(), m_IsMaxSpeed ? 1 : 0);
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	NET_ERROR_CODE ReplayNetwork::SendData(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pMsg)
+	{
+		if (sessionIndex < 0 || sessionIndex >= m_SessionPoolSize) {
+			return NET_ERROR_CODE::kSEND_CLOSE_SOCKET;
+		}
+
+		++m_SendPacketCountList[sessionIndex];
+		m_SendBytesList[sessionIndex] += PACKET_HEADER_SIZE + bodySize;
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	NET_ERROR_CODE ReplayNetwork::SendRawData(const int32_t sessionIndex, const char* pData, const int32_t size)
+	{
+		if (sessionIndex < 0 || sessionIndex >= m_SessionPoolSize) {
+			return NET_ERROR_CODE::kSEND_CLOSE_SOCKET;
+		}
+
+		++m_SendPacketCountList[sessionIndex];
+		m_SendBytesList[sessionIndex] += size;
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	bool ReplayNetwork::Run()
+	{
+		// 소켓이 없으므로 네트워크 스레드가 할 일은 없음
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		return false;
+	}
+
+	void ReplayNetwork::Release()
+	{
+		m_Reader.Close();
+	}
+
+	void ReplayNetwork::ForcingClose(const int32_t sessionIndex)
+	{
+		// 실제 끊김은 캡처에 기록된 kNTF_SYS_CLOSE_SESSION 으로 재생됨
+		++m_ForcingCloseCount;
+	}
+
+	RecvPacketInfo ReplayNetwork::GetPacketInfo()
+	{
+		if (m_HasNextRecord == false) {
+			if (m_IsStarted && m_IsFinished == false) {
+				ReportFinish();
+			}
+			return RecvPacketInfo();
+		}
+
+		if (m_IsStarted == false) {
+			m_IsStarted = true;
+			m_StartTime = std::chrono::steady_clock::now();
+		}
+
+		if (m_IsMaxSpeed == false && m_NextRecord.TimeMicroSec > GetElapsedMicroSec()) {
+			return RecvPacketInfo();
+		}
+
+		RecvPacketInfo packetInfo;
+		packetInfo.SessionIndex = m_NextRecord.SessionIndex;
+		packetInfo.PacketId = m_NextRecord.PacketId;
+		packetInfo.PacketBodySize = m_NextRecord.BodySize;
+		// 매핑된 파일 안을 가리키므로 복사 없이 넘김 (로직은 읽기만 함)
+		packetInfo.pRefData = (int8_t*)m_pNextBody;
+
+		m_LogicTimeMicroSec = std::max(m_LogicTimeMicroSec.load(), m_NextRecord.TimeMicroSec);
+
+		++m_ReplayPacketCount;
+		m_HasNextRecord = ReadNextRecord();
+		return packetInfo;
+	}
+
+	void ReplayNetwork::WaitPacketInfo(const uint32_t waitMicroSec)
+	{
+		int64_t sleepMicroSec = waitMicroSec;
+		if (m_HasNextRecord && m_IsStarted) {
+			sleepMicroSec = std::min<int64_t>(sleepMicroSec, m_NextRecord.TimeMicroSec - GetElapsedMicroSec());
+		}
+
+		if (sleepMicroSec > 0) {
+			std::this_thread::sleep_for(std::chrono::microseconds(sleepMicroSec));
+		}
+	}
+
+	std::chrono::steady_clock::time_point ReplayNetwork::GetLogicTime()
+	{
+		if (m_IsMaxSpeed == false) {
+			return std::chrono::steady_clock::now();
+		}
+
+		return m_LogicStartTime + std::chrono::microseconds(m_LogicTimeMicroSec.load());
+	}
+
+	bool ReplayNetwork::ReadNextRecord()
+	{
+		while (m_Reader.Next(m_NextRecord, m_pNextBody)) {
+			// 다른 설정(세션 수)으로 캡처한 파일이면 범위를 벗어난 세션은 건너뜀
+			if (m_NextRecord.SessionIndex >= 0 && m_NextRecord.SessionIndex < m_SessionPoolSize) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	int64_t ReplayNetwork::GetElapsedMicroSec() const
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_StartTime).count();
+	}
+
+	void ReplayNetwork::ReportFinish()
+	{
+		m_IsFinished = true;
+
+		auto elapsedMicroSec = std::max<int64_t>(1, GetElapsedMicroSec());
+
+		uint64_t sendPacketCount = 0;
+		uint64_t sendBytes = 0;
+		for (int32_t i = 0; i < m_SessionPoolSize; ++i) {
+			sendPacketCount += m_SendPacketCountList[i];
+			sendBytes += m_SendBytesList[i];
+		}
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 캡처 재생 완료. 패킷(%llu), 시간(%lldus), 초당 패킷(%.0f), 보낸 패킷(%llu), 보낸 바이트(%llu), 강제 종료 요청(%llu)",
+			__FUNCTION__, (unsigned long long)m_ReplayPacketCount, (long long)elapsedMicroSec, m_ReplayPacketCount * 1000000.0 / elapsedMicroSec,
+			(unsigned long long)sendPacketCount, (unsigned long long)sendBytes, (unsigned long long)m_ForcingCloseCount);
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <atomic>
+
+#include "interface_tcp_network.h"
+#include "packet_capture.h"
+
+namespace NServerNetLib
+{
+	// 소켓 없이 캡처 파일의 패킷을 로직 스레드에 그대로 넘겨주는 ITcpNetwork
+	// - 기록된 속도: 캡처 시점의 간격을 지켜서 넘김
+	// - 최대 속도: 기다리지 않고 바로 넘김 (로직 처리량 측정용)
+	// 보내는 패킷은 세션별 수/크기만 세고 버림
+	class ReplayNetwork : public ITcpNetwork
+	{
+	public:
+		ReplayNetwork() = default;
+		virtual ~ReplayNetwork() = default;
+
+		NET_ERROR_CODE Init(const ServerConfig* pConfig, ILog* pLogger) override;
+
+		NET_ERROR_CODE SendData(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pMsg) override;
+
+		NET_ERROR_CODE SendRawData(const int32_t sessionIndex, const char* pData, const int32_t size) override;
+
+		bool Run() override;
+
+		void Release() override;
+
+		void ForcingClose(const int32_t sessionIndex) override;
+
+		int32_t ClientSessionPoolSize() override { return m_SessionPoolSize; }
+
+		RecvPacketInfo GetPacketInfo() override;
+
+		void WaitPacketInfo(const uint32_t waitMicroSec) override;
+
+		// 최대 속도면 마지막으로 넘긴 레코드의 시간, 아니면 실제 시간
+		std::chrono::steady_clock::time_point GetLogicTime() override;
+
+		bool IsFinished() const { return m_IsFinished; }
+
+	private:
+		// 다음 레코드를 읽어 m_NextRecord 에 둠 (끝이면 false)
+		bool ReadNextRecord();
+
+		int64_t GetElapsedMicroSec() const;
+
+		void ReportFinish();
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+
+		PacketCaptureReader m_Reader;
+		bool m_IsMaxSpeed = false;
+		int32_t m_SessionPoolSize = 0;
+
+		bool m_HasNextRecord = false;
+		PacketCaptureRecord m_NextRecord;
+		const int8_t* m_pNextBody = nullptr;
+
+		bool m_IsStarted = false;
+		bool m_IsFinished = false;
+		std::chrono::steady_clock::time_point m_StartTime;
+
+		// 최대 속도 재생의 로직 시계 (Init 시간 + 마지막으로 넘긴 레코드의 시간)
+		std::chrono::steady_clock::time_point m_LogicStartTime;
+		std::atomic<int64_t> m_LogicTimeMicroSec = 0;
+
+		uint64_t m_ReplayPacketCount = 0;
+		uint64_t m_ForcingCloseCount = 0;
+		std::vector<uint64_t> m_SendPacketCountList;
+		std::vector<uint64_t> m_SendBytesList;
+	};
+}
@@ -21,11 +21,13 @@ namespace NServerNetLib
         kSEND_SIZE_ZERO = 22,
         kCLIENT_SEND_BUFFER_FULL = 23,
         kCLIENT_FLUSH_SEND_BUFF_REMOTE_CLOSE = 24,
+        kSEND_DROPPED_LAGGING = 25,
 
         // 수락(accept) 처리 관련 에러
         kACCEPT_API_ERROR = 26,
         kACCEPT_MAX_SESSION_COUNT = 27,
         kACCEPT_API_WSAEWOULDBLOCK = 28,
+        kACCEPT_SOCKET_OVER_FD_SETSIZE = 29,
 
         // 수신 관련 에러
         kRECV_API_ERROR = 32,
@@ -33,6 +35,40 @@ namespace NServerNetLib
         kRECV_REMOTE_CLOSE = 34,
         kRECV_PROCESS_NOT_CONNECTED = 35,
         kRECV_CLIENT_MAX_PACKET = 36,
+        kRECV_CLIENT_INVALID_PACKET_SIZE = 37,
+        kRECV_CLIENT_INVALID_PACKET_ID = 38,
+
+        // 패킷 캡처/재생/루프백 관련 에러
+        kCAPTURE_FILE_OPEN_FAIL = 41,
+        kLOOPBACK_SCRIPT_OPEN_FAIL = 42,
+        kLOOPBACK_SCRIPT_INVALID = 43,
+
+        // 무중단 재시작(소켓 넘겨주기) 관련 에러
+        kHANDOFF_NOT_SUPPORTED = 46,
+        kHANDOFF_CONNECT_FAIL = 47,
+        kHANDOFF_SEND_FAIL = 48,
+        kHANDOFF_RECV_FAIL = 49,
+        kHANDOFF_INVALID_STATE = 50,
+
+        // UDP 채널 관련 에러
+        kUDP_SOCKET_CREATE_FAIL = 51,
+        kUDP_SOCKET_BIND_FAIL = 52,
+        kUDP_NOT_BOUND = 53,
+        kUDP_PACKET_TOO_BIG = 54,
+        kUDP_RESEND_LIST_FULL = 55,
+
+        // 공유 메모리 전송(게이트웨이/로직 프로세스 분리) 관련 에러
+        kSHM_FILE_OPEN_FAIL = 61,
+        kSHM_INVALID_FILE = 62,
+        kSHM_INVALID_LOGIC_INDEX = 63,
+        kSHM_RING_FULL = 64,
+
+        // 클러스터(노드 사이 링크) 관련 에러
+        kCLUSTER_INVALID_CONFIG = 71,
+        kCLUSTER_LINK_LISTEN_FAIL = 72,
+        kCLUSTER_NODE_NOT_CONNECTED = 73,
+        kCLUSTER_LINK_BUFFER_FULL = 74,
+        kCLUSTER_NOT_ATTACHED = 75,
     };
 
     constexpr int MAX_NET_ERROR_STRING_LENGTH = 64;
@@ -0,0 +1,246 @@
+#include <cstring>
+
+#include "shm_gateway.h"
+
+namespace NServerNetLib
+{
+	namespace
+	{
+		// 한 번의 Run 에서 로직 하나의 송신 요청을 처리할 최대 수 (다른 로직과 받기 처리가 밀리지 않도록)
+		constexpr int MAX_SEND_RECORD_PER_RUN = 1024;
+
+		uint32_t RoundUpPowerOfTwo(const uint32_t value)
+		{
+			uint32_t result = 1;
+			while (result < value) {
+				result <<= 1;
+			}
+			return result;
+		}
+	}
+
+	NET_ERROR_CODE ShmGateway::Init(const ServerConfig* pConfig, ITcpNetwork* pTcpNetwork, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_pRefTcpNetwork = pTcpNetwork;
+
+		const auto logicCount = (int32_t)pConfig->ShmLogicCount;
+		const auto sessionPoolSize = pTcpNetwork->ClientSessionPoolSize();
+		m_RingSize = RoundUpPowerOfTwo(pConfig->ShmRingSizeKB * 1024);
+
+		if (m_File.OpenShared(pConfig->ShmFileName, ShmLayout::GetFileSize(logicCount, m_RingSize)) == false) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 공유 메모리 파일(%s) 만들기 실패", __FUNCTION__, pConfig->ShmFileName);
+			return NET_ERROR_CODE::kSHM_FILE_OPEN_FAIL;
+		}
+
+		auto pFileHeader = (ShmFileHeader*)m_File.GetData();
+		pFileHeader->Version = SHM_VERSION;
+		pFileHeader->SessionPoolSize = sessionPoolSize;
+		pFileHeader->LogicCount = logicCount;
+		pFileHeader->RingSize = m_RingSize;
+
+		for (int32_t i = 0; i < logicCount; ++i) {
+			auto pChannel = std::make_unique<LogicChannel>();
+			pChannel->pSlot = ShmLayout::AttachChannel(m_File.GetData(), m_RingSize, i, pChannel->RecvRing, pChannel->SendRing);
+			new (pChannel->pSlot) ShmLogicSlot();
+			pChannel->pSlot->AttachSeq.store(0, std::memory_order_relaxed);
+			pChannel->pSlot->ProcessId.store(0, std::memory_order_relaxed);
+			pChannel->RecvRing.Reset();
+			pChannel->SendRing.Reset();
+			m_ChannelList.push_back(std::move(pChannel));
+		}
+
+		// 나머지를 모두 채운 뒤에 써야 로직 프로세스가 반쯤 만든 파일에 붙지 않음
+		std::atomic_thread_fence(std::memory_order_release);
+		memcpy(pFileHeader->Magic, SHM_MAGIC, sizeof(pFileHeader->Magic));
+
+		m_IsConnectedList.assign(sessionPoolSize, false);
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 게이트웨이 시작. 파일(%s), 로직 프로세스(%d), 링(%uKB)", __FUNCTION__,
+			pConfig->ShmFileName, logicCount, m_RingSize / 1024);
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	void ShmGateway::Release()
+	{
+		if (m_File.IsOpened() == false) {
+			return;
+		}
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 게이트웨이 종료. 넘긴 패킷(%llu), 보낸 요청(%llu), 버린 패킷(%llu)", __FUNCTION__,
+			(unsigned long long)m_RecvCount, (unsigned long long)m_SendCount, (unsigned long long)m_DropCount);
+
+		m_ChannelList.clear();
+		m_File.Close(0);
+	}
+
+	bool ShmGateway::Run()
+	{
+		bool isWorked = false;
+		const auto logicCount = (int32_t)m_ChannelList.size();
+
+		for (int32_t i = 0; i < logicCount; ++i) {
+			auto& channel = *m_ChannelList[i];
+			CheckAttach(i, channel);
+
+			if (channel.PendingList.empty() == false) {
+				FlushPending(channel);
+				isWorked = true;
+			}
+		}
+
+		while (true) {
+			auto packetInfo = m_pRefTcpNetwork->GetPacketInfo();
+			if (packetInfo.PacketId == 0) {
+				break;
+			}
+
+			const auto sessionIndex = packetInfo.SessionIndex;
+			if (packetInfo.PacketId == (int16_t)PACKET_ID::kNTF_SYS_CONNECT_SESSION) {
+				m_IsConnectedList[sessionIndex] = true;
+			}
+			else if (packetInfo.PacketId == (int16_t)PACKET_ID::kNTF_SYS_CLOSE_SESSION) {
+				m_IsConnectedList[sessionIndex] = false;
+			}
+
+			PushRecvPacket(*m_ChannelList[sessionIndex % logicCount], sessionIndex, packetInfo.PacketId, packetInfo.PacketBodySize, packetInfo.pRefData);
+			isWorked = true;
+		}
+
+		for (auto& pChannel : m_ChannelList) {
+			if (ProcessSendRing(*pChannel)) {
+				isWorked = true;
+			}
+		}
+
+		return isWorked;
+	}
+
+	void ShmGateway::CheckAttach(const int32_t logicIndex, LogicChannel& channel)
+	{
+		const auto attachSeq = channel.pSlot->AttachSeq.load(std::memory_order_acquire);
+		if (attachSeq == channel.AttachSeq) {
+			return;
+		}
+		channel.AttachSeq = attachSeq;
+
+		// 이전 로직 프로세스에게 넘기려던 패킷은 새 로직 프로세스가 알 수 없는 상태이므로 버림 (링은 로직이 붙으면서 비움)
+		m_DropCount += channel.PendingList.size();
+		channel.PendingList.clear();
+		channel.PendingBytes = 0;
+
+		int32_t sessionCount = 0;
+		const auto logicCount = (int32_t)m_ChannelList.size();
+		for (int32_t i = logicIndex; i < (int32_t)m_IsConnectedList.size(); i += logicCount) {
+			if (m_IsConnectedList[i] == false) {
+				continue;
+			}
+
+			PushRecvPacket(channel, i, (int16_t)PACKET_ID::kNTF_SYS_CONNECT_SESSION, 0, nullptr);
+			++sessionCount;
+		}
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 로직 프로세스(%d) 연결. ProcessId(%d), 접속 중인 세션(%d)", __FUNCTION__,
+			logicIndex, channel.pSlot->ProcessId.load(std::memory_order_relaxed), sessionCount);
+	}
+
+	void ShmGateway::PushRecvPacket(LogicChannel& channel, const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody)
+	{
+		ShmPacketHeader header;
+		memset(&header, 0, sizeof(header));
+		header.SessionIndex = sessionIndex;
+		header.PacketId = packetId;
+		header.BodySize = bodySize > 0 ? bodySize : 0;
+		header.Command = kSHM_RECV;
+
+		if (channel.PendingList.empty() && channel.RecvRing.Write(header, (const char*)pBody)) {
+			++m_RecvCount;
+			return;
+		}
+
+		const bool isSystemPacket = packetId <= MAX_SYS_PACKET_ID;
+		if (isSystemPacket == false && channel.PendingBytes >= m_RingSize) {
+			++m_DropCount;
+			return;
+		}
+
+		PendingPacket pendingPacket;
+		pendingPacket.SessionIndex = sessionIndex;
+		pendingPacket.PacketId = packetId;
+		pendingPacket.Body.assign((const char*)pBody, (const char*)pBody + header.BodySize);
+		channel.PendingBytes += sizeof(ShmPacketHeader) + header.BodySize;
+		channel.PendingList.push_back(std::move(pendingPacket));
+	}
+
+	bool ShmGateway::FlushPending(LogicChannel& channel)
+	{
+		while (channel.PendingList.empty() == false) {
+			auto& pendingPacket = channel.PendingList.front();
+
+			ShmPacketHeader header;
+			memset(&header, 0, sizeof(header));
+			header.SessionIndex = pendingPacket.SessionIndex;
+			header.PacketId = pendingPacket.PacketId;
+			header.BodySize = (int32_t)pendingPacket.Body.size();
+			header.Command = kSHM_RECV;
+
+			if (channel.RecvRing.Write(header, pendingPacket.Body.data()) == false) {
+				return false;
+			}
+
+			++m_RecvCount;
+			channel.PendingBytes -= sizeof(ShmPacketHeader) + pendingPacket.Body.size();
+			channel.PendingList.pop_front();
+		}
+
+		return true;
+	}
+
+	bool ShmGateway::ProcessSendRing(LogicChannel& channel)
+	{
+		int processCount = 0;
+		for (; processCount < MAX_SEND_RECORD_PER_RUN; ++processCount) {
+			auto pHeader = channel.SendRing.Peek();
+			if (pHeader == nullptr) {
+				break;
+			}
+
+			auto pBody = (const char*)(pHeader + 1);
+			if (pHeader->SessionIndex < 0 || pHeader->SessionIndex >= (int32_t)m_IsConnectedList.size()) {
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 잘못된 세션 인덱스(%d)의 송신 요청", __FUNCTION__, pHeader->SessionIndex);
+				channel.SendRing.Pop();
+				continue;
+			}
+
+			switch (pHeader->Command)
+			{
+			case kSHM_SEND:
+				m_pRefTcpNetwork->SendData(pHeader->SessionIndex, pHeader->PacketId, (int16_t)pHeader->BodySize, pBody);
+				break;
+			case kSHM_SEND_RAW:
+				m_pRefTcpNetwork->SendRawData(pHeader->SessionIndex, pBody, pHeader->BodySize);
+				break;
+			case kSHM_FORCING_CLOSE:
+				m_pRefTcpNetwork->ForcingClose(pHeader->SessionIndex);
+				break;
+			case kSHM_LAGGING_DROP:
+				m_pRefTcpNetwork->SetLaggingDropPacket(pHeader->PacketId, pHeader->Flag != 0);
+				break;
+			case kSHM_CAPTURE_MASK:
+				if (pHeader->BodySize == sizeof(ShmCaptureMaskBody)) {
+					auto pMaskBody = (const ShmCaptureMaskBody*)pBody;
+					m_pRefTcpNetwork->SetCaptureMaskField(pHeader->PacketId, pMaskBody->Offset, pMaskBody->Size);
+				}
+				break;
+			default:
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 알 수 없는 송신 요청. Command(%d)", __FUNCTION__, (int)pHeader->Command);
+				break;
+			}
+
+			channel.SendRing.Pop();
+		}
+
+		m_SendCount += processCount;
+		return processCount > 0;
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+
+#include "interface_tcp_network.h"
+#include "packet_capture.h"
+#include "shm_transport.h"
+
+namespace NServerNetLib
+{
+	// 게이트웨이 프로세스: TcpNetwork 가 받은 패킷을 공유 메모리 링으로 로직 프로세스들에게 넘기고, 로직이 링에 쓴 송신 요청을 TcpNetwork 로 보냄
+	// - 세션은 (세션 인덱스 % ShmLogicCount) 번 로직 프로세스가 맡음 (로비/룸 상태는 로직 프로세스끼리 공유하지 않음)
+	// - 로직 프로세스가 다시 붙으면(재시작) 접속 중인 세션마다 kNTF_SYS_CONNECT_SESSION 을 다시 보냄. TCP 연결은 끊기지 않지만 로그인은 다시 해야 함
+	// - 링이 가득 차면 게이트웨이 안에 잠시 쌓아두고, 그것도 링 크기를 넘으면 클라이언트 패킷은 버림 (접속/끊김 같은 시스템 패킷은 항상 넘김)
+	// 게이트웨이 스레드: Run (TcpNetwork::Run 은 네트워크 스레드)
+	class ShmGateway
+	{
+		struct PendingPacket
+		{
+			int32_t SessionIndex = 0;
+			int16_t PacketId = 0;
+			std::vector<char> Body;
+		};
+
+		struct LogicChannel
+		{
+			ShmLogicSlot* pSlot = nullptr;
+			// 게이트웨이 → 로직
+			ShmRing RecvRing;
+			// 로직 → 게이트웨이
+			ShmRing SendRing;
+
+			uint32_t AttachSeq = 0;
+			// 링이 가득 차서 아직 넘기지 못한 패킷 (순서를 지키도록 이것부터 넘김)
+			std::deque<PendingPacket> PendingList;
+			uint64_t PendingBytes = 0;
+		};
+
+	public:
+		ShmGateway() = default;
+		~ShmGateway() = default;
+
+		// pTcpNetwork 는 Init 이 끝난 TcpNetwork
+		NET_ERROR_CODE Init(const ServerConfig* pConfig, ITcpNetwork* pTcpNetwork, ILog* pLogger);
+
+		void Release();
+
+		// 받은 패킷을 로직에게 넘기고 로직의 송신 요청을 처리 (처리한 것이 있으면 true)
+		bool Run();
+
+	private:
+		// 로직 프로세스가 새로 붙었으면 쌓인 패킷을 버리고 접속 중인 세션을 다시 알림
+		void CheckAttach(const int32_t logicIndex, LogicChannel& channel);
+
+		void PushRecvPacket(LogicChannel& channel, const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody);
+
+		// 쌓아둔 패킷을 링에 넣을 수 있는 만큼 넣음 (모두 넣었으면 true)
+		bool FlushPending(LogicChannel& channel);
+
+		bool ProcessSendRing(LogicChannel& channel);
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+		ITcpNetwork* m_pRefTcpNetwork = nullptr;
+
+		MappedFile m_File;
+		uint32_t m_RingSize = 0;
+		std::vector<std::unique_ptr<LogicChannel>> m_ChannelList;
+
+		// 로직 프로세스가 다시 붙었을 때 알려줄 접속 중인 세션
+		std::vector<bool> m_IsConnectedList;
+
+		uint64_t m_RecvCount = 0;
+		uint64_t m_SendCount = 0;
+		uint64_t m_DropCount = 0;
+	};
+}
@@ -0,0 +1,240 @@
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <thread>
+#include <chrono>
+
+#include "shm_network.h"
+
+namespace NServerNetLib
+{
+	namespace
+	{
+		// 보내기 링이 가득 찼을 때 게이트웨이가 비워주기를 기다리는 최대 시간
+		constexpr auto SEND_RING_WAIT_TIME = std::chrono::milliseconds(100);
+		// 받을 패킷을 확인하는 간격 (링에는 깨우는 수단이 없으므로 짧게 자면서 확인)
+		constexpr uint32_t RECV_POLL_MICROSEC = 50;
+	}
+
+	NET_ERROR_CODE ShmNetwork::Init(const ServerConfig* pConfig, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_IdleBlockMicroSec = pConfig->IdleBlockMicroSec;
+
+		if (m_File.OpenShared(pConfig->ShmFileName, 0) == false) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 공유 메모리 파일(%s) 열기 실패 (게이트웨이를 먼저 실행)", __FUNCTION__, pConfig->ShmFileName);
+			return NET_ERROR_CODE::kSHM_FILE_OPEN_FAIL;
+		}
+
+		auto pFileHeader = (const ShmFileHeader*)m_File.GetData();
+		if (m_File.GetSize() < sizeof(ShmFileHeader) || memcmp(pFileHeader->Magic, SHM_MAGIC, sizeof(SHM_MAGIC)) != 0
+			|| pFileHeader->Version != SHM_VERSION
+			|| m_File.GetSize() < ShmLayout::GetFileSize(pFileHeader->LogicCount, pFileHeader->RingSize)) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 공유 메모리 파일(%s) 형식이 다름", __FUNCTION__, pConfig->ShmFileName);
+			m_File.Close(0);
+			return NET_ERROR_CODE::kSHM_INVALID_FILE;
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		const auto logicIndex = (int32_t)pConfig->ShmLogicIndex;
+		if (logicIndex >= pFileHeader->LogicCount) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 로직 프로세스 번호(%d)가 게이트웨이의 로직 프로세스 수(%d)를 넘음", __FUNCTION__,
+				logicIndex, pFileHeader->LogicCount);
+			m_File.Close(0);
+			return NET_ERROR_CODE::kSHM_INVALID_LOGIC_INDEX;
+		}
+
+		m_SessionPoolSize = pFileHeader->SessionPoolSize;
+		m_pSlot = ShmLayout::AttachChannel(m_File.GetData(), pFileHeader->RingSize, logicIndex, m_RecvRing, m_SendRing);
+
+		// 이전 로직 프로세스가 남긴 패킷은 버리고 붙었다고 알림 (게이트웨이가 접속 중인 세션을 다시 알려줌)
+		m_RecvRing.Discard();
+#ifndef _WIN32
+		m_pSlot->ProcessId.store((int32_t)getpid(), std::memory_order_relaxed);
+#endif
+		m_pSlot->AttachSeq.fetch_add(1, std::memory_order_release);
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 게이트웨이에 연결. 파일(%s), 로직 프로세스(%d/%d), 세션 풀(%d)", __FUNCTION__,
+			pConfig->ShmFileName, logicIndex, pFileHeader->LogicCount, m_SessionPoolSize);
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	NET_ERROR_CODE ShmNetwork::SendData(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pMsg)
+	{
+		return WriteSendRing(kSHM_SEND, sessionIndex, packetId, bodySize, pMsg);
+	}
+
+	NET_ERROR_CODE ShmNetwork::SendRawData(const int32_t sessionIndex, const char* pData, const int32_t size)
+	{
+		if (size <= 0) {
+			return NET_ERROR_CODE::kSEND_SIZE_ZERO;
+		}
+
+		return WriteSendRing(kSHM_SEND_RAW, sessionIndex, 0, size, pData);
+	}
+
+	bool ShmNetwork::Run()
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds(m_IdleBlockMicroSec));
+		return false;
+	}
+
+	void ShmNetwork::Release()
+	{
+		if (m_File.IsOpened() == false) {
+			return;
+		}
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 게이트웨이 연결 종료. 송신 대기(%llu), 송신 실패(%llu)", __FUNCTION__,
+			(unsigned long long)m_SendWaitCount, (unsigned long long)m_SendFailCount);
+
+		m_pSlot = nullptr;
+		m_File.Close(0);
+	}
+
+	void ShmNetwork::ForcingClose(const int32_t sessionIndex)
+	{
+		WriteSendRing(kSHM_FORCING_CLOSE, sessionIndex, 0, 0, nullptr);
+	}
+
+	void ShmNetwork::SetCaptureMaskField(const int16_t packetId, const int16_t offset, const int16_t size)
+	{
+		ShmCaptureMaskBody body;
+		body.Offset = offset;
+		body.Size = size;
+		if (WriteSendRing(kSHM_CAPTURE_MASK, 0, packetId, sizeof(body), (const char*)&body) != NET_ERROR_CODE::kNONE) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 게이트웨이에 캡처 가림 설정을 넘기지 못함. PacketId(%d)", __FUNCTION__, packetId);
+		}
+	}
+
+	void ShmNetwork::SetLaggingDropPacket(const int16_t packetId, const bool isDrop)
+	{
+		// 바디 없이 Flag 로 켜고 끔을 전달 (돌려줄 결과가 없으므로 게이트웨이가 멈춰서 넣지 못하면 로그만 남김)
+		std::lock_guard<std::mutex> guard(m_SendLock);
+
+		ShmPacketHeader header;
+		memset(&header, 0, sizeof(header));
+		header.PacketId = packetId;
+		header.BodySize = 0;
+		header.Command = kSHM_LAGGING_DROP;
+		header.Flag = isDrop ? 1 : 0;
+
+		if (m_SendRing.Write(header, nullptr)) {
+			return;
+		}
+
+		++m_SendWaitCount;
+		auto endTime = std::chrono::steady_clock::now() + SEND_RING_WAIT_TIME;
+		while (m_SendRing.Write(header, nullptr) == false) {
+			if (std::chrono::steady_clock::now() >= endTime) {
+				++m_SendFailCount;
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 보내기 링이 가득 차서 설정을 전달하지 못함. 패킷ID(%d), 버림(%d)", __FUNCTION__, packetId, isDrop ? 1 : 0);
+				return;
+			}
+
+			std::this_thread::yield();
+		}
+	}
+
+	RecvPacketInfo ShmNetwork::GetPacketInfo()
+	{
+		// 지난번에 넘긴 레코드는 로직이 다 쓴 뒤이므로 이제 자리를 돌려줌
+		if (m_IsRecvPeeked) {
+			m_RecvRing.Pop();
+			m_IsRecvPeeked = false;
+		}
+
+		RecvPacketInfo packetInfo;
+
+		if (HasPostPacket()) {
+			std::lock_guard<std::mutex> guard(m_PostLock);
+			m_CurPost = std::move(m_PostList.front());
+			m_PostList.pop_front();
+
+			packetInfo = m_CurPost.PacketInfo;
+			packetInfo.pRefData = m_CurPost.Body.empty() ? nullptr : m_CurPost.Body.data();
+			return packetInfo;
+		}
+
+		auto pHeader = m_RecvRing.Peek();
+		if (pHeader == nullptr) {
+			return packetInfo;
+		}
+
+		m_IsRecvPeeked = true;
+		packetInfo.SessionIndex = pHeader->SessionIndex;
+		packetInfo.PacketId = pHeader->PacketId;
+		packetInfo.PacketBodySize = (int16_t)pHeader->BodySize;
+		packetInfo.pRefData = pHeader->BodySize > 0 ? (int8_t*)(pHeader + 1) : nullptr;
+		return packetInfo;
+	}
+
+	void ShmNetwork::WaitPacketInfo(const uint32_t waitMicroSec)
+	{
+		auto endTime = std::chrono::steady_clock::now() + std::chrono::microseconds(waitMicroSec);
+
+		while (m_RecvRing.IsEmpty() && HasPostPacket() == false) {
+			if (std::chrono::steady_clock::now() >= endTime) {
+				return;
+			}
+
+			std::this_thread::sleep_for(std::chrono::microseconds(RECV_POLL_MICROSEC));
+		}
+	}
+
+	void ShmNetwork::PostPacket(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody)
+	{
+		PostPacketData postData;
+		postData.PacketInfo.SessionIndex = sessionIndex;
+		postData.PacketInfo.PacketId = packetId;
+		postData.PacketInfo.PacketBodySize = bodySize;
+		if (bodySize > 0) {
+			postData.Body.assign(pBody, pBody + bodySize);
+		}
+
+		std::lock_guard<std::mutex> guard(m_PostLock);
+		m_PostList.push_back(std::move(postData));
+	}
+
+	NET_ERROR_CODE ShmNetwork::WriteSendRing(const SHM_COMMAND command, const int32_t sessionIndex, const int16_t packetId, const int32_t bodySize, const char* pBody)
+	{
+		ShmPacketHeader header;
+		memset(&header, 0, sizeof(header));
+		header.SessionIndex = sessionIndex;
+		header.PacketId = packetId;
+		header.BodySize = bodySize > 0 ? bodySize : 0;
+		header.Command = command;
+
+		if (header.BodySize > m_SendRing.GetMaxBodySize()) {
+			++m_SendFailCount;
+			return NET_ERROR_CODE::kCLIENT_SEND_BUFFER_FULL;
+		}
+
+		std::lock_guard<std::mutex> guard(m_SendLock);
+		if (m_SendRing.Write(header, pBody)) {
+			return NET_ERROR_CODE::kNONE;
+		}
+
+		// 게이트웨이가 잠깐 밀린 것이면 기다리고, 게이트웨이가 멈췄으면 버림
+		++m_SendWaitCount;
+		auto endTime = std::chrono::steady_clock::now() + SEND_RING_WAIT_TIME;
+		while (m_SendRing.Write(header, pBody) == false) {
+			if (std::chrono::steady_clock::now() >= endTime) {
+				++m_SendFailCount;
+				return NET_ERROR_CODE::kSHM_RING_FULL;
+			}
+
+			std::this_thread::yield();
+		}
+
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	bool ShmNetwork::HasPostPacket()
+	{
+		std::lock_guard<std::mutex> guard(m_PostLock);
+		return m_PostList.empty() == false;
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+
+#include "interface_tcp_network.h"
+#include "packet_capture.h"
+#include "shm_transport.h"
+
+namespace NServerNetLib
+{
+	// 로직 프로세스의 ITcpNetwork: 소켓 대신 게이트웨이(ShmGateway)와 공유하는 메모리 링으로 패킷을 주고받음
+	// - GetPacketInfo 는 받기 링 안의 레코드를 복사 없이 넘기고, 다음 GetPacketInfo 에서 자리를 돌려줌
+	// - SendData/SendRawData/ForcingClose 는 보내기 링에 요청으로 써서 게이트웨이가 TcpNetwork 로 처리 (링이 가득 차면 잠시 기다림)
+	// - PostPacket(UDP) 은 이 프로세스 안에서만 쓰는 큐로 받음
+	// 로직 스레드: GetPacketInfo/WaitPacketInfo, 로직 스레드/워커: SendData 등, UDP 스레드: PostPacket
+	class ShmNetwork : public ITcpNetwork
+	{
+		struct PostPacketData
+		{
+			RecvPacketInfo PacketInfo;
+			std::vector<int8_t> Body;
+		};
+
+	public:
+		ShmNetwork() = default;
+		virtual ~ShmNetwork() = default;
+
+		NET_ERROR_CODE Init(const ServerConfig* pConfig, ILog* pLogger) override;
+
+		NET_ERROR_CODE SendData(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pMsg) override;
+
+		NET_ERROR_CODE SendRawData(const int32_t sessionIndex, const char* pData, const int32_t size) override;
+
+		// 소켓은 게이트웨이가 처리하므로 네트워크 스레드는 기다리기만 함
+		bool Run() override;
+
+		void Release() override;
+
+		void ForcingClose(const int32_t sessionIndex) override;
+
+		void SetLaggingDropPacket(const int16_t packetId, const bool isDrop) override;
+
+		// 캡처는 게이트웨이가 하므로 그쪽으로 넘김
+		void SetCaptureMaskField(const int16_t packetId, const int16_t offset, const int16_t size) override;
+
+		int32_t ClientSessionPoolSize() override { return m_SessionPoolSize; }
+
+		RecvPacketInfo GetPacketInfo() override;
+
+		void WaitPacketInfo(const uint32_t waitMicroSec) override;
+
+		void PostPacket(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody) override;
+
+	private:
+		NET_ERROR_CODE WriteSendRing(const SHM_COMMAND command, const int32_t sessionIndex, const int16_t packetId, const int32_t bodySize, const char* pBody);
+
+		bool HasPostPacket();
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+
+		MappedFile m_File;
+		int32_t m_SessionPoolSize = 0;
+		uint32_t m_IdleBlockMicroSec = 0;
+
+		ShmLogicSlot* m_pSlot = nullptr;
+		ShmRing m_RecvRing;
+		ShmRing m_SendRing;
+
+		// GetPacketInfo 로 넘긴 링 레코드 (다음 GetPacketInfo 에서 Pop)
+		bool m_IsRecvPeeked = false;
+
+		// 보내기 링은 생산자가 하나여야 하므로 여러 로직 워커의 송신을 잠금으로 줄 세움
+		std::mutex m_SendLock;
+
+		std::mutex m_PostLock;
+		std::deque<PostPacketData> m_PostList;
+		// GetPacketInfo 로 넘긴 PostPacket (다음 GetPacketInfo 까지 바디 유지)
+		PostPacketData m_CurPost;
+
+		// 너무 큰 바디는 잠금 없이 실패로 세므로 atomic
+		std::atomic<uint64_t> m_SendWaitCount = 0;
+		std::atomic<uint64_t> m_SendFailCount = 0;
+	};
+}
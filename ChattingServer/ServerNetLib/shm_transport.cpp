@@ -0,0 +1,104 @@
+#include <cstring>
+#include <new>
+
+#include "shm_transport.h"
+
+namespace NServerNetLib
+{
+	void ShmRing::Attach(char* pBase, const uint32_t ringSize)
+	{
+		m_pHeader = (ShmRingHeader*)pBase;
+		m_pData = pBase + sizeof(ShmRingHeader);
+		m_Size = ringSize;
+		m_CachedReadPos = 0;
+		m_PeekNextPos = 0;
+	}
+
+	void ShmRing::Reset()
+	{
+		new (m_pHeader) ShmRingHeader();
+		m_pHeader->WritePos.store(0, std::memory_order_relaxed);
+		m_pHeader->ReadPos.store(0, std::memory_order_relaxed);
+	}
+
+	bool ShmRing::Write(const ShmPacketHeader& header, const char* pBody)
+	{
+		if (header.BodySize < 0 || header.BodySize > GetMaxBodySize()) {
+			return false;
+		}
+
+		const auto recordSize = GetRecordSize(header.BodySize);
+		auto writePos = m_pHeader->WritePos.load(std::memory_order_relaxed);
+		auto offset = writePos & (m_Size - 1);
+		const auto tailSize = m_Size - offset;
+		// 끝에 다 들어가지 않으면 남은 공간은 버리고 처음부터
+		const auto needSize = recordSize + (tailSize < recordSize ? tailSize : 0);
+
+		if (writePos + needSize - m_CachedReadPos > m_Size) {
+			m_CachedReadPos = m_pHeader->ReadPos.load(std::memory_order_acquire);
+			if (writePos + needSize - m_CachedReadPos > m_Size) {
+				return false;
+			}
+		}
+
+		if (tailSize < recordSize) {
+			auto pWrap = (ShmPacketHeader*)(m_pData + offset);
+			memset(pWrap, 0, sizeof(ShmPacketHeader));
+			pWrap->Command = kSHM_WRAP;
+			writePos += tailSize;
+			offset = 0;
+		}
+
+		memcpy(m_pData + offset, &header, sizeof(ShmPacketHeader));
+		if (header.BodySize > 0) {
+			memcpy(m_pData + offset + sizeof(ShmPacketHeader), pBody, header.BodySize);
+		}
+
+		// 레코드를 다 쓴 뒤에 위치를 올려야 읽는 쪽이 반쯤 쓴 레코드를 보지 않음
+		m_pHeader->WritePos.store(writePos + recordSize, std::memory_order_release);
+		return true;
+	}
+
+	const ShmPacketHeader* ShmRing::Peek()
+	{
+		auto readPos = m_pHeader->ReadPos.load(std::memory_order_relaxed);
+		const auto writePos = m_pHeader->WritePos.load(std::memory_order_acquire);
+		if (readPos == writePos) {
+			return nullptr;
+		}
+
+		auto offset = readPos & (m_Size - 1);
+		auto pHeader = (const ShmPacketHeader*)(m_pData + offset);
+		if (pHeader->Command == kSHM_WRAP) {
+			readPos += m_Size - offset;
+			pHeader = (const ShmPacketHeader*)m_pData;
+		}
+
+		m_PeekNextPos = readPos + GetRecordSize(pHeader->BodySize);
+		return pHeader;
+	}
+
+	void ShmRing::Pop()
+	{
+		m_pHeader->ReadPos.store(m_PeekNextPos, std::memory_order_release);
+	}
+
+	void ShmRing::Discard()
+	{
+		m_pHeader->ReadPos.store(m_pHeader->WritePos.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+	ShmLogicSlot* ShmLayout::AttachChannel(char* pData, const uint32_t ringSize, const int32_t logicIndex, ShmRing& recvRing, ShmRing& sendRing)
+	{
+		auto pBase = pData + sizeof(ShmFileHeader) + GetChannelSize(ringSize) * logicIndex;
+
+		auto pSlot = (ShmLogicSlot*)pBase;
+		pBase += sizeof(ShmLogicSlot);
+
+		recvRing.Attach(pBase, ringSize);
+		pBase += ShmRing::GetMemorySize(ringSize);
+
+		sendRing.Attach(pBase, ringSize);
+		return pSlot;
+	}
+}
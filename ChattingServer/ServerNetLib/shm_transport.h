@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+
+namespace NServerNetLib
+{
+	// 공유 메모리 링 레코드 종류
+	enum SHM_COMMAND : uint8_t
+	{
+		// 게이트웨이 → 로직: 받은 패킷 (접속/끊김/송신 버퍼 통보 같은 시스템 패킷 포함)
+		kSHM_RECV = 1,
+		// 로직 → 게이트웨이: ITcpNetwork 호출을 그대로 옮김
+		kSHM_SEND = 2,
+		kSHM_SEND_RAW = 3,
+		kSHM_FORCING_CLOSE = 4,
+		// Flag 가 0 이 아니면 버림
+		kSHM_LAGGING_DROP = 5,
+		// 바디(ShmCaptureMaskBody)의 범위를 캡처 파일에서 가림
+		kSHM_CAPTURE_MASK = 6,
+		// 링 끝에 남은 공간을 건너뛰고 처음부터 이어서 읽음
+		kSHM_WRAP = 0xFF,
+	};
+
+	// 링 레코드 하나 = 헤더 + 바디 (16 바이트 단위로 맞춤)
+	struct ShmPacketHeader
+	{
+		int32_t SessionIndex;
+		int32_t BodySize;
+		int16_t PacketId;
+		uint8_t Command;
+		// 명령마다 쓰는 값 (kSHM_LAGGING_DROP: 버릴지)
+		uint8_t Flag;
+		uint32_t Reserved2;
+	};
+	static_assert(sizeof(ShmPacketHeader) == 16, "ShmPacketHeader size");
+
+	struct ShmCaptureMaskBody
+	{
+		int16_t Offset;
+		int16_t Size;
+	};
+
+	constexpr char SHM_MAGIC[4] = { 'S', 'H', 'M', 'R' };
+	constexpr uint32_t SHM_VERSION = 1;
+	constexpr uint32_t SHM_RECORD_ALIGN = 16;
+
+	// 공유 파일 맨 앞에 한 번 (게이트웨이가 만들면서 채우고 Magic 을 마지막에 씀)
+	struct alignas(64) ShmFileHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		int32_t SessionPoolSize;
+		int32_t LogicCount;
+		uint32_t RingSize;
+	};
+
+	// 로직 프로세스마다 하나. 로직이 붙을 때마다 AttachSeq 를 올리면 게이트웨이가 접속 중인 세션을 다시 알려줌
+	struct alignas(64) ShmLogicSlot
+	{
+		std::atomic<uint32_t> AttachSeq;
+		std::atomic<int32_t> ProcessId;
+	};
+
+	struct alignas(64) ShmRingHeader
+	{
+		// 쓰는 쪽과 읽는 쪽이 서로 다른 캐시 라인을 씀
+		alignas(64) std::atomic<uint64_t> WritePos;
+		alignas(64) std::atomic<uint64_t> ReadPos;
+	};
+
+	// 공유 메모리 위의 단일 생산자/단일 소비자 바이트 링
+	// - 레코드는 링 안에 연속으로 쓰고, 읽는 쪽은 복사 없이 링 안을 가리키는 포인터로 읽은 뒤 Pop 으로 자리를 돌려줌
+	// - 위치는 계속 늘어나는 값이고 링 크기(2 의 거듭제곱)로 나눈 나머지가 실제 위치
+	// - 끝에 레코드가 다 들어가지 않으면 kSHM_WRAP 을 쓰고 처음부터 씀
+	class ShmRing
+	{
+	public:
+		// 링 헤더와 데이터 영역을 합친 크기
+		static uint64_t GetMemorySize(const uint32_t ringSize) { return sizeof(ShmRingHeader) + ringSize; }
+
+		void Attach(char* pBase, const uint32_t ringSize);
+
+		// 게이트웨이: 새로 만든 파일에서 위치를 0 으로
+		void Reset();
+
+		// 생산자: 링이 가득 찼거나 레코드가 너무 크면 false
+		bool Write(const ShmPacketHeader& header, const char* pBody);
+
+		// 소비자: 다음 레코드 (없으면 nullptr). 바디는 헤더 바로 뒤. Pop 전까지 유효
+		const ShmPacketHeader* Peek();
+
+		// 소비자: Peek 한 레코드 자리를 돌려줌
+		void Pop();
+
+		// 소비자: 쌓여 있는 레코드를 모두 버림 (로직 프로세스가 새로 붙을 때)
+		void Discard();
+
+		bool IsEmpty() const { return m_pHeader->ReadPos.load(std::memory_order_relaxed) == m_pHeader->WritePos.load(std::memory_order_acquire); }
+
+		uint64_t GetUsedSize() const { return m_pHeader->WritePos.load(std::memory_order_acquire) - m_pHeader->ReadPos.load(std::memory_order_acquire); }
+
+		// 한 레코드에 담을 수 있는 최대 바디 크기 (링의 1/4)
+		int32_t GetMaxBodySize() const { return (int32_t)(m_Size / 4 - sizeof(ShmPacketHeader)); }
+
+	private:
+		static uint64_t GetRecordSize(const int32_t bodySize)
+		{
+			return (sizeof(ShmPacketHeader) + (uint64_t)bodySize + SHM_RECORD_ALIGN - 1) & ~(uint64_t)(SHM_RECORD_ALIGN - 1);
+		}
+
+	private:
+		ShmRingHeader* m_pHeader = nullptr;
+		char* m_pData = nullptr;
+		uint32_t m_Size = 0;
+
+		// 생산자: 마지막으로 읽은 ReadPos (가득 찬 것 같을 때만 다시 읽음)
+		uint64_t m_CachedReadPos = 0;
+		// 소비자: Peek 한 레코드 다음 위치
+		uint64_t m_PeekNextPos = 0;
+	};
+
+	// 공유 파일 배치: [ShmFileHeader][로직 0: ShmLogicSlot, 받기 링, 보내기 링][로직 1: ...]
+	class ShmLayout
+	{
+	public:
+		static uint64_t GetChannelSize(const uint32_t ringSize) { return sizeof(ShmLogicSlot) + ShmRing::GetMemorySize(ringSize) * 2; }
+
+		static uint64_t GetFileSize(const int32_t logicCount, const uint32_t ringSize) { return sizeof(ShmFileHeader) + GetChannelSize(ringSize) * logicCount; }
+
+		// logicIndex 번째 로직 프로세스의 슬롯과 링을 연결
+		static ShmLogicSlot* AttachChannel(char* pData, const uint32_t ringSize, const int32_t logicIndex, ShmRing& recvRing, ShmRing& sendRing);
+	};
+}
@@ -10,9 +10,14 @@
 #include <sys/select.h>
 #include <sys/time.h>
 #include <sys/ioctl.h>
+#include <cerrno>
 #endif
 
+#include <cstring>
+#include <chrono>
+
 #include "interface_log.h"
+#include "metrics.h"
 #include "tcp_network.h"
 
 namespace NServerNetLib
@@ -43,6 +48,37 @@ namespace NServerNetLib
 
 		m_pRefLogger = pLogger;
 
+		m_ConnectLogLimiter.Init(m_Config.SessionLogPerSec, 1000, m_Config.SessionLogSampleRate);
+		m_AcceptRejectLogLimiter.Init(m_Config.SessionLogPerSec, 1000, m_Config.SessionLogSampleRate);
+
+		m_SendHighWaterSize = (int32_t)((int64_t)m_Config.MaxClientSendBufferSize * m_Config.SendBufferHighWaterPercent / 100);
+		m_SendLowWaterSize = (int32_t)((int64_t)m_Config.MaxClientSendBufferSize * m_Config.SendBufferLowWaterPercent / 100);
+
+		if (m_Config.CaptureFileName[0] != '\0') {
+			if (m_PacketCapture.Open(m_Config.CaptureFileName, (uint64_t)m_Config.CaptureMaxFileSizeMB * 1024 * 1024) == false) {
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 캡처 파일(%s) 열기 실패", __FUNCTION__, m_Config.CaptureFileName);
+				return NET_ERROR_CODE::kCAPTURE_FILE_OPEN_FAIL;
+			}
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 받은 패킷 캡처(%s, 최대 %uMB)", __FUNCTION__, m_Config.CaptureFileName, m_Config.CaptureMaxFileSizeMB);
+		}
+
+		// select 의 fd_set 에 넣을 수 있는 소켓은 FD_SETSIZE 까지이므로 세션 수를 그 안으로 제한
+		// (리슨 소켓, 표준 입출력, 로그/캡처 파일 등 다른 fd 몫을 남겨 둠)
+		auto maxSessionCount = (int32_t)(pConfig->MaxClientCount + pConfig->ExtraClientCount);
+		if (maxSessionCount > MAX_SELECT_SESSION_COUNT) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 세션 수(%d)가 select 한도를 넘어 %d 로 줄임 (FD_SETSIZE %d)", __FUNCTION__,
+				maxSessionCount, MAX_SELECT_SESSION_COUNT, (int32_t)FD_SETSIZE);
+			maxSessionCount = MAX_SELECT_SESSION_COUNT;
+		}
+
+		// 무중단 재시작: 리슨 소켓과 세션을 이전 프로세스에게서 받음
+		if (m_Config.IsHandoffReceive) {
+			FD_ZERO(&m_Readfds);
+			int32_t sessionPoolSize = CreateSessionPool(maxSessionCount);
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 세션 Pool 크기 : %d", __FUNCTION__, sessionPoolSize);
+			return HandoffReceive();
+		}
+
 		// 초기화 오류 감지
 		NET_ERROR_CODE initResult = InitServerSocket();
 		if (initResult != NET_ERROR_CODE::kNONE) {
@@ -60,7 +96,7 @@ namespace NServerNetLib
 		FD_SET(m_ServerSockFD, &m_Readfds);
 
 		// 세션풀 생성
-		int32_t sessionPoolSize = CreateSessionPool(pConfig->MaxClientCount + pConfig->ExtraClientCount);
+		int32_t sessionPoolSize = CreateSessionPool(maxSessionCount);
 
 		// __FUNCTION__ : 현재 함수의 이름을 문자열 리터럴로 제공하는 매크로
 		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 세션 Pool 크기 : %d", __FUNCTION__, sessionPoolSize);
@@ -77,6 +113,12 @@ namespace NServerNetLib
 			session.pRecvBuffer = new char[m_Config.MaxClientRecvBufferSize];
 			session.pSendBuffer = new char[m_Config.MaxClientSendBufferSize];
 
+			// 네트워크 스레드를 고정했으면 Init 을 그 CPU 에서 호출하므로, 지금 한 번 써서 페이지를 그 NUMA 노드에 잡아 둠 (first-touch)
+			if (m_Config.NetworkThreadCpu >= 0) {
+				memset(session.pRecvBuffer, 0, m_Config.MaxClientRecvBufferSize);
+				memset(session.pSendBuffer, 0, m_Config.MaxClientSendBufferSize);
+			}
+
 			m_ClientSessionPool.push_back(session);
 			m_ClientSessionPoolIndex.push_back(session.Index);
 		}
@@ -167,12 +209,25 @@ namespace NServerNetLib
 
 	NET_ERROR_CODE TcpNetwork::SendData(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pMsg)
 	{
+		// 로직 스레드에서 호출되므로 네트워크 스레드의 FlushSendBuff 와 동기화
+		std::lock_guard<std::mutex> guard(m_SendLock);
+
 		ClientSession& session = m_ClientSessionPool[sessionIndex];
+		if (session.IsConnected() == false) {
+			return NET_ERROR_CODE::kSEND_CLOSE_SOCKET;
+		}
+
+		// 느린 세션에게는 놓쳐도 되는 패킷을 복사하지 않음 (응답은 그대로 보냄)
+		if (session.IsSendLagging && packetId >= 0 && packetId < MAX_PACKET_ID && m_IsLaggingDropPacket[packetId]) {
+			Metrics::Local().AddSendLagDrop();
+			return NET_ERROR_CODE::kSEND_DROPPED_LAGGING;
+		}
 
 		// 버퍼 크기 확인
 		int32_t pos = session.SendSize;
 		int16_t totalSize = (int16_t)(bodySize + PACKET_HEADER_SIZE);
 		if ((pos + totalSize) > m_Config.MaxClientSendBufferSize) {
+			Metrics::Local().AddSendBufferFull();
 			return NET_ERROR_CODE::kCLIENT_SEND_BUFFER_FULL;
 		}
 
@@ -188,18 +243,65 @@ namespace NServerNetLib
 		// 버퍼가 합쳐진 길이를 적용
 		session.SendSize += totalSize;
 
+		Metrics::Local().AddSendPacket(packetId, totalSize);
+
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	NET_ERROR_CODE TcpNetwork::SendRawData(const int32_t sessionIndex, const char* pData, const int32_t size)
+	{
+		if (size <= 0) {
+			return NET_ERROR_CODE::kSEND_SIZE_ZERO;
+		}
+
+		std::lock_guard<std::mutex> guard(m_SendLock);
+
+		ClientSession& session = m_ClientSessionPool[sessionIndex];
+		if (session.IsConnected() == false) {
+			return NET_ERROR_CODE::kSEND_CLOSE_SOCKET;
+		}
+
+		// 묶음 일부만 들어가면 패킷이 잘리므로 전부 들어갈 때만 복사
+		if ((session.SendSize + size) > m_Config.MaxClientSendBufferSize) {
+			Metrics::Local().AddSendBufferFull();
+			return NET_ERROR_CODE::kCLIENT_SEND_BUFFER_FULL;
+		}
+
+		memcpy(&session.pSendBuffer[session.SendSize], pData, size);
+		session.SendSize += size;
+
+		// 묶음 안의 헤더를 따라가며 패킷 ID 별로 집계
+		auto& metrics = Metrics::Local();
+		for (int32_t pos = 0; pos + PACKET_HEADER_SIZE <= size;) {
+			auto pHeader = (const PacketHeader*)&pData[pos];
+			if (pHeader->TotalSize < PACKET_HEADER_SIZE) {
+				break;
+			}
+			metrics.AddSendPacket(pHeader->Id, pHeader->TotalSize);
+			pos += pHeader->TotalSize;
+		}
+
 		return NET_ERROR_CODE::kNONE;
 	}
 
 
-	void TcpNetwork::Run()
+	bool TcpNetwork::Run()
 	{
+		// 로직 스레드가 요청한 강제 종료를 먼저 처리
+		RunForcingClose();
+
 		// 원본 m_Readfds를 직접 넘기면 감시할 소켓 집합이 select 호출에 의해 변경되어버림
 		fd_set read_set = m_Readfds;
-		fd_set write_set = m_Readfds;
+		// 모든 소켓을 쓰기 감시하면 select 가 항상 바로 반환되므로 보낼 데이터가 있는 소켓만 감시
+		fd_set write_set;
+		RunBuildWriteSet(write_set);
 
-		// 대기시간 1000 micro second => 1 milli second
-		timeval timeout{ 0, 1000 };
+		// kBLOCK 일 때만 설정된 시간 동안 블록, 나머지는 바로 반환(polling)
+		timeval timeout{ 0, 0 };
+		if (m_Config.IdleStrategy == IDLE_STRATEGY::kBLOCK) {
+			timeout.tv_sec = m_Config.IdleBlockMicroSec / 1000000;
+			timeout.tv_usec = m_Config.IdleBlockMicroSec % 1000000;
+		}
 		// 다수의 소켓 파일 디스크립터 상태를 검사(select)
 #ifdef _WIN32
 		int32_t selectResult = select(0, &read_set, &write_set, 0, &timeout);
@@ -208,7 +310,7 @@ namespace NServerNetLib
 #endif
 		bool isFDSetChanged = RunCheckSelectResult(selectResult);
 		if (isFDSetChanged == false) {
-			return;
+			return false;
 		}
 
 		// 검사 성공 후 fd_set 집합 안에 특정 fd가 있는지 확인
@@ -217,10 +319,13 @@ namespace NServerNetLib
 		}
 
 		RunCheckSelectClients(read_set, write_set);
+		return true;
 	}
 
 	void TcpNetwork::Release()
 	{
+		m_PacketCapture.Close();
+
 #ifdef _WIN32
 		// 윈속 리소스를 해제하고 사용을 종료
 		WSACleanup();
@@ -228,24 +333,114 @@ namespace NServerNetLib
 	}
 
 
-	void TcpNetwork::ForcingClose(const int32_t sessionIndex)
+	void TcpNetwork::SetLaggingDropPacket(const int16_t packetId, const bool isDrop)
 	{
-		if (m_ClientSessionPool[sessionIndex].IsConnected() == false) {
+		if (packetId < 0 || packetId >= MAX_PACKET_ID) {
 			return;
 		}
 
-		CloseSession(SOCKET_CLOSE_CASE::kFORCING_CLOSE, m_ClientSessionPool[sessionIndex].SocketFD, sessionIndex);
+		m_IsLaggingDropPacket[packetId] = isDrop;
+	}
+
+	void TcpNetwork::ForcingClose(const int32_t sessionIndex)
+	{
+		// 요청 시점의 Seq 를 같이 기록해서, 그 사이 재사용된 세션을 닫지 않도록 함
+		int64_t seq = 0;
+		{
+			std::lock_guard<std::mutex> guard(m_SendLock);
+			if (m_ClientSessionPool[sessionIndex].IsConnected() == false) {
+				return;
+			}
+			seq = m_ClientSessionPool[sessionIndex].Seq;
+		}
+
+		std::lock_guard<std::mutex> guard(m_ForcingCloseLock);
+		m_ForcingCloseQueue.emplace_back(sessionIndex, seq);
+	}
+
+	void TcpNetwork::RunForcingClose()
+	{
+		{
+			std::lock_guard<std::mutex> guard(m_ForcingCloseLock);
+			if (m_ForcingCloseQueue.empty()) {
+				return;
+			}
+			m_ForcingCloseList.swap(m_ForcingCloseQueue);
+		}
+
+		for (auto& request : m_ForcingCloseList) {
+			ClientSession& session = m_ClientSessionPool[request.first];
+			if (session.IsConnected() == false || session.Seq != request.second) {
+				continue;
+			}
+
+			CloseSession(SOCKET_CLOSE_CASE::kFORCING_CLOSE, static_cast<SOCKET>(session.SocketFD), request.first);
+		}
+		m_ForcingCloseList.clear();
+	}
+
+	void TcpNetwork::RunBuildWriteSet(fd_set& write_set)
+	{
+		FD_ZERO(&write_set);
+
+		std::lock_guard<std::mutex> guard(m_SendLock);
+		for (auto& session : m_ClientSessionPool) {
+			if (session.IsConnected() == false) {
+				continue;
+			}
+
+			// 받지 않는 클라이언트는 쓰기 가능 상태가 되지 않으므로 고수위는 여기서 확인
+			if (m_SendHighWaterSize > 0 && session.IsSendLagging == false && session.SendSize >= m_SendHighWaterSize) {
+				session.IsSendLagging = true;
+				AddPacketQueue(session.Index, (int16_t)PACKET_ID::kNTF_SYS_SEND_BUFFER_HIGH, 0, nullptr);
+			}
+
+			if (session.SendSize > 0) {
+				FD_SET(static_cast<SOCKET>(session.SocketFD), &write_set);
+			}
+		}
 	}
 
 	RecvPacketInfo TcpNetwork::GetPacketInfo()
 	{
-		RecvPacketInfo packetInfo;
-		if (m_PacketQueue.empty() == false) {
-			packetInfo = m_PacketQueue.front();
-			m_PacketQueue.pop_front();
+		// 읽는 큐를 다 처리했으면 네트워크 스레드가 채운 큐와 교체
+		if (m_ReadPacketPos >= m_ReadPacketQueue.size()) {
+			m_ReadPacketQueue.clear();
+			m_ReadPacketDataQueue.clear();
+			m_ReadPacketPos = 0;
+
+			{
+				std::lock_guard<std::mutex> guard(m_PacketQueueLock);
+				m_PacketQueue.swap(m_ReadPacketQueue);
+				m_PacketDataQueue.swap(m_ReadPacketDataQueue);
+			}
+			Metrics::Instance().SetPacketQueueDepth(0);
+
+			// 바디는 도착 순서대로 이어 붙여 두었으므로 앞에서부터 위치를 계산
+			int8_t* pData = m_ReadPacketDataQueue.data();
+			for (auto& packetInfo : m_ReadPacketQueue) {
+				packetInfo.pRefData = packetInfo.PacketBodySize > 0 ? pData : nullptr;
+				pData += packetInfo.PacketBodySize;
+			}
 		}
 
-		return packetInfo;
+		if (m_ReadPacketPos >= m_ReadPacketQueue.size()) {
+			return RecvPacketInfo();
+		}
+
+		// pRefData 는 다음 교체 전까지, 즉 큐의 패킷을 모두 꺼낼 때까지 유효
+		return m_ReadPacketQueue[m_ReadPacketPos++];
+	}
+
+	void TcpNetwork::WaitPacketInfo(const uint32_t waitMicroSec)
+	{
+		if (m_ReadPacketPos < m_ReadPacketQueue.size()) {
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(m_PacketQueueLock);
+		m_PacketQueueCV.wait_for(lock, std::chrono::microseconds(waitMicroSec),
+			[this]() { return m_PacketQueue.empty() == false; });
 	}
 
 	bool TcpNetwork::RunCheckSelectResult(const int32_t result)
@@ -370,24 +565,37 @@ namespace NServerNetLib
 		const int32_t dataSize = session.RemainingDataSize;
 		int32_t readPos = 0;
 		PacketHeader* pPktHeader;
+		auto& metrics = Metrics::Local();
 
 		while ((dataSize - readPos) >= PACKET_HEADER_SIZE) {
 			pPktHeader = (PacketHeader*)&session.pRecvBuffer[readPos];
 			readPos += PACKET_HEADER_SIZE;
 
 			int16_t bodySize = (int16_t)(pPktHeader->TotalSize - PACKET_HEADER_SIZE);
+			// 헤더보다 작은 크기는 잘못된 패킷 (음수 크기로 readPos 가 되돌아가는 것 방지)
+			if (bodySize < 0) {
+				return NET_ERROR_CODE::kRECV_CLIENT_INVALID_PACKET_SIZE;
+			}
+
 			if (bodySize > 0) {
+				// 최대 크기 검사를 먼저 해야 다 받을 수 없는 패킷을 계속 기다리지 않음
+				if (bodySize > MAX_PACKET_BODY_SIZE) {
+					return NET_ERROR_CODE::kRECV_CLIENT_MAX_PACKET;
+				}
+
 				if (bodySize > (dataSize - readPos)) {
 					readPos -= PACKET_HEADER_SIZE;
 					break;
 				}
+			}
 
-				if (bodySize > MAX_PACKET_BODY_SIZE) {
-					return NET_ERROR_CODE::kRECV_CLIENT_MAX_PACKET;
-				}
+			// 시스템 패킷 ID(접속/끊김 알림 등)는 네트워크 쪽에서만 만들므로 클라이언트가 보내면 끊음
+			if (pPktHeader->Id <= MAX_SYS_PACKET_ID || pPktHeader->Id >= MAX_PACKET_ID) {
+				return NET_ERROR_CODE::kRECV_CLIENT_INVALID_PACKET_ID;
 			}
-			
-			AddPacketQueue(sessionIndex, pPktHeader->Id, bodySize, &session.pRecvBuffer[readPos]);
+
+			AddPacketQueue(sessionIndex, pPktHeader->Id, bodySize, (int8_t*)&session.pRecvBuffer[readPos]);
+			metrics.AddRecvPacket(pPktHeader->Id, PACKET_HEADER_SIZE + bodySize);
 			readPos += bodySize;
 		}
 
@@ -400,6 +608,8 @@ namespace NServerNetLib
 	// 버퍼에 있는 내용을 즉시 출력 장치(파일, 화면, 네트워크 등)로 밀어내서 반영
 	NetError TcpNetwork::FlushSendBuff(const int32_t sessionIndex)
 	{
+		std::lock_guard<std::mutex> guard(m_SendLock);
+
 		ClientSession& session = m_ClientSessionPool[sessionIndex];
 		if (session.IsConnected() == false) {
 			return NetError(NET_ERROR_CODE::kCLIENT_FLUSH_SEND_BUFF_REMOTE_CLOSE);
@@ -424,6 +634,11 @@ namespace NServerNetLib
 			session.SendSize = 0;
 		}
 
+		if (session.IsSendLagging && session.SendSize <= m_SendLowWaterSize) {
+			session.IsSendLagging = false;
+			AddPacketQueue(sessionIndex, (int16_t)PACKET_ID::kNTF_SYS_SEND_BUFFER_LOW, 0, nullptr);
+		}
+
 		return result;
 	}
 
@@ -437,7 +652,12 @@ namespace NServerNetLib
 		}
 
 		// TCP 소켓을 통해 데이터를 전송
+#ifdef _WIN32
 		result.Value = send(fd, pMsg, size, 0);
+#else
+		// 클라이언트가 끊은(RST) 소켓에 보내도 SIGPIPE 로 프로세스가 죽지 않고 에러로 돌아오도록
+		result.Value = send(fd, pMsg, size, MSG_NOSIGNAL);
+#endif
 		if (result.Value <= 0) {
 			result.Error = NET_ERROR_CODE::kSEND_SIZE_ZERO;
 		}
@@ -447,6 +667,18 @@ namespace NServerNetLib
 
 	void TcpNetwork::CloseSession(const SOCKET_CLOSE_CASE closeCase, const SOCKET sockFD, const int32_t sessionIndex)
 	{
+		Metrics::Local().AddClose(closeCase);
+
+		// 세션 할당 전의 소켓은 세션 인덱스가 없으므로(-1) 소켓만 닫음
+		if (closeCase == SOCKET_CLOSE_CASE::kSESSION_POOL_EMPTY) {
+#ifdef _WIN32
+			closesocket(sockFD);
+#else
+			close(sockFD);
+#endif
+			return;
+		}
+
 		if (m_ClientSessionPool[sessionIndex].IsConnected() == false) {
 			return;
 		}
@@ -458,12 +690,9 @@ namespace NServerNetLib
 #endif
 		FD_CLR(sockFD, &m_Readfds);
 
-		if (closeCase == SOCKET_CLOSE_CASE::kSESSION_POOL_EMPTY) {
-			return;
-		}
-
 		ReleaseSessionIndex(sessionIndex);
 		--m_ConnectedSessionCount;
+		Metrics::Instance().SetConnectedSessionCount(m_ConnectedSessionCount);
 
 		AddPacketQueue(sessionIndex, (int16_t)PACKET_ID::kNTF_SYS_CLOSE_SESSION, 0, nullptr);
 	}
@@ -472,19 +701,52 @@ namespace NServerNetLib
 	{
 		// '재사용 가능한 인덱스 목록'에 추가
 		m_ClientSessionPoolIndex.push_back(index);
-		// 세션 초기화
+		// 세션 초기화 (로직 스레드의 SendData 가 보는 값이므로 잠금)
+		std::lock_guard<std::mutex> guard(m_SendLock);
 		m_ClientSessionPool[index].Clear();
 	}
 
 	void TcpNetwork::AddPacketQueue(const int32_t sessionIndex, const int16_t pktId, const int16_t bodySize, int8_t* pDataPos)
+	{
+		if (m_PacketCapture.IsOpened() && m_PacketCapture.Write(sessionIndex, pktId, bodySize, pDataPos) == false) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 캡처 파일이 가득 차서 기록을 멈춤", __FUNCTION__);
+			m_PacketCapture.Close();
+		}
+
+		PushPacketQueue(sessionIndex, pktId, bodySize, pDataPos);
+	}
+
+	void TcpNetwork::PostPacket(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody)
+	{
+		// 캡처 파일은 네트워크 스레드만 쓰므로 다른 전송에서 받은 패킷은 기록하지 않음
+		PushPacketQueue(sessionIndex, packetId, bodySize, pBody);
+	}
+
+	void TcpNetwork::PushPacketQueue(const int32_t sessionIndex, const int16_t pktId, const int16_t bodySize, const int8_t* pDataPos)
 	{
 		RecvPacketInfo packetInfo;
 		packetInfo.SessionIndex = sessionIndex;
 		packetInfo.PacketId = pktId;
 		packetInfo.PacketBodySize = bodySize;
-		packetInfo.pRefData = pDataPos;
+		// 실제 위치는 로직 스레드가 꺼낼 때(GetPacketInfo) 계산
+		packetInfo.pRefData = nullptr;
+
+		bool isWasEmpty = false;
+		{
+			std::lock_guard<std::mutex> guard(m_PacketQueueLock);
+			isWasEmpty = m_PacketQueue.empty();
 
-		m_PacketQueue.push_back(packetInfo);
+			m_PacketQueue.push_back(packetInfo);
+			if (bodySize > 0) {
+				m_PacketDataQueue.insert(m_PacketDataQueue.end(), pDataPos, pDataPos + bodySize);
+			}
+			Metrics::Instance().SetPacketQueueDepth(m_PacketQueue.size());
+		}
+
+		// 비어 있다가 처음 들어온 패킷일 때만 대기 중인 로직 스레드를 깨움
+		if (isWasEmpty) {
+			m_PacketQueueCV.notify_one();
+		}
 	}
 
 	NET_ERROR_CODE TcpNetwork::NewSession()
@@ -500,7 +762,7 @@ namespace NServerNetLib
 			SOCKET client_sockFD = accept(m_ServerSockFD, (struct sockaddr*)&client_adr, &client_len);
 #else
 			int32_t client_len = sizeof(client_adr);
-			SOCKET client_sockFD = accpet(m_ServerSockFD, (struct sockaddr*)&client_adr, (socklen_t*)&client_len);
+			SOCKET client_sockFD = accept(m_ServerSockFD, (struct sockaddr*)&client_adr, (socklen_t*)&client_len);
 #endif
 			if (client_sockFD == INVALID_SOCKET) {
 #ifdef _WIN32
@@ -508,19 +770,39 @@ namespace NServerNetLib
 				if (netError == WSAEWOULDBLOCK) {
 #else 
 				int32_t netError = errno;
-				if (netError == EAGAIN && netError == EWOULDBLOCK) {
+				if (netError == EAGAIN || netError == EWOULDBLOCK) {
 #endif
 					return NET_ERROR_CODE::kACCEPT_API_WSAEWOULDBLOCK;
 				}
 
 				m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 잘못된 소켓 등록", __FUNCTION__);
+				Metrics::Local().AddAcceptReject(NET_ERROR_CODE::kACCEPT_API_ERROR);
 				return NET_ERROR_CODE::kACCEPT_API_ERROR;
 			}
 
+#ifndef _WIN32
+			// 리눅스의 fd_set 은 소켓 번호를 비트 위치로 쓰므로 FD_SETSIZE 이상인 소켓을 넣으면 메모리를 넘어 씀
+			// (세션 수를 줄여도 다른 파일/소켓이 번호를 먼저 차지할 수 있음)
+			if (client_sockFD >= FD_SETSIZE) {
+				uint32_t suppressedCount = 0;
+				if (m_AcceptRejectLogLimiter.Allow(suppressedCount)) {
+					m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 클라이언트 소켓(%d)이 FD_SETSIZE(%d) 이상. 생략된 로그(%u)", __FUNCTION__, client_sockFD, (int32_t)FD_SETSIZE, suppressedCount);
+				}
+
+				Metrics::Local().AddAcceptReject(NET_ERROR_CODE::kACCEPT_SOCKET_OVER_FD_SETSIZE);
+				CloseSession(SOCKET_CLOSE_CASE::kSESSION_POOL_EMPTY, client_sockFD, -1);
+				return NET_ERROR_CODE::kACCEPT_SOCKET_OVER_FD_SETSIZE;
+			}
+#endif
+
 			int32_t newSessionIndex = AllocClientSessionIndex();
 			if (newSessionIndex < 0) {
-				m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 클라이언트 소켓(%I64u) 세션 최대치", __FUNCTION__, client_sockFD);
+				uint32_t suppressedCount = 0;
+				if (m_AcceptRejectLogLimiter.Allow(suppressedCount)) {
+					m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 클라이언트 소켓(%I64u) 세션 최대치. 생략된 로그(%u)", __FUNCTION__, client_sockFD, suppressedCount);
+				}
 			
+				Metrics::Local().AddAcceptReject(NET_ERROR_CODE::kACCEPT_MAX_SESSION_COUNT);
 				CloseSession(SOCKET_CLOSE_CASE::kSESSION_POOL_EMPTY, client_sockFD, -1);
 				return NET_ERROR_CODE::kACCEPT_MAX_SESSION_COUNT;
 			}
@@ -578,15 +860,24 @@ namespace NServerNetLib
 		++m_ConnectSeq;
 
 		// m_ClientSessionPool 에 있는 세션에 정보 업데이트
-		ClientSession& session = m_ClientSessionPool[sessionIndex];
-		session.Seq = m_ConnectSeq;
-		session.SocketFD = fd;
-		memcpy(session.IP, pIP, MAX_IP_LEN - 1);
+		{
+			std::lock_guard<std::mutex> guard(m_SendLock);
+			ClientSession& session = m_ClientSessionPool[sessionIndex];
+			session.Seq = m_ConnectSeq;
+			session.SocketFD = fd;
+			memcpy(session.IP, pIP, MAX_IP_LEN - 1);
+		}
 
 		++m_ConnectedSessionCount;
+		Metrics::Local().AddAccept();
+		Metrics::Instance().SetConnectedSessionCount(m_ConnectedSessionCount);
 
 		AddPacketQueue(sessionIndex, (int16_t)PACKET_ID::kNTF_SYS_CONNECT_SESSION, 0, nullptr);
-		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 새로운 세션 소켓(%I64u), m_ConnectSeq(%d), IP(%s)", __FUNCTION__, fd, m_ConnectSeq, pIP);
+
+		uint32_t suppressedCount = 0;
+		if (m_pRefLogger->IsEnabled(LOG_LEVEL::kL_INFO) && m_ConnectLogLimiter.Allow(suppressedCount)) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 새로운 세션 소켓(%I64u), m_ConnectSeq(%d), IP(%s), 생략된 로그(%u)", __FUNCTION__, fd, m_ConnectSeq, pIP, suppressedCount);
+		}
 	}
 	
 }
@@ -19,10 +19,19 @@
 
 #include <vector>
 #include <deque>
+#include <mutex>
+#include <condition_variable>
 #include "interface_tcp_network.h"
+#include "log_rate_limiter.h"
+#include "packet_capture.h"
 
 namespace NServerNetLib
 {
+	struct HandoffSessionState;
+
+	// select 로 다룰 수 있는 최대 세션 수 (FD_SETSIZE 에서 리슨 소켓과 다른 fd 몫을 뺀 값)
+	constexpr int32_t MAX_SELECT_SESSION_COUNT = FD_SETSIZE - 32;
+
 	class TcpNetwork : public ITcpNetwork
 	{
 	public:
@@ -34,14 +43,28 @@ namespace NServerNetLib
 		NET_ERROR_CODE SendData(const int32_t sessionIndex, const int16_t packetId,
 			const int16_t bodySize, const char* pMsg) override;
 
-		void Run() override;
+		NET_ERROR_CODE SendRawData(const int32_t sessionIndex, const char* pData, const int32_t size) override;
+
+		bool Run() override;
 
 		void Release() override;
 
 		void ForcingClose(const int32_t sessionIndex) override;
 
+		void SetLaggingDropPacket(const int16_t packetId, const bool isDrop) override;
+
+		void SetCaptureMaskField(const int16_t packetId, const int16_t offset, const int16_t size) override { m_PacketCapture.SetMaskField(packetId, offset, size); }
+
+		NET_ERROR_CODE HandoffSend(const std::vector<HandoffSessionInfo>& userTagList) override;
+
+		const std::vector<HandoffSessionInfo>& GetHandoffSessionList() override { return m_HandoffSessionList; }
+
 		RecvPacketInfo GetPacketInfo() override;
 
+		void WaitPacketInfo(const uint32_t waitMicroSec) override;
+
+		void PostPacket(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const int8_t* pBody) override;
+
 		int32_t ClientSessionPoolSize() override { return (int32_t)m_ClientSessionPool.size(); }		
 
 	// 메서드 구역
@@ -63,11 +86,20 @@ namespace NServerNetLib
 		NET_ERROR_CODE RecvSocket(const int32_t sessionIndex);
 		NET_ERROR_CODE RecvBufferProcess(const int32_t sessionIndex);
 		void AddPacketQueue(const int32_t sessionIndex, const int16_t pktId, const int16_t bodySize, int8_t* pDataPos);
+		void PushPacketQueue(const int32_t sessionIndex, const int16_t pktId, const int16_t bodySize, const int8_t* pDataPos);
 
 		void RunProcessWrite(const int32_t sessionIndex, const SOCKET fd, fd_set& write_set);
 		NetError FlushSendBuff(const int32_t sessionIndex);
 		NetError SendSocket(const SOCKET fd, const char* pMsg, const int32_t size);
 
+		void RunForcingClose();
+
+		// 이전 프로세스가 넘겨주는 리슨 소켓과 세션을 받아서 세션 풀에 넣음 (tcp_network_handoff.cpp)
+		NET_ERROR_CODE HandoffReceive();
+		bool InstallHandoffSession(const SOCKET fd, const HandoffSessionState& state, const char* pRecvData, const char* pSendData);
+		// 넘겨받기에 실패하면 넣은 세션과 리슨 소켓을 모두 닫음
+		void AbortHandoffReceive();
+		void RunBuildWriteSet(fd_set& write_set);
 		bool RunCheckSelectResult(const int32_t result);
 		void RunCheckSelectClients(fd_set& read_set, fd_set& wrtie_set);
 		bool RunProcessReceive(const int32_t sessionIndex, const SOCKET fd, fd_set& read_set);
@@ -88,9 +120,43 @@ namespace NServerNetLib
 		std::vector<ClientSession>m_ClientSessionPool;
 		std::deque<int> m_ClientSessionPoolIndex;
 
-		std::deque<RecvPacketInfo> m_PacketQueue;
+		// 네트워크 스레드가 채우는 큐와 로직 스레드가 읽는 큐를 나눠두고, 다 읽으면 서로 교체(swap)
+		// 받은 버퍼(pRecvBuffer)는 다음 recv 에서 덮어써지므로 바디는 m_PacketDataQueue 에 복사해 둠
+		std::mutex m_PacketQueueLock;
+		std::condition_variable m_PacketQueueCV;
+		std::vector<RecvPacketInfo> m_PacketQueue;
+		std::vector<int8_t> m_PacketDataQueue;
+
+		std::vector<RecvPacketInfo> m_ReadPacketQueue;
+		std::vector<int8_t> m_ReadPacketDataQueue;
+		size_t m_ReadPacketPos = 0;
+
+		// 로직 스레드의 SendData 와 네트워크 스레드의 FlushSendBuff 가 같은 송신 버퍼를 사용
+		// 고수위/저수위 알림은 이 잠금 안에서 큐에 넣으므로 잠금 순서는 m_SendLock → m_PacketQueueLock
+		std::mutex m_SendLock;
+
+		// 소켓은 네트워크 스레드에서만 닫도록 로직 스레드의 강제 종료 요청을 모아둠 (세션 인덱스, Seq)
+		std::mutex m_ForcingCloseLock;
+		std::vector<std::pair<int32_t, int64_t>> m_ForcingCloseQueue;
+		std::vector<std::pair<int32_t, int64_t>> m_ForcingCloseList;
 
 		ILog* m_pRefLogger;
+
+		// 접속이 몰릴 때 세션마다 남는 로그가 네트워크 스레드를 잡아먹지 않도록 제한
+		LogRateLimiter m_ConnectLogLimiter;
+		LogRateLimiter m_AcceptRejectLogLimiter;
+
+		// 송신 버퍼 고수위/저수위 (바이트)
+		int32_t m_SendHighWaterSize = 0;
+		int32_t m_SendLowWaterSize = 0;
+		// 느린 세션에게 보내지 않을 패킷 (로직 스레드 시작 전 Init 단계에서만 설정)
+		bool m_IsLaggingDropPacket[MAX_PACKET_ID] = { false, };
+
+		// 이전 프로세스에게서 넘겨받은 세션
+		std::vector<HandoffSessionInfo> m_HandoffSessionList;
+
+		// 받은 패킷 기록 (AddPacketQueue 에서 네트워크 스레드만 씀)
+		PacketCaptureWriter m_PacketCapture;
 	};
 
 
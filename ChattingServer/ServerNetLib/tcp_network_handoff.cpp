@@ -0,0 +1,428 @@
+// 무중단 재시작: 리슨 소켓과 세션 소켓을 Unix 소켓(SCM_RIGHTS)으로 새 프로세스에게 넘김
+// 이전 프로세스(HandoffSend) -> 새 프로세스(HandoffReceive) 순서
+// 1. HandoffHeader + 리슨 소켓
+// 2. 세션마다 HandoffSessionState + 세션 소켓, 이어서 아직 처리하지 않은 받은 데이터와 보내지 못한 데이터
+// 3. 새 프로세스가 1 바이트 응답을 보내면 이전 프로세스는 종료
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <cerrno>
+#endif
+
+#include <cstring>
+#include <algorithm>
+
+#include "interface_log.h"
+#include "metrics.h"
+#include "tcp_network.h"
+
+namespace NServerNetLib
+{
+	constexpr uint32_t HANDOFF_VERSION = 1;
+
+	struct HandoffHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		int64_t ConnectSeq;
+		int32_t SessionCount;
+	};
+
+	struct HandoffSessionState
+	{
+		int32_t Index;
+		int64_t Seq;
+		char IP[MAX_IP_LEN];
+		int32_t RecvDataSize;
+		int32_t SendDataSize;
+		char UserTag[HANDOFF_USER_TAG_SIZE];
+	};
+
+#ifdef _WIN32
+	NET_ERROR_CODE TcpNetwork::HandoffSend(const std::vector<HandoffSessionInfo>& userTagList)
+	{
+		return NET_ERROR_CODE::kHANDOFF_NOT_SUPPORTED;
+	}
+
+	NET_ERROR_CODE TcpNetwork::HandoffReceive()
+	{
+		return NET_ERROR_CODE::kHANDOFF_NOT_SUPPORTED;
+	}
+
+	bool TcpNetwork::InstallHandoffSession(const SOCKET fd, const HandoffSessionState& state, const char* pRecvData, const char* pSendData)
+	{
+		return false;
+	}
+
+	void TcpNetwork::AbortHandoffReceive()
+	{
+	}
+#else
+	namespace
+	{
+		bool SendAll(const int sockFD, const char* pData, size_t size)
+		{
+			while (size > 0) {
+				auto sendSize = send(sockFD, pData, size, MSG_NOSIGNAL);
+				if (sendSize <= 0) {
+					if (sendSize < 0 && errno == EINTR) {
+						continue;
+					}
+					return false;
+				}
+				pData += sendSize;
+				size -= sendSize;
+			}
+			return true;
+		}
+
+		bool RecvAll(const int sockFD, char* pData, size_t size)
+		{
+			while (size > 0) {
+				auto recvSize = recv(sockFD, pData, size, 0);
+				if (recvSize <= 0) {
+					if (recvSize < 0 && errno == EINTR) {
+						continue;
+					}
+					return false;
+				}
+				pData += recvSize;
+				size -= recvSize;
+			}
+			return true;
+		}
+
+		// 데이터와 함께 소켓 하나를 넘김 (받는 쪽 프로세스에 같은 소켓을 가리키는 새 fd 가 생김)
+		bool SendWithFD(const int sockFD, const void* pData, const size_t size, const int passFD)
+		{
+			iovec iov;
+			iov.iov_base = (void*)pData;
+			iov.iov_len = size;
+
+			char control[CMSG_SPACE(sizeof(int))];
+			memset(control, 0, sizeof(control));
+
+			msghdr msg;
+			memset(&msg, 0, sizeof(msg));
+			msg.msg_iov = &iov;
+			msg.msg_iovlen = 1;
+			msg.msg_control = control;
+			msg.msg_controllen = sizeof(control);
+
+			cmsghdr* pCmsg = CMSG_FIRSTHDR(&msg);
+			pCmsg->cmsg_level = SOL_SOCKET;
+			pCmsg->cmsg_type = SCM_RIGHTS;
+			pCmsg->cmsg_len = CMSG_LEN(sizeof(int));
+			memcpy(CMSG_DATA(pCmsg), &passFD, sizeof(int));
+
+			auto sendSize = sendmsg(sockFD, &msg, MSG_NOSIGNAL);
+			if (sendSize <= 0) {
+				return false;
+			}
+
+			// 소켓은 첫 바이트에 붙어서 가므로 나머지는 그냥 보냄
+			return SendAll(sockFD, (const char*)pData + sendSize, size - sendSize);
+		}
+
+		bool RecvWithFD(const int sockFD, void* pData, const size_t size, int& passFD)
+		{
+			passFD = -1;
+
+			iovec iov;
+			iov.iov_base = pData;
+			iov.iov_len = size;
+
+			char control[CMSG_SPACE(sizeof(int))];
+			msghdr msg;
+			memset(&msg, 0, sizeof(msg));
+			msg.msg_iov = &iov;
+			msg.msg_iovlen = 1;
+			msg.msg_control = control;
+			msg.msg_controllen = sizeof(control);
+
+			auto recvSize = recvmsg(sockFD, &msg, MSG_CMSG_CLOEXEC);
+			if (recvSize <= 0) {
+				return false;
+			}
+
+			for (cmsghdr* pCmsg = CMSG_FIRSTHDR(&msg); pCmsg != nullptr; pCmsg = CMSG_NXTHDR(&msg, pCmsg)) {
+				if (pCmsg->cmsg_level == SOL_SOCKET && pCmsg->cmsg_type == SCM_RIGHTS) {
+					memcpy(&passFD, CMSG_DATA(pCmsg), sizeof(int));
+				}
+			}
+
+			if (passFD < 0) {
+				return false;
+			}
+
+			return RecvAll(sockFD, (char*)pData + recvSize, size - recvSize);
+		}
+
+		bool MakeUnixAddress(const char* pszPath, sockaddr_un& addr)
+		{
+			memset(&addr, 0, sizeof(addr));
+			addr.sun_family = AF_UNIX;
+			if (strlen(pszPath) >= sizeof(addr.sun_path)) {
+				return false;
+			}
+			strcpy(addr.sun_path, pszPath);
+			return true;
+		}
+	}
+
+	NET_ERROR_CODE TcpNetwork::HandoffSend(const std::vector<HandoffSessionInfo>& userTagList)
+	{
+		sockaddr_un addr;
+		if (MakeUnixAddress(m_Config.HandoffSocketPath, addr) == false) {
+			return NET_ERROR_CODE::kHANDOFF_CONNECT_FAIL;
+		}
+
+		// 받을 프로세스가 없으면 아무것도 바꾸지 않고 실패를 돌려줌 (이 프로세스가 계속 서비스)
+		int handoffFD = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (handoffFD < 0 || connect(handoffFD, (sockaddr*)&addr, sizeof(addr)) != 0) {
+			if (handoffFD >= 0) {
+				close(handoffFD);
+			}
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 넘겨받을 프로세스(%s)에 연결 실패", __FUNCTION__, m_Config.HandoffSocketPath);
+			return NET_ERROR_CODE::kHANDOFF_CONNECT_FAIL;
+		}
+
+		// 로직 스레드가 남긴 강제 종료 요청은 여기서 끝내고 넘김
+		RunForcingClose();
+
+		std::vector<const char*> userTagBySession(m_ClientSessionPool.size(), nullptr);
+		for (auto& userTag : userTagList) {
+			if (userTag.SessionIndex >= 0 && userTag.SessionIndex < (int32_t)m_ClientSessionPool.size()) {
+				userTagBySession[userTag.SessionIndex] = userTag.UserTag;
+			}
+		}
+
+		HandoffHeader header;
+		memcpy(header.Magic, "HOFF", sizeof(header.Magic));
+		header.Version = HANDOFF_VERSION;
+		header.ConnectSeq = m_ConnectSeq;
+		header.SessionCount = (int32_t)m_ConnectedSessionCount;
+
+		bool isSuccess = SendWithFD(handoffFD, &header, sizeof(header), m_ServerSockFD);
+
+		int32_t sendSessionCount = 0;
+		for (auto& session : m_ClientSessionPool) {
+			if (isSuccess == false) {
+				break;
+			}
+
+			if (session.IsConnected() == false) {
+				continue;
+			}
+
+			HandoffSessionState state;
+			memset(&state, 0, sizeof(state));
+			state.Index = session.Index;
+			state.Seq = session.Seq;
+			memcpy(state.IP, session.IP, sizeof(state.IP));
+			state.RecvDataSize = session.RemainingDataSize;
+			state.SendDataSize = session.SendSize;
+			if (userTagBySession[session.Index] != nullptr) {
+				memcpy(state.UserTag, userTagBySession[session.Index], sizeof(state.UserTag));
+			}
+
+			isSuccess = SendWithFD(handoffFD, &state, sizeof(state), (int)session.SocketFD)
+				&& SendAll(handoffFD, &session.pRecvBuffer[session.PrevReadPosInRecvBuffer], session.RemainingDataSize)
+				&& SendAll(handoffFD, session.pSendBuffer, session.SendSize);
+			++sendSessionCount;
+		}
+
+		// 새 프로세스가 모두 받았다고 응답해야 끝 (HandoffWaitSec 안에 응답이 없으면 계속 서비스)
+		char ack = 0;
+		if (isSuccess) {
+			timeval timeout{ (time_t)m_Config.HandoffWaitSec, 0 };
+			setsockopt(handoffFD, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+			isSuccess = RecvAll(handoffFD, &ack, 1) && ack == 1;
+		}
+		close(handoffFD);
+
+		if (isSuccess == false) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 세션 넘기기 실패. 보낸 세션(%d)", __FUNCTION__, sendSessionCount);
+			return NET_ERROR_CODE::kHANDOFF_SEND_FAIL;
+		}
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 리슨 소켓과 세션(%d)을 넘김", __FUNCTION__, sendSessionCount);
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	NET_ERROR_CODE TcpNetwork::HandoffReceive()
+	{
+		sockaddr_un addr;
+		if (MakeUnixAddress(m_Config.HandoffSocketPath, addr) == false) {
+			return NET_ERROR_CODE::kHANDOFF_RECV_FAIL;
+		}
+
+		unlink(m_Config.HandoffSocketPath);
+		int listenFD = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listenFD < 0 || bind(listenFD, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFD, 1) != 0) {
+			if (listenFD >= 0) {
+				close(listenFD);
+			}
+			return NET_ERROR_CODE::kHANDOFF_RECV_FAIL;
+		}
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 이전 프로세스가 넘겨주기를 기다림(%s, 최대 %u초)", __FUNCTION__, m_Config.HandoffSocketPath, m_Config.HandoffWaitSec);
+
+		fd_set accept_set;
+		FD_ZERO(&accept_set);
+		FD_SET(listenFD, &accept_set);
+		timeval timeout{ (time_t)m_Config.HandoffWaitSec, 0 };
+		int handoffFD = -1;
+		if (select(listenFD + 1, &accept_set, nullptr, nullptr, &timeout) > 0) {
+			handoffFD = accept(listenFD, nullptr, nullptr);
+		}
+		close(listenFD);
+		unlink(m_Config.HandoffSocketPath);
+
+		if (handoffFD < 0) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 이전 프로세스가 넘겨주지 않음", __FUNCTION__);
+			return NET_ERROR_CODE::kHANDOFF_RECV_FAIL;
+		}
+
+		// 넘겨주는 도중 이전 프로세스가 멈춰도 무한히 기다리지 않도록
+		timeval recvTimeout{ (time_t)m_Config.HandoffWaitSec, 0 };
+		setsockopt(handoffFD, SOL_SOCKET, SO_RCVTIMEO, &recvTimeout, sizeof(recvTimeout));
+
+		HandoffHeader header;
+		int serverSockFD = -1;
+		if (RecvWithFD(handoffFD, &header, sizeof(header), serverSockFD) == false
+			|| memcmp(header.Magic, "HOFF", sizeof(header.Magic)) != 0 || header.Version != HANDOFF_VERSION) {
+			if (serverSockFD >= 0) {
+				close(serverSockFD);
+			}
+			close(handoffFD);
+			return NET_ERROR_CODE::kHANDOFF_RECV_FAIL;
+		}
+
+		m_ServerSockFD = serverSockFD;
+		m_MaxSockFD = m_ServerSockFD;
+		SetNonBlockSocket(m_ServerSockFD);
+		FD_SET(m_ServerSockFD, &m_Readfds);
+		m_ConnectSeq = header.ConnectSeq;
+
+		std::vector<char> recvData(m_Config.MaxClientRecvBufferSize);
+		std::vector<char> sendData(m_Config.MaxClientSendBufferSize);
+
+		bool isSuccess = true;
+		int32_t installCount = 0;
+		for (int32_t i = 0; i < header.SessionCount; ++i) {
+			HandoffSessionState state;
+			int sessionFD = -1;
+			if (RecvWithFD(handoffFD, &state, sizeof(state), sessionFD) == false) {
+				isSuccess = false;
+				break;
+			}
+
+			// 버퍼 크기 설정이 줄어들어 담을 수 없으면 넘겨받기를 그만둠 (응답을 받지 못한 이전 프로세스가 계속 서비스)
+			bool isFit = state.RecvDataSize >= 0 && state.RecvDataSize <= m_Config.MaxClientRecvBufferSize
+				&& state.SendDataSize >= 0 && state.SendDataSize <= m_Config.MaxClientSendBufferSize;
+			if (isFit == false) {
+				close(sessionFD);
+				close(handoffFD);
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 넘겨받은 세션의 버퍼가 설정보다 큼. 세션 인덱스(%d)", __FUNCTION__, state.Index);
+				AbortHandoffReceive();
+				return NET_ERROR_CODE::kHANDOFF_INVALID_STATE;
+			}
+
+			if (RecvAll(handoffFD, recvData.data(), state.RecvDataSize) == false || RecvAll(handoffFD, sendData.data(), state.SendDataSize) == false) {
+				close(sessionFD);
+				isSuccess = false;
+				break;
+			}
+
+			if (InstallHandoffSession(sessionFD, state, recvData.data(), sendData.data()) == false) {
+				m_pRefLogger->WriteLog(LOG_LEVEL::kL_WARN, "%s | 넘겨받은 세션을 넣을 수 없어 끊음. 세션 인덱스(%d)", __FUNCTION__, state.Index);
+				close(sessionFD);
+				continue;
+			}
+			++installCount;
+		}
+
+		// 응답이 이전 프로세스에 닿지 않으면 이전 프로세스가 계속 서비스하므로 넘겨받은 것을 모두 버림
+		char ack = isSuccess ? 1 : 0;
+		if (SendAll(handoffFD, &ack, 1) == false && isSuccess) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 이전 프로세스에 응답을 보내지 못함", __FUNCTION__);
+			isSuccess = false;
+		}
+		close(handoffFD);
+
+		if (isSuccess == false) {
+			m_pRefLogger->WriteLog(LOG_LEVEL::kL_ERROR, "%s | 세션 넘겨받기 실패. 받은 세션(%d)", __FUNCTION__, installCount);
+			AbortHandoffReceive();
+			return NET_ERROR_CODE::kHANDOFF_RECV_FAIL;
+		}
+
+		Metrics::Instance().SetConnectedSessionCount(m_ConnectedSessionCount);
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | 리슨 소켓과 세션(%d)을 넘겨받음", __FUNCTION__, installCount);
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	bool TcpNetwork::InstallHandoffSession(const SOCKET fd, const HandoffSessionState& state, const char* pRecvData, const char* pSendData)
+	{
+		if (state.Index < 0 || state.Index >= (int32_t)m_ClientSessionPool.size() || fd >= FD_SETSIZE) {
+			return false;
+		}
+
+		// 세션 인덱스는 로직 쪽 상태와 맞아야 하므로 같은 인덱스를 사용
+		auto iter = std::find(m_ClientSessionPoolIndex.begin(), m_ClientSessionPoolIndex.end(), state.Index);
+		if (iter == m_ClientSessionPoolIndex.end()) {
+			return false;
+		}
+		m_ClientSessionPoolIndex.erase(iter);
+
+		ClientSession& session = m_ClientSessionPool[state.Index];
+		session.Seq = state.Seq;
+		session.SocketFD = fd;
+		memcpy(session.IP, state.IP, MAX_IP_LEN - 1);
+
+		memcpy(session.pRecvBuffer, pRecvData, state.RecvDataSize);
+		session.RemainingDataSize = state.RecvDataSize;
+		session.PrevReadPosInRecvBuffer = 0;
+
+		memcpy(session.pSendBuffer, pSendData, state.SendDataSize);
+		session.SendSize = state.SendDataSize;
+		// 로직 쪽 느린 세션 추적은 새로 시작하므로 고수위를 넘으면 다시 알리도록 해제해 둠
+		session.IsSendLagging = false;
+
+		FD_SET(fd, &m_Readfds);
+		if (m_MaxSockFD < fd) {
+			m_MaxSockFD = fd;
+		}
+		++m_ConnectedSessionCount;
+
+		HandoffSessionInfo sessionInfo;
+		sessionInfo.SessionIndex = state.Index;
+		memcpy(sessionInfo.UserTag, state.UserTag, sizeof(sessionInfo.UserTag));
+		sessionInfo.UserTag[HANDOFF_USER_TAG_SIZE - 1] = '\0';
+		m_HandoffSessionList.push_back(sessionInfo);
+		return true;
+	}
+
+	void TcpNetwork::AbortHandoffReceive()
+	{
+		// 소켓은 이전 프로세스도 가지고 있으므로 이 프로세스의 fd 만 닫음 (접속은 끊기지 않음)
+		// 로직 스레드가 아직 돌지 않으므로 끊김 알림은 넣지 않음
+		for (auto& sessionInfo : m_HandoffSessionList) {
+			auto& session = m_ClientSessionPool[sessionInfo.SessionIndex];
+			close((int)session.SocketFD);
+			FD_CLR(session.SocketFD, &m_Readfds);
+			ReleaseSessionIndex(sessionInfo.SessionIndex);
+		}
+		m_HandoffSessionList.clear();
+		m_ConnectedSessionCount = 0;
+
+		FD_CLR(m_ServerSockFD, &m_Readfds);
+		close((int)m_ServerSockFD);
+		m_ServerSockFD = -1;
+		m_MaxSockFD = 0;
+	}
+#endif
+}
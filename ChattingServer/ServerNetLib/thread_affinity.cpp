@@ -0,0 +1,251 @@
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <thread>
+
+#include "thread_affinity.h"
+
+namespace NServerNetLib
+{
+	namespace
+	{
+		// 정렬된 CPU 목록을 "0-3,8,10-11" 처럼 묶어서 씀
+		std::string FormatCpuList(std::vector<int32_t> cpuList)
+		{
+			std::sort(cpuList.begin(), cpuList.end());
+
+			std::string text;
+			for (size_t i = 0; i < cpuList.size();) {
+				auto j = i;
+				while (j + 1 < cpuList.size() && cpuList[j + 1] == cpuList[j] + 1) {
+					++j;
+				}
+
+				if (text.empty() == false) {
+					text += ',';
+				}
+				text += std::to_string(cpuList[i]);
+				if (j > i) {
+					text += '-' + std::to_string(cpuList[j]);
+				}
+				i = j + 1;
+			}
+
+			return text;
+		}
+
+		// 목록에서 받아들이는 가장 큰 CPU 번호 + 1 (잘못 적은 범위로 큰 목록을 만들지 않도록)
+		constexpr int32_t MAX_CPU_COUNT = 4096;
+
+#ifndef _WIN32
+		constexpr const char* SYS_NODE_PATH = "/sys/devices/system/node";
+#endif
+	}
+
+	namespace ThreadAffinity
+	{
+		bool PinCurrentThread(const int32_t cpu)
+		{
+			if (cpu < 0) {
+				return true;
+			}
+
+#ifdef _WIN32
+			if (cpu >= (int32_t)(sizeof(DWORD_PTR) * 8)) {
+				return false;
+			}
+			return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) != 0;
+#else
+			if (cpu >= CPU_SETSIZE) {
+				return false;
+			}
+
+			cpu_set_t cpuSet;
+			CPU_ZERO(&cpuSet);
+			CPU_SET(cpu, &cpuSet);
+			return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#endif
+		}
+
+		int32_t GetCurrentCpu()
+		{
+#ifdef _WIN32
+			return (int32_t)GetCurrentProcessorNumber();
+#else
+			return sched_getcpu();
+#endif
+		}
+
+		int32_t GetCpuCount()
+		{
+			return std::max(1, (int32_t)std::thread::hardware_concurrency());
+		}
+
+		int32_t GetCpuNode(const int32_t cpu)
+		{
+			if (cpu < 0) {
+				return 0;
+			}
+
+#ifdef _WIN32
+			UCHAR node = 0;
+			if (cpu > 0xFF || GetNumaProcessorNode((UCHAR)cpu, &node) == FALSE || node == 0xFF) {
+				return 0;
+			}
+			return (int32_t)node;
+#else
+			// cpuN 디렉터리 안의 nodeM 링크가 속한 노드
+			std::error_code errorCode;
+			const auto cpuPath = std::filesystem::path("/sys/devices/system/cpu") / ("cpu" + std::to_string(cpu));
+			for (auto& entry : std::filesystem::directory_iterator(cpuPath, errorCode)) {
+				const auto name = entry.path().filename().string();
+				if (name.size() > 4 && name.compare(0, 4, "node") == 0) {
+					return atoi(name.c_str() + 4);
+				}
+			}
+			return 0;
+#endif
+		}
+
+		std::vector<int32_t> ParseCpuList(const char* pszCpuList)
+		{
+			std::vector<int32_t> cpuList;
+			if (pszCpuList == nullptr) {
+				return cpuList;
+			}
+
+			auto pPos = pszCpuList;
+			while (*pPos != '\0') {
+				char* pEnd = nullptr;
+				auto first = strtol(pPos, &pEnd, 10);
+				if (pEnd == pPos) {
+					++pPos;
+					continue;
+				}
+
+				auto last = first;
+				pPos = pEnd;
+				while (*pPos == ' ') {
+					++pPos;
+				}
+				if (*pPos == '-') {
+					last = strtol(pPos + 1, &pEnd, 10);
+					pPos = pEnd;
+				}
+
+				for (auto cpu = first; cpu >= 0 && cpu <= last && cpu < MAX_CPU_COUNT; ++cpu) {
+					cpuList.push_back((int32_t)cpu);
+				}
+			}
+
+			return cpuList;
+		}
+
+		std::string DescribeTopology()
+		{
+			std::string text;
+
+#ifdef _WIN32
+			ULONG highestNode = 0;
+			if (GetNumaHighestNodeNumber(&highestNode)) {
+				for (ULONG node = 0; node <= highestNode; ++node) {
+					ULONGLONG mask = 0;
+					if (GetNumaNodeProcessorMask((UCHAR)node, &mask) == FALSE || mask == 0) {
+						continue;
+					}
+
+					std::vector<int32_t> cpuList;
+					for (int32_t cpu = 0; cpu < 64; ++cpu) {
+						if (mask & (1ULL << cpu)) {
+							cpuList.push_back(cpu);
+						}
+					}
+					text += (text.empty() ? "" : " ") + std::string("node") + std::to_string(node) + "(" + FormatCpuList(cpuList) + ")";
+				}
+			}
+#else
+			std::error_code errorCode;
+			std::vector<std::pair<int32_t, std::string>> nodeList;
+			for (auto& entry : std::filesystem::directory_iterator(SYS_NODE_PATH, errorCode)) {
+				const auto name = entry.path().filename().string();
+				if (name.size() <= 4 || name.compare(0, 4, "node") != 0) {
+					continue;
+				}
+
+				std::ifstream cpuListFile(entry.path() / "cpulist");
+				std::string cpuList;
+				if (std::getline(cpuListFile, cpuList) && cpuList.empty() == false) {
+					nodeList.emplace_back(atoi(name.c_str() + 4), FormatCpuList(ParseCpuList(cpuList.c_str())));
+				}
+			}
+
+			std::sort(nodeList.begin(), nodeList.end());
+			for (auto& [node, cpuList] : nodeList) {
+				text += (text.empty() ? "" : " ") + std::string("node") + std::to_string(node) + "(" + cpuList + ")";
+			}
+#endif
+
+			// NUMA 정보가 없으면 노드 하나로 봄
+			if (text.empty()) {
+				text = "node0(0-" + std::to_string(GetCpuCount() - 1) + ")";
+			}
+			return text;
+		}
+	}
+
+	ScopedThreadAffinity::ScopedThreadAffinity(const int32_t cpu)
+	{
+		if (cpu < 0) {
+			return;
+		}
+
+#ifdef _WIN32
+		if (cpu >= (int32_t)(sizeof(DWORD_PTR) * 8)) {
+			return;
+		}
+
+		auto savedMask = SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu);
+		if (savedMask == 0) {
+			return;
+		}
+		m_SavedMask.resize(sizeof(savedMask));
+		memcpy(m_SavedMask.data(), &savedMask, sizeof(savedMask));
+#else
+		cpu_set_t savedSet;
+		if (pthread_getaffinity_np(pthread_self(), sizeof(savedSet), &savedSet) != 0 || ThreadAffinity::PinCurrentThread(cpu) == false) {
+			return;
+		}
+		m_SavedMask.resize(sizeof(savedSet));
+		memcpy(m_SavedMask.data(), &savedSet, sizeof(savedSet));
+#endif
+		m_IsPinned = true;
+	}
+
+	ScopedThreadAffinity::~ScopedThreadAffinity()
+	{
+		if (m_IsPinned == false) {
+			return;
+		}
+
+#ifdef _WIN32
+		DWORD_PTR savedMask = 0;
+		memcpy(&savedMask, m_SavedMask.data(), sizeof(savedMask));
+		SetThreadAffinityMask(GetCurrentThread(), savedMask);
+#else
+		cpu_set_t savedSet;
+		memcpy(&savedSet, m_SavedMask.data(), sizeof(savedSet));
+		pthread_setaffinity_np(pthread_self(), sizeof(savedSet), &savedSet);
+#endif
+	}
+}
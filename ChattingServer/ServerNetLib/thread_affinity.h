@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace NServerNetLib
+{
+	// 스레드를 CPU 에 고정하고 NUMA 배치를 확인하는 함수 모음
+	// 메모리는 처음 쓴 스레드가 돌던 CPU 의 노드에 잡히므로(first-touch), 고정할 스레드가 쓸 버퍼는
+	// 그 CPU 에 잠깐 옮겨서(ScopedThreadAffinity) 만들고 한 번 써 두면 별도 라이브러리 없이 같은 노드에 놓임
+	namespace ThreadAffinity
+	{
+		// 현재 스레드를 cpu 하나에 고정 (cpu 가 음수면 아무것도 하지 않고 true)
+		bool PinCurrentThread(const int32_t cpu);
+
+		// 현재 스레드가 돌고 있는 CPU (모르면 -1)
+		int32_t GetCurrentCpu();
+
+		int32_t GetCpuCount();
+
+		// cpu 가 속한 NUMA 노드 (NUMA 가 아니거나 모르면 0)
+		int32_t GetCpuNode(const int32_t cpu);
+
+		// "0,2,4-7" 형식의 목록 (잘못된 항목은 건너뜀)
+		std::vector<int32_t> ParseCpuList(const char* pszCpuList);
+
+		// 노드별 CPU 목록 (예: "node0(0-15,32-47) node1(16-31,48-63)")
+		std::string DescribeTopology();
+	}
+
+	// 만들 때 현재 스레드를 cpu 에 옮기고 없어질 때 원래대로 되돌림 (cpu 가 음수면 아무것도 하지 않음)
+	class ScopedThreadAffinity
+	{
+	public:
+		explicit ScopedThreadAffinity(const int32_t cpu);
+		~ScopedThreadAffinity();
+
+		ScopedThreadAffinity(const ScopedThreadAffinity&) = delete;
+		ScopedThreadAffinity& operator=(const ScopedThreadAffinity&) = delete;
+
+	private:
+		bool m_IsPinned = false;
+		// 원래 CPU 마스크 (플랫폼별 크기가 달라서 바이트로 보관)
+		std::vector<uint8_t> m_SavedMask;
+	};
+}
@@ -0,0 +1,483 @@
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <cerrno>
+#endif
+
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+#include "udp_network.h"
+
+namespace NServerNetLib
+{
+	namespace
+	{
+		int64_t NowMilliSec()
+		{
+			return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		uint64_t NewToken()
+		{
+			static std::mt19937_64 generator(((uint64_t)std::random_device()() << 32) | std::random_device()());
+
+			uint64_t token = 0;
+			while (token == 0) {
+				token = generator();
+			}
+			return token;
+		}
+	}
+
+	UdpNetwork::UdpNetwork()
+	{
+	}
+
+	UdpNetwork::~UdpNetwork()
+	{
+		Release();
+	}
+
+	NET_ERROR_CODE UdpNetwork::Init(const ServerConfig* pConfig, const int32_t sessionPoolSize, ITcpNetwork* pTcpNetwork, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_pRefTcpNetwork = pTcpNetwork;
+		m_Port = pConfig->UdpPort;
+		m_ResendMilliSec = pConfig->UdpResendMilliSec;
+		m_MaxResendCount = pConfig->UdpMaxResendCount;
+
+		m_SessionList.resize(sessionPoolSize);
+		m_RecvBuffer.resize((size_t)UDP_BATCH_COUNT * MAX_UDP_PACKET_SIZE);
+
+		m_SockFD = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		if (m_SockFD == INVALID_SOCKET) {
+			return NET_ERROR_CODE::kUDP_SOCKET_CREATE_FAIL;
+		}
+
+		// 무중단 재시작 때 새 프로세스가 이전 프로세스가 끝나기 전에 같은 포트를 열 수 있도록
+		int reuse = 1;
+		setsockopt(m_SockFD, SOL_SOCKET, SO_REUSEADDR, (char*)&reuse, sizeof(reuse));
+
+		// 틱마다 몰려오는 상태 데이터그램을 잃지 않도록 커널 버퍼를 넉넉히
+		int bufferSize = UDP_BATCH_COUNT * MAX_UDP_PACKET_SIZE * 4;
+		setsockopt(m_SockFD, SOL_SOCKET, SO_RCVBUF, (char*)&bufferSize, sizeof(bufferSize));
+		setsockopt(m_SockFD, SOL_SOCKET, SO_SNDBUF, (char*)&bufferSize, sizeof(bufferSize));
+
+		sockaddr_in addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_ANY);
+		addr.sin_port = htons(m_Port);
+		if (bind(m_SockFD, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR) {
+			Release();
+			return NET_ERROR_CODE::kUDP_SOCKET_BIND_FAIL;
+		}
+
+#ifdef _WIN32
+		unsigned long mode = 1;
+		if (ioctlsocket(m_SockFD, FIONBIO, &mode) == SOCKET_ERROR) {
+			Release();
+			return NET_ERROR_CODE::kSERVER_SOCKET_FIONBIO_FAIL;
+		}
+#endif
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | UDP 채널 시작. 포트(%d), 재전송 간격(%ums), 최대 재전송(%u)", __FUNCTION__,
+			m_Port, m_ResendMilliSec, m_MaxResendCount);
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	void UdpNetwork::Release()
+	{
+		if (m_SockFD == INVALID_SOCKET) {
+			return;
+		}
+
+#ifdef _WIN32
+		closesocket(m_SockFD);
+#else
+		close(m_SockFD);
+#endif
+		m_SockFD = INVALID_SOCKET;
+
+		m_pRefLogger->WriteLog(LOG_LEVEL::kL_INFO, "%s | UDP 채널 종료. 받음(%llu), 받고 버림(%llu), 보냄(%llu), 보내지 못함(%llu), 재전송(%llu), 재전송 포기(%llu)", __FUNCTION__,
+			(unsigned long long)m_RecvCount.load(), (unsigned long long)m_RecvDropCount.load(), (unsigned long long)m_SendCount.load(),
+			(unsigned long long)m_SendDropCount.load(), (unsigned long long)m_ResendCount.load(), (unsigned long long)m_ResendGiveUpCount.load());
+	}
+
+	void UdpNetwork::SetRecvPacket(const int16_t packetId, const bool isAllow)
+	{
+		if (packetId <= 0 || packetId >= MAX_PACKET_ID) {
+			return;
+		}
+
+		m_IsRecvPacket[packetId] = isAllow;
+	}
+
+	uint64_t UdpNetwork::OpenSession(const int32_t sessionIndex)
+	{
+		if (sessionIndex < 0 || sessionIndex >= (int32_t)m_SessionList.size()) {
+			return 0;
+		}
+
+		std::lock_guard<std::mutex> guard(m_SessionLock);
+
+		auto& session = m_SessionList[sessionIndex];
+		m_ResendPendingCount -= (uint32_t)session.ResendList.size();
+		session = UdpSession();
+		session.Token = NewToken();
+		return session.Token;
+	}
+
+	void UdpNetwork::CloseSession(const int32_t sessionIndex)
+	{
+		if (sessionIndex < 0 || sessionIndex >= (int32_t)m_SessionList.size()) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> guard(m_SessionLock);
+
+		auto& session = m_SessionList[sessionIndex];
+		m_ResendPendingCount -= (uint32_t)session.ResendList.size();
+		session = UdpSession();
+	}
+
+	NET_ERROR_CODE UdpNetwork::SendData(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pMsg, const bool isReliable)
+	{
+		if (sessionIndex < 0 || sessionIndex >= (int32_t)m_SessionList.size()) {
+			return NET_ERROR_CODE::kSEND_CLOSE_SOCKET;
+		}
+
+		if (bodySize < 0 || bodySize > MAX_UDP_BODY_SIZE) {
+			return NET_ERROR_CODE::kUDP_PACKET_TOO_BIG;
+		}
+
+		std::lock_guard<std::mutex> guard(m_SessionLock);
+
+		auto& session = m_SessionList[sessionIndex];
+		if (session.Token == 0 || session.IsBound == false) {
+			return NET_ERROR_CODE::kUDP_NOT_BOUND;
+		}
+
+		if (isReliable && session.ResendList.size() >= UDP_MAX_RESEND_PENDING) {
+			return NET_ERROR_CODE::kUDP_RESEND_LIST_FULL;
+		}
+
+		UdpPacketHeader header;
+		header.SessionIndex = 0;
+		header.Token = 0;
+		header.Seq = ++session.SendSeq;
+		header.AckSeq = 0;
+		header.Id = packetId;
+		header.Flags = isReliable ? kUDP_FLAG_RELIABLE : 0;
+
+		m_SendList.emplace_back();
+		auto& sendPacket = m_SendList.back();
+		sendPacket.Addr = session.Addr;
+		sendPacket.Size = UDP_HEADER_SIZE + bodySize;
+		memcpy(sendPacket.Data, &header, UDP_HEADER_SIZE);
+		if (bodySize > 0) {
+			memcpy(sendPacket.Data + UDP_HEADER_SIZE, pMsg, bodySize);
+		}
+
+		if (isReliable) {
+			ResendPacket resendPacket;
+			resendPacket.Seq = header.Seq;
+			resendPacket.LastSendTimeMilliSec = NowMilliSec();
+			resendPacket.SendCount = 1;
+			resendPacket.Data.assign(sendPacket.Data, sendPacket.Data + sendPacket.Size);
+			session.ResendList.push_back(std::move(resendPacket));
+			++m_ResendPendingCount;
+		}
+
+		return NET_ERROR_CODE::kNONE;
+	}
+
+	bool UdpNetwork::Flush()
+	{
+		if (m_ResendPendingCount > 0) {
+			ResendCheck(NowMilliSec());
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(m_SessionLock);
+			m_SendList.swap(m_FlushList);
+		}
+
+		if (m_FlushList.empty()) {
+			return false;
+		}
+
+		SendBatch(m_FlushList);
+		return true;
+	}
+
+	void UdpNetwork::ResendCheck(const int64_t curTimeMilliSec)
+	{
+		std::lock_guard<std::mutex> guard(m_SessionLock);
+
+		for (int32_t i = 0; i < (int32_t)m_SessionList.size(); ++i) {
+			auto& session = m_SessionList[i];
+
+			// 보낸 순서대로 쌓이므로 앞에서부터 간격이 안 된 것을 만나면 멈춤
+			while (session.ResendList.empty() == false) {
+				auto& resendPacket = session.ResendList.front();
+				if (curTimeMilliSec - resendPacket.LastSendTimeMilliSec < (int64_t)m_ResendMilliSec) {
+					break;
+				}
+
+				if (resendPacket.SendCount > m_MaxResendCount) {
+					++m_ResendGiveUpCount;
+					SERVER_LOG(m_pRefLogger, LOG_LEVEL::kL_DEBUG, "%s | 응답이 없어 재전송 포기. 세션 인덱스(%d), Seq(%u)", __FUNCTION__, i, resendPacket.Seq);
+					session.ResendList.pop_front();
+					--m_ResendPendingCount;
+					continue;
+				}
+
+				AddSendPacket(m_SendList, session.Addr, resendPacket.Data.data(), (int32_t)resendPacket.Data.size());
+				resendPacket.LastSendTimeMilliSec = curTimeMilliSec;
+				++resendPacket.SendCount;
+				++m_ResendCount;
+
+				// 다시 보낸 것은 뒤로 옮겨 다음 간격까지 기다리게 함
+				session.ResendList.push_back(std::move(resendPacket));
+				session.ResendList.pop_front();
+			}
+		}
+	}
+
+	bool UdpNetwork::Run(const int32_t waitMilliSec)
+	{
+		if (m_SockFD == INVALID_SOCKET) {
+			return false;
+		}
+
+		int32_t recvCount = 0;
+
+#ifdef _WIN32
+		fd_set readSet;
+		FD_ZERO(&readSet);
+		FD_SET(m_SockFD, &readSet);
+		timeval timeout{ 0, waitMilliSec * 1000 };
+		if (select(0, &readSet, nullptr, nullptr, &timeout) <= 0) {
+			return false;
+		}
+
+		while (true) {
+			sockaddr_in addr;
+			int addrLen = sizeof(addr);
+			auto size = recvfrom(m_SockFD, m_RecvBuffer.data(), MAX_UDP_PACKET_SIZE, 0, (sockaddr*)&addr, &addrLen);
+			if (size == SOCKET_ERROR) {
+				break;
+			}
+
+			ProcessDatagram(m_RecvBuffer.data(), size, addr);
+			++recvCount;
+		}
+#else
+		pollfd pollFD{ m_SockFD, POLLIN, 0 };
+		if (poll(&pollFD, 1, waitMilliSec) <= 0) {
+			return false;
+		}
+
+		mmsghdr msgList[UDP_BATCH_COUNT];
+		iovec iovList[UDP_BATCH_COUNT];
+		sockaddr_in addrList[UDP_BATCH_COUNT];
+
+		// 한 번에 가득 받았으면 더 있을 수 있으므로 다시 받음
+		while (true) {
+			memset(msgList, 0, sizeof(msgList));
+			for (int i = 0; i < UDP_BATCH_COUNT; ++i) {
+				iovList[i].iov_base = m_RecvBuffer.data() + (size_t)i * MAX_UDP_PACKET_SIZE;
+				iovList[i].iov_len = MAX_UDP_PACKET_SIZE;
+				msgList[i].msg_hdr.msg_iov = &iovList[i];
+				msgList[i].msg_hdr.msg_iovlen = 1;
+				msgList[i].msg_hdr.msg_name = &addrList[i];
+				msgList[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			}
+
+			int count = recvmmsg(m_SockFD, msgList, UDP_BATCH_COUNT, MSG_DONTWAIT, nullptr);
+			if (count <= 0) {
+				break;
+			}
+
+			for (int i = 0; i < count; ++i) {
+				ProcessDatagram((const char*)iovList[i].iov_base, (int32_t)msgList[i].msg_len, addrList[i]);
+			}
+			recvCount += count;
+
+			if (count < UDP_BATCH_COUNT) {
+				break;
+			}
+		}
+#endif
+
+		if (m_AckList.empty() == false) {
+			SendBatch(m_AckList);
+		}
+
+		return recvCount > 0;
+	}
+
+	void UdpNetwork::ProcessDatagram(const char* pData, const int32_t size, const sockaddr_in& addr)
+	{
+		++m_RecvCount;
+
+		if (size < UDP_HEADER_SIZE) {
+			++m_RecvDropCount;
+			return;
+		}
+
+		UdpPacketHeader header;
+		memcpy(&header, pData, UDP_HEADER_SIZE);
+		auto bodySize = (int16_t)(size - UDP_HEADER_SIZE);
+		auto isReliable = (header.Flags & kUDP_FLAG_RELIABLE) != 0;
+
+		if (header.SessionIndex < 0 || header.SessionIndex >= (int32_t)m_SessionList.size() || header.Token == 0) {
+			++m_RecvDropCount;
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(m_SessionLock);
+
+			auto& session = m_SessionList[header.SessionIndex];
+			if (session.Token != header.Token) {
+				++m_RecvDropCount;
+				return;
+			}
+
+			// 토큰이 맞으면 보낸 주소로 바인딩 (NAT 로 주소가 바뀌어도 따라감)
+			session.Addr = addr;
+			session.IsBound = true;
+
+			if (header.Flags & kUDP_FLAG_ACK) {
+				auto iter = std::find_if(session.ResendList.begin(), session.ResendList.end(),
+					[&](const ResendPacket& resendPacket) { return resendPacket.Seq == header.AckSeq; });
+				if (iter != session.ResendList.end()) {
+					session.ResendList.erase(iter);
+					--m_ResendPendingCount;
+				}
+			}
+
+			// ack 만 담은 데이터그램
+			if (header.Id == 0 && isReliable == false) {
+				return;
+			}
+
+			// 중복이어도 앞선 ack 를 잃었을 수 있으므로 reliable 은 항상 응답
+			if (isReliable) {
+				AddAck(addr, header.Seq);
+			}
+
+			if (CheckRecvSeq(session, header.Seq, isReliable) == false) {
+				++m_RecvDropCount;
+				return;
+			}
+		}
+
+		// Id 0 은 바인딩 확인용
+		if (header.Id == 0) {
+			return;
+		}
+
+		if (header.Id < 0 || header.Id >= MAX_PACKET_ID || m_IsRecvPacket[header.Id] == false) {
+			++m_RecvDropCount;
+			return;
+		}
+
+		m_pRefTcpNetwork->PostPacket(header.SessionIndex, header.Id, bodySize, (const int8_t*)(pData + UDP_HEADER_SIZE));
+	}
+
+	bool UdpNetwork::CheckRecvSeq(UdpSession& session, const uint32_t seq, const bool isReliable)
+	{
+		if (seq > session.RecvMaxSeq) {
+			auto shift = seq - session.RecvMaxSeq;
+			session.RecvSeqMask = shift >= 64 ? 0 : (session.RecvSeqMask << shift);
+			session.RecvSeqMask |= 1;
+			session.RecvMaxSeq = seq;
+			return true;
+		}
+
+		// 기록 범위보다 오래된 것은 중복인지 알 수 없으므로 버림
+		auto diff = session.RecvMaxSeq - seq;
+		if (diff >= 64) {
+			return false;
+		}
+
+		uint64_t bit = (uint64_t)1 << diff;
+		if (session.RecvSeqMask & bit) {
+			return false;
+		}
+		session.RecvSeqMask |= bit;
+
+		// 순서가 뒤바뀐 unreliable 은 이미 더 새로운 상태를 받았으므로 버림
+		return isReliable;
+	}
+
+	void UdpNetwork::AddAck(const sockaddr_in& addr, const uint32_t ackSeq)
+	{
+		UdpPacketHeader header;
+		memset(&header, 0, sizeof(header));
+		header.AckSeq = ackSeq;
+		header.Flags = kUDP_FLAG_ACK;
+
+		AddSendPacket(m_AckList, addr, (const char*)&header, UDP_HEADER_SIZE);
+	}
+
+	void UdpNetwork::AddSendPacket(std::vector<SendPacket>& sendList, const sockaddr_in& addr, const char* pData, const int32_t size)
+	{
+		sendList.emplace_back();
+		auto& sendPacket = sendList.back();
+		sendPacket.Addr = addr;
+		sendPacket.Size = size;
+		memcpy(sendPacket.Data, pData, size);
+	}
+
+	void UdpNetwork::SendBatch(std::vector<SendPacket>& sendList)
+	{
+		size_t sentCount = 0;
+
+#ifdef _WIN32
+		for (auto& sendPacket : sendList) {
+			if (sendto(m_SockFD, sendPacket.Data, sendPacket.Size, 0, (sockaddr*)&sendPacket.Addr, sizeof(sendPacket.Addr)) == SOCKET_ERROR) {
+				break;
+			}
+			++sentCount;
+		}
+#else
+		mmsghdr msgList[UDP_BATCH_COUNT];
+		iovec iovList[UDP_BATCH_COUNT];
+
+		while (sentCount < sendList.size()) {
+			auto count = (int)std::min<size_t>(UDP_BATCH_COUNT, sendList.size() - sentCount);
+
+			memset(msgList, 0, sizeof(msgList));
+			for (int i = 0; i < count; ++i) {
+				auto& sendPacket = sendList[sentCount + i];
+				iovList[i].iov_base = sendPacket.Data;
+				iovList[i].iov_len = sendPacket.Size;
+				msgList[i].msg_hdr.msg_iov = &iovList[i];
+				msgList[i].msg_hdr.msg_iovlen = 1;
+				msgList[i].msg_hdr.msg_name = &sendPacket.Addr;
+				msgList[i].msg_hdr.msg_namelen = sizeof(sendPacket.Addr);
+			}
+
+			// 일부만 보내고 돌아올 수 있음. 소켓 버퍼가 가득 차면(-1) 나머지는 버림
+			int sent = sendmmsg(m_SockFD, msgList, count, MSG_DONTWAIT);
+			if (sent <= 0) {
+				break;
+			}
+			sentCount += sent;
+		}
+#endif
+
+		m_SendCount += sentCount;
+		m_SendDropCount += sendList.size() - sentCount;
+		sendList.clear();
+	}
+}
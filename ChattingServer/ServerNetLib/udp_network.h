@@ -0,0 +1,165 @@
+#pragma once
+
+#ifndef _WIN32
+#include <netinet/in.h>
+#endif
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+
+#include "tcp_network.h"
+
+namespace NServerNetLib
+{
+	// UdpPacketHeader::Flags
+	enum UDP_FLAG : uint8_t
+	{
+		// 받으면 kACK 로 응답해야 하고, 응답이 없으면 재전송
+		kUDP_FLAG_RELIABLE = 0x01,
+		// AckSeq 가 유효 (바디 없이 ack 만 보낼 때는 Id 0)
+		kUDP_FLAG_ACK = 0x02,
+	};
+
+#pragma pack(push, 1)
+	// UDP 데이터그램 하나 = 헤더 + 바디 (TCP 처럼 이어지지 않으므로 TotalSize 는 없음)
+	struct UdpPacketHeader
+	{
+		// 클라이언트 → 서버: 로그인 후 TCP 로 받은 세션 인덱스와 토큰 (서버 → 클라이언트는 0)
+		int32_t SessionIndex;
+		uint64_t Token;
+		// 보내는 쪽이 데이터그램마다 1 씩 올리는 번호 (1 부터)
+		uint32_t Seq;
+		// kUDP_FLAG_ACK: 잘 받았다고 알리는 상대의 Seq
+		uint32_t AckSeq;
+		int16_t Id;
+		uint8_t Flags;
+	};
+#pragma pack(pop)
+	constexpr int UDP_HEADER_SIZE = sizeof(UdpPacketHeader);
+
+	// IP 조각이 나지 않도록 일반적인 MTU 보다 작게
+	constexpr int MAX_UDP_PACKET_SIZE = 1200;
+	constexpr int MAX_UDP_BODY_SIZE = MAX_UDP_PACKET_SIZE - UDP_HEADER_SIZE;
+	// recvmmsg/sendmmsg 한 번에 처리할 데이터그램 수
+	constexpr int UDP_BATCH_COUNT = 64;
+	// 세션마다 응답을 기다리는 reliable 데이터그램 최대 수
+	constexpr int UDP_MAX_RESEND_PENDING = 64;
+
+	// 로그인한 TCP 세션에 토큰으로 묶이는 UDP 채널 (게임 중인 룸의 상태처럼 늦게 오느니 버리는 게 나은 데이터용)
+	// - 클라이언트는 TCP 로 받은 (세션 인덱스, 토큰)을 모든 데이터그램에 붙이고, 처음 받은 주소로 바인딩 (주소가 바뀌면 따라감)
+	//   바인딩 확인은 Id 0, kUDP_FLAG_RELIABLE 데이터그램을 보내고 ack 를 받으면 됨
+	// - 받기: UDP 스레드가 Run 에서 recvmmsg 로 몰아서 받고, 허용한 패킷만 ITcpNetwork::PostPacket 으로 같은 로직 큐에 넣음
+	//   unreliable 은 이미 받은 것보다 오래된 Seq 면 버림 (최신 상태만 의미 있음), reliable 은 중복만 버림
+	// - 보내기: 로직 스레드가 SendData 로 모아두고 Flush 에서 sendmmsg 로 한 번에 보냄. reliable 은 ack 가 올 때까지 재전송
+	class UdpNetwork
+	{
+		struct ResendPacket
+		{
+			uint32_t Seq = 0;
+			int64_t LastSendTimeMilliSec = 0;
+			uint32_t SendCount = 0;
+			std::vector<char> Data;
+		};
+
+		struct UdpSession
+		{
+			// 0 이면 채널이 열리지 않은 세션
+			uint64_t Token = 0;
+			bool IsBound = false;
+			sockaddr_in Addr;
+
+			uint32_t SendSeq = 0;
+			// 받은 가장 큰 Seq 와 그 아래 64 개의 수신 여부 (비트 0 = RecvMaxSeq)
+			uint32_t RecvMaxSeq = 0;
+			uint64_t RecvSeqMask = 0;
+
+			std::deque<ResendPacket> ResendList;
+		};
+
+		struct SendPacket
+		{
+			sockaddr_in Addr;
+			int32_t Size = 0;
+			char Data[MAX_UDP_PACKET_SIZE];
+		};
+
+	public:
+		UdpNetwork();
+		~UdpNetwork();
+
+		// sessionPoolSize 는 TCP 세션 풀 크기 (같은 세션 인덱스를 사용)
+		NET_ERROR_CODE Init(const ServerConfig* pConfig, const int32_t sessionPoolSize, ITcpNetwork* pTcpNetwork, ILog* pLogger);
+
+		void Release();
+
+		uint16_t GetPort() const { return m_Port; }
+
+		// 이 패킷만 UDP 로 받아서 로직에 넘김 (로직 스레드 시작 전 Init 단계에서만 설정)
+		void SetRecvPacket(const int16_t packetId, const bool isAllow);
+
+		// 로직 스레드: 세션의 채널을 새 토큰으로 열고 토큰을 반환 (이전 바인딩과 순서 번호는 버림)
+		uint64_t OpenSession(const int32_t sessionIndex);
+
+		// 로직 스레드: TCP 세션이 끊기면 채널도 닫음
+		void CloseSession(const int32_t sessionIndex);
+
+		// 로직 스레드/워커: 보낼 데이터그램을 모아둠 (실제 전송은 Flush). 클라이언트가 아직 바인딩하지 않았으면 kUDP_NOT_BOUND
+		NET_ERROR_CODE SendData(const int32_t sessionIndex, const int16_t packetId, const int16_t bodySize, const char* pMsg, const bool isReliable);
+
+		// 로직 스레드: 모아둔 데이터그램과 재전송할 reliable 데이터그램을 한 번에 보냄 (보낸 것이 있으면 true)
+		bool Flush();
+
+		// UDP 스레드: 최대 waitMilliSec 동안 기다렸다가 도착한 데이터그램을 몰아서 처리 (처리한 것이 있으면 true)
+		bool Run(const int32_t waitMilliSec);
+
+	private:
+		void ProcessDatagram(const char* pData, const int32_t size, const sockaddr_in& addr);
+
+		// 수신 순서 번호 확인. 로직에 넘겨도 되면 true
+		bool CheckRecvSeq(UdpSession& session, const uint32_t seq, const bool isReliable);
+
+		void AddAck(const sockaddr_in& addr, const uint32_t ackSeq);
+
+		void AddSendPacket(std::vector<SendPacket>& sendList, const sockaddr_in& addr, const char* pData, const int32_t size);
+
+		// sendList 를 UDP_BATCH_COUNT 개씩 보냄 (소켓 버퍼가 가득 차면 나머지는 버림)
+		void SendBatch(std::vector<SendPacket>& sendList);
+
+		void ResendCheck(const int64_t curTimeMilliSec);
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+		ITcpNetwork* m_pRefTcpNetwork = nullptr;
+
+		SOCKET m_SockFD = INVALID_SOCKET;
+		uint16_t m_Port = 0;
+
+		uint32_t m_ResendMilliSec = 0;
+		uint32_t m_MaxResendCount = 0;
+
+		bool m_IsRecvPacket[MAX_PACKET_ID] = { false, };
+
+		// 로직 스레드(열기/닫기/보내기/재전송)와 UDP 스레드(바인딩/ack/수신 순서)가 같이 사용
+		std::mutex m_SessionLock;
+		std::vector<UdpSession> m_SessionList;
+		std::atomic<uint32_t> m_ResendPendingCount = 0;
+
+		// SendData 가 모으는 목록 (m_SessionLock 안에서, 여러 로직 워커가 동시에 호출 가능)
+		std::vector<SendPacket> m_SendList;
+		// Flush 가 m_SendList 와 교체해서 보내는 목록 (로직 스레드만 사용)
+		std::vector<SendPacket> m_FlushList;
+
+		// UDP 스레드만 사용
+		std::vector<SendPacket> m_AckList;
+		std::vector<char> m_RecvBuffer;
+
+		std::atomic<uint64_t> m_RecvCount = 0;
+		std::atomic<uint64_t> m_RecvDropCount = 0;
+		std::atomic<uint64_t> m_SendCount = 0;
+		std::atomic<uint64_t> m_SendDropCount = 0;
+		std::atomic<uint64_t> m_ResendCount = 0;
+		std::atomic<uint64_t> m_ResendGiveUpCount = 0;
+	};
+}